@@ -0,0 +1,267 @@
+// Handle scan benchmark: times the portable core of HandleScan - the growable query buffer, the
+// pid/file-type filter over a system-wide handle table and the .sln candidate ranking - without
+// touching the OS. The table is synthetic (--handles entries, one devenv-like target process) or a
+// recording loaded with --table; --record writes the table used so a run can be replayed.
+//
+// Recorded table format, one handle per line:  pid typeIndex value access [path]
+//
+// Usage: HandleScanBench [--handles N] [--iters N] [--table FILE] [--record FILE]
+
+#include "handle_scan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Stats
+{
+    double meanMs = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+static Stats Summarize(std::vector<double> samples)
+{
+    Stats s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    for (double v : samples) s.meanMs += v;
+    s.meanMs /= (double)samples.size();
+    s.p95Ms = samples[(size_t)((samples.size() - 1) * 0.95)];
+    s.maxMs = samples.back();
+    return s;
+}
+
+template <typename Fn>
+static Stats Time(int iters, Fn&& fn)
+{
+    std::vector<double> samples;
+    samples.reserve(iters);
+    for (int i = 0; i < iters; ++i)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return Summarize(std::move(samples));
+}
+
+static void PrintRow(const char* name, const Stats& s, const char* note = "")
+{
+    std::printf("%-34s %9.4f %9.4f %9.4f  %s\n", name, s.meanMs, s.p95Ms, s.maxMs, note);
+}
+
+struct Table
+{
+    std::vector<HandleScan::HandleEntry> entries;
+    std::unordered_map<uint64_t, std::string> paths; // (pid << 32 | value) -> path of file handles
+    uint32_t targetPid = 0;
+    uint16_t fileType = 0;
+    std::string activeDocument;
+};
+
+static uint64_t PathKey(uint32_t pid, uint64_t value) { return ((uint64_t)pid << 32) ^ value; }
+
+// Roughly a busy desktop: ~40 object types, a few hundred processes, one VS instance holding a
+// couple of thousand handles with three solutions of a monorepo open among its files
+static Table Synthesize(int handles)
+{
+    Table t;
+    t.targetPid = 4242;
+    t.fileType = 37;
+    t.activeDocument = "C:\\src\\Monorepo\\Engine\\Render\\Device.cpp";
+    static const char* dirs[] = { "C:\\src\\Monorepo\\Engine\\Render", "C:\\src\\Monorepo\\Engine", "C:\\src\\Monorepo\\Tools\\Editor",
+                                  "C:\\Program Files\\Microsoft Visual Studio\\2022\\Community\\Common7\\IDE", "C:\\Users\\dev\\AppData\\Local\\Temp" };
+    static const char* exts[] = { ".cpp", ".h", ".dll", ".pdb", ".vsidx", ".json", ".log", ".ipch" };
+    const int targetHandles = std::min(handles, 3000);
+    uint32_t seed = 12345;
+    auto next = [&]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    t.entries.reserve((size_t)handles);
+    for (int i = 0; i < handles; ++i)
+    {
+        HandleScan::HandleEntry e;
+        bool target = i % std::max(1, handles / targetHandles) == 0;
+        e.pid = target ? t.targetPid : 4 + (next() % 400) * 4;
+        e.typeIndex = (uint16_t)((next() % 4) == 0 ? t.fileType : 2 + next() % 40);
+        e.value = 4 + (uint64_t)i * 4;
+        e.access = 0x0012019f;
+        t.entries.push_back(e);
+        if (e.pid == t.targetPid && e.typeIndex == t.fileType)
+        {
+            const char* dir = dirs[next() % 5];
+            t.paths[PathKey(e.pid, e.value)] = std::string(dir) + "\\f" + std::to_string(i) + exts[next() % 8];
+        }
+    }
+    // The solutions VS keeps open; the one closest to the active document must win
+    int added = 0;
+    for (auto& e : t.entries)
+    {
+        if (e.pid != t.targetPid || e.typeIndex != t.fileType) continue;
+        if (added == 0) t.paths[PathKey(e.pid, e.value)] = "C:\\src\\Monorepo\\Monorepo.sln";
+        else if (added == 1) t.paths[PathKey(e.pid, e.value)] = "C:\\src\\Monorepo\\Engine\\Engine.sln";
+        else if (added == 2) t.paths[PathKey(e.pid, e.value)] = "C:\\src\\Monorepo\\Tools\\Editor\\Editor.slnf";
+        else break;
+        added++;
+    }
+    return t;
+}
+
+static bool Load(const std::string& file, Table& t)
+{
+    std::ifstream in(file);
+    if (!in) return false;
+    std::unordered_map<uint32_t, int> perPid;
+    std::unordered_map<uint16_t, int> perType;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ls(line);
+        HandleScan::HandleEntry e;
+        unsigned type = 0;
+        if (!(ls >> e.pid >> type >> e.value >> e.access)) continue;
+        e.typeIndex = (uint16_t)type;
+        std::string path;
+        std::getline(ls >> std::ws, path);
+        if (!path.empty())
+        {
+            t.paths[PathKey(e.pid, e.value)] = path;
+            perType[e.typeIndex]++;
+            if (t.activeDocument.empty() && path.find(".sln") == std::string::npos) t.activeDocument = path;
+        }
+        perPid[e.pid]++;
+        t.entries.push_back(e);
+    }
+    // Target: the process with the most handles; file type: the type that carries paths
+    for (auto& kv : perPid) if (t.targetPid == 0 || kv.second > perPid[t.targetPid]) t.targetPid = kv.first;
+    int best = 0;
+    for (auto& kv : perType) if (kv.second > best) { best = kv.second; t.fileType = kv.first; }
+    return !t.entries.empty();
+}
+
+static bool Record(const std::string& file, const Table& t)
+{
+    std::ofstream out(file);
+    if (!out) return false;
+    out << "# pid typeIndex value access [path]\n";
+    for (const auto& e : t.entries)
+    {
+        out << e.pid << ' ' << e.typeIndex << ' ' << e.value << ' ' << e.access;
+        auto it = t.paths.find(PathKey(e.pid, e.value));
+        if (it != t.paths.end()) out << ' ' << it->second;
+        out << '\n';
+    }
+    return true;
+}
+
+// Stand-in for NtQuerySystemInformation: reports the size it needs and fails until it fits.
+// The table grows by grow entries per call, like a live system between the probe and the retry.
+struct FakeSystemQuery
+{
+    const Table* table;
+    size_t count;
+    size_t grow;
+
+    HandleScan::QueryStatus operator()(void* data, size_t size, size_t& needed)
+    {
+        count = std::min(count + grow, table->entries.size());
+        needed = sizeof(uint64_t) + count * sizeof(HandleScan::HandleEntry);
+        if (size < needed) return HandleScan::QueryStatus::TooSmall;
+        uint64_t n = count;
+        std::memcpy(data, &n, sizeof(n));
+        std::memcpy(static_cast<char*>(data) + sizeof(n), table->entries.data(), count * sizeof(HandleScan::HandleEntry));
+        return HandleScan::QueryStatus::Ok;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    int handles = 150000;
+    int iters = 50;
+    std::string tableFile, recordFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        auto next = [&](void) -> const char* { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (a == "--handles") handles = std::max(1, std::atoi(next()));
+        else if (a == "--iters") iters = std::max(1, std::atoi(next()));
+        else if (a == "--table") tableFile = next();
+        else if (a == "--record") recordFile = next();
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--handles N] [--iters N] [--table FILE] [--record FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Table table;
+    if (!tableFile.empty())
+    {
+        if (!Load(tableFile, table))
+        {
+            std::fprintf(stderr, "[bench] cannot read handle table %s\n", tableFile.c_str());
+            return 1;
+        }
+    }
+    else
+    {
+        table = Synthesize(handles);
+    }
+    if (!recordFile.empty() && !Record(recordFile, table))
+        std::fprintf(stderr, "[bench] cannot write %s\n", recordFile.c_str());
+
+    std::printf("HandleScanBench: %s, %d handles, target pid %u, file type %u, %d iterations\n",
+                tableFile.empty() ? "synthetic table" : tableFile.c_str(), (int)table.entries.size(),
+                (unsigned)table.targetPid, (unsigned)table.fileType, iters);
+    std::printf("%-34s %9s %9s %9s\n", "step", "mean ms", "p95 ms", "max ms");
+
+    // 1. Query with a fresh 64 KiB buffer every time (the old fixed buffer, but retrying) vs. a reused one
+    const size_t start = table.entries.size() - std::min<size_t>(table.entries.size(), 500);
+    unsigned coldGrows = 0;
+    PrintRow("query, fresh 64 KiB buffer", Time(iters, [&]() {
+        HandleScan::GrowableBuffer buffer(64 * 1024);
+        FakeSystemQuery query{ &table, start, 100 };
+        buffer.Fill(query);
+        coldGrows += buffer.GrowCount();
+    }));
+    HandleScan::GrowableBuffer reused(64 * 1024);
+    PrintRow("query, reused buffer", Time(iters, [&]() {
+        FakeSystemQuery query{ &table, start, 100 };
+        reused.Fill(query);
+    }));
+    std::printf("  buffer grows: %.1f per fresh query, %u in total for the reused buffer (%zu KiB)\n",
+                (double)coldGrows / iters, reused.GrowCount(), reused.Size() / 1024);
+
+    // 2. Keep the target's file handles only (everything else never reaches path resolution)
+    char note[96];
+    std::vector<HandleScan::HandleEntry> files;
+    Stats filter = Time(iters, [&]() {
+        HandleScan::FilterHandles(table.entries.data(), table.entries.size(), table.targetPid, table.fileType, files);
+    });
+    std::snprintf(note, sizeof(note), "%d of %d handles kept", (int)files.size(), (int)table.entries.size());
+    PrintRow("filter pid + file type", filter, note);
+
+    // 3. Rank .sln candidates among the resolved paths
+    std::vector<std::string> openPaths;
+    for (const auto& e : files)
+    {
+        auto it = table.paths.find(PathKey(e.pid, e.value));
+        if (it != table.paths.end()) openPaths.push_back(it->second);
+    }
+    std::vector<std::string> ranked;
+    Stats rank = Time(iters, [&]() { ranked = HandleScan::RankSolutionCandidates(openPaths, table.activeDocument); });
+    std::snprintf(note, sizeof(note), "%d paths, %d candidates", (int)openPaths.size(), (int)ranked.size());
+    PrintRow("rank solution candidates", rank, note);
+
+    std::printf("\nactive document: %s\n", table.activeDocument.c_str());
+    for (size_t i = 0; i < ranked.size() && i < 5; ++i)
+        std::printf("  %zu. %s\n", i + 1, ranked[i].c_str());
+    return 0;
+}
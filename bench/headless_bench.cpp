@@ -0,0 +1,351 @@
+// Headless UI benchmark: drives FeatureManager::DrawAllFeatures with a null renderer
+// (draw data is produced and discarded) so frame cost can be measured without a GPU or display.
+//
+// Usage: HeadlessBench [--frames N] [--warmup N] [--size WxH] [--font path.ttf] [--words N] [--csv out.csv]
+
+#include "feature_manager.h"
+#include "feature_profiler.h"
+#include "file_watcher.h"
+#include "notifier.h"
+#include "word_deck.h"
+#include "word_reminder.h"
+#include "word_strings.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Allocation counters
+// ---------------------------------------------------------------------------
+// Heap allocations come from FeatureProfiler's per-thread counter (FEATURE_PROFILER_TRACK_ALLOCS),
+// so only the UI thread's allocations are charged; ImGui's own allocations are counted here.
+static std::atomic<uint64_t> g_imguiAllocs{0};
+
+static void* BenchImGuiAlloc(size_t size, void*)
+{
+    g_imguiAllocs.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size);
+}
+static void BenchImGuiFree(void* ptr, void*) { std::free(ptr); }
+
+// ---------------------------------------------------------------------------
+// Per-feature samples
+// ---------------------------------------------------------------------------
+struct FeatureSamples
+{
+    std::vector<double> cpuMs;
+    std::vector<int> vertices;
+    std::vector<int> indices;
+    std::vector<uint64_t> heapAllocs;
+    std::vector<uint64_t> imguiAllocs;
+
+    // in-flight values captured at begin
+    std::chrono::steady_clock::time_point t0;
+    int vtx0 = 0, idx0 = 0;
+    uint64_t heap0 = 0, imgui0 = 0;
+};
+
+struct FrameSample
+{
+    double cpuMs = 0.0;
+    int vertices = 0;
+    int indices = 0;
+    int drawLists = 0;
+    uint64_t heapAllocs = 0;
+    uint64_t imguiAllocs = 0;
+};
+
+// Sum of vertices/indices recorded so far in every window's draw list (valid between NewFrame and Render)
+static void CountLiveGeometry(int& vtx, int& idx)
+{
+    vtx = 0; idx = 0;
+    ImGuiContext* ctx = ImGui::GetCurrentContext();
+    if (!ctx) return;
+    for (ImGuiWindow* w : ctx->Windows)
+    {
+        if (!w || !w->DrawList) continue;
+        vtx += w->DrawList->VtxBuffer.Size;
+        idx += w->DrawList->IdxBuffer.Size;
+    }
+}
+
+static double Percentile(std::vector<double> v, double p)
+{
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)std::min<double>((double)(v.size() - 1), std::floor(p * (double)(v.size() - 1) + 0.5));
+    return v[i];
+}
+
+template <typename T>
+static double Mean(const std::vector<T>& v)
+{
+    if (v.empty()) return 0.0;
+    double s = 0.0;
+    for (const auto& x : v) s += (double)x;
+    return s / (double)v.size();
+}
+
+// Deterministic scripted input: mouse sweeps a Lissajous path, wheel scrolls periodically.
+// No clicks are issued so buttons with side effects (launching VS, deleting words) are never triggered.
+static void FeedScriptedInput(ImGuiIO& io, int frame, float w, float h)
+{
+    float t = (float)frame * 0.02f;
+    float x = w * (0.5f + 0.45f * std::sin(t * 1.3f));
+    float y = h * (0.5f + 0.45f * std::sin(t * 0.7f + 1.0f));
+    io.AddMousePosEvent(x, y);
+    if (frame % 30 == 15) io.AddMouseWheelEvent(0.0f, (frame / 30) % 2 ? 1.0f : -1.0f);
+}
+
+int main(int argc, char** argv)
+{
+    int frames = 600;
+    int warmup = 30;
+    int seedWords = 0;
+    float width = 1600.0f, height = 900.0f;
+    std::string fontPath;
+    std::string csvPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        auto next = [&](void) -> const char* { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (a == "--frames") frames = std::max(1, std::atoi(next()));
+        else if (a == "--warmup") warmup = std::max(0, std::atoi(next()));
+        else if (a == "--words") seedWords = std::max(0, std::atoi(next()));
+        else if (a == "--font") fontPath = next();
+        else if (a == "--csv") csvPath = next();
+        else if (a == "--size")
+        {
+            int w = 0, h = 0;
+            if (std::sscanf(next(), "%dx%d", &w, &h) == 2 && w > 0 && h > 0) { width = (float)w; height = (float)h; }
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--frames N] [--warmup N] [--size WxH] [--font path] [--words N] [--csv out.csv]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // The word reminder keeps its shard, deck index and review log in the working directory: run
+    // in a scratch directory so the bench never touches the user's files
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fontPath.empty()) fontPath = fs::absolute(fontPath, ec).u8string();
+    if (!csvPath.empty()) csvPath = fs::absolute(csvPath, ec).u8string();
+    const fs::path previousDir = fs::current_path(ec);
+    const fs::path scratchDir = fs::temp_directory_path(ec) /
+        ("headless_bench_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(scratchDir, ec);
+    fs::current_path(scratchDir, ec);
+    if (ec)
+    {
+        std::fprintf(stderr, "[bench] cannot enter scratch directory %s: %s\n", scratchDir.u8string().c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    // Seed words as one shard file that the feature loads, instead of an AddWord (and a full
+    // save) per word
+    if (seedWords > 0)
+    {
+        const auto now = std::chrono::system_clock::now();
+        std::vector<WordReminder::WordEntry> words((size_t)seedWords);
+        for (int i = 0; i < seedWords; ++i)
+        {
+            WordReminder::WordEntry& e = words[(size_t)i];
+            e.word = WordReminder::Strings::Intern("bench" + std::to_string(i));
+            e.meaning = WordReminder::Strings::Intern("基准测试释义 " + std::to_string(i));
+            e.remindTime = now + std::chrono::seconds((i % 3 == 0) ? -60 : 3600);
+            e.lastReview = now;
+        }
+        if (!WordReminder::Decks::SaveShard(WordReminder::Decks::kLegacyShard, words))
+        {
+            std::fprintf(stderr, "[bench] cannot write seed words\n");
+        }
+        WordReminder::Strings::Clear();
+    }
+
+    ImGui::SetAllocatorFunctions(BenchImGuiAlloc, BenchImGuiFree, nullptr);
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr; // 不读写 imgui.ini，保证每次运行布局一致
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2(width, height);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    ImGui::StyleColorsDark();
+
+    // Null renderer: build the atlas once and hand ImGui a dummy texture id
+    if (!fontPath.empty())
+    {
+        if (!io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 16.0f, nullptr, io.Fonts->GetGlyphRangesChineseSimplifiedCommon()))
+        {
+            std::fprintf(stderr, "[bench] failed to load font: %s, using default\n", fontPath.c_str());
+            io.Fonts->AddFontDefault();
+        }
+    }
+    else
+    {
+        io.Fonts->AddFontDefault();
+    }
+    unsigned char* texPixels = nullptr;
+    int texW = 0, texH = 0;
+    auto atlasStart = std::chrono::steady_clock::now();
+    io.Fonts->GetTexDataAsRGBA32(&texPixels, &texW, &texH);
+    double atlasMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - atlasStart).count();
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+
+    FeatureManager& fm = FeatureManager::GetInstance();
+    fm.SetPersistState(false); // enabling every feature below must not change the user's feature_state.ini
+    fm.Initialize();
+    for (const auto& f : fm.GetFeatures())
+    {
+        if (!f.enabled) fm.EnableFeature(f.name, true);
+    }
+    fm.WaitForPendingInit(); // features load lazily/in the background; measure steady state only
+
+    std::map<std::string, FeatureSamples> samples;
+    std::vector<std::string> order;
+    for (const auto& f : fm.GetFeatures())
+    {
+        samples[f.name];
+        order.push_back(f.name);
+    }
+    std::vector<FrameSample> frameSamples;
+    frameSamples.reserve((size_t)frames);
+    bool recording = false;
+
+    fm.SetDrawHook([&](const FeatureInfo& f, bool begin) {
+        if (!recording) return;
+        FeatureSamples& s = samples[f.name];
+        if (begin)
+        {
+            CountLiveGeometry(s.vtx0, s.idx0);
+            s.heap0 = FeatureProfiler::GetAllocationCount();
+            s.imgui0 = g_imguiAllocs.load(std::memory_order_relaxed);
+            s.t0 = std::chrono::steady_clock::now();
+            return;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        int vtx1 = 0, idx1 = 0;
+        uint64_t heap1 = FeatureProfiler::GetAllocationCount();
+        uint64_t imgui1 = g_imguiAllocs.load(std::memory_order_relaxed);
+        CountLiveGeometry(vtx1, idx1);
+        s.cpuMs.push_back(std::chrono::duration<double, std::milli>(t1 - s.t0).count());
+        s.vertices.push_back(vtx1 - s.vtx0);
+        s.indices.push_back(idx1 - s.idx0);
+        s.heapAllocs.push_back(heap1 - s.heap0);
+        s.imguiAllocs.push_back(imgui1 - s.imgui0);
+    });
+
+    for (int frame = 0; frame < warmup + frames; ++frame)
+    {
+        recording = frame >= warmup;
+        uint64_t heap0 = FeatureProfiler::GetAllocationCount();
+        uint64_t imgui0 = g_imguiAllocs.load(std::memory_order_relaxed);
+        auto t0 = std::chrono::steady_clock::now();
+
+        FeedScriptedInput(io, frame, width, height);
+        ImGui::NewFrame();
+        fm.DrawAllFeatures();
+        fm.DrawFeatureSelector();
+        FileWatcher::Pump();
+        if (fm.IsFeatureReady(WordReminder::GetFeatureName())) WordReminder::PollReminders();
+        Notifier::Pump();
+        Notifier::DrawToasts();
+        ImGui::Render();
+        ImDrawData* dd = ImGui::GetDrawData(); // 不提交给任何后端，直接丢弃
+
+        auto t1 = std::chrono::steady_clock::now();
+        if (!recording) continue;
+        FrameSample fs;
+        fs.cpuMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        fs.vertices = dd ? dd->TotalVtxCount : 0;
+        fs.indices = dd ? dd->TotalIdxCount : 0;
+        fs.drawLists = dd ? dd->CmdListsCount : 0;
+        fs.heapAllocs = FeatureProfiler::GetAllocationCount() - heap0;
+        fs.imguiAllocs = g_imguiAllocs.load(std::memory_order_relaxed) - imgui0;
+        frameSamples.push_back(fs);
+    }
+    fm.SetDrawHook(nullptr);
+
+    // ---------------------------------------------------------------------
+    // Report
+    // ---------------------------------------------------------------------
+    std::vector<double> frameMs;
+    std::vector<int> frameVtx, frameIdx;
+    std::vector<uint64_t> frameHeap, frameImgui;
+    for (const auto& fs : frameSamples)
+    {
+        frameMs.push_back(fs.cpuMs);
+        frameVtx.push_back(fs.vertices);
+        frameIdx.push_back(fs.indices);
+        frameHeap.push_back(fs.heapAllocs);
+        frameImgui.push_back(fs.imguiAllocs);
+    }
+
+    std::printf("HeadlessBench: %d frames (+%d warmup), %.0fx%.0f, atlas %dx%d built in %.2f ms\n",
+                frames, warmup, width, height, texW, texH, atlasMs);
+    std::printf("%-28s %9s %9s %9s %9s %10s %10s %10s %10s\n",
+                "feature", "mean ms", "p50 ms", "p95 ms", "max ms", "vtx/frm", "idx/frm", "heap/frm", "imgui/frm");
+    for (const auto& name : order)
+    {
+        const FeatureSamples& s = samples[name];
+        if (s.cpuMs.empty()) continue;
+        std::printf("%-28s %9.3f %9.3f %9.3f %9.3f %10.0f %10.0f %10.1f %10.1f\n",
+                    name.c_str(), Mean(s.cpuMs), Percentile(s.cpuMs, 0.50), Percentile(s.cpuMs, 0.95),
+                    Percentile(s.cpuMs, 1.0), Mean(s.vertices), Mean(s.indices), Mean(s.heapAllocs), Mean(s.imguiAllocs));
+    }
+    std::printf("%-28s %9.3f %9.3f %9.3f %9.3f %10.0f %10.0f %10.1f %10.1f\n",
+                "[frame total]", Mean(frameMs), Percentile(frameMs, 0.50), Percentile(frameMs, 0.95),
+                Percentile(frameMs, 1.0), Mean(frameVtx), Mean(frameIdx), Mean(frameHeap), Mean(frameImgui));
+
+    if (!csvPath.empty())
+    {
+        std::ofstream csv(csvPath, std::ios::out | std::ios::trunc);
+        if (csv)
+        {
+            csv << "frame,feature,cpu_ms,vertices,indices,heap_allocs,imgui_allocs\n";
+            for (size_t i = 0; i < frameSamples.size(); ++i)
+            {
+                const auto& fs = frameSamples[i];
+                csv << i << ",[frame total]," << fs.cpuMs << ',' << fs.vertices << ',' << fs.indices << ','
+                    << fs.heapAllocs << ',' << fs.imguiAllocs << '\n';
+                for (const auto& name : order)
+                {
+                    const FeatureSamples& s = samples[name];
+                    if (i >= s.cpuMs.size()) continue;
+                    csv << i << ',' << name << ',' << s.cpuMs[i] << ',' << s.vertices[i] << ',' << s.indices[i] << ','
+                        << s.heapAllocs[i] << ',' << s.imguiAllocs[i] << '\n';
+                }
+            }
+        }
+        else
+        {
+            std::fprintf(stderr, "[bench] cannot write csv: %s\n", csvPath.c_str());
+        }
+    }
+
+    fm.Cleanup();
+    Notifier::Shutdown();
+    FileWatcher::Shutdown();
+    ImGui::DestroyContext();
+    fs::current_path(previousDir, ec);
+    fs::remove_all(scratchDir, ec);
+    return 0;
+}
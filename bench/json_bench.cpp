@@ -0,0 +1,334 @@
+// JSON benchmark: times the shared Json reader/writer against the parsers it replaced, on
+// synthetic multi-MB inputs so the numbers do not depend on the machine's own prefs or Cursor state.
+//   - prefs.json: the old hand-rolled SkipWs/ParseJsonString parser and string-concatenating writer
+//     (copied below as they were) vs. ConfigStore::ParseJson / ConfigStore::WriteJson
+//   - storage.json: the chunked JsonStream reader vs. a Json::Reader pass over the loaded buffer
+//   - long strings: Json::ScanString vs. a byte-at-a-time loop
+//
+// Usage: JsonBench [--mb N] [--iters N]
+
+#include "config_store.h"
+#include "json.h"
+#include "json_stream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using ConfigStore::SavedConfig;
+
+struct Stats
+{
+    double meanMs = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+static Stats Summarize(std::vector<double> samples)
+{
+    Stats s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    for (double v : samples) s.meanMs += v;
+    s.meanMs /= (double)samples.size();
+    s.p95Ms = samples[(size_t)((samples.size() - 1) * 0.95)];
+    s.maxMs = samples.back();
+    return s;
+}
+
+template <typename Fn>
+static Stats Time(int iters, Fn&& fn)
+{
+    std::vector<double> samples;
+    samples.reserve(iters);
+    for (int i = 0; i < iters; ++i)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return Summarize(std::move(samples));
+}
+
+static void PrintRow(const char* name, const Stats& s, const char* note = "")
+{
+    std::printf("%-34s %9.4f %9.4f %9.4f  %s\n", name, s.meanMs, s.p95Ms, s.maxMs, note);
+}
+
+static double MBps(size_t bytes, const Stats& s)
+{
+    return s.meanMs > 0.0 ? (double)bytes / (1024.0 * 1024.0) / (s.meanMs / 1000.0) : 0.0;
+}
+
+// ---- Legacy prefs code, as VSInspector had it before the Json module ----
+namespace Legacy
+{
+    static std::string JsonEscape(const std::string& s)
+    {
+        std::string out; out.reserve(s.size() + 8);
+        for (char c : s)
+        {
+            switch (c)
+            {
+                case '\\': out += "\\\\"; break;
+                case '"': out += "\\\""; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default: out += c; break;
+            }
+        }
+        return out;
+    }
+
+    static void WriteConfigs(const std::vector<SavedConfig>& configs, std::string& out)
+    {
+        out.reserve(64 + configs.size() * 256);
+        out += "{\n  \"configs\": [\n";
+        for (size_t i = 0; i < configs.size(); ++i)
+        {
+            const auto& c = configs[i];
+            out += "    {\n";
+            out += "      \"name\": \"" + JsonEscape(c.name) + "\",\n";
+            out += "      \"vs\": \"" + JsonEscape(c.vsSolutionPath) + "\",\n";
+            out += "      \"cursor\": \"" + JsonEscape(c.cursorFolderPath) + "\",\n";
+            out += "      \"feishu\": \"" + JsonEscape(c.feishuPath) + "\",\n";
+            out += "      \"wechat\": \"" + JsonEscape(c.wechatPath) + "\",\n";
+            out += "      \"createdAt\": " + std::to_string(c.createdAt) + ",\n";
+            out += "      \"lastUsedAt\": " + std::to_string(c.lastUsedAt) + "\n";
+            out += (i + 1 < configs.size() ? "    },\n" : "    }\n");
+        }
+        out += "  ]\n}";
+    }
+
+    static bool ParseJsonString(const std::string& s, size_t& pos, std::string& out)
+    {
+        out.clear();
+        if (pos >= s.size() || s[pos] != '"') return false;
+        pos++;
+        while (pos < s.size())
+        {
+            char c = s[pos++];
+            if (c == '"') return true;
+            if (c == '\\' && pos < s.size())
+            {
+                char e = s[pos++];
+                switch (e) { case 'n': out += '\n'; break; case 'r': out += '\r'; break; case 't': out += '\t'; break; case '"': out += '"'; break; case '\\': out += '\\'; break; default: out += e; break; }
+            }
+            else { out += c; }
+        }
+        return false;
+    }
+
+    static void SkipWs(const std::string& s, size_t& pos) { while (pos < s.size() && (s[pos]==' '||s[pos]=='\n'||s[pos]=='\r'||s[pos]=='\t')) pos++; }
+
+    static bool ParseConfigs(const std::string& content, std::vector<SavedConfig>& out)
+    {
+        out.clear();
+        size_t pos = 0; SkipWs(content, pos);
+        if (pos >= content.size() || content[pos] != '{') { return false; }
+        pos++;
+        bool ok = false;
+        while (pos < content.size())
+        {
+            SkipWs(content, pos);
+            if (pos < content.size() && content[pos] == '}') { pos++; break; }
+            std::string key; if (!ParseJsonString(content, pos, key)) break;
+            SkipWs(content, pos); if (pos >= content.size() || content[pos] != ':') break; pos++;
+            SkipWs(content, pos);
+            if (key == "configs")
+            {
+                if (pos >= content.size() || content[pos] != '[') break;
+                pos++;
+                SkipWs(content, pos);
+                while (pos < content.size() && content[pos] != ']')
+                {
+                    SkipWs(content, pos);
+                    if (pos >= content.size() || content[pos] != '{') break;
+                    pos++;
+                    SavedConfig c;
+                    while (pos < content.size())
+                    {
+                        SkipWs(content, pos);
+                        if (pos < content.size() && content[pos] == '}') { pos++; break; }
+                        std::string k; if (!ParseJsonString(content, pos, k)) { pos = content.size(); break; }
+                        SkipWs(content, pos); if (pos >= content.size() || content[pos] != ':') { pos = content.size(); break; } pos++;
+                        SkipWs(content, pos);
+                        if (k == "name" || k == "vs" || k == "cursor" || k == "feishu" || k == "wechat")
+                        {
+                            std::string v; if (!ParseJsonString(content, pos, v)) { pos = content.size(); break; }
+                            if (k == "name") c.name = v; else if (k == "vs") c.vsSolutionPath = v; else if (k == "cursor") c.cursorFolderPath = v; else if (k == "feishu") c.feishuPath = v; else c.wechatPath = v;
+                        }
+                        else if (k == "createdAt" || k == "lastUsedAt")
+                        {
+                            size_t start = pos; while (pos < content.size() && (isdigit((unsigned char)content[pos]) || content[pos]=='-')) pos++; unsigned long long val = strtoull(content.substr(start, pos-start).c_str(), nullptr, 10);
+                            if (k == "createdAt") c.createdAt = val; else c.lastUsedAt = val;
+                        }
+                        SkipWs(content, pos);
+                        if (pos < content.size() && content[pos] == ',') { pos++; }
+                    }
+                    if (!c.name.empty()) out.push_back(c);
+                    SkipWs(content, pos);
+                    if (pos < content.size() && content[pos] == ',') { pos++; }
+                    SkipWs(content, pos);
+                }
+                if (pos < content.size() && content[pos] == ']') { pos++; ok = true; }
+            }
+            SkipWs(content, pos);
+            if (pos < content.size() && content[pos] == ',') { pos++; continue; }
+        }
+        return ok;
+    }
+}
+
+// Configs with Windows-style paths until the written prefs.json reaches `bytes`
+static std::vector<SavedConfig> SynthesizeConfigs(size_t bytes)
+{
+    std::vector<SavedConfig> configs;
+    size_t approx = 0;
+    for (int i = 0; approx < bytes; ++i)
+    {
+        SavedConfig c;
+        c.name = "workspace-" + std::to_string(i) + (i % 7 == 0 ? " \"release\"" : "");
+        c.vsSolutionPath = "C:\\src\\Monorepo\\Project" + std::to_string(i % 500) + "\\Project" + std::to_string(i) + ".sln";
+        c.cursorFolderPath = "D:\\work\\repos\\service-" + std::to_string(i % 300) + "\\frontend";
+        c.feishuPath = "C:\\Users\\dev\\AppData\\Local\\Feishu\\Feishu.exe";
+        c.wechatPath = "C:\\Program Files\\Tencent\\WeChat\\WeChat.exe";
+        c.createdAt = 1700000000ull + (unsigned long long)i * 37;
+        c.lastUsedAt = i % 3 == 0 ? 0 : c.createdAt + 3600;
+        approx += 330 + c.name.size() + c.vsSolutionPath.size() + c.cursorFolderPath.size();
+        configs.push_back(std::move(c));
+    }
+    return configs;
+}
+
+// Shape of Cursor's storage.json: a flat object of state keys, some holding long escaped blobs,
+// plus the windowsState/openedPathsList sections the inspector actually reads
+static std::string SynthesizeStorage(size_t bytes)
+{
+    std::string out;
+    out.reserve(bytes + 4096);
+    Json::Writer w(out, 4);
+    w.BeginObject();
+    for (int i = 0; out.size() < bytes; ++i)
+    {
+        w.Key("workbench.state." + std::to_string(i));
+        if (i % 4 == 0)
+        {
+            std::string blob = "{\"views\":[";
+            for (int j = 0; j < 40; ++j) blob += "{\"id\":\"workbench.view.explorer." + std::to_string(j) + "\",\"visible\":true},";
+            blob += "{}]}";
+            w.String(blob);
+        }
+        else if (i % 4 == 1)
+        {
+            w.BeginArray();
+            for (int j = 0; j < 8; ++j) w.UInt((uint64_t)i * 131 + j);
+            w.EndArray();
+        }
+        else
+        {
+            w.String("file:///d%3A/work/repos/service-" + std::to_string(i % 300) + "/src/components/Panel" + std::to_string(i) + ".tsx");
+        }
+    }
+    w.Key("windowsState").BeginObject();
+    w.Key("lastActiveWindow").BeginObject().Key("folder").String("file:///d%3A/work/repos/service-42").EndObject();
+    w.Key("openedWindows").BeginArray();
+    for (int j = 0; j < 4; ++j) w.BeginObject().Key("folder").String("file:///d%3A/work/repos/service-" + std::to_string(j)).EndObject();
+    w.EndArray().EndObject();
+    w.EndObject();
+    return out;
+}
+
+int main(int argc, char** argv)
+{
+    int mb = 8;
+    int iters = 20;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        auto next = [&](void) -> const char* { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (a == "--mb") mb = std::max(1, std::atoi(next()));
+        else if (a == "--iters") iters = std::max(1, std::atoi(next()));
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--mb N] [--iters N]\n", argv[0]);
+            return 2;
+        }
+    }
+    const size_t bytes = (size_t)mb * 1024 * 1024;
+
+    std::vector<SavedConfig> configs = SynthesizeConfigs(bytes);
+    std::string prefs;
+    ConfigStore::WriteJson(configs, prefs);
+    std::string storage = SynthesizeStorage(bytes);
+
+    std::printf("JsonBench: prefs %.1f MiB (%d configs), storage %.1f MiB, %d iterations\n",
+                prefs.size() / (1024.0 * 1024.0), (int)configs.size(), storage.size() / (1024.0 * 1024.0), iters);
+    std::printf("%-34s %9s %9s %9s\n", "step", "mean ms", "p95 ms", "max ms");
+
+    // 1. prefs.json read
+    char note[96];
+    std::vector<SavedConfig> parsed;
+    Stats s = Time(iters, [&]() { Legacy::ParseConfigs(prefs, parsed); });
+    std::snprintf(note, sizeof(note), "%.0f MiB/s, %d configs", MBps(prefs.size(), s), (int)parsed.size());
+    PrintRow("prefs read, legacy parser", s, note);
+    std::string error;
+    bool ok = true;
+    s = Time(iters, [&]() { ok = ConfigStore::ParseJson(prefs, parsed, error) && ok; });
+    std::snprintf(note, sizeof(note), "%.0f MiB/s, %d configs%s", MBps(prefs.size(), s), (int)parsed.size(), ok ? "" : ", FAILED");
+    PrintRow("prefs read, Json::Reader", s, note);
+
+    // 2. prefs.json write
+    std::string written;
+    s = Time(iters, [&]() { written.clear(); Legacy::WriteConfigs(configs, written); });
+    std::snprintf(note, sizeof(note), "%.0f MiB/s", MBps(written.size(), s));
+    PrintRow("prefs write, legacy concat", s, note);
+    const size_t legacySize = written.size();
+    s = Time(iters, [&]() { written.clear(); ConfigStore::WriteJson(configs, written); });
+    std::snprintf(note, sizeof(note), "%.0f MiB/s%s", MBps(written.size(), s), written.size() == legacySize ? ", same bytes" : ", size differs");
+    PrintRow("prefs write, Json::Writer", s, note);
+
+    // 3. storage.json full pass (no early stop: worst case for the folder lookup)
+    size_t tokens = 0;
+    s = Time(iters, [&]() {
+        tokens = 0;
+        JsonStream::Reader reader([&](JsonStream::Event, const std::string&) { ++tokens; return true; });
+        const size_t chunk = 64 * 1024;
+        for (size_t off = 0; off < storage.size(); off += chunk)
+            if (!reader.Feed(storage.data() + off, std::min(chunk, storage.size() - off))) break;
+        reader.Finish();
+    });
+    std::snprintf(note, sizeof(note), "%.0f MiB/s, %zu tokens", MBps(storage.size(), s), tokens);
+    PrintRow("storage scan, JsonStream 64K", s, note);
+    s = Time(iters, [&]() {
+        tokens = 0;
+        Json::Reader reader(storage);
+        Json::Token t;
+        while ((t = reader.Next()) != Json::Token::End && t != Json::Token::Error) ++tokens;
+    });
+    std::snprintf(note, sizeof(note), "%.0f MiB/s, %zu tokens", MBps(storage.size(), s), tokens);
+    PrintRow("storage scan, Json::Reader", s, note);
+
+    // 4. The string-run scan both readers are built on
+    std::string run(bytes, 'a');
+    run.back() = '"';
+    const char* hit = nullptr;
+    const char* volatile base = run.data();  // keeps the loop from being hoisted out of the timing
+    s = Time(iters, [&]() {
+        const char* p = base;
+        const char* end = p + run.size();
+        while (p < end && *p != '"' && *p != '\\' && (unsigned char)*p >= 0x20) ++p;
+        hit = p;
+    });
+    std::snprintf(note, sizeof(note), "%.0f MiB/s%s", MBps(run.size(), s), hit == run.data() + run.size() - 1 ? "" : ", WRONG");
+    PrintRow("string run, byte loop", s, note);
+    s = Time(iters, [&]() { hit = Json::ScanString(base, base + run.size()); });
+    std::snprintf(note, sizeof(note), "%.0f MiB/s%s", MBps(run.size(), s), hit == run.data() + run.size() - 1 ? "" : ", WRONG");
+    PrintRow("string run, Json::ScanString", s, note);
+    return ok ? 0 : 1;
+}
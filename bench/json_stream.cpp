@@ -0,0 +1,196 @@
+#include "json_stream.h"
+#include "json.h"
+
+#include <fstream>
+
+namespace JsonStream
+{
+    Reader::Reader(Handler handler) : handler(std::move(handler))
+    {
+    }
+
+    bool Reader::Emit(Event event)
+    {
+        if (!handler(event, token))
+        {
+            lex = Lex::Stopped;
+            return false;
+        }
+        return true;
+    }
+
+    bool Reader::Fail(const char* what)
+    {
+        error = std::string(what) + " at offset " + std::to_string(offset);
+        lex = Lex::Failed;
+        return false;
+    }
+
+    bool Reader::Close(char c)
+    {
+        const char open = c == '}' ? '{' : '[';
+        if (stack.empty() || stack.back() != open) return Fail("unbalanced bracket");
+        stack.pop_back();
+        expectKey = false;
+        token.clear();
+        return Emit(c == '}' ? Event::ObjectEnd : Event::ArrayEnd);
+    }
+
+    bool Reader::EndScalar()
+    {
+        if (lex == Lex::Literal && token != "true" && token != "false" && token != "null")
+            return Fail("invalid literal");
+        Event event = lex == Lex::Number ? Event::Number : Event::Literal;
+        lex = Lex::Value;
+        return Emit(event);
+    }
+
+    void Reader::AppendCodePoint(unsigned cp)
+    {
+        Json::AppendUtf8(token, cp);
+    }
+
+    bool Reader::Feed(const char* data, size_t size)
+    {
+        size_t i = 0;
+        while (i < size)
+        {
+            if (lex == Lex::Stopped || lex == Lex::Failed) return false;
+            const char c = data[i];
+            switch (lex)
+            {
+            case Lex::Value:
+                switch (c)
+                {
+                case ' ': case '\t': case '\r': case '\n': break;
+                case '{': stack.push_back('{'); expectKey = true; token.clear(); sawValue = true; if (!Emit(Event::ObjectBegin)) return false; break;
+                case '[': stack.push_back('['); expectKey = false; token.clear(); sawValue = true; if (!Emit(Event::ArrayBegin)) return false; break;
+                case '}': case ']': if (!Close(c)) return false; break;
+                case ',': expectKey = !stack.empty() && stack.back() == '{'; break;
+                case ':': expectKey = false; break;
+                case '"': lex = Lex::String; token.clear(); sawValue = true; break;
+                default:
+                    if (c == '-' || (c >= '0' && c <= '9')) lex = Lex::Number;
+                    else if (c == 't' || c == 'f' || c == 'n') lex = Lex::Literal;
+                    else return Fail("unexpected character");
+                    token.assign(1, c);
+                    sawValue = true;
+                    break;
+                }
+                break;
+
+            case Lex::String:
+            {
+                // Copy the plain run up to the next quote, backslash or control character in one go
+                size_t j = (size_t)(Json::ScanString(data + i, data + size) - data);
+                if (j > i)
+                {
+                    if (highSurrogate) { AppendCodePoint(0xFFFD); highSurrogate = 0; }
+                    token.append(data + i, j - i);
+                }
+                offset += j - i;
+                i = j;
+                if (i == size) continue;
+                if ((unsigned char)data[i] < 0x20) return Fail("control character in string");
+                if (data[i] == '\\')
+                {
+                    lex = Lex::Escape;
+                }
+                else
+                {
+                    if (highSurrogate) { AppendCodePoint(0xFFFD); highSurrogate = 0; }
+                    lex = Lex::Value;
+                    bool isKey = expectKey && !stack.empty() && stack.back() == '{';
+                    if (!Emit(isKey ? Event::Key : Event::String)) return false;
+                }
+                break;
+            }
+
+            case Lex::Escape:
+                lex = Lex::String;
+                if (c == 'u') { lex = Lex::Unicode; unicode = 0; unicodeDigits = 0; break; }
+                if (highSurrogate) { AppendCodePoint(0xFFFD); highSurrogate = 0; }
+                switch (c)
+                {
+                case '"': case '\\': case '/': token.push_back(c); break;
+                case 'b': token.push_back('\b'); break;
+                case 'f': token.push_back('\f'); break;
+                case 'n': token.push_back('\n'); break;
+                case 'r': token.push_back('\r'); break;
+                case 't': token.push_back('\t'); break;
+                default: return Fail("invalid escape");
+                }
+                break;
+
+            case Lex::Unicode:
+            {
+                unsigned digit;
+                if (c >= '0' && c <= '9') digit = (unsigned)(c - '0');
+                else if (c >= 'a' && c <= 'f') digit = (unsigned)(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') digit = (unsigned)(c - 'A' + 10);
+                else return Fail("invalid \\u escape");
+                unicode = (unicode << 4) | digit;
+                if (++unicodeDigits < 4) break;
+                lex = Lex::String;
+                if (unicode >= 0xDC00 && unicode <= 0xDFFF && highSurrogate)
+                {
+                    AppendCodePoint(0x10000 + ((highSurrogate - 0xD800) << 10) + (unicode - 0xDC00));
+                    highSurrogate = 0;
+                    break;
+                }
+                if (highSurrogate) { AppendCodePoint(0xFFFD); highSurrogate = 0; }
+                if (unicode >= 0xD800 && unicode <= 0xDBFF) highSurrogate = unicode;
+                else AppendCodePoint(unicode >= 0xDC00 && unicode <= 0xDFFF ? 0xFFFD : unicode);
+                break;
+            }
+
+            case Lex::Number:
+            case Lex::Literal:
+            {
+                bool more = lex == Lex::Number
+                    ? ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')
+                    : (c >= 'a' && c <= 'z');
+                if (more) { token.push_back(c); break; }
+                if (!EndScalar()) return false;
+                continue; // the terminating character belongs to the next token
+            }
+
+            case Lex::Stopped:
+            case Lex::Failed:
+                return false;
+            }
+            ++i;
+            ++offset;
+        }
+        return lex != Lex::Stopped && lex != Lex::Failed;
+    }
+
+    bool Reader::Finish()
+    {
+        if (lex == Lex::Number || lex == Lex::Literal)
+        {
+            if (!EndScalar()) return false;
+        }
+        if (lex != Lex::Value) return lex == Lex::Stopped ? false : Fail("unterminated string");
+        if (!stack.empty()) return Fail("unexpected end of input");
+        return sawValue;
+    }
+
+    bool ParseFile(const std::filesystem::path& path, const Handler& handler, size_t* bytesRead)
+    {
+        if (bytesRead) *bytesRead = 0;
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        Reader reader(handler);
+        std::vector<char> chunk(64 * 1024);
+        while (in)
+        {
+            in.read(chunk.data(), (std::streamsize)chunk.size());
+            size_t n = (size_t)in.gcount();
+            if (n == 0) break;
+            if (bytesRead) *bytesRead += n;
+            if (!reader.Feed(chunk.data(), n)) return reader.Stopped();
+        }
+        return reader.Finish();
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// SAX-style JSON reader: input is fed in chunks and every token is reported to a handler as it
+// is completed, so a caller can stop as soon as it has what it needs instead of loading and
+// scanning a whole multi-MB file (Cursor's storage.json). Strings are unescaped (\uXXXX to UTF-8);
+// numbers and true/false/null are passed through as their source text.
+// Benchmark baseline only: the app reads storage.json with Json::Reader (src/json.h); JsonBench
+// keeps this reader to compare against.
+namespace JsonStream
+{
+    enum class Event { ObjectBegin, ObjectEnd, ArrayBegin, ArrayEnd, Key, String, Number, Literal };
+
+    // Return false to stop reading
+    using Handler = std::function<bool(Event event, const std::string& text)>;
+
+    class Reader
+    {
+    public:
+        explicit Reader(Handler handler);
+
+        // Returns false once the handler stopped the parse or the input is malformed
+        bool Feed(const char* data, size_t size);
+        // End of input: flushes a trailing top-level number/literal. True if the document was complete.
+        bool Finish();
+
+        bool Stopped() const { return lex == Lex::Stopped; }
+        bool Failed() const { return lex == Lex::Failed; }
+        const std::string& Error() const { return error; }
+        size_t Depth() const { return stack.size(); }
+
+    private:
+        enum class Lex { Value, String, Escape, Unicode, Number, Literal, Stopped, Failed };
+
+        bool Emit(Event event);
+        bool Fail(const char* what);
+        bool Close(char c);
+        bool EndScalar();
+        void AppendCodePoint(unsigned cp);
+
+        Handler handler;
+        Lex lex = Lex::Value;
+        std::string token;
+        std::vector<char> stack;   // '{' or '[' per open container
+        bool expectKey = false;
+        bool sawValue = false;
+        unsigned unicode = 0;
+        int unicodeDigits = 0;
+        unsigned highSurrogate = 0;
+        size_t offset = 0;
+        std::string error;
+    };
+
+    // Streams a file through a Reader in 64 KiB chunks and stops reading when the handler does.
+    // False if the file cannot be opened or is malformed before the handler stopped.
+    bool ParseFile(const std::filesystem::path& path, const Handler& handler, size_t* bytesRead = nullptr);
+}
@@ -0,0 +1,187 @@
+// Process enumeration benchmark: times ProcessEnumerator::Enumerate plus the VSInspector name
+// table match. On Linux a synthetic /proc-style tree with --procs entries is generated in a temp
+// directory (stat, cmdline, exe link, fd links) so results do not depend on the build box; the
+// live system is measured as well.
+//
+// Usage: ProcessEnumBench [--procs N] [--iters N] [--keep]
+
+#include "process_enum.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct Stats
+{
+    double meanMs = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+static Stats Summarize(std::vector<double> samples)
+{
+    Stats s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    for (double v : samples) s.meanMs += v;
+    s.meanMs /= (double)samples.size();
+    s.p95Ms = samples[(size_t)((samples.size() - 1) * 0.95)];
+    s.maxMs = samples.back();
+    return s;
+}
+
+template <typename Fn>
+static Stats Time(int iters, Fn&& fn)
+{
+    std::vector<double> samples;
+    samples.reserve(iters);
+    for (int i = 0; i < iters; ++i)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return Summarize(std::move(samples));
+}
+
+static void PrintRow(const char* name, const Stats& s, const char* note = "")
+{
+    std::printf("%-34s %9.4f %9.4f %9.4f  %s\n", name, s.meanMs, s.p95Ms, s.maxMs, note);
+}
+
+// Same tags VSInspector uses for its refresh
+static ProcessEnum::NameTable BuildNameTable()
+{
+    ProcessEnum::NameTable table;
+    const char* names[] = { "devenv.exe", "cursor.exe", "cursor", "feishu.exe", "lark.exe", "weixin.exe", "wechat.exe", "wechatappex.exe" };
+    int tag = 1;
+    for (const char* n : names) table.Add(n, tag++);
+    return table;
+}
+
+#ifdef __linux__
+// One directory per pid: stat, cmdline, exe -> image, fd/{0,1,2} -> files. About 1 in 250 is an app
+// from the name table so the detail queries have something to do.
+static bool BuildSyntheticProc(const fs::path& root, int procs)
+{
+    static const char* pool[] = { "systemd", "bash", "sshd", "kworker/0:1", "python3", "node", "chrome", "Xorg (wayland)" };
+    static const char* apps[] = { "devenv.exe", "Cursor", "feishu.exe", "WeChat.exe" };
+    std::error_code ec;
+    fs::create_directories(root, ec);
+    if (ec) return false;
+    for (int i = 0; i < procs; ++i)
+    {
+        int pid = 100 + i;
+        bool app = (i % 250) == 7;
+        std::string name = app ? apps[(i / 250) % 4] : pool[i % 8];
+        fs::path dir = root / std::to_string(pid);
+        fs::create_directories(dir / "fd", ec);
+        if (ec) return false;
+        {
+            std::ofstream stat(dir / "stat");
+            stat << pid << " (" << name << ") S 1 " << pid << ' ' << pid << " 0 -1 4194560 100 0 0 0 1 2 0 0 20 0 1 0 "
+                 << (1000 + i) << " 10485760 500 18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 0 0 0 0 0 0\n";
+        }
+        {
+            std::ofstream cmdline(dir / "cmdline", std::ios::binary);
+            std::string args = "/usr/bin/" + name + std::string(1, '\0') + "--workspace" + std::string(1, '\0') + "/home/dev/project" + std::to_string(i) + std::string(1, '\0');
+            cmdline.write(args.data(), (std::streamsize)args.size());
+        }
+        fs::create_symlink("/usr/bin/" + name, dir / "exe", ec);
+        for (int fd = 0; fd < 3; ++fd)
+            fs::create_symlink("/home/dev/project" + std::to_string(i) + "/file" + std::to_string(fd), dir / "fd" / std::to_string(fd), ec);
+    }
+    fs::create_directories(root / "self", ec); // non-numeric entries must be skipped
+    return true;
+}
+#endif
+
+static void RunSuite(const char* label, ProcessEnum::ProcessEnumerator& enumerator, const ProcessEnum::NameTable& table, int iters)
+{
+    std::vector<ProcessEnum::ProcessInfo> procs;
+    if (!enumerator.Enumerate(procs))
+    {
+        std::printf("%s: enumeration unavailable\n", label);
+        return;
+    }
+    std::printf("\n%s: %d processes\n", label, (int)procs.size());
+    std::printf("%-34s %9s %9s %9s\n", "step", "mean ms", "p95 ms", "max ms");
+
+    PrintRow("enumerate", Time(iters, [&]() { enumerator.Enumerate(procs); }));
+
+    std::vector<uint32_t> matched;
+    Stats match = Time(iters, [&]() {
+        matched.clear();
+        for (const auto& p : procs)
+            if (table.Match(p.name)) matched.push_back(p.pid);
+    });
+    char note[64];
+    std::snprintf(note, sizeof(note), "%d matched%s", (int)matched.size(), match.p95Ms < 1.0 ? "" : "  (over 1 ms budget)");
+    PrintRow("name table match", match, note);
+
+    std::vector<std::string> files;
+    size_t bytes = 0;
+    PrintRow("exe + cmdline + fd (matched)", Time(iters, [&]() {
+        for (uint32_t pid : matched)
+        {
+            bytes += enumerator.QueryExePath(pid).size();
+            bytes += enumerator.QueryCommandLine(pid).size();
+            if (enumerator.QueryOpenFiles(pid, files)) bytes += files.size();
+        }
+    }));
+    if (bytes == 0 && !matched.empty()) std::printf("  (detail queries returned nothing: access denied?)\n");
+}
+
+int main(int argc, char** argv)
+{
+    int procs = 5000;
+    int iters = 50;
+    bool keep = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        auto next = [&](void) -> const char* { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (a == "--procs") procs = std::max(1, std::atoi(next()));
+        else if (a == "--iters") iters = std::max(1, std::atoi(next()));
+        else if (a == "--keep") keep = true;
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--procs N] [--iters N] [--keep]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    ProcessEnum::NameTable table = BuildNameTable();
+
+#ifdef __linux__
+    std::error_code ec;
+    fs::path root = fs::temp_directory_path(ec) / ("process_enum_bench_" + std::to_string(procs));
+    fs::remove_all(root, ec);
+    auto t0 = std::chrono::steady_clock::now();
+    if (!BuildSyntheticProc(root, procs))
+    {
+        std::fprintf(stderr, "[bench] cannot create synthetic tree under %s\n", root.string().c_str());
+        return 1;
+    }
+    std::printf("ProcessEnumBench: synthetic tree %s built in %.0f ms, %d iterations\n", root.string().c_str(),
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count(), iters);
+    {
+        auto synthetic = ProcessEnum::CreateProcFsEnumerator(root.string());
+        RunSuite("synthetic", *synthetic, table, iters);
+    }
+    if (!keep) fs::remove_all(root, ec);
+#else
+    std::printf("ProcessEnumBench: %d iterations (synthetic tree is Linux only)\n", iters);
+#endif
+
+    auto live = ProcessEnum::CreateSystemEnumerator();
+    RunSuite("system", *live, table, iters);
+    return 0;
+}
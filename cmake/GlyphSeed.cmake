@@ -0,0 +1,30 @@
+# GlyphCache bakes only the CJK glyphs the UI uses. Runtime text reports itself through
+# GlyphCache::AddText(); UI labels do not, so their characters are collected from the sources at
+# build time (tools/glyph_seed_gen.cpp) into glyph_seed.inc, included by src/glyph_cache.cpp.
+#
+# add_glyph_seed(<target> <repo_root>)
+
+function(add_glyph_seed target repo_root)
+    if(NOT TARGET GlyphSeedGen)
+        add_executable(GlyphSeedGen ${repo_root}/tools/glyph_seed_gen.cpp)
+    endif()
+
+    file(GLOB _glyph_seed_sources CONFIGURE_DEPENDS
+        ${repo_root}/src/*.cpp
+        ${repo_root}/src/*.h
+    )
+    list(APPEND _glyph_seed_sources ${repo_root}/main.cpp)
+
+    set(_glyph_seed_dir ${CMAKE_CURRENT_BINARY_DIR}/glyph_seed)
+    set(_glyph_seed_file ${_glyph_seed_dir}/glyph_seed.inc)
+    add_custom_command(
+        OUTPUT ${_glyph_seed_file}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${_glyph_seed_dir}
+        COMMAND GlyphSeedGen ${_glyph_seed_file} ${_glyph_seed_sources}
+        DEPENDS GlyphSeedGen ${_glyph_seed_sources}
+        COMMENT "Collecting UI glyphs for GlyphCache"
+        VERBATIM
+    )
+    target_sources(${target} PRIVATE ${_glyph_seed_file})
+    target_include_directories(${target} PRIVATE ${_glyph_seed_dir})
+endfunction()
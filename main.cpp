@@ -3,6 +3,10 @@
 #include "src/vs_inspector.h"
 #include "src/word_reminder.h"
 #include "src/feature_manager.h"
+#include "src/font_loader.h"
+#include "src/startup_pipeline.h"
+#include "src/notifier.h"
+#include "src/file_watcher.h"
 #include <string>
 #include <vector>
 #include <mutex>
@@ -372,6 +376,10 @@ static void DrawUI()
             {
                 FeatureManager::GetInstance().ShowFeatureSelector();
             }
+            if (ImGui::MenuItem("Feature Profiler"))
+            {
+                FeatureManager::GetInstance().ShowProfiler();
+            }
             ImGui::EndMenu();
         }
         
@@ -398,6 +406,7 @@ static void DrawUI()
     
     // 最后绘制Feature Manager窗口（如果可见的话），确保它显示在最前面
     FeatureManager::GetInstance().DrawFeatureSelector();
+    FeatureManager::GetInstance().DrawProfiler();
 }
 
 static void DrawVSUI()
@@ -406,6 +415,50 @@ static void DrawVSUI()
     // Keeping it for backward compatibility
 }
 
+// Saved main window placement (window_config.txt: "width height x y")
+struct WindowConfig
+{
+    bool found = false;
+    bool parsed = false;
+    int width = 0, height = 0, x = 0, y = 0;
+
+    // 检查窗口位置是否有效（不在屏幕外）
+    bool IsValid() const
+    {
+        return parsed && x >= -10000 && y >= -10000 && x < 10000 && y < 10000 &&
+               width > 100 && height > 100 && width < 5000 && height < 5000;
+    }
+};
+
+// Startup worker task: pure file I/O, the window is resized on the UI thread
+static WindowConfig ReadWindowConfig()
+{
+    WindowConfig config;
+    std::ifstream winConfigFile("window_config.txt");
+    if (!winConfigFile.is_open()) return config;
+    config.found = true;
+    config.parsed = static_cast<bool>(winConfigFile >> config.width >> config.height >> config.x >> config.y);
+    return config;
+}
+
+// Startup worker task: log the window entries saved in imgui.ini
+static void LogImGuiIniWindows(const std::string& suffix)
+{
+    std::error_code ec;
+    if (!fs::exists("imgui.ini", ec)) {
+        AppendLog("[window] imgui.ini file does not exist" + suffix);
+        return;
+    }
+    AppendLog("[window] imgui.ini file exists" + suffix);
+    std::ifstream iniFile("imgui.ini");
+    std::string line;
+    while (std::getline(iniFile, line)) {
+        if (line.find("[Window]") != std::string::npos) {
+            AppendLog("[window] Found window config" + suffix + ": " + line);
+        }
+    }
+}
+
 #ifdef IMGUI_USE_D3D11
 // Win32 + DirectX11 backend
 #include "imgui_impl_win32.h"
@@ -464,7 +517,7 @@ static bool CreateDeviceD3D(HWND hWnd)
 
     // Log backend and adapter info
     {
-        FILE* log = fopen("DearImGuiExample.log", "w");
+        FILE* log = fopen("DearImGuiExample.log", "a"); // 追加：启动任务可能已写入日志
         if (log)
         {
             fprintf(log, "Backend: Direct3D11\n");
@@ -784,6 +837,8 @@ static LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 
 int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
 {
+    Startup::Mark("process_start");
+
     // 单实例控制 - 使用命名互斥体
     HANDLE singleInstanceMutex = CreateMutexW(nullptr, FALSE, L"DearImGuiTool_SingleInstance");
     if (singleInstanceMutex == nullptr || GetLastError() == ERROR_ALREADY_EXISTS)
@@ -815,20 +870,38 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         return 1; // 退出程序
     }
 
+    // 启动任务图：与窗口/设备创建无关的文件 I/O 在后台线程并行执行
+    Startup::TaskGraph startup;
+    WindowConfig savedWindow;
+    static FontLoader::FontSet startupFonts; // font bytes are referenced by the atlas
+    Startup::TaskId windowConfigTask = startup.Add("read_window_config", [&savedWindow]() { savedWindow = ReadWindowConfig(); });
+    startup.Add("scan_imgui_ini", []() { LogImGuiIniWindows(""); });
+    Startup::TaskId fontTask = startup.Add("discover_fonts", []() { startupFonts = FontLoader::DiscoverFonts(); });
+    startup.Start();
+
     // Create Win32 window
     WNDCLASSEX wc = { sizeof(WNDCLASSEX), CS_CLASSDC, WndProc, 0L, 0L, GetModuleHandle(NULL), NULL, NULL, NULL, NULL, _T("ImGui Example"), NULL };
-    RegisterClassEx(&wc);
-    EnablePerMonitorDpiAwareness();
-    g_appIcon = CreateAppIcon();
-    HWND hwnd = CreateWindow(wc.lpszClassName, _T("Dear ImGui Minimal Example (D3D11)"), WS_OVERLAPPEDWINDOW, 100, 100, 1280, 720, NULL, NULL, wc.hInstance, NULL);
-    if (g_appIcon && hwnd)
+    HWND hwnd = NULL;
     {
-        SendMessage(hwnd, WM_SETICON, ICON_BIG,   (LPARAM)g_appIcon);
-        SendMessage(hwnd, WM_SETICON, ICON_SMALL, (LPARAM)g_appIcon);
+        Startup::ScopedPhase phase("create_window");
+        RegisterClassEx(&wc);
+        EnablePerMonitorDpiAwareness();
+        g_appIcon = CreateAppIcon();
+        hwnd = CreateWindow(wc.lpszClassName, _T("Dear ImGui Minimal Example (D3D11)"), WS_OVERLAPPEDWINDOW, 100, 100, 1280, 720, NULL, NULL, wc.hInstance, NULL);
+        if (g_appIcon && hwnd)
+        {
+            SendMessage(hwnd, WM_SETICON, ICON_BIG,   (LPARAM)g_appIcon);
+            SendMessage(hwnd, WM_SETICON, ICON_SMALL, (LPARAM)g_appIcon);
+        }
     }
 
     // Initialize D3D
-    if (!CreateDeviceD3D(hwnd))
+    bool deviceCreated = false;
+    {
+        Startup::ScopedPhase phase("create_d3d_device");
+        deviceCreated = CreateDeviceD3D(hwnd);
+    }
+    if (!deviceCreated)
     {
         CleanupDeviceD3D();
         UnregisterClass(wc.lpszClassName, wc.hInstance);
@@ -844,25 +917,20 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
     int height = rect.bottom - rect.top;
     AppendLog("[window] Initial window size: " + std::to_string(width) + "x" + std::to_string(height));
     
-    // 尝试从配置文件恢复窗口大小
-    std::ifstream winConfigFile("window_config.txt");
-    if (winConfigFile.is_open()) {
-        int savedWidth, savedHeight, savedX, savedY;
-        if (winConfigFile >> savedWidth >> savedHeight >> savedX >> savedY) {
-            // 检查窗口位置是否有效（不在屏幕外）
-            if (savedX >= -10000 && savedY >= -10000 && savedX < 10000 && savedY < 10000 && 
-                savedWidth > 100 && savedHeight > 100 && savedWidth < 5000 && savedHeight < 5000) {
-                AppendLog("[window] Restoring window size: " + std::to_string(savedWidth) + "x" + std::to_string(savedHeight) + " at " + std::to_string(savedX) + "," + std::to_string(savedY));
-                SetWindowPos(hwnd, NULL, savedX, savedY, savedWidth, savedHeight, SWP_NOZORDER);
-            } else {
-                AppendLog("[window] Invalid window position detected, using default size: " + std::to_string(savedWidth) + "x" + std::to_string(savedHeight) + " at " + std::to_string(savedX) + "," + std::to_string(savedY));
-                // 使用默认位置和大小
-                SetWindowPos(hwnd, NULL, 100, 100, 1280, 720, SWP_NOZORDER);
-            }
-        }
-        winConfigFile.close();
-    } else {
+    // 尝试从配置文件恢复窗口大小（配置已在后台读取）
+    startup.Wait(windowConfigTask);
+    if (!savedWindow.found) {
         AppendLog("[window] No saved window config found, using default size");
+    } else if (savedWindow.parsed) {
+        const std::string placement = std::to_string(savedWindow.width) + "x" + std::to_string(savedWindow.height) + " at " + std::to_string(savedWindow.x) + "," + std::to_string(savedWindow.y);
+        if (savedWindow.IsValid()) {
+            AppendLog("[window] Restoring window size: " + placement);
+            SetWindowPos(hwnd, NULL, savedWindow.x, savedWindow.y, savedWindow.width, savedWindow.height, SWP_NOZORDER);
+        } else {
+            AppendLog("[window] Invalid window position detected, using default size: " + placement);
+            // 使用默认位置和大小
+            SetWindowPos(hwnd, NULL, 100, 100, 1280, 720, SWP_NOZORDER);
+        }
     }
     
     // Keep tray icon persistent regardless of window visibility
@@ -878,190 +946,31 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
     io.IniFilename = "imgui.ini";
     AppendLog("[window] Setting IniFilename to: imgui.ini");
     
-    // 检查imgui.ini文件是否存在
-    if (fs::exists("imgui.ini")) {
-        AppendLog("[window] imgui.ini file exists");
-        std::ifstream iniFile("imgui.ini");
-        std::string line;
-        while (std::getline(iniFile, line)) {
-            if (line.find("[Window]") != std::string::npos) {
-                AppendLog("[window] Found window config: " + line);
-            }
-        }
-        iniFile.close();
-    } else {
-        AppendLog("[window] imgui.ini file does not exist");
-    }
-    
     ImGui::StyleColorsDark();
     const float dpiScale = GetDpiScaleForWindow(hwnd);
     ImGui::GetStyle().ScaleAllSizes(dpiScale);
 
     // Setup Platform/Renderer bindings
-    ImGui_ImplWin32_Init(hwnd);
-    // Enable IME in Win32 backend explicitly
-    ImGui::GetIO().WantCaptureKeyboard = true;
-    ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
+    {
+        Startup::ScopedPhase phase("init_backend");
+        ImGui_ImplWin32_Init(hwnd);
+        // Enable IME in Win32 backend explicitly
+        ImGui::GetIO().WantCaptureKeyboard = true;
+        ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
+    }
 
-    // Initialize feature manager and all features
-    FeatureManager::GetInstance().Initialize();
+    // Initialize feature manager; feature init (prefs, word store) continues in the background
+    {
+        Startup::ScopedPhase phase("feature_manager_init");
+        FeatureManager::GetInstance().Initialize();
+    }
 
-    // Font loading and verbose logging (D3D11 path)
+    // Font atlas setup: the only hard dependency of the first frame besides the backend
+    startup.Wait(fontTask);
     {
+        Startup::ScopedPhase phase("font_atlas_setup");
         AppendLog("[font] D3D11: starting font setup");
-        ImGuiIO& io = ImGui::GetIO();
-        ImFont* defaultFont = io.Fonts->AddFontDefault();
-        if (defaultFont) AppendLog("[font] D3D11: added default font");
-
-        ImFont* chineseFont = nullptr;
-        const char* localCandidates[] = {
-            "fonts/NotoSansSC-Regular.otf",
-            "fonts/NotoSansSC-Regular.ttf",
-            "fonts/SourceHanSansCN-Regular.otf",
-            "fonts/SourceHanSansCN-Regular.ttf",
-            "fonts/MSYH.TTC",
-            "fonts/msyh.ttc",
-            "fonts/SIMSUN.TTC",
-            "fonts/simsun.ttc"
-        };
-
-        // Build search dirs: CWD fonts/Fonts and EXE_DIR fonts/Fonts
-        std::vector<fs::path> fontSearchDirs;
-        fontSearchDirs.push_back(fs::path("fonts"));
-        fontSearchDirs.push_back(fs::path("Fonts"));
-        wchar_t exePathW[MAX_PATH] = {0};
-        if (GetModuleFileNameW(NULL, exePathW, MAX_PATH) > 0)
-        {
-            fs::path exeDir = fs::path(exePathW).parent_path();
-            fontSearchDirs.push_back(exeDir / "fonts");
-            fontSearchDirs.push_back(exeDir / "Fonts");
-            AppendLog(std::string("[font] D3D11: exeDir= ") + exeDir.string());
-        }
-        AppendLog(std::string("[font] D3D11: current_path= ") + fs::current_path().string());
-
-        for (const auto& dir : fontSearchDirs)
-        {
-            AppendLog(std::string("[font] D3D11: check dir: ") + dir.string() + (fs::exists(dir) ? " [exists]" : " [missing]"));
-            if (!fs::exists(dir)) continue;
-            for (const char* rel : localCandidates)
-            {
-                fs::path candidate = dir / fs::path(rel).filename();
-                if (!fs::exists(candidate)) continue;
-                std::string p = candidate.string();
-                AppendLog(std::string("[font] D3D11: trying bundled font: ") + p);
-                ImFontConfig cfg; cfg.OversampleH = 3; cfg.OversampleV = 1; cfg.RasterizerMultiply = 1.0f; cfg.PixelSnapH = true;
-                chineseFont = io.Fonts->AddFontFromFileTTF(p.c_str(), 16.0f * dpiScale, &cfg, io.Fonts->GetGlyphRangesChineseSimplifiedCommon());
-                if (chineseFont) { AppendLog(std::string("[font] Loaded Chinese font (bundled): ") + p); break; }
-                else { AppendLog(std::string("[font] failed to load: ") + p); }
-            }
-            if (chineseFont) break;
-            // Scan directory for any ttf/otf/ttc
-            for (auto& entry : fs::directory_iterator(dir))
-            {
-                if (!entry.is_regular_file()) continue;
-                auto ext = entry.path().extension().string();
-                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                if (ext == ".ttf" || ext == ".otf" || ext == ".ttc")
-                {
-                    std::string p = entry.path().string();
-                    AppendLog(std::string("[font] D3D11: scanning try: ") + p);
-                    ImFontConfig cfg; cfg.OversampleH = 3; cfg.OversampleV = 1; cfg.RasterizerMultiply = 1.0f; cfg.PixelSnapH = true;
-                    chineseFont = io.Fonts->AddFontFromFileTTF(p.c_str(), 16.0f * dpiScale, &cfg, io.Fonts->GetGlyphRangesChineseSimplifiedCommon());
-                    if (chineseFont) { AppendLog(std::string("[font] Loaded Chinese font (scanned): ") + p); break; }
-                }
-            }
-            if (chineseFont) break;
-        }
-
-        // System fallback
-        if (!chineseFont)
-        {
-            const char* sysFonts[] = {
-                "C:/Windows/Fonts/msyh.ttc",
-                "C:/Windows/Fonts/simsun.ttc",
-                "C:/Windows/Fonts/msyh.ttf",
-                "C:/Windows/Fonts/simsun.ttf"
-            };
-            for (const char* fp : sysFonts)
-            {
-                AppendLog(std::string("[font] D3D11: try system font: ") + fp);
-                if (!fs::exists(fp)) { AppendLog("[font] D3D11: not found"); continue; }
-                ImFontConfig cfg; cfg.OversampleH = 3; cfg.OversampleV = 1; cfg.RasterizerMultiply = 1.0f; cfg.PixelSnapH = true;
-                chineseFont = io.Fonts->AddFontFromFileTTF(fp, 16.0f * dpiScale, &cfg, io.Fonts->GetGlyphRangesChineseSimplifiedCommon());
-                if (chineseFont) { AppendLog(std::string("[font] Loaded Chinese font (system): ") + fp); break; }
-            }
-        }
-
-        // Emoji fallback: load a monochrome-capable emoji font and MERGE into atlas
-        ImFont* emojiFont = nullptr;
-        const char* emojiBundled[] = {
-            "fonts/NotoEmoji-Regular.ttf",      // monochrome glyphs -> works with stb
-            "fonts/NotoColorEmoji.ttf"          // color requires FreeType; may not render with stb
-        };
-        const char* emojiSystem[] = {
-            "C:/Windows/Fonts/seguisym.ttf",    // Segoe UI Symbol (monochrome)
-            "C:/Windows/Fonts/seguiemj.ttf",    // Segoe UI Emoji (color; needs FreeType for color)
-            "C:/Windows/Fonts/seguiemj.ttc"
-        };
-
-        // Build emoji ranges
-        ImVector<ImWchar> emojiRanges; ImFontGlyphRangesBuilder builder; 
-        builder.AddRanges(io.Fonts->GetGlyphRangesDefault());
-        // Common emoji blocks
-        static const ImWchar range_arrows[]      = { 0x2190, 0x21FF, 0 };
-        static const ImWchar range_symbols[]     = { 0x2600, 0x27FF, 0 };
-        static const ImWchar range_misc_pict[]   = { 0x1F300, 0x1F6FF, 0 };
-        static const ImWchar range_supp_pict[]   = { 0x1F900, 0x1F9FF, 0 };
-        static const ImWchar range_pict_ext_a[]  = { 0x1FA70, 0x1FAFF, 0 };
-        builder.AddRanges(range_arrows);
-        builder.AddRanges(range_symbols);
-        builder.AddRanges(range_misc_pict);
-        builder.AddRanges(range_supp_pict);
-        builder.AddRanges(range_pict_ext_a);
-        builder.BuildRanges(&emojiRanges);
-
-        ImFontConfig cfg; cfg.MergeMode = true; cfg.PixelSnapH = true; cfg.GlyphMinAdvanceX = 0.0f;
-        // Try bundled first
-        for (const auto& dir : fontSearchDirs)
-        {
-            if (emojiFont) break; if (!fs::exists(dir)) continue;
-            for (const char* rel : emojiBundled)
-            {
-                fs::path p = dir / fs::path(rel).filename();
-                if (!fs::exists(p)) continue;
-                AppendLog(std::string("[font] D3D11: merge emoji bundled: ") + p.string());
-                emojiFont = io.Fonts->AddFontFromFileTTF(p.string().c_str(), 16.0f * dpiScale, &cfg, emojiRanges.Data);
-                if (emojiFont) { AppendLog(std::string("[font] Merged emoji font (bundled): ") + p.string()); break; }
-            }
-        }
-        // Then system
-        if (!emojiFont)
-        {
-            for (const char* fp : emojiSystem)
-            {
-                if (!fs::exists(fp)) continue;
-                AppendLog(std::string("[font] D3D11: merge emoji system: ") + fp);
-                emojiFont = io.Fonts->AddFontFromFileTTF(fp, 16.0f * dpiScale, &cfg, emojiRanges.Data);
-                if (emojiFont) { AppendLog(std::string("[font] Merged emoji font (system): ") + fp); break; }
-            }
-        }
-
-        // Set default font preference
-        if (chineseFont)
-        {
-            io.FontDefault = chineseFont;
-            AppendLog("[font] D3D11: Using Chinese font as default");
-        }
-        else if (emojiFont)
-        {
-            io.FontDefault = emojiFont;
-            AppendLog("[font] D3D11: Using emoji font as default");
-        }
-        else
-        {
-            io.FontDefault = defaultFont;
-            AppendLog("[font] D3D11: Using default font");
-        }
+        FontLoader::AddFontsToAtlas(io, startupFonts, 16.0f * dpiScale);
     }
 
     // Main loop
@@ -1079,19 +988,27 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         if (done)
             break;
 
+        // 新出现的字符分批加入字体 atlas（需重建字体纹理）
+        if (FontLoader::UpdateGlyphs(io, startupFonts))
+            ImGui_ImplDX11_InvalidateDeviceObjects();
+
         ImGui_ImplDX11_NewFrame();
         ImGui_ImplWin32_NewFrame();
         ImGui::NewFrame();
+        FontLoader::NoteInputCharacters(io);
 
         DrawUI();
         DrawVSUI();
         
-        // 检查单词提醒
-        if (WordReminder::HasReminderToShow())
+        // 其他实例或同步盘改了单词分片 / prefs.json：按记录合并进来
+        FileWatcher::Pump();
+        // 单词提醒：到期检查与通知投递（提醒弹窗 / 应用内提示 / 桌面通知）
+        if (FeatureManager::GetInstance().IsFeatureReady(WordReminder::GetFeatureName()))
         {
-            // 这里可以添加声音提醒或其他提醒方式
-            // 目前会在UI中显示弹窗
+            WordReminder::PollReminders();
         }
+        Notifier::Pump();
+        Notifier::DrawToasts();
 
         ImGui::Render();
         const float clear_color_with_alpha[4] = { 0.45f, 0.55f, 0.60f, 1.00f };
@@ -1099,12 +1016,16 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView, clear_color_with_alpha);
         ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
         g_pSwapChain->Present(1, 0);
+        Startup::MarkFirstFrame();
+        Startup::WriteTraceWhenIdle();
     }
 
     // 窗口大小已经在隐藏时保存，这里不需要重复保存
     
     // Cleanup
     FeatureManager::GetInstance().Cleanup();
+    Notifier::Shutdown();
+    FileWatcher::Shutdown();
     
     // 保存ImGui设置到ini文件
     AppendLog("[window] Saving ImGui settings to imgui.ini");
@@ -1147,6 +1068,8 @@ static HANDLE g_singleInstanceMutex = nullptr;
 
 int main(int, char**)
 {
+    Startup::Mark("process_start");
+
     // 创建命名互斥体，确保只有一个实例运行
     g_singleInstanceMutex = CreateMutexW(nullptr, FALSE, L"DearImGuiTool_SingleInstance");
     if (g_singleInstanceMutex == nullptr || GetLastError() == ERROR_ALREADY_EXISTS)
@@ -1181,59 +1104,69 @@ int main(int, char**)
     //log
     AppendLog("main - 单实例检查通过");
 
+    // 启动任务图：与窗口/GL 上下文创建无关的文件 I/O 在后台线程并行执行
+    Startup::TaskGraph startup;
+    WindowConfig savedWindow;
+    static FontLoader::FontSet startupFonts; // font bytes are referenced by the atlas
+    Startup::TaskId windowConfigTask = startup.Add("read_window_config", [&savedWindow]() { savedWindow = ReadWindowConfig(); });
+    startup.Add("scan_imgui_ini", []() { LogImGuiIniWindows(" (GLFW)"); });
+    Startup::TaskId fontTask = startup.Add("discover_fonts", []() { startupFonts = FontLoader::DiscoverFonts(); });
+    startup.Start();
+
     glfwSetErrorCallback(glfw_error_callback);
-    if (!glfwInit())
-        return 1;
 #ifndef IMGUI_USE_OPENGL2
     const char* glsl_version = "#version 130";
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+#endif
+    GLFWwindow* window = nullptr;
+    {
+        Startup::ScopedPhase phase("create_window");
+        if (!glfwInit())
+            return 1;
+#ifndef IMGUI_USE_OPENGL2
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_FALSE);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_ANY_PROFILE);
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_FALSE);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_ANY_PROFILE);
 #endif
 
-    GLFWwindow* window = glfwCreateWindow(1280, 720, "Dear ImGui Minimal Example", nullptr, nullptr);
-    if (window == nullptr)
-        return 1;
-    glfwMakeContextCurrent(window);
-    glfwSwapInterval(1);
+        window = glfwCreateWindow(1280, 720, "Dear ImGui Minimal Example", nullptr, nullptr);
+        if (window == nullptr)
+            return 1;
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(1);
+    }
     
     // 记录当前窗口大小
     int width, height;
     glfwGetWindowSize(window, &width, &height);
     AppendLog("[window] Initial GLFW window size: " + std::to_string(width) + "x" + std::to_string(height));
     
-    // 尝试从配置文件恢复窗口大小
-    std::ifstream glfwConfigFile("window_config.txt");
-    if (glfwConfigFile.is_open()) {
-        int savedWidth, savedHeight, savedX, savedY;
-        if (glfwConfigFile >> savedWidth >> savedHeight >> savedX >> savedY) {
-            // 检查窗口位置是否有效（不在屏幕外）
-            if (savedX >= -10000 && savedY >= -10000 && savedX < 10000 && savedY < 10000 && 
-                savedWidth > 100 && savedHeight > 100 && savedWidth < 5000 && savedHeight < 5000) {
-                AppendLog("[window] Restoring GLFW window size: " + std::to_string(savedWidth) + "x" + std::to_string(savedHeight) + " at " + std::to_string(savedX) + "," + std::to_string(savedY));
-                glfwSetWindowSize(window, savedWidth, savedHeight);
-                glfwSetWindowPos(window, savedX, savedY);
-            } else {
-                AppendLog("[window] Invalid GLFW window position detected, using default size: " + std::to_string(savedWidth) + "x" + std::to_string(savedHeight) + " at " + std::to_string(savedX) + "," + std::to_string(savedY));
-                // 使用默认位置和大小
-                glfwSetWindowSize(window, 1280, 720);
-                glfwSetWindowPos(window, 100, 100);
-            }
-        }
-        glfwConfigFile.close();
-    } else {
+    // 尝试从配置文件恢复窗口大小（配置已在后台读取）
+    startup.Wait(windowConfigTask);
+    if (!savedWindow.found) {
         AppendLog("[window] No saved GLFW window config found, using default size");
+    } else if (savedWindow.parsed) {
+        const std::string placement = std::to_string(savedWindow.width) + "x" + std::to_string(savedWindow.height) + " at " + std::to_string(savedWindow.x) + "," + std::to_string(savedWindow.y);
+        if (savedWindow.IsValid()) {
+            AppendLog("[window] Restoring GLFW window size: " + placement);
+            glfwSetWindowSize(window, savedWindow.width, savedWindow.height);
+            glfwSetWindowPos(window, savedWindow.x, savedWindow.y);
+        } else {
+            AppendLog("[window] Invalid GLFW window position detected, using default size: " + placement);
+            // 使用默认位置和大小
+            glfwSetWindowSize(window, 1280, 720);
+            glfwSetWindowPos(window, 100, 100);
+        }
     }
 
     // Log backend and GL info
     {
-        FILE* log = fopen("DearImGuiExample.log", "w");
+        FILE* log = fopen("DearImGuiExample.log", "a"); // 追加：启动任务可能已写入日志
         if (log)
         {
             const unsigned char* renderer = glGetString(GL_RENDERER);
@@ -1260,159 +1193,47 @@ int main(int, char**)
     io.IniFilename = "imgui.ini";
     AppendLog("[window] Setting IniFilename to: imgui.ini (GLFW)");
     
-    // 检查imgui.ini文件是否存在
-    if (fs::exists("imgui.ini")) {
-        AppendLog("[window] imgui.ini file exists (GLFW)");
-        std::ifstream iniFile("imgui.ini");
-        std::string line;
-        while (std::getline(iniFile, line)) {
-            if (line.find("[Window]") != std::string::npos) {
-                AppendLog("[window] Found window config (GLFW): " + line);
-            }
-        }
-        iniFile.close();
-    } else {
-        AppendLog("[window] imgui.ini file does not exist (GLFW)");
-    }
-    
     ImGui::StyleColorsDark();
 
-    ImGui_ImplGlfw_InitForOpenGL(window, true);
+    {
+        Startup::ScopedPhase phase("init_backend");
+        ImGui_ImplGlfw_InitForOpenGL(window, true);
 #ifdef IMGUI_USE_OPENGL2
-    ImGui_ImplOpenGL2_Init();
+        ImGui_ImplOpenGL2_Init();
 #else
-    ImGui_ImplOpenGL3_Init(glsl_version);
-#endif
-
-    // Initialize feature manager and all features
-    FeatureManager::GetInstance().Initialize();
-
-    // 改进的字体加载策略
-    ImFont* defaultFont = io.Fonts->AddFontDefault();
-    
-    // 尝试加载支持中文和emoji的字体（优先从本地 fonts/ 目录加载，便于自带字体）
-    ImFont* chineseFont = nullptr;
-    {
-        // 首选预置候选（若随程序打包）
-        const char* localCandidates[] = {
-            "fonts/NotoSansSC-Regular.otf",
-            "fonts/NotoSansSC-Regular.ttf",
-            "fonts/SourceHanSansCN-Regular.otf",
-            "fonts/SourceHanSansCN-Regular.ttf",
-            "fonts/MSYH.TTC",
-            "fonts/msyh.ttc",
-            "fonts/SIMSUN.TTC",
-            "fonts/simsun.ttc"
-        };
-        // 构建搜索目录：当前工作目录下 fonts/ 与 Fonts/，以及可执行目录下的 fonts/ 与 Fonts/
-        std::vector<fs::path> fontSearchDirs;
-        fontSearchDirs.push_back(fs::path("fonts"));
-        fontSearchDirs.push_back(fs::path("Fonts"));
-#ifdef _WIN32
-        {
-            wchar_t exePathW[MAX_PATH] = {0};
-            if (GetModuleFileNameW(NULL, exePathW, MAX_PATH) > 0)
-            {
-                fs::path exeDir = fs::path(exePathW).parent_path();
-                fontSearchDirs.push_back(exeDir / "fonts");
-                fontSearchDirs.push_back(exeDir / "Fonts");
-            }
-        }
+        ImGui_ImplOpenGL3_Init(glsl_version);
 #endif
-        for (const auto& dir : fontSearchDirs)
-        {
-            if (!fs::exists(dir)) continue;
-            AppendLog(std::string("[font] Searching bundled fonts under: ") + dir.string());
-            for (const char* rel : localCandidates)
-            {
-                fs::path candidate = dir / fs::path(rel).filename();
-                if (!fs::exists(candidate)) continue;
-                std::string p = candidate.string();
-                chineseFont = io.Fonts->AddFontFromFileTTF(p.c_str(), 16.0f, nullptr, io.Fonts->GetGlyphRangesChineseSimplifiedCommon());
-                if (chineseFont) { AppendLog(std::string("[font] Loaded Chinese font (bundled): ") + p); break; }
-            }
-            if (chineseFont) break;
-        }
-        // 若以上未命中，则扫描 fonts 目录的所有 ttf/otf
-        if (!chineseFont)
-        {
-            for (const auto& dir : fontSearchDirs)
-            {
-                if (!fs::exists(dir)) continue;
-                AppendLog(std::string("[font] scanning fonts directory: ") + dir.string());
-                for (auto& entry : fs::directory_iterator(dir))
-                {
-                    if (!entry.is_regular_file()) continue;
-                    auto ext = entry.path().extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                    if (ext == ".ttf" || ext == ".otf" || ext == ".ttc")
-                    {
-                        std::string p = entry.path().string();
-                        chineseFont = io.Fonts->AddFontFromFileTTF(p.c_str(), 16.0f, nullptr, io.Fonts->GetGlyphRangesChineseSimplifiedCommon());
-                        if (chineseFont) { AppendLog(std::string("[font] Loaded Chinese font (scanned): ") + p); break; }
-                    }
-                }
-                if (chineseFont) break;
-            }
-        }
-        // 系统字体兜底
-        if (!chineseFont)
-        {
-            const char* chineseFontPaths[] = {
-                "C:/Windows/Fonts/msyh.ttc",
-                "C:/Windows/Fonts/simsun.ttc",
-                "C:/Windows/Fonts/msyh.ttf",
-                "C:/Windows/Fonts/simsun.ttf"
-            };
-            for (const char* fontPath : chineseFontPaths)
-            {
-                if (!fs::exists(fontPath)) continue;
-                chineseFont = io.Fonts->AddFontFromFileTTF(fontPath, 16.0f, nullptr, io.Fonts->GetGlyphRangesChineseSimplifiedCommon());
-                if (chineseFont) { AppendLog(std::string("[font] Loaded Chinese font (system): ") + fontPath); break; }
-            }
-        }
     }
-    
-    // 尝试加载emoji字体作为补充
-    ImFont* emojiFont = nullptr;
-    const char* emojiFontPaths[] = {
-        "fonts/NotoColorEmoji.ttf",
-        "fonts/NotoEmoji-Regular.ttf",
-        "C:/Windows/Fonts/seguiemj.ttf",
-        "C:/Windows/Fonts/seguiemj.ttc",
-        "C:/Windows/Fonts/arial.ttf"
-    };
-    
-    for (const char* fontPath : emojiFontPaths)
-    {
-        emojiFont = io.Fonts->AddFontFromFileTTF(fontPath, 16.0f, nullptr, io.Fonts->GetGlyphRangesDefault());
-        if (emojiFont) 
-        {
-            AppendLog(std::string("[font] Loaded emoji font: ") + fontPath);
-            break;
-        }
-    }
-    
-    // 设置字体优先级：中文字体 > emoji字体 > 默认字体
-    if (chineseFont)
-    {
-        io.FontDefault = chineseFont;
-        AppendLog("[font] Using Chinese font as default");
-    }
-    else if (emojiFont)
+
+    // Initialize feature manager; feature init (prefs, word store) continues in the background
     {
-        io.FontDefault = emojiFont;
-        AppendLog("[font] Using emoji font as default");
+        Startup::ScopedPhase phase("feature_manager_init");
+        FeatureManager::GetInstance().Initialize();
     }
-    else
+
+    // 字体：候选路径探测与文件读取已在后台完成，这里只把数据交给 atlas
+    startup.Wait(fontTask);
     {
-        io.FontDefault = defaultFont;
-        AppendLog("[font] Using default font");
+        Startup::ScopedPhase phase("font_atlas_setup");
+        FontLoader::AddFontsToAtlas(io, startupFonts, 16.0f);
     }
 
     while (!glfwWindowShouldClose(window))
     {
         glfwPollEvents();
+
+        // 新出现的字符分批加入字体 atlas（需重建字体纹理）
+        if (FontLoader::UpdateGlyphs(io, startupFonts))
+        {
+#ifdef IMGUI_USE_OPENGL2
+            ImGui_ImplOpenGL2_DestroyFontsTexture();
+            ImGui_ImplOpenGL2_CreateFontsTexture();
+#else
+            ImGui_ImplOpenGL3_DestroyFontsTexture();
+            ImGui_ImplOpenGL3_CreateFontsTexture();
+#endif
+        }
+
 #ifdef IMGUI_USE_OPENGL2
         ImGui_ImplOpenGL2_NewFrame();
 #else
@@ -1420,16 +1241,20 @@ int main(int, char**)
 #endif
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
+        FontLoader::NoteInputCharacters(io);
 
         DrawUI();
         DrawVSUI();
         
-        // 检查单词提醒
-        if (WordReminder::HasReminderToShow())
+        // 其他实例或同步盘改了单词分片 / prefs.json：按记录合并进来
+        FileWatcher::Pump();
+        // 单词提醒：到期检查与通知投递（提醒弹窗 / 应用内提示 / 桌面通知）
+        if (FeatureManager::GetInstance().IsFeatureReady(WordReminder::GetFeatureName()))
         {
-            // 这里可以添加声音提醒或其他提醒方式
-            // 目前会在UI中显示弹窗
+            WordReminder::PollReminders();
         }
+        Notifier::Pump();
+        Notifier::DrawToasts();
 
         ImGui::Render();
         int display_w, display_h; glfwGetFramebufferSize(window, &display_w, &display_h);
@@ -1442,6 +1267,8 @@ int main(int, char**)
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 #endif
         glfwSwapBuffers(window);
+        Startup::MarkFirstFrame();
+        Startup::WriteTraceWhenIdle();
     }
 
     // 保存当前窗口大小和位置（在清理之前）
@@ -1467,6 +1294,8 @@ int main(int, char**)
     }
     
     FeatureManager::GetInstance().Cleanup();
+    Notifier::Shutdown();
+    FileWatcher::Shutdown();
     
     // 保存ImGui设置到ini文件
     AppendLog("[window] Saving ImGui settings to imgui.ini (GLFW)");
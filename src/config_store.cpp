@@ -0,0 +1,374 @@
+#include "config_store.h"
+#include "json.h"
+
+#include <algorithm>
+
+namespace ConfigStore
+{
+    void WriteJson(const std::vector<SavedConfig>& configs, std::string& out)
+    {
+        out.reserve(out.size() + 64 + configs.size() * 256);
+        Json::Writer w(out);
+        w.BeginObject().Key("configs").BeginArray();
+        for (const SavedConfig& c : configs)
+        {
+            w.BeginObject();
+            w.Key("name").String(c.name);
+            w.Key("vs").String(c.vsSolutionPath);
+            w.Key("cursor").String(c.cursorFolderPath);
+            w.Key("feishu").String(c.feishuPath);
+            w.Key("wechat").String(c.wechatPath);
+            w.Key("createdAt").UInt(c.createdAt);
+            w.Key("lastUsedAt").UInt(c.lastUsedAt);
+            w.EndObject();
+        }
+        w.EndArray().EndObject();
+    }
+
+    bool ParseJson(std::string_view content, std::vector<SavedConfig>& out, std::string& error)
+    {
+        out.clear();
+        Json::Reader r(content);
+        bool sawConfigs = false;
+        Json::Token t = r.Next();
+        if (t != Json::Token::ObjectBegin)
+        {
+            error = r.Failed() ? r.Error() : "expected an object";
+            return false;
+        }
+        while ((t = r.Next()) == Json::Token::Key)
+        {
+            if (r.Text() != "configs")
+            {
+                if (!r.SkipValue()) break;
+                continue;
+            }
+            if (r.Next() != Json::Token::ArrayBegin)
+            {
+                error = r.Failed() ? r.Error() : "\"configs\" is not an array";
+                return false;
+            }
+            while ((t = r.Next()) == Json::Token::ObjectBegin)
+            {
+                SavedConfig c;
+                while ((t = r.Next()) == Json::Token::Key)
+                {
+                    std::string* field = nullptr;
+                    unsigned long long* stamp = nullptr;
+                    const std::string_view k = r.Text();
+                    if (k == "name") field = &c.name;
+                    else if (k == "vs") field = &c.vsSolutionPath;
+                    else if (k == "cursor") field = &c.cursorFolderPath;
+                    else if (k == "feishu") field = &c.feishuPath;
+                    else if (k == "wechat") field = &c.wechatPath;
+                    else if (k == "createdAt") stamp = &c.createdAt;
+                    else if (k == "lastUsedAt") stamp = &c.lastUsedAt;
+                    if (!field && !stamp)
+                    {
+                        if (!r.SkipValue()) break;
+                        continue;
+                    }
+                    t = r.Next();
+                    uint64_t v = 0;
+                    if (field && t == Json::Token::String) field->assign(r.Text().data(), r.Text().size());
+                    else if (stamp && t == Json::Token::Number && r.UInt(v)) *stamp = v;
+                    else if (t == Json::Token::ObjectBegin || t == Json::Token::ArrayBegin || t == Json::Token::Error) { t = Json::Token::Error; break; }
+                }
+                if (t != Json::Token::ObjectEnd) break;
+                if (!c.name.empty()) out.push_back(std::move(c));
+            }
+            if (t != Json::Token::ArrayEnd) break;
+            sawConfigs = true;
+        }
+        if (t != Json::Token::ObjectEnd || r.Next() != Json::Token::End)
+        {
+            error = r.Failed() ? r.Error() : "unexpected structure at offset " + std::to_string(r.Offset());
+            return false;
+        }
+        if (!sawConfigs) error = "no \"configs\" array";
+        return sawConfigs;
+    }
+
+    const SavedConfig* Store::Find(const std::string& name) const
+    {
+        auto it = index.find(name);
+        return it == index.end() ? nullptr : &configs[it->second];
+    }
+
+    void Store::Assign(std::vector<SavedConfig> loaded)
+    {
+        configs.clear();
+        index.clear();
+        configs.reserve(loaded.size());
+        index.reserve(loaded.size());
+        MergeResult ignored;
+        for (SavedConfig& c : loaded)
+        {
+            if (c.name.empty()) continue;
+            if (index.count(c.name)) { MergeOne(c, ignored); continue; }
+            index.emplace(c.name, (uint32_t)configs.size());
+            configs.push_back(std::move(c));
+        }
+        RebuildMru();
+        ++generation;
+    }
+
+    bool Store::Upsert(const std::string& name, const std::string& vs, const std::string& cursor,
+                       const std::string& feishu, const std::string& wechat, unsigned long long now)
+    {
+        if (name.empty()) return false;
+        auto it = index.find(name);
+        if (it != index.end())
+        {
+            SavedConfig& c = configs[it->second];
+            c.vsSolutionPath = vs;
+            c.cursorFolderPath = cursor;
+            c.feishuPath = feishu;
+            c.wechatPath = wechat;
+            if (c.createdAt == 0)
+            {
+                MruErase(it->second);
+                c.createdAt = now;
+                MruInsert(it->second);
+            }
+            ++generation;
+            return false;
+        }
+        SavedConfig c;
+        c.name = name;
+        c.vsSolutionPath = vs;
+        c.cursorFolderPath = cursor;
+        c.feishuPath = feishu;
+        c.wechatPath = wechat;
+        c.createdAt = now;
+        const uint32_t i = (uint32_t)configs.size();
+        configs.push_back(std::move(c));
+        index.emplace(name, i);
+        MruInsert(i);
+        ++generation;
+        return true;
+    }
+
+    bool Store::MarkUsed(const std::string& name, unsigned long long now)
+    {
+        auto it = index.find(name);
+        if (it == index.end()) return false;
+        MruErase(it->second);
+        configs[it->second].lastUsedAt = now;
+        MruInsert(it->second);
+        ++generation;
+        return true;
+    }
+
+    bool Store::Remove(const std::string& name)
+    {
+        auto it = index.find(name);
+        if (it == index.end()) return false;
+        const uint32_t removed = it->second;
+        MruErase(removed);
+        index.erase(it);
+        configs.erase(configs.begin() + removed);
+        // Later records moved down by one; file order is kept so saves stay diff-friendly
+        for (auto& entry : index) if (entry.second > removed) --entry.second;
+        for (uint32_t& i : mru) if (i > removed) --i;
+        ++generation;
+        return true;
+    }
+
+    MergeResult Store::Merge(const std::vector<SavedConfig>& incoming)
+    {
+        MergeResult result;
+        const size_t before = configs.size();
+        index.reserve(before + incoming.size());
+        for (const SavedConfig& in : incoming)
+        {
+            if (in.name.empty()) continue;
+            MergeOne(in, result);
+        }
+        // One sort for a bulk import instead of an ordered insert per record
+        if (result.added + result.updated > 0)
+        {
+            RebuildMru();
+            ++generation;
+        }
+        return result;
+    }
+
+    // FNV-1a 64 over every field but lastUsedAt; the NUL after each string keeps fields apart
+    static uint64_t Fingerprint(const SavedConfig& c)
+    {
+        uint64_t h = 14695981039346656037ull;
+        auto mix = [&h](const char* data, size_t size) {
+            for (size_t i = 0; i < size; ++i)
+            {
+                h ^= (unsigned char)data[i];
+                h *= 1099511628211ull;
+            }
+        };
+        for (const std::string* field : { &c.name, &c.vsSolutionPath, &c.cursorFolderPath, &c.feishuPath, &c.wechatPath })
+        {
+            mix(field->c_str(), field->size() + 1);
+        }
+        mix(reinterpret_cast<const char*>(&c.createdAt), sizeof(c.createdAt));
+        return h;
+    }
+
+    Snapshot TakeSnapshot(const std::vector<SavedConfig>& configs)
+    {
+        Snapshot snapshot;
+        snapshot.reserve(configs.size());
+        for (const SavedConfig& c : configs) snapshot[c.name] = Fingerprint(c);
+        return snapshot;
+    }
+
+    SyncResult Store::Sync(const std::vector<SavedConfig>& remote, const Snapshot& base)
+    {
+        SyncResult result;
+        bool changed = false;
+        std::unordered_map<std::string, const SavedConfig*> remoteByName;
+        remoteByName.reserve(remote.size());
+        for (const SavedConfig& r : remote)
+        {
+            if (!r.name.empty()) remoteByName[r.name] = &r;  // a duplicate name: the last one wins
+        }
+
+        // Records on this side that the remote version deleted
+        std::vector<std::string> removals;
+        for (const SavedConfig& c : configs)
+        {
+            if (remoteByName.count(c.name)) continue;
+            auto b = base.find(c.name);
+            if (b == base.end()) continue;  // added here, not saved yet
+            if (b->second == Fingerprint(c)) removals.push_back(c.name);
+            else { result.conflicts++; result.conflictNames.push_back(c.name); }
+        }
+
+        for (const SavedConfig& r : remote)
+        {
+            if (r.name.empty() || remoteByName[r.name] != &r) continue;
+            const uint64_t rf = Fingerprint(r);
+            auto b = base.find(r.name);
+            auto it = index.find(r.name);
+            if (it == index.end())
+            {
+                if (b == base.end())
+                {
+                    Replace((uint32_t)configs.size(), r);
+                    result.added++;
+                    changed = true;
+                }
+                else if (b->second != rf)
+                {
+                    // Deleted here, changed there
+                    result.conflicts++;
+                    result.conflictNames.push_back(r.name);
+                }
+                continue;
+            }
+
+            const SavedConfig& cur = configs[it->second];
+            const uint64_t lf = Fingerprint(cur);
+            if (lf == rf || (b != base.end() && b->second == rf))
+            {
+                // Same record, or only this side changed it: just take the later use
+                if (r.lastUsedAt > cur.lastUsedAt)
+                {
+                    SavedConfig merged = cur;
+                    merged.lastUsedAt = r.lastUsedAt;
+                    Replace(it->second, merged);
+                    changed = true;
+                }
+            }
+            else if (b != base.end() && b->second == lf)
+            {
+                SavedConfig merged = r;
+                merged.lastUsedAt = (std::max)(r.lastUsedAt, cur.lastUsedAt);
+                Replace(it->second, merged);
+                result.updated++;
+                result.updatedNames.push_back(r.name);
+                changed = true;
+            }
+            else
+            {
+                result.conflicts++;
+                result.conflictNames.push_back(r.name);
+            }
+        }
+
+        for (const std::string& name : removals)
+        {
+            Remove(name);
+            result.removed++;
+            result.removedNames.push_back(name);
+        }
+        if (changed) ++generation;
+        return result;
+    }
+
+    // Overwrite the record at `i`, or append when i == Size()
+    void Store::Replace(uint32_t i, const SavedConfig& config)
+    {
+        if (i == configs.size())
+        {
+            index.emplace(config.name, i);
+            configs.push_back(config);
+        }
+        else
+        {
+            MruErase(i);
+            configs[i] = config;
+        }
+        MruInsert(i);
+    }
+
+    void Store::MergeOne(const SavedConfig& in, MergeResult& result)
+    {
+        auto it = index.find(in.name);
+        if (it == index.end())
+        {
+            index.emplace(in.name, (uint32_t)configs.size());
+            configs.push_back(in);
+            ++result.added;
+            return;
+        }
+        SavedConfig& cur = configs[it->second];
+        if (cur.createdAt == 0 || (in.createdAt != 0 && in.createdAt < cur.createdAt)) cur.createdAt = in.createdAt;
+        if (in.lastUsedAt > cur.lastUsedAt) cur.lastUsedAt = in.lastUsedAt;
+        if (!in.vsSolutionPath.empty()) cur.vsSolutionPath = in.vsSolutionPath;
+        if (!in.cursorFolderPath.empty()) cur.cursorFolderPath = in.cursorFolderPath;
+        if (!in.feishuPath.empty()) cur.feishuPath = in.feishuPath;
+        if (!in.wechatPath.empty()) cur.wechatPath = in.wechatPath;
+        ++result.updated;
+    }
+
+    // lastUsedAt desc, createdAt desc, then file order
+    bool Store::MruBefore(uint32_t a, uint32_t b) const
+    {
+        const SavedConfig& x = configs[a];
+        const SavedConfig& y = configs[b];
+        if (x.lastUsedAt != y.lastUsedAt) return x.lastUsedAt > y.lastUsedAt;
+        if (x.createdAt != y.createdAt) return x.createdAt > y.createdAt;
+        return a < b;
+    }
+
+    void Store::MruInsert(uint32_t i)
+    {
+        auto pos = std::lower_bound(mru.begin(), mru.end(), i, [this](uint32_t a, uint32_t b) { return MruBefore(a, b); });
+        mru.insert(pos, i);
+    }
+
+    // Called before the record's sort keys change, so the binary search still sees the old keys
+    void Store::MruErase(uint32_t i)
+    {
+        auto pos = std::lower_bound(mru.begin(), mru.end(), i, [this](uint32_t a, uint32_t b) { return MruBefore(a, b); });
+        if (pos != mru.end() && *pos == i) mru.erase(pos);
+        else mru.erase(std::remove(mru.begin(), mru.end(), i), mru.end());
+    }
+
+    void Store::RebuildMru()
+    {
+        mru.resize(configs.size());
+        for (uint32_t i = 0; i < (uint32_t)mru.size(); ++i) mru[i] = i;
+        std::sort(mru.begin(), mru.end(), [this](uint32_t a, uint32_t b) { return MruBefore(a, b); });
+    }
+}
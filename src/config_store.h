@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Saved workspace configurations for VSInspector (VS solution, Cursor folder, Feishu/WeChat paths).
+// Records keep their file order; a name -> index map makes lookups O(1) and a most-recently-used
+// order (lastUsedAt desc, then createdAt desc) is kept up to date by every mutation, so neither
+// the UI nor an import of thousands of configs scans or re-sorts the whole list.
+// Not thread-safe: owned by the UI thread.
+namespace ConfigStore
+{
+    struct SavedConfig
+    {
+        std::string name;
+        std::string vsSolutionPath;
+        std::string cursorFolderPath;
+        std::string feishuPath;
+        std::string wechatPath;
+        unsigned long long createdAt = 0;    // unix time seconds
+        unsigned long long lastUsedAt = 0;   // unix time seconds
+    };
+
+    struct MergeResult
+    {
+        size_t added = 0;
+        size_t updated = 0;
+    };
+
+    // Name -> fingerprint of a version of the configs (what prefs.json held when last read or
+    // written). lastUsedAt is left out: every use bumps it, and the later stamp always wins.
+    using Snapshot = std::unordered_map<std::string, uint64_t>;
+    Snapshot TakeSnapshot(const std::vector<SavedConfig>& configs);
+
+    struct SyncResult
+    {
+        size_t added = 0;
+        size_t updated = 0;
+        size_t removed = 0;
+        size_t conflicts = 0;                     // changed on both sides: the local record is kept
+        std::vector<std::string> updatedNames;
+        std::vector<std::string> removedNames;
+        std::vector<std::string> conflictNames;
+    };
+
+    // prefs.json / export format: {"configs": [{"name": ..., "vs": ..., "cursor": ..., "feishu": ...,
+    // "wechat": ..., "createdAt": N, "lastUsedAt": N}, ...]}, appended to out
+    void WriteJson(const std::vector<SavedConfig>& configs, std::string& out);
+
+    // Unknown members are skipped. False (reason in error) if the document is malformed or has no
+    // "configs" array; out then holds whatever was read before the error.
+    bool ParseJson(std::string_view content, std::vector<SavedConfig>& out, std::string& error);
+
+    class Store
+    {
+    public:
+        size_t Size() const { return configs.size(); }
+        bool Empty() const { return configs.empty(); }
+
+        // File order
+        const std::vector<SavedConfig>& All() const { return configs; }
+
+        // Indices into All(), most recently used first
+        const std::vector<uint32_t>& MruOrder() const { return mru; }
+
+        // Bumped by every change; cached views compare it instead of the contents
+        uint64_t Generation() const { return generation; }
+
+        const SavedConfig* Find(const std::string& name) const;
+
+        // Replace the contents (load). Duplicate names are merged as Merge() does.
+        void Assign(std::vector<SavedConfig> loaded);
+
+        // Create or overwrite the paths of `name`; createdAt is set on creation. Returns true if created.
+        bool Upsert(const std::string& name, const std::string& vs, const std::string& cursor,
+                    const std::string& feishu, const std::string& wechat, unsigned long long now);
+
+        // Set lastUsedAt and move the config to the front of the MRU order. False if not found.
+        bool MarkUsed(const std::string& name, unsigned long long now);
+
+        bool Remove(const std::string& name);
+
+        // Import rule per name: keep the earliest createdAt and the latest lastUsedAt, take
+        // non-empty paths from the incoming record; unknown names are appended.
+        MergeResult Merge(const std::vector<SavedConfig>& incoming);
+
+        // Three-way merge of prefs.json changed by someone else: `base` is the snapshot of the
+        // version last read or written, `remote` the file's new contents. A record only changes
+        // here if the remote side changed it and this side did not; local edits not yet saved
+        // survive, and records changed on both sides are reported as conflicts.
+        SyncResult Sync(const std::vector<SavedConfig>& remote, const Snapshot& base);
+
+    private:
+        bool MruBefore(uint32_t a, uint32_t b) const;
+        void MruInsert(uint32_t index);
+        void MruErase(uint32_t index);
+        void RebuildMru();
+        void MergeOne(const SavedConfig& in, MergeResult& result);
+        void Replace(uint32_t index, const SavedConfig& config);
+
+        std::vector<SavedConfig> configs;
+        std::unordered_map<std::string, uint32_t> index;
+        std::vector<uint32_t> mru;
+        uint64_t generation = 0;
+    };
+}
@@ -1,5 +1,7 @@
 #include "feature_manager.h"
+#include "feature_profiler.h"
 #include "replace_tool.h"
+#include "startup_pipeline.h"
 #include "vs_inspector.h"
 #include "word_reminder.h"
 #include "imgui.h"
@@ -41,12 +43,13 @@ void FeatureManager::Initialize()
     RegisterFeatures();
     LoadState();
     
-    // Initialize all features
+    // Features are initialized lazily: enabled ones start loading here (in the background
+    // when asyncInit is set), disabled ones only when first enabled
     for (auto& feature : features)
     {
-        if (feature.initFunction)
+        if (feature.enabled)
         {
-            feature.initFunction();
+            EnsureLoaded(feature);
         }
     }
 }
@@ -55,59 +58,200 @@ void FeatureManager::Cleanup()
 {
     // Cleanup all features
     SaveState();
+    WaitForPendingInit();
     for (auto& feature : features)
     {
-        if (feature.cleanupFunction)
+        if (feature.loadState == FeatureLoadState::Ready)
         {
-            feature.cleanupFunction();
+            Unload(feature);
         }
     }
 }
 
+void FeatureManager::EnsureLoaded(FeatureInfo& feature)
+{
+    if (feature.loadState != FeatureLoadState::Unloaded) return;
+    if (!feature.initFunction)
+    {
+        feature.loadState = FeatureLoadState::Ready;
+        return;
+    }
+    if (feature.asyncInit)
+    {
+        feature.loadState = FeatureLoadState::Loading;
+        FeatureInfo* target = &feature; // features vector is never resized after registration
+        feature.pendingInit = std::async(std::launch::async, [target]() {
+            Startup::ScopedPhase phase("init:" + target->name);
+            FeatureProfiler::ScopedTimer timer(target->name, FeatureProfiler::Phase::Init);
+            target->initFunction();
+        });
+        ReplaceTool::AppendLog("[feature] 后台初始化: " + feature.name);
+        return;
+    }
+    {
+        Startup::ScopedPhase phase("init:" + feature.name);
+        FeatureProfiler::ScopedTimer timer(feature.name, FeatureProfiler::Phase::Init);
+        feature.initFunction();
+    }
+    feature.loadState = FeatureLoadState::Ready;
+}
+
+void FeatureManager::PollLoading(FeatureInfo& feature)
+{
+    if (feature.loadState != FeatureLoadState::Loading || !feature.pendingInit.valid()) return;
+    if (feature.pendingInit.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+    try
+    {
+        feature.pendingInit.get();
+    }
+    catch (const std::exception& e)
+    {
+        ReplaceTool::AppendLog("[feature] 初始化异常: " + feature.name + " - " + e.what());
+    }
+    feature.loadState = FeatureLoadState::Ready;
+    ReplaceTool::AppendLog("[feature] 初始化完成: " + feature.name);
+}
+
+void FeatureManager::Unload(FeatureInfo& feature)
+{
+    if (feature.cleanupFunction)
+    {
+        FeatureProfiler::ScopedTimer timer(feature.name, FeatureProfiler::Phase::Cleanup);
+        feature.cleanupFunction();
+    }
+    // Features without init keep no lazily created state, so they stay Ready
+    feature.loadState = feature.initFunction ? FeatureLoadState::Unloaded : FeatureLoadState::Ready;
+    feature.disabledSince = {};
+}
+
+void FeatureManager::WaitForPendingInit()
+{
+    for (auto& feature : features)
+    {
+        if (feature.loadState == FeatureLoadState::Loading && feature.pendingInit.valid())
+        {
+            feature.pendingInit.wait();
+            PollLoading(feature);
+        }
+    }
+}
+
+bool FeatureManager::IsFeatureReady(const std::string& name) const
+{
+    for (const auto& feature : features)
+    {
+        if (feature.name == name)
+        {
+            return feature.loadState == FeatureLoadState::Ready;
+        }
+    }
+    return false;
+}
+
+void FeatureManager::DrawLoadingPlaceholder(const FeatureInfo& feature)
+{
+    ImGui::SetNextWindowSize(ImVec2(320, 90), ImGuiCond_FirstUseEver);
+    std::string title = feature.name + "##loading";
+    if (ImGui::Begin(title.c_str(), nullptr, ImGuiWindowFlags_NoCollapse))
+    {
+        static const char spinner[] = "|/-\\";
+        int frame = (int)(ImGui::GetTime() * 8.0) & 3;
+        ImGui::Text("%c 正在加载 %s ...", spinner[frame], feature.name.c_str());
+    }
+    ImGui::End();
+}
+
 void FeatureManager::RegisterFeatures()
 {
     // Register Replace Tool
-    features.push_back({
-        "String Replace Tool",
-        "Replace strings in files and filenames",
-        true,
-        []() { ReplaceTool::DrawReplaceUI(); },
-        nullptr, // No init needed
-        nullptr  // No cleanup needed
-    });
+    {
+        FeatureInfo info;
+        info.name = "String Replace Tool";
+        info.description = "Replace strings in files and filenames";
+        info.enabled = true;
+        info.drawFunction = []() { ReplaceTool::DrawReplaceUI(); };
+        // No init / cleanup needed
+        features.push_back(std::move(info));
+    }
     
-    // Register VS Inspector
-    features.push_back({
-        "Visual Studio Inspector", 
-        "Inspect running Visual Studio instances",
-        true,
-        []() { VSInspector::DrawVSUI(); },
-        nullptr, // No init needed
-        nullptr  // No cleanup needed
-    });
+    // Register VS Inspector (prefs are loaded on a worker thread; refresh has its own worker)
+    {
+        FeatureInfo info;
+        info.name = "Visual Studio Inspector";
+        info.description = "Inspect running Visual Studio instances";
+        info.enabled = true;
+        info.drawFunction = []() { VSInspector::DrawVSUI(); };
+        info.initFunction = []() { VSInspector::Initialize(); };
+        info.cleanupFunction = []() { VSInspector::Cleanup(); };
+        info.asyncInit = true;
+        features.push_back(std::move(info));
+    }
     
-    // Register Word Reminder
-    features.push_back({
-        "单词学习提醒",
-        "英语单词学习定时提醒工具",
-        true,
-        []() { WordReminder::DrawUI(); },
-        []() { WordReminder::Initialize(); },
-        []() { WordReminder::Cleanup(); }
-    });
+    // Register Word Reminder (word file is loaded on a worker thread)
+    {
+        FeatureInfo info;
+        info.name = "单词学习提醒";
+        info.description = "英语单词学习定时提醒工具";
+        info.enabled = true;
+        info.drawFunction = []() { WordReminder::DrawUI(); };
+        info.initFunction = []() { WordReminder::Initialize(); };
+        info.cleanupFunction = []() { WordReminder::Cleanup(); };
+        info.asyncInit = true;
+        features.push_back(std::move(info));
+    }
 }
 
 void FeatureManager::DrawAllFeatures()
 {
+    FeatureProfiler::NewFrame();
+    const auto now = std::chrono::steady_clock::now();
     for (auto& feature : features)
     {
-        if (feature.enabled && feature.drawFunction)
+        // Collect finished async init even when the feature was disabled while loading
+        PollLoading(feature);
+        if (!feature.enabled)
         {
-            feature.drawFunction();
+            // Release state of features that stay disabled for a while
+            if (feature.loadState == FeatureLoadState::Ready && feature.cleanupFunction)
+            {
+                if (feature.disabledSince == std::chrono::steady_clock::time_point{})
+                {
+                    feature.disabledSince = now;
+                }
+                else if (std::chrono::duration<float>(now - feature.disabledSince).count() >= unloadDelaySeconds)
+                {
+                    ReplaceTool::AppendLog("[feature] 长时间未启用，释放: " + feature.name);
+                    Unload(feature);
+                }
+            }
+            continue;
+        }
+        feature.disabledSince = {};
+        
+        EnsureLoaded(feature);
+        if (feature.loadState == FeatureLoadState::Loading)
+        {
+            DrawLoadingPlaceholder(feature);
+            continue;
+        }
+        
+        if (feature.drawFunction)
+        {
+            if (drawHook) drawHook(feature, true);
+            {
+                FeatureProfiler::ScopedTimer timer(feature.name, FeatureProfiler::Phase::Draw);
+                feature.drawFunction();
+            }
+            if (drawHook) drawHook(feature, false);
         }
     }
 }
 
+void FeatureManager::DrawProfiler()
+{
+    FeatureProfiler::DrawOverlay(&showProfiler);
+}
+
 void FeatureManager::EnableFeature(const std::string& name, bool enable)
 {
     for (auto& feature : features)
@@ -115,6 +259,7 @@ void FeatureManager::EnableFeature(const std::string& name, bool enable)
         if (feature.name == name)
         {
             feature.enabled = enable;
+            if (enable) EnsureLoaded(feature);
             SaveState();
             break;
         }
@@ -176,8 +321,7 @@ void FeatureManager::DrawFeatureSelector()
             bool enabled = feature.enabled;
             if (ImGui::Checkbox(feature.name.c_str(), &enabled))
             {
-                feature.enabled = enabled;
-                SaveState();
+                EnableFeature(feature.name, enabled);
             }
             
             // 显示功能描述的工具提示
@@ -194,9 +338,8 @@ void FeatureManager::DrawFeatureSelector()
         {
             for (auto& feature : features)
             {
-                feature.enabled = true;
+                EnableFeature(feature.name, true);
             }
-            SaveState();
         }
         
         ImGui::SameLine();
@@ -205,9 +348,8 @@ void FeatureManager::DrawFeatureSelector()
         {
             for (auto& feature : features)
             {
-                feature.enabled = false;
+                EnableFeature(feature.name, false);
             }
-            SaveState();
         }
         
         ImGui::SameLine();
@@ -244,6 +386,7 @@ void FeatureManager::LoadState()
 
 void FeatureManager::SaveState() const
 {
+    if (!persistState) return;
     const auto path = GetConfigPath();
     std::ofstream ofs(path.string(), std::ios::out | std::ios::binary | std::ios::trunc);
     if (!ofs) return;
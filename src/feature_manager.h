@@ -3,22 +3,42 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <utility>
+#include <chrono>
+#include <future>
 
 // Forward declarations of feature modules
 namespace ReplaceTool { void DrawReplaceUI(); }
 namespace VSInspector { void DrawVSUI(); }
 namespace WordReminder { void DrawUI(); }
 
+// Lifecycle of a feature's resident state (features are initialized lazily)
+enum class FeatureLoadState
+{
+    Unloaded,   // initFunction not run yet (or state released after being disabled)
+    Loading,    // initFunction running on a worker thread
+    Ready       // initialized; drawFunction may run
+};
+
 struct FeatureInfo
 {
     std::string name;
     std::string description;
-    bool enabled;
+    bool enabled = true;
     std::function<void()> drawFunction;
     std::function<void()> initFunction;
     std::function<void()> cleanupFunction;
+    bool asyncInit = false; // run initFunction on a worker thread (must not touch ImGui)
+    
+    // Runtime state, owned by FeatureManager
+    FeatureLoadState loadState = FeatureLoadState::Unloaded;
+    std::future<void> pendingInit;
+    std::chrono::steady_clock::time_point disabledSince{};
 };
 
+// Called around each feature's drawFunction (begin=true before, false after); used by benchmarks
+using FeatureDrawHook = std::function<void(const FeatureInfo&, bool begin)>;
+
 class FeatureManager
 {
 public:
@@ -31,8 +51,19 @@ public:
     // Feature management
     void EnableFeature(const std::string& name, bool enable);
     bool IsFeatureEnabled(const std::string& name);
+    // True once the feature's initFunction has completed (callers outside the draw path must check this)
+    bool IsFeatureReady(const std::string& name) const;
+    // Block until every in-flight background initialization has finished
+    void WaitForPendingInit();
+    // Seconds a disabled feature keeps its state before cleanupFunction releases it
+    void SetUnloadDelay(float seconds) { unloadDelaySeconds = seconds; }
+    // When false, enable/disable changes are not written to feature_state.ini (benchmarks)
+    void SetPersistState(bool persist) { persistState = persist; }
     const std::vector<FeatureInfo>& GetFeatures() const { return features; }
     
+    // Optional observer invoked around every feature draw (pass nullptr to clear)
+    void SetDrawHook(FeatureDrawHook hook) { drawHook = std::move(hook); }
+    
     // Draw feature selection UI
     void DrawFeatureSelector();
     
@@ -46,6 +77,10 @@ public:
     }
     void HideFeatureSelector() { showFeatureSelector = false; }
     bool IsFeatureSelectorVisible() const { return showFeatureSelector; }
+    
+    // Per-feature profiler overlay (timings, percentiles, Chrome trace export)
+    void ShowProfiler() { showProfiler = true; }
+    void DrawProfiler();
 
 private:
     FeatureManager() = default;
@@ -57,7 +92,16 @@ private:
     void LoadState();
     void SaveState() const;
     
+    void EnsureLoaded(FeatureInfo& feature);
+    void PollLoading(FeatureInfo& feature);
+    void Unload(FeatureInfo& feature);
+    static void DrawLoadingPlaceholder(const FeatureInfo& feature);
+    
     std::vector<FeatureInfo> features;
     bool showFeatureSelector = false;
     bool needBringToFront = false;
+    bool showProfiler = false;
+    float unloadDelaySeconds = 120.0f;
+    bool persistState = true;
+    FeatureDrawHook drawHook;
 };
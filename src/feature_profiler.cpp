@@ -0,0 +1,439 @@
+#include "feature_profiler.h"
+#include "replace_tool.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Heap allocation counting (replaces global operator new when enabled at build time).
+// Per thread: worker threads (refresh, samplers, async init, font reads) allocate while the UI
+// thread draws, and must not be charged to the feature being drawn.
+// ---------------------------------------------------------------------------
+static thread_local uint64_t t_allocCount = 0;
+
+#ifdef FEATURE_PROFILER_TRACK_ALLOCS
+void* operator new(std::size_t size)
+{
+    ++t_allocCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+namespace FeatureProfiler
+{
+    using ReplaceTool::AppendLog;
+
+    // Max buffered trace events (oldest are overwritten)
+    static constexpr size_t MAX_TRACE_EVENTS = 65536;
+
+    struct FeatureStats
+    {
+        std::string name;
+        std::array<float, HISTORY_SIZE> drawMs{};
+        std::array<int, HISTORY_SIZE> vertices{};
+        std::array<uint32_t, HISTORY_SIZE> allocs{};
+        int head = 0;   // next write slot
+        int count = 0;  // valid samples
+
+        // Bar of the frame being built / last completed frame (for the flame view)
+        int64_t curStartUs = 0, curDurUs = 0; int curFrame = -1;
+        int64_t lastStartUs = 0, lastDurUs = 0; bool hasLast = false;
+
+        double initMs = -1.0;
+        double cleanupMs = -1.0;
+    };
+
+    struct TraceEvent
+    {
+        int featureIndex; // -1 = frame marker
+        Phase phase;
+        int64_t tsUs;
+        int64_t durUs;
+        uint32_t tid;
+    };
+
+    static std::mutex g_mutex;
+    static std::atomic<bool> g_enabled{true};
+    static std::vector<FeatureStats> g_stats;
+    static std::vector<TraceEvent> g_events;
+    static size_t g_eventHead = 0;
+    static bool g_eventsWrapped = false;
+
+    static int g_frameIndex = 0;
+    static int64_t g_frameStartUs = 0;
+    static int64_t g_lastFrameStartUs = 0;
+    static int64_t g_lastFrameDurUs = 0;
+    static uint64_t g_frameAllocs0 = 0;
+    static std::array<float, HISTORY_SIZE> g_frameMs{};
+    static std::array<uint32_t, HISTORY_SIZE> g_frameAllocs{};
+    static int g_frameHead = 0;
+    static int g_frameCount = 0;
+
+    static int64_t NowUs()
+    {
+        static const auto origin = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    static uint32_t ThreadTag()
+    {
+        return (uint32_t)(std::hash<std::thread::id>{}(std::this_thread::get_id()) & 0xFFFF);
+    }
+
+    // Sum of vertices already emitted into all window draw lists this frame
+    static int CountLiveVertices()
+    {
+        ImGuiContext* ctx = ImGui::GetCurrentContext();
+        if (!ctx) return 0;
+        int total = 0;
+        for (ImGuiWindow* w : ctx->Windows)
+        {
+            if (w && w->DrawList) total += w->DrawList->VtxBuffer.Size;
+        }
+        return total;
+    }
+
+    // Caller holds g_mutex
+    static int FindOrAddFeature(const std::string& name)
+    {
+        for (size_t i = 0; i < g_stats.size(); ++i)
+        {
+            if (g_stats[i].name == name) return (int)i;
+        }
+        g_stats.emplace_back();
+        g_stats.back().name = name;
+        return (int)g_stats.size() - 1;
+    }
+
+    // Caller holds g_mutex
+    static void PushEvent(const TraceEvent& ev)
+    {
+        if (g_events.capacity() < MAX_TRACE_EVENTS) g_events.reserve(MAX_TRACE_EVENTS);
+        if (g_events.size() < MAX_TRACE_EVENTS)
+        {
+            g_events.push_back(ev);
+            return;
+        }
+        g_events[g_eventHead] = ev;
+        g_eventHead = (g_eventHead + 1) % MAX_TRACE_EVENTS;
+        g_eventsWrapped = true;
+    }
+
+    template <typename T>
+    static float PercentileOf(const std::array<T, HISTORY_SIZE>& ring, int count, float p)
+    {
+        if (count <= 0) return 0.0f;
+        std::array<float, HISTORY_SIZE> tmp;
+        for (int i = 0; i < count; ++i) tmp[i] = (float)ring[i];
+        int k = std::clamp((int)(p * (float)(count - 1) + 0.5f), 0, count - 1);
+        std::nth_element(tmp.begin(), tmp.begin() + k, tmp.begin() + count);
+        return tmp[k];
+    }
+
+    ScopedTimer::ScopedTimer(const std::string& feature, Phase phase)
+        : feature(feature), phase(phase), active(g_enabled.load()), startUs(0), vertices0(0), allocs0(0)
+    {
+        if (!active) return;
+        if (phase == Phase::Draw)
+        {
+            vertices0 = CountLiveVertices();
+            allocs0 = t_allocCount;
+        }
+        startUs = NowUs();
+    }
+
+    ScopedTimer::~ScopedTimer()
+    {
+        if (!active) return;
+        int64_t endUs = NowUs();
+        int vertices = 0;
+        uint32_t allocs = 0;
+        if (phase == Phase::Draw)
+        {
+            vertices = CountLiveVertices() - vertices0;
+            allocs = (uint32_t)(t_allocCount - allocs0);
+        }
+
+        std::lock_guard<std::mutex> lock(g_mutex);
+        int idx = FindOrAddFeature(feature);
+        FeatureStats& s = g_stats[idx];
+        double ms = (double)(endUs - startUs) / 1000.0;
+        switch (phase)
+        {
+            case Phase::Init: s.initMs = ms; break;
+            case Phase::Cleanup: s.cleanupMs = ms; break;
+            case Phase::Draw:
+                s.drawMs[s.head] = (float)ms;
+                s.vertices[s.head] = vertices;
+                s.allocs[s.head] = allocs;
+                s.head = (s.head + 1) % HISTORY_SIZE;
+                s.count = std::min(s.count + 1, HISTORY_SIZE);
+                s.curStartUs = startUs;
+                s.curDurUs = endUs - startUs;
+                s.curFrame = g_frameIndex;
+                break;
+        }
+        PushEvent({ idx, phase, startUs, endUs - startUs, ThreadTag() });
+    }
+
+    void NewFrame()
+    {
+        if (!g_enabled) return;
+        int64_t now = NowUs();
+        uint64_t allocs = t_allocCount;
+
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_frameStartUs != 0)
+        {
+            g_lastFrameStartUs = g_frameStartUs;
+            g_lastFrameDurUs = now - g_frameStartUs;
+            g_frameMs[g_frameHead] = (float)g_lastFrameDurUs / 1000.0f;
+            g_frameAllocs[g_frameHead] = (uint32_t)(allocs - g_frameAllocs0);
+            g_frameHead = (g_frameHead + 1) % HISTORY_SIZE;
+            g_frameCount = std::min(g_frameCount + 1, HISTORY_SIZE);
+            PushEvent({ -1, Phase::Draw, g_frameStartUs, g_lastFrameDurUs, ThreadTag() });
+
+            for (auto& s : g_stats)
+            {
+                s.hasLast = (s.curFrame == g_frameIndex);
+                s.lastStartUs = s.curStartUs;
+                s.lastDurUs = s.curDurUs;
+            }
+        }
+        ++g_frameIndex;
+        g_frameStartUs = now;
+        g_frameAllocs0 = allocs;
+    }
+
+    void SetEnabled(bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_enabled = enabled;
+        if (!enabled) g_frameStartUs = 0;
+    }
+
+    bool IsEnabled()
+    {
+        return g_enabled;
+    }
+
+    uint64_t GetAllocationCount()
+    {
+        return t_allocCount;
+    }
+
+    static const char* PhaseName(Phase phase)
+    {
+        switch (phase)
+        {
+            case Phase::Init: return "init";
+            case Phase::Cleanup: return "cleanup";
+            default: return "draw";
+        }
+    }
+
+    static void WriteJsonString(std::ofstream& ofs, const std::string& s)
+    {
+        ofs << '"';
+        for (char c : s)
+        {
+            switch (c)
+            {
+                case '"': ofs << "\\\""; break;
+                case '\\': ofs << "\\\\"; break;
+                case '\n': ofs << "\\n"; break;
+                case '\r': ofs << "\\r"; break;
+                case '\t': ofs << "\\t"; break;
+                default:
+                    if ((unsigned char)c < 0x20) { char buf[8]; std::snprintf(buf, sizeof(buf), "\\u%04x", c); ofs << buf; }
+                    else ofs << c;
+            }
+        }
+        ofs << '"';
+    }
+
+    bool ExportChromeTrace(const std::string& path)
+    {
+        std::vector<TraceEvent> events;
+        std::vector<std::string> names;
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            events.reserve(g_events.size());
+            if (g_eventsWrapped)
+            {
+                events.insert(events.end(), g_events.begin() + (long)g_eventHead, g_events.end());
+                events.insert(events.end(), g_events.begin(), g_events.begin() + (long)g_eventHead);
+            }
+            else
+            {
+                events = g_events;
+            }
+            for (const auto& s : g_stats) names.push_back(s.name);
+        }
+
+        std::ofstream ofs(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!ofs)
+        {
+            AppendLog("[profiler] 无法写入 trace 文件: " + path);
+            return false;
+        }
+        ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        for (const auto& ev : events)
+        {
+            if (!first) ofs << ",\n";
+            first = false;
+            ofs << "{\"name\":";
+            WriteJsonString(ofs, ev.featureIndex < 0 ? std::string("Frame") : names[ev.featureIndex]);
+            ofs << ",\"cat\":\"" << (ev.featureIndex < 0 ? "frame" : PhaseName(ev.phase)) << "\""
+                << ",\"ph\":\"X\",\"ts\":" << ev.tsUs << ",\"dur\":" << ev.durUs
+                << ",\"pid\":1,\"tid\":" << ev.tid << "}";
+        }
+        ofs << "\n]}\n";
+        ofs.close();
+        if (!ofs)
+        {
+            AppendLog("[profiler] 写入 trace 文件失败: " + path);
+            return false;
+        }
+        AppendLog("[profiler] 已导出 " + std::to_string(events.size()) + " 个事件到 " + path);
+        return true;
+    }
+
+    static ImU32 BarColor(int index)
+    {
+        static const ImU32 palette[] = {
+            IM_COL32(66, 150, 250, 255), IM_COL32(250, 170, 60, 255), IM_COL32(90, 200, 120, 255),
+            IM_COL32(220, 90, 110, 255), IM_COL32(170, 120, 230, 255), IM_COL32(80, 200, 210, 255),
+        };
+        return palette[index % (int)(sizeof(palette) / sizeof(palette[0]))];
+    }
+
+    void DrawOverlay(bool* open)
+    {
+        if (open && !*open) return;
+
+        ImGui::SetNextWindowSize(ImVec2(720, 460), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Feature Profiler", open))
+        {
+            ImGui::End();
+            return;
+        }
+
+        bool enabled = g_enabled.load();
+        if (ImGui::Checkbox("Recording", &enabled)) SetEnabled(enabled);
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome Trace"))
+        {
+            ExportChromeTrace("feature_trace.json");
+        }
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("写入 feature_trace.json，可在 chrome://tracing 或 Perfetto 中打开");
+
+        std::lock_guard<std::mutex> lock(g_mutex);
+
+        ImGui::Text("Frame: %.2f ms (p50 %.2f / p95 %.2f / p99 %.2f)  allocs/frame: %u",
+                    (float)g_lastFrameDurUs / 1000.0f,
+                    PercentileOf(g_frameMs, g_frameCount, 0.50f),
+                    PercentileOf(g_frameMs, g_frameCount, 0.95f),
+                    PercentileOf(g_frameMs, g_frameCount, 0.99f),
+                    g_frameCount > 0 ? g_frameAllocs[(g_frameHead + HISTORY_SIZE - 1) % HISTORY_SIZE] : 0u);
+#ifndef FEATURE_PROFILER_TRACK_ALLOCS
+        ImGui::SameLine();
+        ImGui::TextDisabled("(allocation tracking disabled at build time)");
+#endif
+
+        // Flame-style view of the last completed frame: frame bar on top, feature bars beneath
+        {
+            const float rowH = ImGui::GetTextLineHeight() + 4.0f;
+            const float width = std::max(100.0f, ImGui::GetContentRegionAvail().x);
+            ImVec2 origin = ImGui::GetCursorScreenPos();
+            ImDrawList* dl = ImGui::GetWindowDrawList();
+            const double span = (double)std::max<int64_t>(1, g_lastFrameDurUs);
+
+            dl->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + rowH), IM_COL32(70, 70, 80, 255));
+            char label[128];
+            std::snprintf(label, sizeof(label), "Frame %.2f ms", (float)g_lastFrameDurUs / 1000.0f);
+            dl->AddText(ImVec2(origin.x + 4, origin.y + 2), IM_COL32(255, 255, 255, 255), label);
+
+            for (size_t i = 0; i < g_stats.size(); ++i)
+            {
+                const FeatureStats& s = g_stats[i];
+                if (!s.hasLast) continue;
+                float x0 = origin.x + (float)((double)(s.lastStartUs - g_lastFrameStartUs) / span * width);
+                float x1 = x0 + std::max(2.0f, (float)((double)s.lastDurUs / span * width));
+                ImVec2 a(x0, origin.y + rowH), b(x1, origin.y + rowH * 2.0f);
+                dl->AddRectFilled(a, b, BarColor((int)i));
+                dl->PushClipRect(a, b, true);
+                std::snprintf(label, sizeof(label), "%s %.2f ms", s.name.c_str(), (float)s.lastDurUs / 1000.0f);
+                dl->AddText(ImVec2(x0 + 3, a.y + 2), IM_COL32(0, 0, 0, 255), label);
+                dl->PopClipRect();
+            }
+            ImGui::Dummy(ImVec2(width, rowH * 2.0f + 4.0f));
+        }
+
+        if (ImGui::BeginTable("ProfilerTable", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+        {
+            ImGui::TableSetupColumn("Feature");
+            ImGui::TableSetupColumn("last ms");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("vtx");
+            ImGui::TableSetupColumn("allocs");
+            ImGui::TableSetupColumn("init ms");
+            ImGui::TableSetupColumn("cleanup ms");
+            ImGui::TableHeadersRow();
+            for (size_t i = 0; i < g_stats.size(); ++i)
+            {
+                const FeatureStats& s = g_stats[i];
+                int last = (s.head + HISTORY_SIZE - 1) % HISTORY_SIZE;
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(BarColor((int)i)), "%s", s.name.c_str());
+                ImGui::TableSetColumnIndex(1); ImGui::Text("%.3f", s.count ? s.drawMs[last] : 0.0f);
+                ImGui::TableSetColumnIndex(2); ImGui::Text("%.3f", PercentileOf(s.drawMs, s.count, 0.50f));
+                ImGui::TableSetColumnIndex(3); ImGui::Text("%.3f", PercentileOf(s.drawMs, s.count, 0.95f));
+                ImGui::TableSetColumnIndex(4); ImGui::Text("%.3f", PercentileOf(s.drawMs, s.count, 0.99f));
+                ImGui::TableSetColumnIndex(5); ImGui::Text("%d", s.count ? s.vertices[last] : 0);
+                ImGui::TableSetColumnIndex(6); ImGui::Text("%u", s.count ? s.allocs[last] : 0u);
+                ImGui::TableSetColumnIndex(7);
+                if (s.initMs >= 0.0) ImGui::Text("%.2f", s.initMs); else ImGui::TextDisabled("-");
+                ImGui::TableSetColumnIndex(8);
+                if (s.cleanupMs >= 0.0) ImGui::Text("%.2f", s.cleanupMs); else ImGui::TextDisabled("-");
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::CollapsingHeader("History"))
+        {
+            for (const auto& s : g_stats)
+            {
+                if (s.count == 0) continue;
+                // Ring buffer is passed with values_offset so the plot scrolls oldest -> newest
+                int offset = (s.count < HISTORY_SIZE) ? 0 : s.head;
+                ImGui::PlotLines(s.name.c_str(), s.drawMs.data(), s.count, offset, nullptr, 0.0f, FLT_MAX, ImVec2(0, 40));
+            }
+        }
+
+        ImGui::End();
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Lightweight per-feature CPU profiler used by FeatureManager.
+// Records init/draw/cleanup durations, keeps a ring-buffered draw history per feature
+// (with percentiles), draw-list vertex counts and heap allocations, and can export a
+// Chrome trace (chrome://tracing / Perfetto) JSON file.
+namespace FeatureProfiler
+{
+    enum class Phase { Init, Draw, Cleanup };
+
+    // Number of frames kept in each feature's draw history
+    constexpr int HISTORY_SIZE = 240;
+
+    // RAII timer: measures the enclosing scope and records it against a feature/phase.
+    // Draw scopes also capture draw-list vertex and heap allocation deltas.
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(const std::string& feature, Phase phase);
+        ~ScopedTimer();
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        const std::string& feature;
+        Phase phase;
+        bool active;
+        int64_t startUs;
+        int vertices0;
+        uint64_t allocs0;
+    };
+
+    // Mark the start of a UI frame (call once per frame before any feature draws)
+    void NewFrame();
+
+    // Enable/disable recording (disabled recording costs one branch per scope)
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    // Heap allocations made by the calling thread so far (0 when allocation tracking is compiled
+    // out with FEATURE_PROFILER_TRACK_ALLOCS undefined)
+    uint64_t GetAllocationCount();
+
+    // Write all buffered trace events to a Chrome trace JSON file; returns false on I/O failure
+    bool ExportChromeTrace(const std::string& path);
+
+    // Draw the profiler overlay window (flame-style bars, percentiles, history)
+    void DrawOverlay(bool* open);
+}
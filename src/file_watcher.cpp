@@ -0,0 +1,374 @@
+#include "file_watcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace FileWatcher
+{
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr double kPollIntervalMs = 1000.0;
+
+    struct Signature
+    {
+        bool exists = false;
+        uintmax_t size = 0;
+        fs::file_time_type mtime{};
+
+        bool operator==(const Signature& o) const { return exists == o.exists && size == o.size && mtime == o.mtime; }
+        bool operator!=(const Signature& o) const { return !(*this == o); }
+    };
+
+    static Signature Stat(const fs::path& file)
+    {
+        Signature sig;
+        std::error_code ec;
+        auto size = fs::file_size(file, ec);
+        if (ec) return sig;
+        auto mtime = fs::last_write_time(file, ec);
+        if (ec) return sig;
+        sig.exists = true;
+        sig.size = size;
+        sig.mtime = mtime;
+        return sig;
+    }
+
+    // One per watched directory, shared by the files in it
+    struct Directory
+    {
+        fs::path path;
+        int refs = 0;
+        bool polled = false;                // no OS notifications: stat the files every kPollIntervalMs
+        Clock::time_point lastPoll;
+#ifdef _WIN32
+        HANDLE handle = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped{};
+        std::unique_ptr<DWORD[]> buffer;   // DWORD-aligned as FILE_NOTIFY_INFORMATION requires
+        static constexpr DWORD kBufferBytes = 16 * 1024;
+#elif defined(__linux__)
+        int wd = -1;
+#endif
+    };
+
+    struct WatchEntry
+    {
+        Id id = 0;
+        fs::path file;
+        fs::path dir;
+        Callback onChange;
+        Signature synced;      // the owner's version
+        Signature lastPolled;  // polled directories only
+        bool pending = false;
+        Clock::time_point lastEvent;
+        Stats stats;
+    };
+
+    static std::vector<std::unique_ptr<Directory>> g_dirs;
+    static std::vector<WatchEntry> g_watches;
+    static Id g_nextId = 0;
+#if defined(__linux__)
+    static int g_inotify = -1;
+#endif
+
+    static const char* BackendName(const Directory& d)
+    {
+        if (d.polled) return "poll";
+#ifdef _WIN32
+        return "ReadDirectoryChangesW";
+#elif defined(__linux__)
+        return "inotify";
+#else
+        return "poll";
+#endif
+    }
+
+    static Directory* FindDir(const fs::path& path)
+    {
+        for (auto& d : g_dirs)
+        {
+            if (d->path == path) return d.get();
+        }
+        return nullptr;
+    }
+
+    static void MarkPending(const fs::path& dir, const fs::path* name)
+    {
+        const auto now = Clock::now();
+        for (WatchEntry& w : g_watches)
+        {
+            if (w.dir != dir) continue;
+            if (name && w.file.filename() != *name) continue;
+            w.pending = true;
+            w.lastEvent = now;
+            w.stats.events++;
+        }
+    }
+
+#ifdef _WIN32
+    static bool IssueRead(Directory& d)
+    {
+        ResetEvent(d.overlapped.hEvent);
+        return ReadDirectoryChangesW(d.handle, d.buffer.get(), Directory::kBufferBytes, FALSE,
+                                     FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+                                     nullptr, &d.overlapped, nullptr) != FALSE;
+    }
+
+    static bool OpenDir(Directory& d)
+    {
+        d.handle = CreateFileW(d.path.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (d.handle == INVALID_HANDLE_VALUE) return false;
+        d.overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        d.buffer.reset(new DWORD[Directory::kBufferBytes / sizeof(DWORD)]);
+        if (d.overlapped.hEvent && IssueRead(d)) return true;
+        if (d.overlapped.hEvent) CloseHandle(d.overlapped.hEvent);
+        CloseHandle(d.handle);
+        d.handle = INVALID_HANDLE_VALUE;
+        return false;
+    }
+
+    static void CloseDir(Directory& d)
+    {
+        if (d.handle == INVALID_HANDLE_VALUE) return;
+        CancelIoEx(d.handle, &d.overlapped);
+        DWORD bytes = 0;
+        GetOverlappedResult(d.handle, &d.overlapped, &bytes, TRUE);
+        CloseHandle(d.overlapped.hEvent);
+        CloseHandle(d.handle);
+        d.handle = INVALID_HANDLE_VALUE;
+    }
+
+    static void DrainDir(Directory& d)
+    {
+        if (d.handle == INVALID_HANDLE_VALUE || !HasOverlappedIoCompleted(&d.overlapped)) return;
+        DWORD bytes = 0;
+        if (!GetOverlappedResult(d.handle, &d.overlapped, &bytes, FALSE) || bytes == 0)
+        {
+            // Buffer overflow (or a failed read): we no longer know which files changed
+            MarkPending(d.path, nullptr);
+        }
+        else
+        {
+            const BYTE* p = reinterpret_cast<const BYTE*>(d.buffer.get());
+            for (;;)
+            {
+                const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(p);
+                fs::path name(std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+                MarkPending(d.path, &name);
+                if (info->NextEntryOffset == 0) break;
+                p += info->NextEntryOffset;
+            }
+        }
+        if (!IssueRead(d))
+        {
+            CloseDir(d);
+            d.polled = true;
+        }
+    }
+#elif defined(__linux__)
+    static bool OpenDir(Directory& d)
+    {
+        if (g_inotify < 0) g_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (g_inotify < 0) return false;
+        d.wd = inotify_add_watch(g_inotify, d.path.c_str(),
+                                 IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM);
+        return d.wd >= 0;
+    }
+
+    static void CloseDir(Directory& d)
+    {
+        if (d.wd >= 0 && g_inotify >= 0) inotify_rm_watch(g_inotify, d.wd);
+        d.wd = -1;
+    }
+
+    static void DrainInotify()
+    {
+        if (g_inotify < 0) return;
+        alignas(struct inotify_event) char buf[16 * 1024];
+        for (;;)
+        {
+            ssize_t n = read(g_inotify, buf, sizeof(buf));
+            if (n <= 0) break;  // EAGAIN: nothing left
+            for (char* p = buf; p < buf + n;)
+            {
+                const struct inotify_event* ev = reinterpret_cast<const struct inotify_event*>(p);
+                p += sizeof(struct inotify_event) + ev->len;
+                if (ev->mask & IN_Q_OVERFLOW)
+                {
+                    for (auto& d : g_dirs) MarkPending(d->path, nullptr);
+                    continue;
+                }
+                for (auto& d : g_dirs)
+                {
+                    if (d->wd != ev->wd) continue;
+                    if (ev->len > 0)
+                    {
+                        fs::path name(ev->name);
+                        MarkPending(d->path, &name);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+#else
+    static bool OpenDir(Directory&) { return false; }
+    static void CloseDir(Directory&) {}
+#endif
+
+    static void PollDir(Directory& d, Clock::time_point now)
+    {
+        if (std::chrono::duration<double, std::milli>(now - d.lastPoll).count() < kPollIntervalMs) return;
+        d.lastPoll = now;
+        for (WatchEntry& w : g_watches)
+        {
+            if (w.dir != d.path) continue;
+            Signature sig = Stat(w.file);
+            if (sig == w.lastPolled) continue;
+            w.lastPolled = sig;
+            w.pending = true;
+            w.lastEvent = now;
+            w.stats.events++;
+        }
+    }
+
+    Id Watch(const fs::path& file, Callback onChange)
+    {
+        std::error_code ec;
+        fs::path abs = fs::absolute(file, ec);
+        if (ec || !onChange) return 0;
+        abs = abs.lexically_normal();
+
+        WatchEntry w;
+        w.id = ++g_nextId;
+        w.file = abs;
+        w.dir = abs.parent_path();
+        w.onChange = std::move(onChange);
+        w.synced = w.lastPolled = Stat(abs);
+        w.stats.file = abs.filename().u8string();
+
+        Directory* d = FindDir(w.dir);
+        if (!d)
+        {
+            auto created = std::make_unique<Directory>();
+            created->path = w.dir;
+            created->lastPoll = Clock::now();
+            if (!OpenDir(*created)) created->polled = true;
+            d = created.get();
+            g_dirs.push_back(std::move(created));
+        }
+        d->refs++;
+        w.stats.backend = BackendName(*d);
+        g_watches.push_back(std::move(w));
+        return g_watches.back().id;
+    }
+
+    void Unwatch(Id id)
+    {
+        if (id == 0) return;
+        auto it = std::find_if(g_watches.begin(), g_watches.end(), [id](const WatchEntry& w) { return w.id == id; });
+        if (it == g_watches.end()) return;
+        const fs::path dir = it->dir;
+        g_watches.erase(it);
+        for (size_t i = 0; i < g_dirs.size(); ++i)
+        {
+            if (g_dirs[i]->path != dir) continue;
+            if (--g_dirs[i]->refs == 0)
+            {
+                CloseDir(*g_dirs[i]);
+                g_dirs.erase(g_dirs.begin() + i);
+            }
+            break;
+        }
+    }
+
+    void MarkSynced(Id id)
+    {
+        if (id == 0) return;
+        for (WatchEntry& w : g_watches)
+        {
+            if (w.id != id) continue;
+            w.synced = w.lastPolled = Stat(w.file);
+            return;
+        }
+    }
+
+    bool ChangedSinceSync(Id id)
+    {
+        if (id == 0) return false;
+        for (const WatchEntry& w : g_watches)
+        {
+            if (w.id == id) return Stat(w.file) != w.synced;
+        }
+        return false;
+    }
+
+    void Pump()
+    {
+        if (g_watches.empty()) return;
+        const auto now = Clock::now();
+#if defined(__linux__)
+        DrainInotify();
+#endif
+        for (auto& d : g_dirs)
+        {
+#ifdef _WIN32
+            if (!d->polled) DrainDir(*d);
+#endif
+            if (d->polled) PollDir(*d, now);
+        }
+
+        // Callbacks may add or remove watches: collect first, run after the loop
+        std::vector<std::pair<Callback, fs::path>> due;
+        for (WatchEntry& w : g_watches)
+        {
+            if (!w.pending) continue;
+            if (std::chrono::duration<double, std::milli>(now - w.lastEvent).count() < kDebounceMs) continue;
+            w.pending = false;
+            Signature sig = Stat(w.file);
+            if (sig == w.synced)
+            {
+                w.stats.ownWrites++;
+                continue;
+            }
+            w.synced = w.lastPolled = sig;
+            w.stats.changes++;
+            due.emplace_back(w.onChange, w.file);
+        }
+        for (auto& [callback, file] : due) callback(file);
+    }
+
+    std::vector<Stats> GetStats()
+    {
+        std::vector<Stats> out;
+        out.reserve(g_watches.size());
+        for (const WatchEntry& w : g_watches) out.push_back(w.stats);
+        return out;
+    }
+
+    void Shutdown()
+    {
+        g_watches.clear();
+        for (auto& d : g_dirs) CloseDir(*d);
+        g_dirs.clear();
+#if defined(__linux__)
+        if (g_inotify >= 0) close(g_inotify);
+        g_inotify = -1;
+#endif
+    }
+}
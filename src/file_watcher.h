@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Notices files being changed by someone else (a sync client, another instance) so their owners
+// can merge the new contents in. Each watched file's directory is watched (inotify on Linux,
+// overlapped ReadDirectoryChangesW on Windows, a 1 s stat poll elsewhere) because atomic saves
+// replace the file by renaming over it. Events are drained without blocking in Pump(); a file's
+// callback runs once it has been quiet for kDebounceMs and its size/mtime differ from the last
+// version its owner read or wrote (MarkSynced), so the owner's own saves do not come back as
+// changes. Everything runs on the UI thread: features whose Initialize() runs on a worker
+// register their watches from their first UI-thread call instead.
+namespace FileWatcher
+{
+    constexpr double kDebounceMs = 500.0;
+
+    using Id = uint64_t;
+    using Callback = std::function<void(const std::filesystem::path& file)>;
+
+    // Watch `file` (it need not exist yet); its current size/mtime count as synced. 0 on failure.
+    // The functions taking an Id do nothing for 0.
+    Id Watch(const std::filesystem::path& file, Callback onChange);
+    void Unwatch(Id id);
+
+    // Record the file's current size/mtime as the owner's own version: call after reading or
+    // writing it
+    void MarkSynced(Id id);
+
+    // True if the file on disk is no longer the version last marked synced, i.e. someone else
+    // wrote it and the callback has not run yet. Check before overwriting the file.
+    bool ChangedSinceSync(Id id);
+
+    // Drain change events and run the callbacks that are due; call once per frame
+    void Pump();
+
+    struct Stats
+    {
+        std::string file;
+        uint64_t events = 0;       // raw notifications for this file
+        uint64_t changes = 0;      // callbacks run
+        uint64_t ownWrites = 0;    // settled on a version the owner had marked synced
+        const char* backend = "";
+    };
+    std::vector<Stats> GetStats();
+
+    // Remove all watches and close the OS handles
+    void Shutdown();
+}
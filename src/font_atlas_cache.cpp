@@ -0,0 +1,371 @@
+#include "font_atlas_cache.h"
+#include "replace_tool.h"
+#include "imgui.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace FontAtlasCache
+{
+    using ReplaceTool::AppendLog;
+
+    static const char kMagic[4] = { 'I', 'M', 'F', 'C' };
+    static const uint32_t kFormatVersion = 1;
+
+    // File layout (native endianness, the cache never leaves the machine):
+    //   Header | TexUvLines[uvLineCount] | RectRecord[customRectCount] | fonts... | alpha8 pixels[texWidth * texHeight]
+    //   font = FontRecord | GlyphRecord[glyphCount]
+    struct Header
+    {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t imguiVersion;
+        uint32_t texWidth;
+        uint32_t texHeight;
+        uint64_t sourcesKey;
+        uint64_t layoutKey;
+        float uvWhiteX, uvWhiteY;
+        int32_t packIdMouseCursors;
+        int32_t packIdLines;
+        uint32_t customRectCount;
+        uint32_t fontCount;
+        int32_t defaultFontIndex;
+        uint32_t uvLineCount;
+    };
+
+    struct RectRecord
+    {
+        uint16_t width, height, x, y;
+    };
+
+    struct FontRecord
+    {
+        float fontSize, ascent, descent;
+        uint32_t fallbackChar, ellipsisChar;
+        uint32_t glyphCount;
+    };
+
+    struct GlyphRecord
+    {
+        uint32_t codepoint;
+        uint32_t colored;
+        float advanceX, x0, y0, x1, y1, u0, v0, u1, v1;
+    };
+
+    uint64_t Hash(const void* data, size_t size, uint64_t seed)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint64_t h = seed;
+        for (size_t i = 0; i < size; ++i)
+        {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    // ---------------------------------------------------------------------
+    // MappedFile
+    // ---------------------------------------------------------------------
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this == &other) return *this;
+        Close();
+        data = other.data; size = other.size;
+        other.data = nullptr; other.size = 0;
+#ifdef _WIN32
+        fileHandle = other.fileHandle; mappingHandle = other.mappingHandle;
+        other.fileHandle = nullptr; other.mappingHandle = nullptr;
+#endif
+        return *this;
+    }
+
+    bool MappedFile::Open(const fs::path& path)
+    {
+        Close();
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        fileHandle = file;
+        mappingHandle = mapping;
+        data = static_cast<const unsigned char*>(view);
+        size = (size_t)fileSize.QuadPart;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping keeps the file referenced
+        if (view == MAP_FAILED) return false;
+        data = static_cast<const unsigned char*>(view);
+        size = (size_t)st.st_size;
+#endif
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (!data) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle) CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<unsigned char*>(data), size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    // ---------------------------------------------------------------------
+    // Cache file
+    // ---------------------------------------------------------------------
+    fs::path GetCachePath()
+    {
+        std::error_code ec;
+        fs::path dir;
+#ifdef _WIN32
+        wchar_t exePathW[MAX_PATH] = {0};
+        if (GetModuleFileNameW(NULL, exePathW, MAX_PATH) > 0)
+            dir = fs::path(exePathW).parent_path();
+#endif
+        if (dir.empty()) dir = fs::current_path(ec);
+        if (ec) return fs::path("font_atlas.cache");
+        return dir / "font_atlas.cache";
+    }
+
+    // Bounds-checked sequential reader over the mapping
+    struct Reader
+    {
+        const unsigned char* p;
+        const unsigned char* end;
+
+        template <typename T>
+        bool Read(T& out)
+        {
+            if ((size_t)(end - p) < sizeof(T)) return false;
+            std::memcpy(&out, p, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+    };
+
+    static bool ReadHeader(const MappedFile& file, Header& header)
+    {
+        if (!file.IsOpen() || file.Size() < sizeof(Header)) return false;
+        std::memcpy(&header, file.Data(), sizeof(Header));
+        return std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+               header.formatVersion == kFormatVersion &&
+               header.imguiVersion == (uint32_t)IMGUI_VERSION_NUM;
+    }
+
+    bool MatchesSources(const MappedFile& file, uint64_t sourcesKey)
+    {
+        Header header;
+        return ReadHeader(file, header) && header.sourcesKey == sourcesKey;
+    }
+
+#if IMGUI_VERSION_NUM < 19200
+    bool Load(ImFontAtlas* atlas, const MappedFile& file, const Key& key, int* defaultFontIndex)
+    {
+        if (defaultFontIndex) *defaultFontIndex = -1;
+        Header header;
+        if (!ReadHeader(file, header) || header.sourcesKey != key.sources || header.layoutKey != key.layout) return false;
+        if (header.uvLineCount != (uint32_t)IM_ARRAYSIZE(atlas->TexUvLines)) return false;
+
+        const size_t pixelBytes = (size_t)header.texWidth * header.texHeight;
+        if (pixelBytes == 0 || pixelBytes > file.Size() - sizeof(Header)) return false;
+        Reader reader{ file.Data() + sizeof(Header), file.Data() + file.Size() - pixelBytes };
+
+        atlas->Clear();
+        bool ok = true;
+        for (uint32_t i = 0; i < header.uvLineCount && ok; ++i)
+        {
+            ok = reader.Read(atlas->TexUvLines[i]);
+        }
+        for (uint32_t i = 0; i < header.customRectCount && ok; ++i)
+        {
+            RectRecord rec;
+            ok = reader.Read(rec);
+            if (!ok) break;
+            ImFontAtlasCustomRect rect;
+            rect.Width = rec.width; rect.Height = rec.height; rect.X = rec.x; rect.Y = rec.y;
+            atlas->CustomRects.push_back(rect);
+        }
+        for (uint32_t f = 0; f < header.fontCount && ok; ++f)
+        {
+            FontRecord rec;
+            ok = reader.Read(rec);
+            if (!ok) break;
+            ImFont* font = IM_NEW(ImFont)();
+            atlas->Fonts.push_back(font);
+            font->ContainerAtlas = atlas;
+            font->FontSize = rec.fontSize;
+            font->Ascent = rec.ascent;
+            font->Descent = rec.descent;
+            font->FallbackChar = (ImWchar)rec.fallbackChar;
+            font->EllipsisChar = (ImWchar)rec.ellipsisChar;
+            font->Glyphs.reserve((int)rec.glyphCount);
+            for (uint32_t g = 0; g < rec.glyphCount && ok; ++g)
+            {
+                GlyphRecord glyph;
+                ok = reader.Read(glyph);
+                if (!ok) break;
+                // Coordinates are stored post-config (offsets/advance clamps applied), so no cfg here
+                font->AddGlyph(nullptr, (ImWchar)glyph.codepoint, glyph.x0, glyph.y0, glyph.x1, glyph.y1,
+                               glyph.u0, glyph.v0, glyph.u1, glyph.v1, glyph.advanceX);
+                font->Glyphs[font->Glyphs.Size - 1].Colored = glyph.colored ? 1 : 0;
+            }
+            if (ok) font->BuildLookupTable();
+        }
+        if (!ok || reader.p != reader.end)
+        {
+            AppendLog("[font] atlas cache is truncated or corrupt, rebuilding");
+            atlas->Clear();
+            return false;
+        }
+
+        // ImGui owns the pixels (freed by ClearTexData); copy out of the mapping
+        atlas->TexWidth = (int)header.texWidth;
+        atlas->TexHeight = (int)header.texHeight;
+        atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+        atlas->TexUvWhitePixel = ImVec2(header.uvWhiteX, header.uvWhiteY);
+        atlas->PackIdMouseCursors = header.packIdMouseCursors;
+        atlas->PackIdLines = header.packIdLines;
+        atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(pixelBytes);
+        std::memcpy(atlas->TexPixelsAlpha8, reader.end, pixelBytes);
+        atlas->TexReady = true;
+        if (defaultFontIndex) *defaultFontIndex = header.defaultFontIndex;
+        return true;
+    }
+
+    bool Save(const ImFontAtlas* atlas, const Key& key, int defaultFontIndex, const fs::path& path)
+    {
+        if (!atlas->TexPixelsAlpha8 || atlas->TexWidth <= 0 || atlas->TexHeight <= 0) return false;
+        for (const auto& rect : atlas->CustomRects)
+        {
+            // Custom glyph rects reference ImFont pointers; not worth persisting
+            if (rect.Font != nullptr) return false;
+        }
+
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.formatVersion = kFormatVersion;
+        header.imguiVersion = (uint32_t)IMGUI_VERSION_NUM;
+        header.texWidth = (uint32_t)atlas->TexWidth;
+        header.texHeight = (uint32_t)atlas->TexHeight;
+        header.sourcesKey = key.sources;
+        header.layoutKey = key.layout;
+        header.uvWhiteX = atlas->TexUvWhitePixel.x;
+        header.uvWhiteY = atlas->TexUvWhitePixel.y;
+        header.packIdMouseCursors = atlas->PackIdMouseCursors;
+        header.packIdLines = atlas->PackIdLines;
+        header.customRectCount = (uint32_t)atlas->CustomRects.Size;
+        header.fontCount = (uint32_t)atlas->Fonts.Size;
+        header.defaultFontIndex = defaultFontIndex;
+        header.uvLineCount = (uint32_t)IM_ARRAYSIZE(atlas->TexUvLines);
+
+        fs::path tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream ofs(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!ofs) return false;
+            auto write = [&ofs](const void* p, size_t n) { ofs.write(static_cast<const char*>(p), (std::streamsize)n); };
+            write(&header, sizeof(header));
+            write(atlas->TexUvLines, sizeof(atlas->TexUvLines[0]) * header.uvLineCount);
+            for (const auto& rect : atlas->CustomRects)
+            {
+                RectRecord rec{ rect.Width, rect.Height, rect.X, rect.Y };
+                write(&rec, sizeof(rec));
+            }
+            for (const ImFont* font : atlas->Fonts)
+            {
+                FontRecord rec{ font->FontSize, font->Ascent, font->Descent,
+                                (uint32_t)font->FallbackChar, (uint32_t)font->EllipsisChar, (uint32_t)font->Glyphs.Size };
+                write(&rec, sizeof(rec));
+                for (int g = 0; g < font->Glyphs.Size; ++g)
+                {
+                    const ImFontGlyph& src = font->Glyphs[g];
+                    GlyphRecord glyph{ (uint32_t)src.Codepoint, (uint32_t)src.Colored, src.AdvanceX,
+                                       src.X0, src.Y0, src.X1, src.Y1, src.U0, src.V0, src.U1, src.V1 };
+                    write(&glyph, sizeof(glyph));
+                }
+            }
+            write(atlas->TexPixelsAlpha8, (size_t)atlas->TexWidth * atlas->TexHeight);
+            if (!ofs) return false;
+        }
+
+        std::error_code ec;
+        fs::rename(tmpPath, path, ec);
+        if (ec)
+        {
+            // Windows refuses to rename over a file that is still mapped by another instance
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+        return true;
+    }
+#else
+    // ImGui 1.92+ rasterizes glyphs on demand; there is no baked atlas to persist
+    bool Load(ImFontAtlas*, const MappedFile&, const Key&, int* defaultFontIndex)
+    {
+        if (defaultFontIndex) *defaultFontIndex = -1;
+        return false;
+    }
+
+    bool Save(const ImFontAtlas*, const Key&, int, const fs::path&)
+    {
+        return false;
+    }
+#endif
+}
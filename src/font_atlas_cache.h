@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+struct ImFontAtlas;
+
+// Persistent pre-baked font atlas (alpha8 pixels + glyph tables + custom rects).
+// The cache file is memory-mapped on later launches so the atlas is restored without
+// rasterizing the CJK/emoji fonts. Invalidation is automatic: the key covers the font files
+// (path, size, mtime), pixel size/DPI, glyph ranges and the ImGui version.
+namespace FontAtlasCache
+{
+    struct Key
+    {
+        uint64_t sources = 0; // font files; computable on a worker before ImGui exists
+        uint64_t layout = 0;  // pixel size, glyph ranges, font configs, ImGui version
+    };
+
+    // 64-bit FNV-1a; chain calls through seed
+    uint64_t Hash(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+    // Read-only memory mapping of a cache file
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::filesystem::path& path);
+        void Close();
+        bool IsOpen() const { return data != nullptr; }
+        const unsigned char* Data() const { return data; }
+        size_t Size() const { return size; }
+
+    private:
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+    // font_atlas.cache next to the executable (or in the working directory)
+    std::filesystem::path GetCachePath();
+
+    // Cheap header check used by the startup worker to decide whether the font files must be read
+    bool MatchesSources(const MappedFile& file, uint64_t sourcesKey);
+
+    // Restore a previously saved atlas into an empty atlas. On failure the atlas is left empty.
+    // defaultFontIndex receives the index of io.FontDefault in atlas->Fonts (-1 if none).
+    bool Load(ImFontAtlas* atlas, const MappedFile& file, const Key& key, int* defaultFontIndex);
+
+    // Serialize a built atlas (written to a temp file, then renamed into place)
+    bool Save(const ImFontAtlas* atlas, const Key& key, int defaultFontIndex, const std::filesystem::path& path);
+}
@@ -0,0 +1,414 @@
+#include "font_loader.h"
+#include "glyph_cache.h"
+#include "replace_tool.h"
+#include "imgui.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace FontLoader
+{
+    using ReplaceTool::AppendLog;
+
+    static const char* const kChineseCandidates[] = {
+        "NotoSansSC-Regular.otf",
+        "NotoSansSC-Regular.ttf",
+        "SourceHanSansCN-Regular.otf",
+        "SourceHanSansCN-Regular.ttf",
+        "MSYH.TTC",
+        "msyh.ttc",
+        "SIMSUN.TTC",
+        "simsun.ttc"
+    };
+
+    static const char* const kChineseSystem[] = {
+        "C:/Windows/Fonts/msyh.ttc",
+        "C:/Windows/Fonts/simsun.ttc",
+        "C:/Windows/Fonts/msyh.ttf",
+        "C:/Windows/Fonts/simsun.ttf"
+    };
+
+    static const char* const kEmojiCandidates[] = {
+        "NotoEmoji-Regular.ttf",   // monochrome glyphs -> works with stb
+        "NotoColorEmoji.ttf"       // color requires FreeType; may not render with stb
+    };
+
+    static const char* const kEmojiSystem[] = {
+        "C:/Windows/Fonts/seguisym.ttf",    // Segoe UI Symbol (monochrome)
+        "C:/Windows/Fonts/seguiemj.ttf",    // Segoe UI Emoji (color; needs FreeType for color)
+        "C:/Windows/Fonts/seguiemj.ttc"
+    };
+
+    static bool ReadWholeFile(const fs::path& path, std::vector<char>& out)
+    {
+        std::ifstream ifs(path, std::ios::in | std::ios::binary);
+        if (!ifs) return false;
+        ifs.seekg(0, std::ios::end);
+        std::streamoff size = ifs.tellg();
+        if (size <= 0) return false;
+        ifs.seekg(0, std::ios::beg);
+        out.resize((size_t)size);
+        if (!ifs.read(out.data(), size))
+        {
+            out.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // Resolve only (stat); the bytes are read later if the atlas cache can't be used
+    static bool TryResolve(const fs::path& path, const char* origin, FontFile& out)
+    {
+        std::error_code ec;
+        if (!fs::is_regular_file(path, ec)) return false;
+        uintmax_t size = fs::file_size(path, ec);
+        if (ec || size == 0) return false;
+        auto mtime = fs::last_write_time(path, ec);
+        if (ec) return false;
+        out.path = path.string();
+        out.origin = origin;
+        out.fileSize = size;
+        out.mtime = (long long)mtime.time_since_epoch().count();
+        return true;
+    }
+
+    static void ReadFontData(FontFile& font)
+    {
+        if (!font.Found() || !font.data.empty()) return;
+        if (!ReadWholeFile(font.path, font.data))
+        {
+            AppendLog("[font] failed to read: " + font.path);
+            font = FontFile();
+        }
+    }
+
+    static uint64_t HashFontFile(const FontFile& font, uint64_t seed)
+    {
+        seed = FontAtlasCache::Hash(font.path.data(), font.path.size(), seed);
+        seed = FontAtlasCache::Hash(&font.fileSize, sizeof(font.fileSize), seed);
+        return FontAtlasCache::Hash(&font.mtime, sizeof(font.mtime), seed);
+    }
+
+    static uint64_t ComputeSourcesKey(const FontSet& fonts)
+    {
+        return HashFontFile(fonts.emoji, HashFontFile(fonts.chinese, FontAtlasCache::Hash(nullptr, 0)));
+    }
+
+    static uint64_t HashRanges(const ImWchar* ranges, uint64_t seed)
+    {
+        for (; ranges && ranges[0]; ranges += 2)
+        {
+            seed = FontAtlasCache::Hash(ranges, sizeof(ImWchar) * 2, seed);
+        }
+        return FontAtlasCache::Hash("|", 1, seed);
+    }
+
+    static fs::path GetGlyphSetPath()
+    {
+        return FontAtlasCache::GetCachePath().replace_filename("font_glyphs.txt");
+    }
+
+    static bool HasFontExtension(const fs::path& path)
+    {
+        auto ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return ext == ".ttf" || ext == ".otf" || ext == ".ttc";
+    }
+
+    std::vector<fs::path> GetFontSearchDirs()
+    {
+        std::vector<fs::path> dirs;
+        dirs.push_back(fs::path("fonts"));
+        dirs.push_back(fs::path("Fonts"));
+#ifdef _WIN32
+        wchar_t exePathW[MAX_PATH] = {0};
+        if (GetModuleFileNameW(NULL, exePathW, MAX_PATH) > 0)
+        {
+            fs::path exeDir = fs::path(exePathW).parent_path();
+            dirs.push_back(exeDir / "fonts");
+            dirs.push_back(exeDir / "Fonts");
+        }
+#endif
+        return dirs;
+    }
+
+    FontSet DiscoverFonts()
+    {
+        FontSet result;
+        GlyphCache::Load(GetGlyphSetPath());
+        std::error_code ec;
+        std::vector<fs::path> dirs;
+        for (const auto& dir : GetFontSearchDirs())
+        {
+            if (fs::is_directory(dir, ec)) dirs.push_back(dir);
+        }
+
+        // Chinese: bundled candidates, then any font file in the same dir, then system fonts
+        for (const auto& dir : dirs)
+        {
+            AppendLog("[font] searching bundled fonts under: " + dir.string());
+            for (const char* name : kChineseCandidates)
+            {
+                if (TryResolve(dir / name, "bundled", result.chinese)) break;
+            }
+            if (result.chinese.Found()) break;
+            for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+            {
+                if (!it->is_regular_file(ec) || !HasFontExtension(it->path())) continue;
+                if (TryResolve(it->path(), "scanned", result.chinese)) break;
+            }
+            if (result.chinese.Found()) break;
+        }
+        if (!result.chinese.Found())
+        {
+            for (const char* path : kChineseSystem)
+            {
+                if (TryResolve(path, "system", result.chinese)) break;
+            }
+        }
+
+        // Emoji: bundled first, then system
+        for (const auto& dir : dirs)
+        {
+            for (const char* name : kEmojiCandidates)
+            {
+                if (TryResolve(dir / name, "bundled", result.emoji)) break;
+            }
+            if (result.emoji.Found()) break;
+        }
+        if (!result.emoji.Found())
+        {
+            for (const char* path : kEmojiSystem)
+            {
+                if (TryResolve(path, "system", result.emoji)) break;
+            }
+        }
+
+        // Map the atlas cache; the (large) font files only need reading when it is stale
+        result.sourcesKey = ComputeSourcesKey(result);
+        if (result.cache.Open(FontAtlasCache::GetCachePath()) && FontAtlasCache::MatchesSources(result.cache, result.sourcesKey))
+        {
+            AppendLog("[font] atlas cache matches font files, skipping font reads");
+        }
+        else
+        {
+            result.cache.Close();
+            ReadFontData(result.chinese);
+            ReadFontData(result.emoji);
+            result.sourcesKey = ComputeSourcesKey(result); // a font may have failed to read
+        }
+
+        AppendLog("[font] discovered chinese=" + (result.chinese.Found() ? result.chinese.path : std::string("<none>")) +
+                  " emoji=" + (result.emoji.Found() ? result.emoji.path : std::string("<none>")));
+        return result;
+    }
+
+    static const ImVector<ImWchar>& GetEmojiRanges(ImGuiIO& io)
+    {
+        // Ranges must stay alive until the atlas is built
+        static ImVector<ImWchar> emojiRanges;
+        if (emojiRanges.empty())
+        {
+            ImFontGlyphRangesBuilder builder;
+            builder.AddRanges(io.Fonts->GetGlyphRangesDefault());
+            static const ImWchar range_arrows[]      = { 0x2190, 0x21FF, 0 };
+            static const ImWchar range_symbols[]     = { 0x2600, 0x27FF, 0 };
+            static const ImWchar range_misc_pict[]   = { 0x1F300, 0x1F6FF, 0 };
+            static const ImWchar range_supp_pict[]   = { 0x1F900, 0x1F9FF, 0 };
+            static const ImWchar range_pict_ext_a[]  = { 0x1FA70, 0x1FAFF, 0 };
+            builder.AddRanges(range_arrows);
+            builder.AddRanges(range_symbols);
+            builder.AddRanges(range_misc_pict);
+            builder.AddRanges(range_supp_pict);
+            builder.AddRanges(range_pict_ext_a);
+            builder.BuildRanges(&emojiRanges);
+        }
+        return emojiRanges;
+    }
+
+    static double MsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void AddFontsToAtlas(ImGuiIO& io, FontSet& fonts, float sizePixels)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        fonts.sizePixels = sizePixels;
+
+        // CJK ranges come from the codepoints actually in use; must stay alive until the atlas is built
+        static ImVector<ImWchar> chineseRangesStorage;
+        chineseRangesStorage.clear();
+        for (uint32_t c : GlyphCache::TakeRanges(IM_UNICODE_CODEPOINT_MAX))
+        {
+            chineseRangesStorage.push_back((ImWchar)c);
+        }
+        const ImWchar* chineseRanges = chineseRangesStorage.Data;
+        const ImVector<ImWchar>& emojiRanges = GetEmojiRanges(io);
+
+        // Bump the tag when the ImFontConfig values below change
+        static const char kConfigTag[] = "cjk:oh3,ov1,snap|emoji:merge,snap";
+        FontAtlasCache::Key key;
+        key.sources = fonts.sourcesKey;
+        key.layout = FontAtlasCache::Hash(kConfigTag, sizeof(kConfigTag));
+        key.layout = FontAtlasCache::Hash(&sizePixels, sizeof(sizePixels), key.layout);
+        key.layout = HashRanges(chineseRanges, key.layout);
+        key.layout = HashRanges(emojiRanges.Data, key.layout);
+
+        int defaultIndex = -1;
+        if (fonts.cache.IsOpen() && FontAtlasCache::Load(io.Fonts, fonts.cache, key, &defaultIndex))
+        {
+            fonts.cache.Close();
+            io.FontDefault = (defaultIndex >= 0 && defaultIndex < io.Fonts->Fonts.Size) ? io.Fonts->Fonts[defaultIndex] : nullptr;
+            char buf[128];
+            std::snprintf(buf, sizeof(buf), "[font] atlas restored from cache (%dx%d) in %.1f ms",
+                          io.Fonts->TexWidth, io.Fonts->TexHeight, MsSince(start));
+            AppendLog(buf);
+            return;
+        }
+        // Unmap before Save() renames over the file; fonts were not read if the sources matched
+        fonts.cache.Close();
+        ReadFontData(fonts.chinese);
+        ReadFontData(fonts.emoji);
+        key.sources = fonts.sourcesKey = ComputeSourcesKey(fonts);
+
+        ImFont* defaultFont = io.Fonts->AddFontDefault();
+
+        ImFont* chineseFont = nullptr;
+        if (fonts.chinese.Found())
+        {
+            ImFontConfig cfg; cfg.OversampleH = 3; cfg.OversampleV = 1; cfg.RasterizerMultiply = 1.0f; cfg.PixelSnapH = true;
+            cfg.FontDataOwnedByAtlas = false;
+            chineseFont = io.Fonts->AddFontFromMemoryTTF(fonts.chinese.data.data(), (int)fonts.chinese.data.size(), sizePixels, &cfg, chineseRanges);
+            if (chineseFont) AppendLog("[font] Loaded Chinese font (" + fonts.chinese.origin + "): " + fonts.chinese.path);
+            else AppendLog("[font] failed to load: " + fonts.chinese.path);
+        }
+
+        // Emoji: MERGE into the previous font
+        ImFont* emojiFont = nullptr;
+        if (fonts.emoji.Found())
+        {
+            ImFontConfig cfg; cfg.MergeMode = true; cfg.PixelSnapH = true; cfg.GlyphMinAdvanceX = 0.0f;
+            cfg.FontDataOwnedByAtlas = false;
+            emojiFont = io.Fonts->AddFontFromMemoryTTF(fonts.emoji.data.data(), (int)fonts.emoji.data.size(), sizePixels, &cfg, emojiRanges.Data);
+            if (emojiFont) AppendLog("[font] Merged emoji font (" + fonts.emoji.origin + "): " + fonts.emoji.path);
+        }
+
+        if (chineseFont)
+        {
+            io.FontDefault = chineseFont;
+            AppendLog("[font] Using Chinese font as default");
+        }
+        else if (emojiFont)
+        {
+            io.FontDefault = emojiFont;
+            AppendLog("[font] Using emoji font as default");
+        }
+        else
+        {
+            io.FontDefault = defaultFont;
+            AppendLog("[font] Using default font");
+        }
+
+        // Build now (instead of lazily in the backend) so the result can be cached
+        io.Fonts->Build();
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "[font] atlas built (%dx%d) in %.1f ms", io.Fonts->TexWidth, io.Fonts->TexHeight, MsSince(start));
+        AppendLog(buf);
+
+        for (int i = 0; i < io.Fonts->Fonts.Size; ++i)
+        {
+            if (io.Fonts->Fonts[i] == io.FontDefault) defaultIndex = i;
+        }
+        GlyphCache::Save(GetGlyphSetPath());
+        const fs::path cachePath = FontAtlasCache::GetCachePath();
+        if (FontAtlasCache::Save(io.Fonts, key, defaultIndex, cachePath))
+            AppendLog("[font] atlas cache written: " + cachePath.string());
+        else
+            AppendLog("[font] atlas cache not written: " + cachePath.string());
+    }
+
+    void NoteInputCharacters(const ImGuiIO& io)
+    {
+        for (int i = 0; i < io.InputQueueCharacters.Size; ++i)
+        {
+            GlyphCache::AddCodepoint((uint32_t)io.InputQueueCharacters[i]);
+        }
+    }
+
+#if IMGUI_VERSION_NUM < 19200
+    static bool NeedsRead(const FontFile& font)
+    {
+        return font.Found() && font.data.empty();
+    }
+
+    static FontFile WithoutData(const FontFile& font)
+    {
+        FontFile copy;
+        copy.path = font.path;
+        copy.origin = font.origin;
+        copy.fileSize = font.fileSize;
+        copy.mtime = font.mtime;
+        return copy;
+    }
+#endif
+
+    bool UpdateGlyphs(ImGuiIO& io, FontSet& fonts)
+    {
+#if IMGUI_VERSION_NUM >= 19200
+        // 1.92+ rasterizes glyphs on demand
+        (void)io; (void)fonts;
+        return false;
+#else
+        // Collect a finished background read (the worker only fills its own copies of the faces)
+        if (fonts.pendingRead.valid())
+        {
+            if (fonts.pendingRead.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+            std::pair<FontFile, FontFile> read = fonts.pendingRead.get();
+            if (NeedsRead(fonts.chinese)) fonts.chinese = std::move(read.first);
+            if (NeedsRead(fonts.emoji)) fonts.emoji = std::move(read.second);
+        }
+
+        // Batch window: text usually arrives in bursts (word import, log spam, IME composition)
+        const double kBatchSeconds = 0.25;
+        if (!fonts.chinese.Found() || GlyphCache::PendingCount() == 0 || GlyphCache::PendingAgeSeconds() < kBatchSeconds)
+            return false;
+
+        // An atlas restored from the cache has no font bytes yet: read them off the UI thread first.
+        // The worker only gets path/size copies; a face that already has its bytes is left alone
+        // because the atlas points into them.
+        if (NeedsRead(fonts.chinese) || NeedsRead(fonts.emoji))
+        {
+            FontFile chinese = NeedsRead(fonts.chinese) ? WithoutData(fonts.chinese) : FontFile();
+            FontFile emoji = NeedsRead(fonts.emoji) ? WithoutData(fonts.emoji) : FontFile();
+            fonts.pendingRead = std::async(std::launch::async, [chinese, emoji]() mutable {
+                ReadFontData(chinese);
+                ReadFontData(emoji);
+                return std::make_pair(std::move(chinese), std::move(emoji));
+            });
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const size_t added = GlyphCache::PendingCount();
+        io.Fonts->Clear();
+        AddFontsToAtlas(io, fonts, fonts.sizePixels);
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "[font] glyph rebuild: +%d codepoints in %.1f ms", (int)added, MsSince(start));
+        AppendLog(buf);
+        return true;
+#endif
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "font_atlas_cache.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct ImGuiIO;
+struct ImFont;
+
+// UI font discovery + atlas setup shared by both backends.
+// The CJK face is baked with the GlyphCache codepoint set only, not the full Chinese range.
+// DiscoverFonts() only touches the file system (probe candidates, map the atlas cache, read font
+// bytes on a cache miss) so it can run on a startup worker; AddFontsToAtlas() must run on the UI
+// thread after ImGui::CreateContext().
+namespace FontLoader
+{
+    struct FontFile
+    {
+        std::string path;
+        std::string origin;     // "bundled" / "scanned" / "system"
+        uintmax_t fileSize = 0;
+        long long mtime = 0;
+        std::vector<char> data; // whole file, handed to the atlas without copying; empty on a cache hit
+        bool Found() const { return !path.empty(); }
+    };
+
+    struct FontSet
+    {
+        FontFile chinese;
+        FontFile emoji;
+        uint64_t sourcesKey = 0;          // identity of the font files above
+        FontAtlasCache::MappedFile cache; // open only when its sources match
+        float sizePixels = 0.0f;          // set by AddFontsToAtlas, reused by glyph rebuilds
+        // Background font read before the first glyph rebuild: the worker fills copies of
+        // chinese / emoji and UpdateGlyphs moves them in after get(), on the UI thread
+        std::future<std::pair<FontFile, FontFile>> pendingRead;
+    };
+
+    // fonts/ and Fonts/ under the working directory and next to the executable
+    std::vector<std::filesystem::path> GetFontSearchDirs();
+
+    // Resolve the CJK + emoji faces (bundled, then directory scan, then system). The font bytes
+    // are only read when the atlas cache does not match these files.
+    FontSet DiscoverFonts();
+
+    // Restore the atlas from the cache, or add default + discovered fonts (emoji merged into the
+    // CJK face), build and refresh the cache. Picks io.FontDefault.
+    // fonts must outlive the atlas: the data is not owned by ImGui.
+    void AddFontsToAtlas(ImGuiIO& io, FontSet& fonts, float sizePixels);
+
+    // Report characters typed this frame; call between ImGui::NewFrame() and ImGui::Render()
+    void NoteInputCharacters(const ImGuiIO& io);
+
+    // Call before ImGui::NewFrame(). Rebuilds the atlas once new codepoints reported to GlyphCache
+    // have settled for a short batch window. Returns true when the backend must recreate its font
+    // texture (ImGui_ImplDX11_InvalidateDeviceObjects / ImGui_ImplOpenGL3_DestroyFontsTexture+Create).
+    bool UpdateGlyphs(ImGuiIO& io, FontSet& fonts);
+}
@@ -0,0 +1,165 @@
+#include "glyph_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <set>
+
+// kUiSeed: non-ASCII characters used in UI string literals (src/, main.cpp). Labels are not
+// routed through AddText(), so the table is generated at build time by tools/glyph_seed_gen.cpp
+// (cmake/GlyphSeed.cmake).
+#include "glyph_seed.inc"
+
+namespace GlyphCache
+{
+    // Always baked: Latin-1, general punctuation, CJK symbols/punctuation, fullwidth forms
+    static const uint32_t kBaseRanges[][2] = {
+        { 0x0020, 0x00FF },
+        { 0x2000, 0x206F },
+        { 0x3000, 0x303F },
+        { 0xFF00, 0xFFEF },
+    };
+
+    static std::mutex g_mutex;
+    static std::set<uint32_t> g_baked;
+    static std::set<uint32_t> g_pending;
+    static std::chrono::steady_clock::time_point g_pendingSince;
+    static bool g_seeded = false;
+
+    static bool InBaseRanges(uint32_t c)
+    {
+        for (const auto& r : kBaseRanges)
+        {
+            if (c >= r[0] && c <= r[1]) return true;
+        }
+        return false;
+    }
+
+    // Minimal UTF-8 decoder; invalid bytes are skipped
+    template <typename Fn>
+    static void ForEachCodepoint(const char* text, const char* textEnd, Fn&& fn)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+        const unsigned char* end = reinterpret_cast<const unsigned char*>(textEnd);
+        while (p < end)
+        {
+            unsigned char b = *p;
+            int len = b < 0x80 ? 1 : (b >> 5) == 0x6 ? 2 : (b >> 4) == 0xE ? 3 : (b >> 3) == 0x1E ? 4 : 0;
+            if (len == 0 || end - p < len) { ++p; continue; }
+            uint32_t c = len == 1 ? b : len == 2 ? (b & 0x1F) : len == 3 ? (b & 0x0F) : (b & 0x07);
+            for (int i = 1; i < len; ++i) c = (c << 6) | (p[i] & 0x3F);
+            p += len;
+            fn(c);
+        }
+    }
+
+    // Caller holds g_mutex
+    static void AddLocked(uint32_t c)
+    {
+        if (c < 0x80 || InBaseRanges(c) || g_baked.count(c)) return;
+        if (g_pending.empty()) g_pendingSince = std::chrono::steady_clock::now();
+        g_pending.insert(c);
+    }
+
+    // Caller holds g_mutex
+    static void SeedLocked()
+    {
+        if (g_seeded) return;
+        g_seeded = true;
+        for (const uint32_t* c = kUiSeed; *c; ++c) AddLocked(*c);
+    }
+
+    void AddText(const char* text, const char* textEnd)
+    {
+        if (!text) return;
+        if (!textEnd) textEnd = text + std::char_traits<char>::length(text);
+        const char* firstWide = std::find_if(text, textEnd, [](char ch) { return (unsigned char)ch >= 0x80; });
+        if (firstWide == textEnd) return; // pure ASCII, always baked
+        std::lock_guard<std::mutex> lock(g_mutex);
+        ForEachCodepoint(firstWide, textEnd, [](uint32_t c) { AddLocked(c); });
+    }
+
+    void AddCodepoint(uint32_t codepoint)
+    {
+        if (codepoint < 0x80) return;
+        std::lock_guard<std::mutex> lock(g_mutex);
+        AddLocked(codepoint);
+    }
+
+    size_t PendingCount()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_pending.size();
+    }
+
+    double PendingAgeSeconds()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_pending.empty()) return 0.0;
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - g_pendingSince).count();
+    }
+
+    std::vector<uint32_t> TakeRanges(uint32_t maxCodepoint)
+    {
+        std::vector<uint32_t> ranges;
+        std::lock_guard<std::mutex> lock(g_mutex);
+        SeedLocked();
+        g_baked.insert(g_pending.begin(), g_pending.end());
+        g_pending.clear();
+
+        for (const auto& r : kBaseRanges)
+        {
+            ranges.push_back(r[0]);
+            ranges.push_back(r[1]);
+        }
+        // g_baked is ordered: merge consecutive codepoints into one range
+        for (auto it = g_baked.begin(); it != g_baked.end() && *it <= maxCodepoint; )
+        {
+            uint32_t first = *it, last = *it;
+            for (++it; it != g_baked.end() && *it == last + 1 && *it <= maxCodepoint; ++it) last = *it;
+            ranges.push_back(first);
+            ranges.push_back(last);
+        }
+        ranges.push_back(0);
+        return ranges;
+    }
+
+    void Load(const std::filesystem::path& path)
+    {
+        std::ifstream ifs(path, std::ios::in | std::ios::binary);
+        if (!ifs) return;
+        std::string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        std::lock_guard<std::mutex> lock(g_mutex);
+        ForEachCodepoint(text.data(), text.data() + text.size(), [](uint32_t c) {
+            if (c >= 0x80 && !InBaseRanges(c)) g_baked.insert(c);
+        });
+    }
+
+    void Save(const std::filesystem::path& path)
+    {
+        std::string text;
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            for (uint32_t c : g_baked)
+            {
+                if (c < 0x800) { text += (char)(0xC0 | (c >> 6)); }
+                else if (c < 0x10000) { text += (char)(0xE0 | (c >> 12)); text += (char)(0x80 | ((c >> 6) & 0x3F)); }
+                else { text += (char)(0xF0 | (c >> 18)); text += (char)(0x80 | ((c >> 12) & 0x3F)); text += (char)(0x80 | ((c >> 6) & 0x3F)); }
+                text += (char)(0x80 | (c & 0x3F));
+            }
+        }
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream ofs(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!ofs) return;
+            ofs.write(text.data(), (std::streamsize)text.size());
+            if (!ofs) return;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec) std::filesystem::remove(tmpPath, ec);
+    }
+}
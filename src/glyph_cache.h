@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Set of non-ASCII codepoints the UI actually displays. The CJK font is baked with only these
+// (plus Latin/CJK punctuation) instead of the full ChineseSimplifiedCommon range; text sources
+// (word entries, log lines, config names, typed input) report their characters via AddText()
+// and FontLoader::UpdateGlyphs() folds new ones into the atlas in batched rebuilds.
+// All functions are thread-safe; AddText() on pure ASCII does not lock.
+namespace GlyphCache
+{
+    void AddText(const char* text, const char* textEnd = nullptr);
+    inline void AddText(const std::string& text) { AddText(text.data(), text.data() + text.size()); }
+    void AddCodepoint(uint32_t codepoint);
+
+    // Codepoints reported since the last TakeRanges()
+    size_t PendingCount();
+
+    // Seconds since the oldest pending codepoint was reported (0 if none)
+    double PendingAgeSeconds();
+
+    // Fold pending codepoints into the baked set and return glyph ranges for it
+    // ({first, last} pairs, 0-terminated; codepoints above maxCodepoint are dropped)
+    std::vector<uint32_t> TakeRanges(uint32_t maxCodepoint);
+
+    // Learned set, persisted so the next launch bakes the same ranges (and hits the atlas cache)
+    void Load(const std::filesystem::path& path);
+    void Save(const std::filesystem::path& path);
+}
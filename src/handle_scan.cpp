@@ -0,0 +1,302 @@
+#include "handle_scan.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+#ifdef _WIN32
+#include <windows.h>
+#include <mutex>
+#endif
+
+namespace HandleScan
+{
+    GrowableBuffer::GrowableBuffer(size_t initialSize, size_t limit)
+        : bytes(std::min(initialSize, limit)), limit(limit)
+    {
+    }
+
+    bool GrowableBuffer::Grow(size_t needed)
+    {
+        if (bytes.size() >= limit) return false;
+        // The table keeps changing between the size probe and the retry: leave some headroom
+        size_t target = std::max(needed, bytes.size() * 2);
+        target += target / 8;
+        bytes.resize(std::min(target, limit));
+        grows++;
+        return true;
+    }
+
+    void FilterHandles(const HandleEntry* entries, size_t count, uint32_t pid, uint16_t typeIndex, std::vector<HandleEntry>& out)
+    {
+        out.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const HandleEntry& e = entries[i];
+            if (e.pid == pid && e.typeIndex == typeIndex) out.push_back(e);
+        }
+    }
+
+    // Lower-case, '/'-separated copy used for case-insensitive path comparison
+    static std::string NormalizePath(const std::string& path)
+    {
+        std::string out(path.size(), '\0');
+        std::transform(path.begin(), path.end(), out.begin(), [](unsigned char c) {
+            return c == '\\' ? '/' : (char)std::tolower(c);
+        });
+        return out;
+    }
+
+    static bool IsSolutionFile(const std::string& normalized)
+    {
+        auto endsWith = [&](const char* ext, size_t n) {
+            return normalized.size() > n && normalized.compare(normalized.size() - n, n, ext) == 0;
+        };
+        return endsWith(".sln", 4) || endsWith(".slnf", 5);
+    }
+
+    // Number of leading directories shared by two normalized directory strings ending with '/'
+    static int SharedDepth(const std::string& a, const std::string& b)
+    {
+        int depth = 0;
+        size_t n = std::min(a.size(), b.size());
+        for (size_t i = 0; i < n && a[i] == b[i]; ++i)
+            if (a[i] == '/') depth++;
+        return depth;
+    }
+
+    std::vector<std::string> RankSolutionCandidates(const std::vector<std::string>& openPaths, const std::string& activeDocument)
+    {
+        struct Candidate
+        {
+            const std::string* path;
+            int shared;
+            int depth;
+        };
+
+        std::string docDir = NormalizePath(activeDocument);
+        size_t docSlash = docDir.find_last_of('/');
+        docDir.erase(docSlash == std::string::npos ? 0 : docSlash + 1);
+
+        std::vector<Candidate> candidates;
+        std::unordered_set<std::string> seen;
+        for (const std::string& path : openPaths)
+        {
+            std::string norm = NormalizePath(path);
+            if (!IsSolutionFile(norm) || !seen.insert(norm).second) continue;
+            size_t slash = norm.find_last_of('/');
+            std::string dir = slash == std::string::npos ? std::string() : norm.substr(0, slash + 1);
+            int depth = (int)std::count(dir.begin(), dir.end(), '/');
+            candidates.push_back(Candidate{ &path, docDir.empty() ? 0 : SharedDepth(dir, docDir), depth });
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            if (a.shared != b.shared) return a.shared > b.shared;
+            if (a.depth != b.depth) return a.depth < b.depth;
+            return *a.path < *b.path;
+        });
+
+        std::vector<std::string> out;
+        out.reserve(candidates.size());
+        for (const Candidate& c : candidates) out.push_back(*c.path);
+        return out;
+    }
+
+#ifdef _WIN32
+    typedef LONG (WINAPI *PNtQuerySystemInformation)(ULONG, PVOID, ULONG, PULONG);
+    typedef LONG (WINAPI *PNtQueryInformationProcess)(HANDLE, ULONG, PVOID, ULONG, PULONG);
+
+    static const LONG kStatusInfoLengthMismatch = (LONG)0xC0000004;
+    static const LONG kStatusBufferTooSmall = (LONG)0xC0000023;
+    static const LONG kStatusBufferOverflow = (LONG)0x80000005;
+
+    // ProcessHandleInformation (51, Windows 8+): the handles of one process only
+    struct ProcessHandleEntry
+    {
+        HANDLE HandleValue;
+        ULONG_PTR HandleCount;
+        ULONG_PTR PointerCount;
+        ACCESS_MASK GrantedAccess;
+        ULONG ObjectTypeIndex;
+        ULONG HandleAttributes;
+        ULONG Reserved;
+    };
+
+    struct ProcessHandleSnapshot
+    {
+        ULONG_PTR NumberOfHandles;
+        ULONG_PTR Reserved;
+        ProcessHandleEntry Handles[1];
+    };
+
+    // SystemExtendedHandleInformation (64): every handle in the system, with full-width pids/values
+    struct SystemHandleEntryEx
+    {
+        PVOID Object;
+        ULONG_PTR UniqueProcessId;
+        ULONG_PTR HandleValue;
+        ULONG GrantedAccess;
+        USHORT CreatorBackTraceIndex;
+        USHORT ObjectTypeIndex;
+        ULONG HandleAttributes;
+        ULONG Reserved;
+    };
+
+    struct SystemHandleInformationEx
+    {
+        ULONG_PTR NumberOfHandles;
+        ULONG_PTR Reserved;
+        SystemHandleEntryEx Handles[1];
+    };
+
+    // All state below is guarded by g_mutex; the buffers are reused across scans
+    static std::mutex g_mutex;
+    static GrowableBuffer g_processBuffer(64 * 1024);
+    static GrowableBuffer g_systemBuffer(4 * 1024 * 1024);
+    static std::vector<HandleEntry> g_entries;
+    static std::vector<HandleEntry> g_fileHandles;
+    static int g_fileTypeIndex = -1; // -1: not probed yet, -2: probe failed
+
+    static QueryStatus ToQueryStatus(LONG status)
+    {
+        if (status >= 0) return QueryStatus::Ok;
+        if (status == kStatusInfoLengthMismatch || status == kStatusBufferTooSmall || status == kStatusBufferOverflow)
+            return QueryStatus::TooSmall;
+        return QueryStatus::Failed;
+    }
+
+    static bool QueryProcessHandles(HANDLE hProc, uint32_t pid, std::vector<HandleEntry>& out)
+    {
+        static PNtQueryInformationProcess query = (PNtQueryInformationProcess)GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQueryInformationProcess");
+        if (!query) return false;
+        const ULONG ProcessHandleInformation = 51;
+        QueryStatus status = g_processBuffer.Fill([&](void* data, size_t size, size_t& needed) {
+            ULONG len = 0;
+            QueryStatus s = ToQueryStatus(query(hProc, ProcessHandleInformation, data, (ULONG)size, &len));
+            needed = len;
+            return s;
+        });
+        if (status != QueryStatus::Ok) return false;
+
+        const ProcessHandleSnapshot* info = static_cast<const ProcessHandleSnapshot*>(g_processBuffer.Data());
+        out.resize((size_t)info->NumberOfHandles);
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            const ProcessHandleEntry& h = info->Handles[i];
+            out[i] = HandleEntry{ pid, (uint16_t)h.ObjectTypeIndex, (uint64_t)(ULONG_PTR)h.HandleValue, (uint32_t)h.GrantedAccess };
+        }
+        return true;
+    }
+
+    static bool QuerySystemHandles(std::vector<HandleEntry>& out)
+    {
+        static PNtQuerySystemInformation query = (PNtQuerySystemInformation)GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation");
+        if (!query) return false;
+        const ULONG SystemExtendedHandleInformation = 64;
+        QueryStatus status = g_systemBuffer.Fill([&](void* data, size_t size, size_t& needed) {
+            ULONG len = 0;
+            QueryStatus s = ToQueryStatus(query(SystemExtendedHandleInformation, data, (ULONG)size, &len));
+            needed = len;
+            return s;
+        });
+        if (status != QueryStatus::Ok) return false;
+
+        const SystemHandleInformationEx* info = static_cast<const SystemHandleInformationEx*>(g_systemBuffer.Data());
+        out.resize((size_t)info->NumberOfHandles);
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            const SystemHandleEntryEx& h = info->Handles[i];
+            out[i] = HandleEntry{ (uint32_t)h.UniqueProcessId, h.ObjectTypeIndex, (uint64_t)h.HandleValue, (uint32_t)h.GrantedAccess };
+        }
+        return true;
+    }
+
+    static bool QueryHandles(HANDLE hProc, uint32_t pid, std::vector<HandleEntry>& out)
+    {
+        return QueryProcessHandles(hProc, pid, out) || QuerySystemHandles(out);
+    }
+
+    // Object type numbers differ between Windows builds: learn the "File" index from a handle we own
+    static int FileTypeIndex()
+    {
+        if (g_fileTypeIndex != -1) return g_fileTypeIndex;
+        g_fileTypeIndex = -2;
+        wchar_t self[MAX_PATH];
+        DWORD len = GetModuleFileNameW(NULL, self, MAX_PATH);
+        if (len == 0 || len >= MAX_PATH) return g_fileTypeIndex;
+        HANDLE hFile = CreateFileW(self, FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, 0, NULL);
+        if (hFile == INVALID_HANDLE_VALUE) return g_fileTypeIndex;
+        const uint32_t selfPid = GetCurrentProcessId();
+        if (QueryHandles(GetCurrentProcess(), selfPid, g_entries))
+        {
+            for (const HandleEntry& e : g_entries)
+            {
+                if (e.pid == selfPid && e.value == (uint64_t)(ULONG_PTR)hFile)
+                {
+                    g_fileTypeIndex = e.typeIndex;
+                    break;
+                }
+            }
+        }
+        CloseHandle(hFile);
+        return g_fileTypeIndex;
+    }
+
+    static std::string WideToUtf8(const wchar_t* w, int len)
+    {
+        if (len <= 0) return std::string();
+        int size = WideCharToMultiByte(CP_UTF8, 0, w, len, NULL, 0, NULL, NULL);
+        std::string out(size, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, w, len, &out[0], size, NULL, NULL);
+        return out;
+    }
+
+    bool QueryOpenFilePaths(uint32_t pid, std::vector<std::string>& out, std::chrono::steady_clock::time_point deadline)
+    {
+        out.clear();
+        std::lock_guard<std::mutex> lock(g_mutex);
+        HANDLE hProc = OpenProcess(PROCESS_DUP_HANDLE | PROCESS_QUERY_INFORMATION, FALSE, pid);
+        if (!hProc) return false;
+
+        const int fileType = FileTypeIndex();
+        if (!QueryHandles(hProc, pid, g_entries))
+        {
+            CloseHandle(hProc);
+            return false;
+        }
+        if (fileType >= 0)
+        {
+            FilterHandles(g_entries.data(), g_entries.size(), pid, (uint16_t)fileType, g_fileHandles);
+        }
+        else
+        {
+            // Type unknown: GetFileType() below still keeps pipes and devices away from path resolution
+            g_fileHandles.clear();
+            for (const HandleEntry& e : g_entries)
+                if (e.pid == pid) g_fileHandles.push_back(e);
+        }
+
+        wchar_t path[1024];
+        for (size_t i = 0; i < g_fileHandles.size(); ++i)
+        {
+            if ((i & 63) == 0 && std::chrono::steady_clock::now() >= deadline) break;
+            HANDLE dup = NULL;
+            if (!DuplicateHandle(hProc, (HANDLE)(ULONG_PTR)g_fileHandles[i].value, GetCurrentProcess(), &dup, 0, FALSE, DUPLICATE_SAME_ACCESS))
+                continue;
+            // Only disk files: resolving a name on a synchronous pipe can block indefinitely
+            if (GetFileType(dup) == FILE_TYPE_DISK)
+            {
+                DWORD len = GetFinalPathNameByHandleW(dup, path, (DWORD)(sizeof(path) / sizeof(path[0])), FILE_NAME_NORMALIZED | VOLUME_NAME_DOS);
+                if (len > 0 && len < sizeof(path) / sizeof(path[0]))
+                {
+                    const wchar_t* p = path;
+                    if (wcsncmp(p, L"\\\\?\\", 4) == 0) { p += 4; len -= 4; }
+                    out.push_back(WideToUtf8(p, (int)len));
+                }
+            }
+            CloseHandle(dup);
+        }
+        CloseHandle(hProc);
+        return true;
+    }
+#endif
+}
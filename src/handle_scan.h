@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Open-file discovery for VSInspector's handle-based solution lookup.
+// The portable core (growable query buffer, pid/type filter, candidate ranking) has no OS
+// dependency so it can be benchmarked on Linux with recorded handle tables (bench/handle_scan_bench).
+// On Windows, QueryOpenFilePaths() asks for the target process' own handle snapshot first and only
+// falls back to the system-wide extended table, and resolves paths for file handles only.
+namespace HandleScan
+{
+    struct HandleEntry
+    {
+        uint32_t pid = 0;
+        uint16_t typeIndex = 0;  // object type (File, Event, Key, ...), numbering is per boot
+        uint64_t value = 0;      // handle value in the owning process
+        uint32_t access = 0;     // granted access mask
+    };
+
+    enum class QueryStatus { Ok, TooSmall, Failed };
+
+    // Reused buffer for "retry with a bigger buffer" APIs such as NtQuerySystemInformation.
+    // Keeps its size between calls, so a steady-state query needs no allocation and no retry.
+    class GrowableBuffer
+    {
+    public:
+        explicit GrowableBuffer(size_t initialSize = 256 * 1024, size_t limit = size_t(1) << 30);
+
+        // query(void* data, size_t size, size_t& needed) -> QueryStatus. On TooSmall the buffer grows
+        // to max(needed, 2 * size) plus headroom for entries created meanwhile, up to the limit.
+        template <typename Query>
+        QueryStatus Fill(Query&& query)
+        {
+            for (;;)
+            {
+                size_t needed = 0;
+                QueryStatus status = query(static_cast<void*>(bytes.data()), bytes.size(), needed);
+                if (status != QueryStatus::TooSmall) return status;
+                if (!Grow(needed)) return QueryStatus::Failed;
+            }
+        }
+
+        void* Data() { return bytes.data(); }
+        size_t Size() const { return bytes.size(); }
+        unsigned GrowCount() const { return grows; }
+
+    private:
+        bool Grow(size_t needed);
+
+        std::vector<unsigned char> bytes;
+        size_t limit;
+        unsigned grows = 0;
+    };
+
+    // Handles owned by pid with the given object type (out is cleared first)
+    void FilterHandles(const HandleEntry* entries, size_t count, uint32_t pid, uint16_t typeIndex, std::vector<HandleEntry>& out);
+
+    // .sln/.slnf files among openPaths, best first: the deepest directory shared with the active
+    // document wins, then the shallower solution path, then name order. Duplicates are removed.
+    std::vector<std::string> RankSolutionCandidates(const std::vector<std::string>& openPaths, const std::string& activeDocument);
+
+#ifdef _WIN32
+    // Paths of disk files pid has open (UTF-8). Stops early at deadline. False if the handle
+    // list is unavailable (e.g. access denied to the process).
+    bool QueryOpenFilePaths(uint32_t pid, std::vector<std::string>& out, std::chrono::steady_clock::time_point deadline);
+#endif
+}
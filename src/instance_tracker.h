@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+// Per-process state that survives across refreshes, keyed by (pid, start time) so a recycled pid
+// is never mistaken for the process it replaced. A refresh pass calls Touch() for every live
+// process (only the ones reported new need probing) and Sweep() once at the end to drop the
+// processes that exited.
+namespace ProcessEnum
+{
+    struct ProcessKey
+    {
+        uint32_t pid = 0;
+        uint64_t startTime = 0;
+        bool operator==(const ProcessKey& o) const { return pid == o.pid && startTime == o.startTime; }
+    };
+
+    struct ProcessKeyHash
+    {
+        size_t operator()(const ProcessKey& k) const
+        {
+            return std::hash<uint64_t>()(k.startTime * 0x9E3779B97F4A7C15ull ^ k.pid);
+        }
+    };
+
+    template <typename T>
+    class InstanceTracker
+    {
+    public:
+        // Mark key alive in the current pass; isNew is true the first time a key is seen
+        T& Touch(const ProcessKey& key, bool& isNew)
+        {
+            auto result = entries.try_emplace(key);
+            isNew = result.second;
+            result.first->second.lastPass = pass;
+            return result.first->second.value;
+        }
+
+        // Drop every entry not touched since the previous Sweep (onRemoved(key, value) runs first)
+        // and start a new pass
+        template <typename Fn>
+        void Sweep(Fn&& onRemoved)
+        {
+            for (auto it = entries.begin(); it != entries.end(); )
+            {
+                if (it->second.lastPass != pass)
+                {
+                    onRemoved(it->first, it->second.value);
+                    it = entries.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            ++pass;
+        }
+
+        template <typename Fn>
+        void ForEach(Fn&& fn)
+        {
+            for (auto& kv : entries) fn(kv.first, kv.second.value);
+        }
+
+        size_t Size() const { return entries.size(); }
+
+    private:
+        struct Entry
+        {
+            T value{};
+            uint64_t lastPass = 0;
+        };
+
+        std::unordered_map<ProcessKey, Entry, ProcessKeyHash> entries;
+        uint64_t pass = 1;
+    };
+}
@@ -0,0 +1,482 @@
+#include "json.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSON_HAVE_SSE2 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace Json
+{
+#ifdef JSON_HAVE_SSE2
+    static unsigned LowestBit(unsigned mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (unsigned)index;
+#else
+        return (unsigned)__builtin_ctz(mask);
+#endif
+    }
+#endif
+
+    const char* ScanString(const char* p, const char* end)
+    {
+#ifdef JSON_HAVE_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i controlMax = _mm_set1_epi8(0x1F);
+        while (end - p >= 16)
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i*)p);
+            // Unsigned v <= 0x1F  <=>  min(v, 0x1F) == v
+            const __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                             _mm_cmpeq_epi8(_mm_min_epu8(v, controlMax), v));
+            const unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+            if (mask) return p + LowestBit(mask);
+            p += 16;
+        }
+#endif
+        while (p < end && *p != '"' && *p != '\\' && (unsigned char)*p >= 0x20) ++p;
+        return p;
+    }
+
+    void AppendUtf8(std::string& out, unsigned cp)
+    {
+        if (cp < 0x80) { out.push_back((char)cp); }
+        else if (cp < 0x800) { out.push_back((char)(0xC0 | (cp >> 6))); out.push_back((char)(0x80 | (cp & 0x3F))); }
+        else if (cp < 0x10000) { out.push_back((char)(0xE0 | (cp >> 12))); out.push_back((char)(0x80 | ((cp >> 6) & 0x3F))); out.push_back((char)(0x80 | (cp & 0x3F))); }
+        else { out.push_back((char)(0xF0 | (cp >> 18))); out.push_back((char)(0x80 | ((cp >> 12) & 0x3F))); out.push_back((char)(0x80 | ((cp >> 6) & 0x3F))); out.push_back((char)(0x80 | (cp & 0x3F))); }
+    }
+
+    void AppendEscaped(std::string& out, std::string_view s)
+    {
+        const char* p = s.data();
+        const char* end = p + s.size();
+        while (p < end)
+        {
+            // Same set of bytes ends a plain run when reading and needs escaping when writing
+            const char* run = ScanString(p, end);
+            out.append(p, (size_t)(run - p));
+            if (run == end) break;
+            const char c = *run;
+            switch (c)
+            {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)(unsigned char)c);
+                out += buf;
+                break;
+            }
+            }
+            p = run + 1;
+        }
+    }
+
+    // ---- Reader --------------------------------------------------------------------------------
+
+    static bool IsSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+    static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+    Reader::Reader(std::string_view input)
+        : begin(input.data()), pos(input.data()), end(input.data() + input.size())
+    {
+    }
+
+    Token Reader::Fail(const char* what)
+    {
+        if (!failed)
+        {
+            failed = true;
+            error = std::string(what) + " at offset " + std::to_string(Offset());
+        }
+        text = std::string_view();
+        return Token::Error;
+    }
+
+    Token Reader::Close(char c)
+    {
+        ++pos;
+        stack.pop_back();
+        expect = Expect::AfterValue;
+        text = std::string_view();
+        return c == '}' ? Token::ObjectEnd : Token::ArrayEnd;
+    }
+
+    Token Reader::Next()
+    {
+        if (failed) return Token::Error;
+        for (;;)
+        {
+            while (pos < end && IsSpace(*pos)) ++pos;
+            if (pos == end)
+            {
+                if (started && stack.empty() && expect == Expect::AfterValue) { text = std::string_view(); return Token::End; }
+                return Fail("unexpected end of input");
+            }
+            const char c = *pos;
+            switch (expect)
+            {
+            case Expect::AfterValue:
+                if (stack.empty()) return Fail("trailing characters");
+                if (c == ',')
+                {
+                    ++pos;
+                    expect = stack.back() == '{' ? Expect::Key : Expect::Value;
+                    continue;
+                }
+                if (c == (stack.back() == '{' ? '}' : ']')) return Close(c);
+                return Fail(stack.back() == '{' ? "expected ',' or '}'" : "expected ',' or ']'");
+
+            case Expect::Colon:
+                if (c != ':') return Fail("expected ':'");
+                ++pos;
+                expect = Expect::Value;
+                continue;
+
+            case Expect::KeyOrClose:
+                if (c == '}') return Close(c);
+                // fall through
+            case Expect::Key:
+                if (c != '"') return Fail("expected key");
+                return ParseString(true);
+
+            case Expect::ValueOrClose:
+                if (c == ']') return Close(c);
+                // fall through
+            case Expect::Value:
+                started = true;
+                switch (c)
+                {
+                case '{':
+                    ++pos;
+                    stack.push_back('{');
+                    expect = Expect::KeyOrClose;
+                    text = std::string_view();
+                    return Token::ObjectBegin;
+                case '[':
+                    ++pos;
+                    stack.push_back('[');
+                    expect = Expect::ValueOrClose;
+                    text = std::string_view();
+                    return Token::ArrayBegin;
+                case '"':
+                    return ParseString(false);
+                case 't': case 'f': case 'n':
+                    return ParseLiteral();
+                default:
+                    if (c == '-' || IsDigit(c)) return ParseNumber();
+                    return Fail("unexpected character");
+                }
+            }
+        }
+    }
+
+    static int HexDigit(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    static bool ReadHex4(const char* p, const char* end, unsigned& value)
+    {
+        if (end - p < 4) return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const int d = HexDigit(p[i]);
+            if (d < 0) return false;
+            value = (value << 4) | (unsigned)d;
+        }
+        return true;
+    }
+
+    Token Reader::ParseString(bool isKey)
+    {
+        const char* start = ++pos;
+        const char* run = ScanString(pos, end);
+        if (run < end && *run == '"')
+        {
+            // No escapes: point straight into the input
+            text = std::string_view(start, (size_t)(run - start));
+            pos = run + 1;
+        }
+        else
+        {
+            scratch.assign(start, (size_t)(run - start));
+            pos = run;
+            for (;;)
+            {
+                if (pos == end) return Fail("unterminated string");
+                const char c = *pos;
+                if (c == '"') { ++pos; break; }
+                if ((unsigned char)c < 0x20) return Fail("control character in string");
+                // c == '\\'
+                if (++pos == end) return Fail("unterminated string");
+                const char e = *pos++;
+                switch (e)
+                {
+                case '"': case '\\': case '/': scratch.push_back(e); break;
+                case 'b': scratch.push_back('\b'); break;
+                case 'f': scratch.push_back('\f'); break;
+                case 'n': scratch.push_back('\n'); break;
+                case 'r': scratch.push_back('\r'); break;
+                case 't': scratch.push_back('\t'); break;
+                case 'u':
+                {
+                    unsigned cp;
+                    if (!ReadHex4(pos, end, cp)) return Fail("invalid \\u escape");
+                    pos += 4;
+                    if (cp >= 0xD800 && cp <= 0xDBFF)
+                    {
+                        unsigned low;
+                        if (end - pos >= 6 && pos[0] == '\\' && pos[1] == 'u' && ReadHex4(pos + 2, end, low) && low >= 0xDC00 && low <= 0xDFFF)
+                        {
+                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            pos += 6;
+                        }
+                        else
+                        {
+                            cp = 0xFFFD;  // lone high surrogate
+                        }
+                    }
+                    else if (cp >= 0xDC00 && cp <= 0xDFFF)
+                    {
+                        cp = 0xFFFD;  // lone low surrogate
+                    }
+                    AppendUtf8(scratch, cp);
+                    break;
+                }
+                default:
+                    return Fail("invalid escape");
+                }
+                run = ScanString(pos, end);
+                scratch.append(pos, (size_t)(run - pos));
+                pos = run;
+            }
+            text = scratch;
+        }
+        if (isKey)
+        {
+            expect = Expect::Colon;
+            return Token::Key;
+        }
+        expect = Expect::AfterValue;
+        return Token::String;
+    }
+
+    Token Reader::ParseNumber()
+    {
+        const char* start = pos;
+        if (*pos == '-') ++pos;
+        if (pos == end || !IsDigit(*pos)) return Fail("invalid number");
+        if (*pos == '0') ++pos;
+        else while (pos < end && IsDigit(*pos)) ++pos;
+        if (pos < end && *pos == '.')
+        {
+            ++pos;
+            if (pos == end || !IsDigit(*pos)) return Fail("invalid number");
+            while (pos < end && IsDigit(*pos)) ++pos;
+        }
+        if (pos < end && (*pos == 'e' || *pos == 'E'))
+        {
+            ++pos;
+            if (pos < end && (*pos == '+' || *pos == '-')) ++pos;
+            if (pos == end || !IsDigit(*pos)) return Fail("invalid number");
+            while (pos < end && IsDigit(*pos)) ++pos;
+        }
+        text = std::string_view(start, (size_t)(pos - start));
+        expect = Expect::AfterValue;
+        return Token::Number;
+    }
+
+    Token Reader::ParseLiteral()
+    {
+        static const struct { const char* word; size_t len; Token token; } literals[] = {
+            { "true", 4, Token::True }, { "false", 5, Token::False }, { "null", 4, Token::Null },
+        };
+        for (const auto& lit : literals)
+        {
+            if ((size_t)(end - pos) >= lit.len && std::string_view(pos, lit.len) == std::string_view(lit.word, lit.len))
+            {
+                text = std::string_view(pos, lit.len);
+                pos += lit.len;
+                expect = Expect::AfterValue;
+                return lit.token;
+            }
+        }
+        return Fail("invalid literal");
+    }
+
+    bool Reader::UInt(uint64_t& value) const
+    {
+        if (text.empty() || !IsDigit(text[0])) return false;
+        uint64_t v = 0;
+        for (char c : text)
+        {
+            if (!IsDigit(c)) return false;
+            const uint64_t d = (uint64_t)(c - '0');
+            if (v > (UINT64_MAX - d) / 10) return false;
+            v = v * 10 + d;
+        }
+        value = v;
+        return true;
+    }
+
+    bool Reader::SkipValue()
+    {
+        const Token t = Next();
+        if (t == Token::Error || t == Token::End || t == Token::ObjectEnd || t == Token::ArrayEnd) return false;
+        if (t != Token::ObjectBegin && t != Token::ArrayBegin) return true;
+        const size_t depth = stack.size();
+        while (stack.size() >= depth)
+        {
+            if (Next() == Token::Error) return false;
+        }
+        return true;
+    }
+
+    // ---- Writer --------------------------------------------------------------------------------
+
+    Writer::Writer(std::string& out, int indent) : out(out), indent(indent)
+    {
+    }
+
+    void Writer::NewLine()
+    {
+        if (indent <= 0) return;
+        out.push_back('\n');
+        out.append(levels.size() * (size_t)indent, ' ');
+    }
+
+    void Writer::BeforeValue()
+    {
+        started = true;
+        if (afterKey) { afterKey = false; return; }
+        if (levels.empty()) return;
+        if (levels.back()++ > 0) out.push_back(',');
+        NewLine();
+    }
+
+    Writer& Writer::BeginObject()
+    {
+        BeforeValue();
+        out.push_back('{');
+        levels.push_back(0);
+        return *this;
+    }
+
+    Writer& Writer::EndObject()
+    {
+        const bool empty = levels.back() == 0;
+        levels.pop_back();
+        if (!empty) NewLine();
+        out.push_back('}');
+        return *this;
+    }
+
+    Writer& Writer::BeginArray()
+    {
+        BeforeValue();
+        out.push_back('[');
+        levels.push_back(0);
+        return *this;
+    }
+
+    Writer& Writer::EndArray()
+    {
+        const bool empty = levels.back() == 0;
+        levels.pop_back();
+        if (!empty) NewLine();
+        out.push_back(']');
+        return *this;
+    }
+
+    Writer& Writer::Key(std::string_view key)
+    {
+        BeforeValue();
+        out.push_back('"');
+        AppendEscaped(out, key);
+        out += indent > 0 ? "\": " : "\":";
+        afterKey = true;
+        return *this;
+    }
+
+    Writer& Writer::String(std::string_view value)
+    {
+        BeforeValue();
+        out.push_back('"');
+        AppendEscaped(out, value);
+        out.push_back('"');
+        return *this;
+    }
+
+    Writer& Writer::UInt(uint64_t value)
+    {
+        BeforeValue();
+        char buf[24];
+        out.append(buf, (size_t)std::snprintf(buf, sizeof(buf), "%llu", (unsigned long long)value));
+        return *this;
+    }
+
+    Writer& Writer::Int(int64_t value)
+    {
+        BeforeValue();
+        char buf[24];
+        out.append(buf, (size_t)std::snprintf(buf, sizeof(buf), "%lld", (long long)value));
+        return *this;
+    }
+
+    Writer& Writer::Double(double value)
+    {
+        BeforeValue();
+        if (!std::isfinite(value)) { out += "null"; return *this; }  // JSON has no NaN/Inf
+        char buf[32];
+        out.append(buf, (size_t)std::snprintf(buf, sizeof(buf), "%.17g", value));
+        return *this;
+    }
+
+    Writer& Writer::Bool(bool value)
+    {
+        BeforeValue();
+        out += value ? "true" : "false";
+        return *this;
+    }
+
+    Writer& Writer::Null()
+    {
+        BeforeValue();
+        out += "null";
+        return *this;
+    }
+
+    bool ReadFile(const std::filesystem::path& path, std::string& out)
+    {
+        out.clear();
+        std::ifstream ifs(path, std::ios::in | std::ios::binary);
+        if (!ifs) return false;
+        ifs.seekg(0, std::ios::end);
+        const std::streamoff size = ifs.tellg();
+        if (size < 0) return false;
+        ifs.seekg(0, std::ios::beg);
+        out.resize((size_t)size);
+        if (size > 0 && !ifs.read(&out[0], size)) { out.clear(); return false; }
+        return true;
+    }
+}
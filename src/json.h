@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Shared JSON reader/writer for prefs, imports and the Cursor/VS files VSInspector reads.
+// Reader is a validating pull parser over a complete buffer: no DOM, one pass, strings come back
+// as string_views (into the input when they have no escapes, into a scratch buffer otherwise).
+// Plain string runs are skipped 16 bytes at a time with SSE2 where the target has it.
+// Writer appends to a caller-owned std::string with the same escaping rules.
+// Bytes >= 0x80 are passed through as-is in both directions: prefs hold ANSI-code-page paths.
+namespace Json
+{
+    enum class Token { ObjectBegin, ObjectEnd, ArrayBegin, ArrayEnd, Key, String, Number, True, False, Null, End, Error };
+
+    // First byte in [p, end) that ends a plain string run: '"', '\\' or a control character
+    const char* ScanString(const char* p, const char* end);
+
+    // Append code point cp as UTF-8
+    void AppendUtf8(std::string& out, unsigned cp);
+
+    // Append s with JSON string escaping (without the surrounding quotes)
+    void AppendEscaped(std::string& out, std::string_view s);
+
+    class Reader
+    {
+    public:
+        explicit Reader(std::string_view input);
+
+        // Next token; End once the single top-level value is complete, Error (sticky) on malformed input
+        Token Next();
+
+        // Key/String: unescaped text, valid until the next call to Next(). Number: source text.
+        std::string_view Text() const { return text; }
+
+        // Current Number token as an unsigned integer; false if it is negative, fractional or too large
+        bool UInt(uint64_t& value) const;
+
+        // Skip the next value (after a Key, or inside an array), nested containers included
+        bool SkipValue();
+
+        // Open containers
+        size_t Depth() const { return stack.size(); }
+
+        bool Failed() const { return failed; }
+        const std::string& Error() const { return error; }
+        size_t Offset() const { return (size_t)(pos - begin); }
+
+    private:
+        enum class Expect { Value, ValueOrClose, Key, KeyOrClose, Colon, AfterValue };
+
+        Token Fail(const char* what);
+        Token Close(char c);
+        Token ParseString(bool isKey);
+        Token ParseNumber();
+        Token ParseLiteral();
+
+        const char* begin;
+        const char* pos;
+        const char* end;
+        std::vector<char> stack;  // '{' or '[' per open container
+        Expect expect = Expect::Value;
+        bool started = false;
+        bool failed = false;
+        std::string_view text;
+        std::string scratch;
+        std::string error;
+    };
+
+    class Writer
+    {
+    public:
+        // indent 0 writes compact JSON; otherwise one member per line, indented by `indent` spaces
+        explicit Writer(std::string& out, int indent = 2);
+
+        Writer& BeginObject();
+        Writer& EndObject();
+        Writer& BeginArray();
+        Writer& EndArray();
+        Writer& Key(std::string_view key);
+        Writer& String(std::string_view value);
+        Writer& UInt(uint64_t value);
+        Writer& Int(int64_t value);
+        Writer& Double(double value);
+        Writer& Bool(bool value);
+        Writer& Null();
+
+        // True once the top-level value is closed
+        bool Complete() const { return started && levels.empty(); }
+
+    private:
+        void BeforeValue();
+        void NewLine();
+
+        std::string& out;
+        int indent;
+        std::vector<uint32_t> levels;  // values written per open container
+        bool afterKey = false;
+        bool started = false;
+    };
+
+    // Whole file into out; false if it cannot be opened or read
+    bool ReadFile(const std::filesystem::path& path, std::string& out);
+}
@@ -0,0 +1,455 @@
+#include "launch_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#ifdef _WIN32
+#include <windows.h>
+#include <tlhelp32.h>
+#elif defined(__linux__)
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace LaunchScheduler
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Job
+    {
+        uint64_t id = 0;
+        Resolver resolve;
+        Done onDone;
+        Clock::time_point queuedAt;
+    };
+
+    static std::mutex g_mutex;  // guards everything below
+    static std::condition_variable g_wake;
+    static std::vector<std::thread> g_workers;
+    static std::deque<Job> g_queue;
+    static std::vector<Launch> g_launches;  // ordered by id
+    static uint64_t g_nextId = 1;
+    static int g_concurrency = kDefaultConcurrency;
+    static int g_running = 0;
+    static bool g_stopping = false;
+
+    static double MsSince(Clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    const char* StateName(State s)
+    {
+        switch (s)
+        {
+        case State::Queued: return "queued";
+        case State::Starting: return "starting";
+        case State::Waiting: return "waiting for window";
+        case State::Ready: return "ready";
+        case State::HandedOff: return "handed off";
+        case State::Failed: return "failed";
+        case State::TimedOut: return "timed out";
+        }
+        return "?";
+    }
+
+    bool IsFinished(State s)
+    {
+        return s == State::Ready || s == State::HandedOff || s == State::Failed || s == State::TimedOut;
+    }
+
+    // Caller holds g_mutex
+    static Launch* FindLocked(uint64_t id)
+    {
+        auto it = std::lower_bound(g_launches.begin(), g_launches.end(), id,
+                                   [](const Launch& l, uint64_t v) { return l.id < v; });
+        return it != g_launches.end() && it->id == id ? &*it : nullptr;
+    }
+
+    // Caller holds g_mutex; drops the oldest finished records beyond kKeepFinished
+    static void TrimLocked()
+    {
+        size_t finished = 0;
+        for (const Launch& l : g_launches) finished += IsFinished(l.state) ? 1 : 0;
+        for (auto it = g_launches.begin(); it != g_launches.end() && finished > kKeepFinished;)
+        {
+            if (IsFinished(it->state)) { it = g_launches.erase(it); --finished; }
+            else ++it;
+        }
+    }
+
+    // ---- Platform: start a command line and watch it come up ----------------------------------
+
+    enum class Probe { Running, Ready, Exited };
+
+#ifdef _WIN32
+    struct Process
+    {
+        HANDLE handle = NULL;
+        uint32_t pid = 0;
+    };
+
+    static bool Spawn(const std::string& commandLine, Process& p, std::string& error)
+    {
+        STARTUPINFOA si = { sizeof(si) };
+        PROCESS_INFORMATION pi = {};
+        si.dwFlags = STARTF_USESHOWWINDOW;
+        si.wShowWindow = SW_SHOW;
+        std::string cmd = commandLine;  // CreateProcessA may write into the buffer
+        if (!CreateProcessA(NULL, &cmd[0], NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
+        {
+            error = "CreateProcess failed, error: " + std::to_string(GetLastError());
+            return false;
+        }
+        CloseHandle(pi.hThread);
+        p.handle = pi.hProcess;
+        p.pid = pi.dwProcessId;
+        return true;
+    }
+
+    static void Close(Process& p)
+    {
+        if (p.handle) CloseHandle(p.handle);
+        p.handle = NULL;
+    }
+
+    // The started process and everything it spawned (launcher stubs start the real app as a child)
+    static std::vector<DWORD> ProcessTree(DWORD root, bool includeRoot)
+    {
+        std::vector<DWORD> tree;
+        if (includeRoot) tree.push_back(root);
+        HANDLE snap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+        if (snap == INVALID_HANDLE_VALUE) return tree;
+        std::unordered_multimap<DWORD, DWORD> children;
+        PROCESSENTRY32 pe = { sizeof(pe) };
+        for (BOOL ok = Process32First(snap, &pe); ok; ok = Process32Next(snap, &pe))
+            children.emplace(pe.th32ParentProcessID, pe.th32ProcessID);
+        CloseHandle(snap);
+        std::vector<DWORD> frontier{ root };
+        while (!frontier.empty() && tree.size() < 256)
+        {
+            DWORD parent = frontier.back();
+            frontier.pop_back();
+            auto range = children.equal_range(parent);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == root || std::find(tree.begin(), tree.end(), it->second) != tree.end()) continue;
+                tree.push_back(it->second);
+                frontier.push_back(it->second);
+            }
+        }
+        return tree;
+    }
+
+    struct WindowSearch
+    {
+        const std::vector<DWORD>* pids;
+        bool found;
+    };
+
+    static BOOL CALLBACK FindVisibleWindow(HWND hwnd, LPARAM lParam)
+    {
+        WindowSearch* search = (WindowSearch*)lParam;
+        if (!IsWindowVisible(hwnd) || GetWindow(hwnd, GW_OWNER) != NULL) return TRUE;
+        DWORD pid = 0;
+        GetWindowThreadProcessId(hwnd, &pid);
+        if (std::find(search->pids->begin(), search->pids->end(), pid) == search->pids->end()) return TRUE;
+        search->found = true;
+        return FALSE;
+    }
+
+    static bool HasVisibleWindow(const std::vector<DWORD>& pids)
+    {
+        if (pids.empty()) return false;
+        WindowSearch search{ &pids, false };
+        EnumWindows(FindVisibleWindow, (LPARAM)&search);
+        return search.found;
+    }
+
+    static Probe Poll(Process& p, int waitMs, double /*sinceSpawnMs*/, uint32_t& exitCode)
+    {
+        const bool exited = WaitForSingleObject(p.handle, 0) == WAIT_OBJECT_0;
+        std::vector<DWORD> tree = ProcessTree(p.pid, !exited);
+        if (HasVisibleWindow(tree)) return Probe::Ready;
+        if (exited)
+        {
+            DWORD code = 0;
+            GetExitCodeProcess(p.handle, &code);
+            exitCode = code;
+            // A launcher that left children behind is still coming up
+            if (tree.empty()) return Probe::Exited;
+            Sleep(waitMs);
+            return Probe::Running;
+        }
+        WaitForSingleObject(p.handle, waitMs);
+        return Probe::Running;
+    }
+
+    static void ReapDetached() {}
+#elif defined(__linux__)
+    struct Process
+    {
+        pid_t pid = -1;
+    };
+
+    static constexpr double kSettleMs = 500.0;
+    static std::vector<pid_t> g_detached;  // ready children not waited for yet (guarded by g_mutex)
+
+    static bool Spawn(const std::string& commandLine, Process& p, std::string& error)
+    {
+        std::string script = "exec " + commandLine;
+        char* argv[] = { (char*)"/bin/sh", (char*)"-c", &script[0], nullptr };
+        pid_t pid = -1;
+        int rc = posix_spawn(&pid, "/bin/sh", nullptr, nullptr, argv, environ);
+        if (rc != 0)
+        {
+            error = "posix_spawn failed, error: " + std::to_string(rc);
+            return false;
+        }
+        p.pid = pid;
+        return true;
+    }
+
+    static void Close(Process& p)
+    {
+        if (p.pid <= 0) return;
+        // Still running: reap it later so it does not linger as a zombie once it exits
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_detached.push_back(p.pid);
+        p.pid = -1;
+    }
+
+    // No window probe here: a process that survives the settle time counts as up
+    static Probe Poll(Process& p, int waitMs, double sinceSpawnMs, uint32_t& exitCode)
+    {
+        int status = 0;
+        if (waitpid(p.pid, &status, WNOHANG) == p.pid)
+        {
+            exitCode = WIFEXITED(status) ? (uint32_t)WEXITSTATUS(status) : 128u + (uint32_t)WTERMSIG(status);
+            p.pid = -1;
+            return Probe::Exited;
+        }
+        if (sinceSpawnMs >= kSettleMs) return Probe::Ready;
+        std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+        return Probe::Running;
+    }
+
+    static void ReapDetached()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_detached.erase(std::remove_if(g_detached.begin(), g_detached.end(),
+                                        [](pid_t pid) { return waitpid(pid, nullptr, WNOHANG) != 0; }),
+                         g_detached.end());
+    }
+#else
+    struct Process { int pid = 0; };
+
+    static bool Spawn(const std::string&, Process&, std::string& error)
+    {
+        error = "launching is not supported on this platform";
+        return false;
+    }
+
+    static void Close(Process&) {}
+    static Probe Poll(Process&, int, double, uint32_t&) { return Probe::Exited; }
+    static void ReapDetached() {}
+#endif
+
+    // ---- Workers --------------------------------------------------------------------------------
+
+    static void Finish(uint64_t id, State state, const std::string& detail, const Done& onDone)
+    {
+        Launch copy;
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            Launch* l = FindLocked(id);
+            if (!l) return;
+            l->state = state;
+            l->detail = detail;
+            copy = *l;
+            TrimLocked();
+        }
+        if (onDone) onDone(copy);
+    }
+
+    static void RunJob(const Job& job)
+    {
+        const Clock::time_point t0 = Clock::now();
+        Command command = job.resolve ? job.resolve() : Command{};
+        if (command.commandLine.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(g_mutex);
+                if (Launch* l = FindLocked(job.id)) l->spawnMs = MsSince(t0);
+            }
+            Finish(job.id, State::Failed, command.error.empty() ? "nothing to launch" : command.error, job.onDone);
+            return;
+        }
+
+        Process process;
+        std::string error;
+        const bool spawned = Spawn(command.commandLine, process, error);
+        const Clock::time_point spawnedAt = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            if (Launch* l = FindLocked(job.id))
+            {
+                l->spawnMs = MsSince(t0);
+                if (spawned)
+                {
+                    l->state = State::Waiting;
+                    l->pid = process.pid > 0 ? (uint32_t)process.pid : 0;
+                }
+            }
+        }
+        if (!spawned)
+        {
+            Finish(job.id, State::Failed, error, job.onDone);
+            return;
+        }
+
+        State state = State::TimedOut;
+        std::string detail;
+        for (;;)
+        {
+            {
+                std::lock_guard<std::mutex> lock(g_mutex);
+                if (g_stopping) { state = State::Failed; detail = "cancelled"; break; }
+            }
+            const double since = MsSince(spawnedAt);
+            if (since >= kReadyTimeoutMs) break;
+            uint32_t exitCode = 0;
+            Probe probe = Poll(process, 100, since, exitCode);
+            if (probe == Probe::Ready) { state = State::Ready; break; }
+            if (probe == Probe::Exited)
+            {
+                state = exitCode == 0 ? State::HandedOff : State::Failed;
+                detail = "exit code " + std::to_string(exitCode);
+                break;
+            }
+        }
+        Close(process);
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            if (Launch* l = FindLocked(job.id)) l->readyMs = MsSince(spawnedAt);
+        }
+        Finish(job.id, state, detail, job.onDone);
+    }
+
+    static void Worker()
+    {
+        std::unique_lock<std::mutex> lock(g_mutex);
+        for (;;)
+        {
+            g_wake.wait(lock, []() { return g_stopping || (!g_queue.empty() && g_running < g_concurrency); });
+            if (g_stopping) return;
+            Job job = std::move(g_queue.front());
+            g_queue.pop_front();
+            ++g_running;
+            if (Launch* l = FindLocked(job.id))
+            {
+                l->state = State::Starting;
+                l->queuedMs = MsSince(job.queuedAt);
+            }
+            lock.unlock();
+            RunJob(job);
+            ReapDetached();
+            lock.lock();
+            --g_running;
+            // A slot freed up (or the limit was raised meanwhile)
+            g_wake.notify_all();
+        }
+    }
+
+    uint64_t Enqueue(const std::string& label, Resolver resolve, Done onDone)
+    {
+        uint64_t id = 0;
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            id = g_nextId++;
+            Launch l;
+            l.id = id;
+            l.label = label;
+            g_launches.push_back(l);
+            Job job;
+            job.id = id;
+            job.resolve = std::move(resolve);
+            job.onDone = std::move(onDone);
+            job.queuedAt = Clock::now();
+            g_queue.push_back(std::move(job));
+            // Workers are started on demand and stay parked until Shutdown()
+            const size_t wanted = std::min<size_t>((size_t)g_concurrency, (size_t)g_running + g_queue.size());
+            while (g_workers.size() < wanted) g_workers.emplace_back(Worker);
+        }
+        g_wake.notify_all();
+        return id;
+    }
+
+    std::vector<Launch> Launches()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_launches;
+    }
+
+    size_t Pending()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_queue.size() + (size_t)g_running;
+    }
+
+    void SetConcurrency(int n)
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            g_concurrency = std::max(1, std::min(kMaxConcurrency, n));
+            const size_t wanted = std::min<size_t>((size_t)g_concurrency, (size_t)g_running + g_queue.size());
+            while (g_workers.size() < wanted) g_workers.emplace_back(Worker);
+        }
+        g_wake.notify_all();
+    }
+
+    int Concurrency()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_concurrency;
+    }
+
+    void ClearFinished()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_launches.erase(std::remove_if(g_launches.begin(), g_launches.end(),
+                                        [](const Launch& l) { return IsFinished(l.state); }),
+                         g_launches.end());
+    }
+
+    void Shutdown()
+    {
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            g_stopping = true;
+            for (const Job& job : g_queue)
+            {
+                if (Launch* l = FindLocked(job.id))
+                {
+                    l->state = State::Failed;
+                    l->detail = "cancelled";
+                }
+            }
+            g_queue.clear();
+            workers.swap(g_workers);
+        }
+        g_wake.notify_all();
+        for (std::thread& t : workers) t.join();
+        ReapDetached();
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_stopping = false;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Background launcher for VSInspector's "open VS / Cursor / Feishu / WeChat" actions.
+// Launches are queued from the UI thread and run on a small worker pool; at most Concurrency()
+// of them are in flight (resolving the executable, starting it, waiting for it to come up) at
+// any time. A launch counts as ready once the started process or one of its children shows a
+// visible top-level window (Windows), or once it is still running after a short settle time
+// elsewhere. A launcher that exits with code 0 before any window appears has handed the request
+// to an instance that was already running (Cursor, Feishu) and is reported as HandedOff.
+namespace LaunchScheduler
+{
+    constexpr int kDefaultConcurrency = 2;
+    constexpr int kMaxConcurrency = 8;
+    constexpr double kReadyTimeoutMs = 120000.0;  // devenv with a large solution can take a while
+    constexpr size_t kKeepFinished = 32;          // finished launches kept for the status list
+
+    enum class State { Queued, Starting, Waiting, Ready, HandedOff, Failed, TimedOut };
+
+    // What to start; filled by the resolver on the worker thread (exe lookup touches the disk)
+    struct Command
+    {
+        std::string commandLine;  // empty: nothing to start, error says why
+        std::string error;
+    };
+    using Resolver = std::function<Command()>;
+
+    struct Launch
+    {
+        uint64_t id = 0;
+        std::string label;
+        State state = State::Queued;
+        uint32_t pid = 0;
+        double queuedMs = 0.0;  // waiting for a free slot
+        double spawnMs = 0.0;   // resolve + process creation
+        double readyMs = 0.0;   // process creation to window / hand-off
+        std::string detail;     // error or exit code
+    };
+
+    // Called on the worker thread once a launch reaches a final state
+    using Done = std::function<void(const Launch&)>;
+
+    // Queue a launch and return its id. Never blocks.
+    uint64_t Enqueue(const std::string& label, Resolver resolve, Done onDone = nullptr);
+
+    // Queued, running and the last kKeepFinished finished launches, oldest first
+    std::vector<Launch> Launches();
+
+    // Queued + in flight
+    size_t Pending();
+
+    // Clamped to [1, kMaxConcurrency]; applies to launches that have not started yet
+    void SetConcurrency(int n);
+    int Concurrency();
+
+    void ClearFinished();
+
+    // Drop queued launches, stop waiting on running ones and join the workers
+    void Shutdown();
+
+    const char* StateName(State s);
+    bool IsFinished(State s);
+}
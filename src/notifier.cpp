@@ -0,0 +1,385 @@
+#include "notifier.h"
+#include "imgui.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#if defined(__linux__)
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace Notifier
+{
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kLatencySamples = 128;
+
+    struct Queued
+    {
+        Event event;
+        double postedMs = 0.0;
+    };
+
+    struct Channel
+    {
+        std::string name;
+        std::string topic;
+        std::shared_ptr<Sink> sink;
+        ChannelLimits limits;
+        std::vector<Queued> queue;
+        std::unordered_map<std::string, size_t> keys;  // key -> index in queue
+        size_t droppedPending = 0;                     // dropped since the last delivery
+        double lastPostMs = 0.0;
+        double lastDeliveryMs = -1e300;
+        ChannelStats stats;
+        double latency[kLatencySamples] = {};
+        size_t latencyCount = 0;
+        size_t latencyPos = 0;
+    };
+
+    static std::mutex g_mutex;  // guards everything below
+    static std::vector<Channel> g_channels;
+    static std::unordered_map<std::string, Formatter> g_formatters;
+    static uint64_t g_nextId = 1;
+
+    static double NowMs()
+    {
+        static const Clock::time_point t0 = Clock::now();
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    static Channel* FindChannel(const std::string& name)
+    {
+        for (auto& c : g_channels) if (c.name == name) return &c;
+        return nullptr;
+    }
+
+    static void DefaultFormat(Notification& n)
+    {
+        if (n.count == 1 && !n.preview.empty())
+        {
+            n.title = n.preview[0].title;
+            n.body = n.preview[0].body;
+            return;
+        }
+        n.title = std::to_string(n.count) + " notifications";
+        for (const Event& e : n.preview)
+        {
+            if (!n.body.empty()) n.body += ", ";
+            n.body += e.title;
+        }
+        if (n.count > n.preview.size()) n.body += ", ...";
+    }
+
+    void SetFormatter(const std::string& topic, Formatter format)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_formatters[topic] = std::move(format);
+    }
+
+    void AddChannel(const std::string& name, const std::string& topic, std::shared_ptr<Sink> sink, ChannelLimits limits)
+    {
+        if (!sink) return;
+        std::lock_guard<std::mutex> lock(g_mutex);
+        Channel* c = FindChannel(name);
+        if (!c)
+        {
+            g_channels.emplace_back();
+            c = &g_channels.back();
+        }
+        *c = Channel();
+        c->name = name;
+        c->topic = topic;
+        c->sink = std::move(sink);
+        c->limits = limits;
+        c->stats.name = name;
+        c->stats.sink = c->sink->Name();
+    }
+
+    void RemoveChannel(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_channels.erase(std::remove_if(g_channels.begin(), g_channels.end(),
+                                        [&](const Channel& c) { return c.name == name; }),
+                         g_channels.end());
+    }
+
+    void Post(const std::string& topic, Event event)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        const double now = NowMs();
+        for (auto& c : g_channels)
+        {
+            if (c.topic != topic) continue;
+            c.stats.posted++;
+            c.lastPostMs = now;
+            if (!event.key.empty())
+            {
+                auto it = c.keys.find(event.key);
+                if (it != c.keys.end())
+                {
+                    // Same card again: newer text, but latency still counts from the first post
+                    c.queue[it->second].event = event;
+                    c.stats.merged++;
+                    continue;
+                }
+            }
+            if (c.queue.size() >= c.limits.maxQueued)
+            {
+                c.droppedPending++;
+                c.stats.dropped++;
+                continue;
+            }
+            if (!event.key.empty()) c.keys.emplace(event.key, c.queue.size());
+            c.queue.push_back(Queued{ event, now });
+            c.stats.queueDepth = c.queue.size();
+            c.stats.maxQueueDepth = std::max(c.stats.maxQueueDepth, c.queue.size());
+        }
+    }
+
+    static void RecordLatency(Channel& c, double ms)
+    {
+        c.latency[c.latencyPos] = ms;
+        c.latencyPos = (c.latencyPos + 1) % kLatencySamples;
+        c.latencyCount = std::min(c.latencyCount + 1, kLatencySamples);
+        std::vector<double> sorted(c.latency, c.latency + c.latencyCount);
+        std::sort(sorted.begin(), sorted.end());
+        c.stats.latencyP50Ms = sorted[(sorted.size() - 1) / 2];
+        c.stats.latencyP95Ms = sorted[(size_t)((sorted.size() - 1) * 0.95)];
+        c.stats.latencyMaxMs = std::max(c.stats.latencyMaxMs, ms);
+    }
+
+    void Pump()
+    {
+        struct Ready
+        {
+            std::string channel;
+            std::shared_ptr<Sink> sink;
+            Notification n;
+            Formatter format;
+        };
+        std::vector<Ready> ready;
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            const double now = NowMs();
+            for (auto& c : g_channels)
+            {
+                if (c.queue.empty()) continue;
+                const double oldest = c.queue.front().postedMs;
+                const bool burstOver = now - c.lastPostMs >= kQuietMs || now - oldest >= kMaxBatchDelayMs;
+                if (!burstOver || now - c.lastDeliveryMs < c.limits.minIntervalMs) continue;
+
+                Ready r;
+                r.channel = c.name;
+                r.sink = c.sink;
+                r.n.id = g_nextId++;
+                r.n.topic = c.topic;
+                r.n.count = c.queue.size() + c.droppedPending;
+                r.n.latencyMs = now - oldest;
+                const size_t preview = std::min(c.queue.size(), kPreviewEvents);
+                r.n.preview.reserve(preview);
+                for (size_t i = 0; i < preview; ++i) r.n.preview.push_back(std::move(c.queue[i].event));
+                auto f = g_formatters.find(c.topic);
+                if (f != g_formatters.end()) r.format = f->second;
+
+                c.queue.clear();
+                c.keys.clear();
+                c.droppedPending = 0;
+                c.lastDeliveryMs = now;
+                c.stats.queueDepth = 0;
+                RecordLatency(c, r.n.latencyMs);
+                ready.push_back(std::move(r));
+            }
+        }
+        if (ready.empty()) return;
+
+        // Sinks run without the lock: they may post, or take a while (process spawn)
+        for (auto& r : ready)
+        {
+            if (r.format) r.format(r.n);
+            else DefaultFormat(r.n);
+            const bool ok = r.sink->Deliver(r.n);
+            std::lock_guard<std::mutex> lock(g_mutex);
+            if (Channel* c = FindChannel(r.channel))
+            {
+                if (ok) c->stats.delivered++;
+                else c->stats.failed++;
+            }
+        }
+    }
+
+    std::vector<ChannelStats> Stats()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        std::vector<ChannelStats> out;
+        out.reserve(g_channels.size());
+        for (const auto& c : g_channels) out.push_back(c.stats);
+        return out;
+    }
+
+    // ---- In-app toast ----
+
+    struct Toast
+    {
+        std::string title;
+        std::string body;
+        double shownAtMs = 0.0;
+        double showMs = 0.0;
+    };
+
+    static constexpr size_t kMaxToasts = 4;
+    static std::deque<Toast> g_toasts;  // UI thread only, newest last
+
+    class ToastSink : public Sink
+    {
+    public:
+        explicit ToastSink(double showMs) : showMs(showMs) {}
+        const char* Name() const override { return "toast"; }
+        bool Deliver(const Notification& n) override
+        {
+            g_toasts.push_back(Toast{ n.title, n.body, NowMs(), showMs });
+            while (g_toasts.size() > kMaxToasts) g_toasts.pop_front();
+            return true;
+        }
+
+    private:
+        double showMs;
+    };
+
+    std::shared_ptr<Sink> MakeToastSink(double showMs)
+    {
+        return std::make_shared<ToastSink>(showMs);
+    }
+
+    void DrawToasts()
+    {
+        if (g_toasts.empty()) return;
+        const double now = NowMs();
+        g_toasts.erase(std::remove_if(g_toasts.begin(), g_toasts.end(),
+                                      [&](const Toast& t) { return now - t.shownAtMs >= t.showMs; }),
+                       g_toasts.end());
+
+        const ImVec2 display = ImGui::GetIO().DisplaySize;
+        const float pad = 12.0f;
+        float y = display.y - pad;
+        const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
+                                       ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs;
+        int index = 0;
+        for (auto it = g_toasts.rbegin(); it != g_toasts.rend(); ++it, ++index)
+        {
+            // Fade out over the last 500 ms
+            const double left = it->showMs - (now - it->shownAtMs);
+            const float alpha = left < 500.0 ? (float)(left / 500.0) : 1.0f;
+            ImGui::SetNextWindowPos(ImVec2(display.x - pad, y), ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+            ImGui::SetNextWindowBgAlpha(0.85f * alpha);
+            char id[32];
+            snprintf(id, sizeof(id), "##toast%d", index);
+            if (ImGui::Begin(id, nullptr, flags))
+            {
+                ImGui::PushTextWrapPos(ImGui::GetFontSize() * 24.0f);
+                ImGui::TextUnformatted(it->title.c_str());
+                if (!it->body.empty()) ImGui::TextDisabled("%s", it->body.c_str());
+                ImGui::PopTextWrapPos();
+                y -= ImGui::GetWindowHeight() + 6.0f;
+            }
+            ImGui::End();
+        }
+    }
+
+    // ---- Desktop notification ----
+
+#if defined(__linux__)
+    // notify-send stands in for a D-Bus client: one short-lived process per (already batched,
+    // rate-limited) notification. Arguments go straight to exec, no shell.
+    class DesktopSink : public Sink
+    {
+    public:
+        explicit DesktopSink(const std::string& appName) : appName(appName) {}
+        ~DesktopSink() override { Reap(); }
+        const char* Name() const override { return "notify-send"; }
+        bool Deliver(const Notification& n) override
+        {
+            Reap();
+            if (unavailable) return false;
+            std::string title = n.title, body = n.body;
+            char* argv[] = { (char*)"notify-send", (char*)"-a", &appName[0], (char*)"--", &title[0], &body[0], nullptr };
+            pid_t pid = -1;
+            if (posix_spawnp(&pid, "notify-send", nullptr, nullptr, argv, environ) != 0)
+            {
+                unavailable = true;  // not installed: stop trying
+                return false;
+            }
+            children.push_back(pid);
+            return true;
+        }
+
+    private:
+        void Reap()
+        {
+            children.erase(std::remove_if(children.begin(), children.end(),
+                                          [](pid_t pid) { return waitpid(pid, nullptr, WNOHANG) != 0; }),
+                           children.end());
+        }
+
+        std::string appName;
+        std::vector<pid_t> children;
+        bool unavailable = false;
+    };
+
+    std::shared_ptr<Sink> MakeDesktopSink(const std::string& appName)
+    {
+        return std::make_shared<DesktopSink>(appName);
+    }
+#else
+    std::shared_ptr<Sink> MakeDesktopSink(const std::string&)
+    {
+        return nullptr;
+    }
+#endif
+
+    void DrawStats()
+    {
+        std::vector<ChannelStats> stats = Stats();
+        if (stats.empty())
+        {
+            ImGui::TextDisabled("(no channels)");
+            return;
+        }
+        if (!ImGui::BeginTable("##notifier_stats", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+            return;
+        ImGui::TableSetupColumn("channel");
+        ImGui::TableSetupColumn("sink");
+        ImGui::TableSetupColumn("events");
+        ImGui::TableSetupColumn("sent / failed");
+        ImGui::TableSetupColumn("merged / dropped");
+        ImGui::TableSetupColumn("queue (max)");
+        ImGui::TableSetupColumn("latency p50/p95/max ms");
+        ImGui::TableHeadersRow();
+        for (const auto& s : stats)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(s.name.c_str());
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(s.sink.c_str());
+            ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)s.posted);
+            ImGui::TableNextColumn(); ImGui::Text("%llu / %llu", (unsigned long long)s.delivered, (unsigned long long)s.failed);
+            ImGui::TableNextColumn(); ImGui::Text("%llu / %llu", (unsigned long long)s.merged, (unsigned long long)s.dropped);
+            ImGui::TableNextColumn(); ImGui::Text("%zu (%zu)", s.queueDepth, s.maxQueueDepth);
+            ImGui::TableNextColumn(); ImGui::Text("%.0f / %.0f / %.0f", s.latencyP50Ms, s.latencyP95Ms, s.latencyMaxMs);
+        }
+        ImGui::EndTable();
+    }
+
+    void Shutdown()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_channels.clear();
+        g_formatters.clear();
+        g_toasts.clear();
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Notification engine: producers Post() events on a topic, presentation lives in sinks.
+// Every channel pairs one sink with a topic and its own rate limit. Events queued on a channel are
+// coalesced: Pump() delivers them as one Notification once the burst has gone quiet (or has been
+// going on for kMaxBatchDelayMs) and the channel's minimum interval since its last delivery has
+// passed, so a thousand cards falling due in the same tick show up as a single batch.
+// Post() may be called from any thread; Pump(), DrawToasts() and the sinks run on the UI thread.
+namespace Notifier
+{
+    constexpr double kQuietMs = 300.0;           // a burst ends after this long without new events
+    constexpr double kMaxBatchDelayMs = 2000.0;  // ...or at the latest this long after its first event
+    constexpr size_t kPreviewEvents = 5;         // events carried in a Notification for display
+
+    struct Event
+    {
+        std::string key;    // events with a key already queued on a channel replace it
+        std::string title;
+        std::string body;
+    };
+
+    struct Notification
+    {
+        uint64_t id = 0;
+        std::string topic;
+        std::string title;          // filled by the topic's formatter
+        std::string body;
+        size_t count = 0;           // events coalesced into this notification (dropped ones included)
+        std::vector<Event> preview; // the first kPreviewEvents of them
+        double latencyMs = 0.0;     // oldest event's Post() to delivery
+    };
+
+    class Sink
+    {
+    public:
+        virtual ~Sink() = default;
+        virtual const char* Name() const = 0;
+        // False if it could not be shown (helper missing, no window); counted as failed, not retried
+        virtual bool Deliver(const Notification& n) = 0;
+    };
+
+    struct ChannelLimits
+    {
+        double minIntervalMs = 0.0;  // at most one delivery per interval; events keep queueing meanwhile
+        size_t maxQueued = 10000;    // beyond this new events are only counted, not queued
+    };
+
+    // Builds title/body from count + preview; the default uses the single event's text or
+    // "<count> notifications" with the preview titles
+    using Formatter = std::function<void(Notification& n)>;
+
+    void SetFormatter(const std::string& topic, Formatter format);
+
+    // Replaces a channel with the same name
+    void AddChannel(const std::string& name, const std::string& topic, std::shared_ptr<Sink> sink, ChannelLimits limits = {});
+    void RemoveChannel(const std::string& name);
+
+    void Post(const std::string& topic, Event event);
+
+    // Deliver the batches that are ready; call once per frame
+    void Pump();
+
+    struct ChannelStats
+    {
+        std::string name;
+        std::string sink;
+        uint64_t posted = 0;      // events queued on this channel
+        uint64_t merged = 0;      // replaced by a later event with the same key
+        uint64_t dropped = 0;     // over maxQueued
+        uint64_t delivered = 0;   // notifications
+        uint64_t failed = 0;
+        size_t queueDepth = 0;
+        size_t maxQueueDepth = 0;
+        double latencyP50Ms = 0.0;  // over the last deliveries
+        double latencyP95Ms = 0.0;
+        double latencyMaxMs = 0.0;
+    };
+    std::vector<ChannelStats> Stats();
+
+    // In-app toast shown by DrawToasts() in the bottom-right corner of the main window
+    std::shared_ptr<Sink> MakeToastSink(double showMs = 6000.0);
+    void DrawToasts();
+
+    // Desktop notification through notify-send on Linux; nullptr where there is none
+    // (Windows reminders use WordReminder's own popup)
+    std::shared_ptr<Sink> MakeDesktopSink(const std::string& appName);
+
+    // Table of Stats() for a settings panel
+    void DrawStats();
+
+    // Remove all channels, queued events and toasts
+    void Shutdown();
+}
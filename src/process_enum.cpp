@@ -0,0 +1,347 @@
+#include "process_enum.h"
+#include "handle_scan.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#include <tlhelp32.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ProcessEnum
+{
+    void NameTable::Add(const std::string& name, int tag)
+    {
+        std::string key = name;
+        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+        if (key.empty()) return;
+        maxLength = std::max(maxLength, key.size());
+        if (key.size() < 64) lengthMask |= 1ull << key.size();
+        firstChars[(unsigned char)key[0]] = true;
+        tags[key] = tag;
+    }
+
+    int NameTable::Match(const std::string& name) const
+    {
+        // Nearly every process misses: reject on length and first character before hashing
+        if (name.empty() || name.size() > maxLength) return 0;
+        if (name.size() < 64 && !(lengthMask & (1ull << name.size()))) return 0;
+        if (!firstChars[(unsigned char)std::tolower((unsigned char)name[0])]) return 0;
+        std::string key(name.size(), '\0'); // short names stay in the SSO buffer
+        std::transform(name.begin(), name.end(), key.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+        auto it = tags.find(key);
+        return it == tags.end() ? 0 : it->second;
+    }
+
+#ifdef _WIN32
+    static std::string WideToUtf8(const wchar_t* w, int len)
+    {
+        if (len <= 0) return std::string();
+        int size = WideCharToMultiByte(CP_UTF8, 0, w, len, NULL, 0, NULL, NULL);
+        std::string out(size, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, w, len, &out[0], size, NULL, NULL);
+        return out;
+    }
+
+    class Win32Enumerator : public ProcessEnumerator
+    {
+    public:
+        bool Enumerate(std::vector<ProcessInfo>& out) override
+        {
+            out.clear();
+            HANDLE hSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+            if (hSnap == INVALID_HANDLE_VALUE) return false;
+            PROCESSENTRY32W pe;
+            pe.dwSize = sizeof(pe);
+            if (Process32FirstW(hSnap, &pe))
+            {
+                do
+                {
+                    ProcessInfo info;
+                    info.pid = pe.th32ProcessID;
+                    info.parentPid = pe.th32ParentProcessID;
+                    info.name = WideToUtf8(pe.szExeFile, (int)wcslen(pe.szExeFile));
+                    out.push_back(std::move(info));
+                } while (Process32NextW(hSnap, &pe));
+            }
+            CloseHandle(hSnap);
+            return true;
+        }
+
+        uint64_t QueryStartTime(uint32_t pid) override
+        {
+            uint64_t start = 0;
+            HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (hProc)
+            {
+                FILETIME created, exited, kernel, user;
+                if (GetProcessTimes(hProc, &created, &exited, &kernel, &user))
+                    start = ((uint64_t)created.dwHighDateTime << 32) | created.dwLowDateTime;
+                CloseHandle(hProc);
+            }
+            return start;
+        }
+
+        std::string QueryExePath(uint32_t pid) override
+        {
+            std::string path;
+            HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (hProc)
+            {
+                char buf[MAX_PATH];
+                DWORD sz = (DWORD)sizeof(buf);
+                if (QueryFullProcessImageNameA(hProc, 0, buf, &sz))
+                    path.assign(buf, sz);
+                CloseHandle(hProc);
+            }
+            return path;
+        }
+
+        std::string QueryCommandLine(uint32_t pid) override
+        {
+            // ProcessCommandLineInformation (Windows 8.1+) returns a UNICODE_STRING followed by its buffer
+            typedef LONG (WINAPI *PNtQueryInformationProcess)(HANDLE, ULONG, PVOID, ULONG, PULONG);
+            static PNtQueryInformationProcess query = (PNtQueryInformationProcess)GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQueryInformationProcess");
+            if (!query) return std::string();
+            HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (!hProc) return std::string();
+
+            struct UnicodeString { USHORT Length; USHORT MaximumLength; PWSTR Buffer; };
+            const ULONG ProcessCommandLineInformation = 60;
+            ULONG needed = 0;
+            if (buffer.size() < 4096) buffer.resize(4096);
+            LONG status = query(hProc, ProcessCommandLineInformation, buffer.data(), (ULONG)buffer.size(), &needed);
+            if (status != 0 && needed > buffer.size())
+            {
+                buffer.resize(needed);
+                status = query(hProc, ProcessCommandLineInformation, buffer.data(), (ULONG)buffer.size(), &needed);
+            }
+            CloseHandle(hProc);
+            if (status != 0) return std::string();
+            const UnicodeString* str = reinterpret_cast<const UnicodeString*>(buffer.data());
+            return WideToUtf8(str->Buffer, str->Length / (int)sizeof(wchar_t));
+        }
+
+        bool QueryOpenFiles(uint32_t pid, std::vector<std::string>& out) override
+        {
+            return HandleScan::QueryOpenFilePaths(pid, out, std::chrono::steady_clock::time_point::max());
+        }
+
+    private:
+        std::vector<char> buffer;
+    };
+
+    std::unique_ptr<ProcessEnumerator> CreateSystemEnumerator()
+    {
+        return std::unique_ptr<ProcessEnumerator>(new Win32Enumerator());
+    }
+#elif defined(__linux__)
+    struct LinuxDirent64
+    {
+        uint64_t d_ino;
+        int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[1];
+    };
+
+    // Calls fn(name) for every entry of an open directory, reading it in large getdents64 batches
+    template <typename Fn>
+    static void ForEachDirEntry(int dirFd, std::vector<char>& buf, Fn&& fn)
+    {
+        for (;;)
+        {
+            long n = syscall(SYS_getdents64, dirFd, buf.data(), buf.size());
+            if (n <= 0) return;
+            for (long off = 0; off < n; )
+            {
+                const LinuxDirent64* d = reinterpret_cast<const LinuxDirent64*>(buf.data() + off);
+                off += d->d_reclen;
+                if (d->d_name[0] == '.' && (d->d_name[1] == '\0' || (d->d_name[1] == '.' && d->d_name[2] == '\0'))) continue;
+                fn(d->d_name);
+            }
+        }
+    }
+
+    static bool ParsePid(const char* s, uint32_t& pid)
+    {
+        if (*s < '1' || *s > '9') return false;
+        uint32_t v = 0;
+        for (; *s; ++s)
+        {
+            if (*s < '0' || *s > '9') return false;
+            v = v * 10 + (uint32_t)(*s - '0');
+        }
+        pid = v;
+        return true;
+    }
+
+    class ProcFsEnumerator : public ProcessEnumerator
+    {
+    public:
+        explicit ProcFsEnumerator(std::string root) : root(std::move(root)), dirBuf(32 * 1024), fileBuf(4096) {}
+
+        bool Enumerate(std::vector<ProcessInfo>& out) override
+        {
+            int rootFd = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (rootFd < 0) { out.clear(); return false; }
+            // Overwrite existing elements in place so their name strings keep their capacity
+            size_t count = 0;
+            char rel[32];
+            ForEachDirEntry(rootFd, dirBuf, [&](const char* name) {
+                uint32_t pid = 0;
+                if (!ParsePid(name, pid)) return;
+                std::snprintf(rel, sizeof(rel), "%s/stat", name);
+                size_t len = 0;
+                if (!ReadAt(rootFd, rel, len)) return; // exited between getdents and open
+                if (count == out.size()) out.emplace_back();
+                ProcessInfo& info = out[count];
+                info.pid = pid;
+                info.parentPid = 0;
+                info.startTime = 0;
+                if (ParseStat(fileBuf.data(), len, info)) ++count;
+            });
+            close(rootFd);
+            out.resize(count);
+            return true;
+        }
+
+        uint64_t QueryStartTime(uint32_t pid) override
+        {
+            int rootFd = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (rootFd < 0) return 0;
+            std::string rel = std::to_string(pid) + "/stat";
+            size_t len = 0;
+            ProcessInfo info;
+            bool ok = ReadAt(rootFd, rel.c_str(), len) && ParseStat(fileBuf.data(), len, info);
+            close(rootFd);
+            return ok ? info.startTime : 0;
+        }
+
+        std::string QueryExePath(uint32_t pid) override
+        {
+            std::string link = root + "/" + std::to_string(pid) + "/exe";
+            ssize_t n = readlink(link.c_str(), fileBuf.data(), fileBuf.size());
+            if (n <= 0) return std::string();
+            std::string path(fileBuf.data(), (size_t)n);
+            static const char kDeleted[] = " (deleted)";
+            const size_t deletedLen = sizeof(kDeleted) - 1;
+            if (path.size() > deletedLen && path.compare(path.size() - deletedLen, deletedLen, kDeleted) == 0)
+                path.resize(path.size() - deletedLen);
+            return path;
+        }
+
+        std::string QueryCommandLine(uint32_t pid) override
+        {
+            int rootFd = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (rootFd < 0) return std::string();
+            std::string rel = std::to_string(pid) + "/cmdline";
+            size_t len = 0;
+            bool ok = ReadAt(rootFd, rel.c_str(), len);
+            close(rootFd);
+            if (!ok) return std::string();
+            // Arguments are NUL separated (and NUL terminated)
+            while (len > 0 && fileBuf[len - 1] == '\0') --len;
+            std::string cmd(fileBuf.data(), len);
+            std::replace(cmd.begin(), cmd.end(), '\0', ' ');
+            return cmd;
+        }
+
+        bool QueryOpenFiles(uint32_t pid, std::vector<std::string>& out) override
+        {
+            out.clear();
+            std::string fdDir = root + "/" + std::to_string(pid) + "/fd";
+            int dirFd = open(fdDir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (dirFd < 0) return false;
+            ForEachDirEntry(dirFd, dirBuf, [&](const char* name) {
+                ssize_t n = readlinkat(dirFd, name, fileBuf.data(), fileBuf.size());
+                if (n > 0) out.emplace_back(fileBuf.data(), (size_t)n);
+            });
+            close(dirFd);
+            return true;
+        }
+
+    private:
+        // Read a whole file relative to dirFd into fileBuf (grown as needed, never shrunk)
+        bool ReadAt(int dirFd, const char* rel, size_t& len)
+        {
+            int fd = openat(dirFd, rel, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+            len = 0;
+            for (;;)
+            {
+                if (len == fileBuf.size()) fileBuf.resize(fileBuf.size() * 2);
+                ssize_t n = read(fd, fileBuf.data() + len, fileBuf.size() - len);
+                if (n < 0) { close(fd); return false; }
+                if (n == 0) break;
+                len += (size_t)n;
+            }
+            close(fd);
+            return true;
+        }
+
+        // "pid (comm) state ppid ... starttime(22nd field) ..."; comm may contain spaces and ')'
+        static bool ParseStat(const char* text, size_t len, ProcessInfo& info)
+        {
+            const char* end = text + len;
+            const char* nameStart = static_cast<const char*>(std::memchr(text, '(', len));
+            if (!nameStart) return false;
+            const char* nameEnd = end;
+            while (nameEnd > nameStart && *(nameEnd - 1) != ')') --nameEnd;
+            if (nameEnd == nameStart) return false;
+            info.name.assign(nameStart + 1, nameEnd - 1);
+            const char* p = nameEnd;
+            int field = 2; // the field just parsed
+            while (p < end && field < 22)
+            {
+                while (p < end && *p == ' ') ++p;
+                ++field;
+                const char* tokenStart = p;
+                while (p < end && *p != ' ') ++p;
+                if (field == 4 || field == 22)
+                {
+                    uint64_t v = 0;
+                    for (const char* q = tokenStart; q < p && *q >= '0' && *q <= '9'; ++q) v = v * 10 + (uint64_t)(*q - '0');
+                    if (field == 4) info.parentPid = (uint32_t)v; else info.startTime = v;
+                }
+            }
+            return true;
+        }
+
+        std::string root;
+        std::vector<char> dirBuf;
+        std::vector<char> fileBuf;
+    };
+
+    std::unique_ptr<ProcessEnumerator> CreateProcFsEnumerator(const std::string& procRoot)
+    {
+        return std::unique_ptr<ProcessEnumerator>(new ProcFsEnumerator(procRoot));
+    }
+
+    std::unique_ptr<ProcessEnumerator> CreateSystemEnumerator()
+    {
+        return CreateProcFsEnumerator("/proc");
+    }
+#else
+    class NullEnumerator : public ProcessEnumerator
+    {
+    public:
+        bool Enumerate(std::vector<ProcessInfo>& out) override { out.clear(); return false; }
+        uint64_t QueryStartTime(uint32_t) override { return 0; }
+        std::string QueryExePath(uint32_t) override { return std::string(); }
+        std::string QueryCommandLine(uint32_t) override { return std::string(); }
+        bool QueryOpenFiles(uint32_t, std::vector<std::string>& out) override { out.clear(); return false; }
+    };
+
+    std::unique_ptr<ProcessEnumerator> CreateSystemEnumerator()
+    {
+        return std::unique_ptr<ProcessEnumerator>(new NullEnumerator());
+    }
+#endif
+}
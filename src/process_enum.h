@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Portable process enumeration used by VSInspector's refresh.
+// Win32: Toolhelp snapshot + QueryFullProcessImageName. Linux: /proc read with raw getdents64/
+// openat into buffers reused across calls, so a refresh does not allocate per process.
+// Enumerators are not thread-safe (the buffers are shared); give each thread its own instance.
+namespace ProcessEnum
+{
+    struct ProcessInfo
+    {
+        uint32_t pid = 0;
+        uint32_t parentPid = 0;
+        uint64_t startTime = 0; // Linux: clock ticks since boot; 0 where not available cheaply (Win32)
+        std::string name;       // executable file name as reported by the OS ("devenv.exe", "cursor")
+    };
+
+    class ProcessEnumerator
+    {
+    public:
+        virtual ~ProcessEnumerator() = default;
+
+        // Replace out with every visible process (pid, parent, name). False if the list is unavailable.
+        virtual bool Enumerate(std::vector<ProcessInfo>& out) = 0;
+
+        // Process creation time in the same unit as ProcessInfo::startTime would use (Win32: FILETIME
+        // ticks); 0 if denied/exited. Use when Enumerate() left startTime at 0.
+        virtual uint64_t QueryStartTime(uint32_t pid) = 0;
+
+        // Full image path (Win32: ANSI code page, as the launch helpers expect); empty if denied/exited
+        virtual std::string QueryExePath(uint32_t pid) = 0;
+
+        // Command line with arguments separated by spaces; empty if denied/exited
+        virtual std::string QueryCommandLine(uint32_t pid) = 0;
+
+        // Targets of the process' open file descriptors. False if unsupported or denied.
+        virtual bool QueryOpenFiles(uint32_t pid, std::vector<std::string>& out) = 0;
+    };
+
+    // Enumerator for the running system
+    std::unique_ptr<ProcessEnumerator> CreateSystemEnumerator();
+
+#ifdef __linux__
+    // /proc reader rooted elsewhere (same layout as /proc); used by the benchmark's synthetic tree
+    std::unique_ptr<ProcessEnumerator> CreateProcFsEnumerator(const std::string& procRoot);
+#endif
+
+    // Case-insensitive exact match of process names to caller-defined tags
+    class NameTable
+    {
+    public:
+        void Add(const std::string& name, int tag);
+
+        // Tag for name, 0 if not in the table
+        int Match(const std::string& name) const;
+
+    private:
+        std::unordered_map<std::string, int> tags; // lower-case keys
+        size_t maxLength = 0;
+        uint64_t lengthMask = 0;                   // bit n set if some key has length n
+        bool firstChars[256] = {};                 // lower-case first characters of the keys
+    };
+}
@@ -0,0 +1,345 @@
+#include "process_sampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ProcessSampler
+{
+    struct Counters
+    {
+        uint64_t cpuNs = 0;
+        uint64_t workingSet = 0;  // bytes
+        uint64_t ioBytes = 0;
+        bool ioOk = false;
+    };
+
+    // Sampler-thread state per watched process
+    struct Tracked
+    {
+        std::shared_ptr<History> history;
+        Counters prev;
+        std::chrono::steady_clock::time_point prevAt;
+        bool primed = false;
+#ifdef _WIN32
+        HANDLE handle = NULL;
+#elif defined(__linux__)
+        int dirFd = -1;
+#endif
+    };
+
+    static std::mutex g_mutex;  // guards everything below except g_tracker (sampler thread only)
+    static std::condition_variable g_wake;
+    static std::thread g_thread;
+    static bool g_stopping = false;
+    static std::vector<ProcessEnum::ProcessKey> g_watched;
+    static std::unordered_map<uint32_t, std::shared_ptr<const History>> g_published;
+    static Stats g_stats;
+
+    static ProcessEnum::InstanceTracker<Tracked> g_tracker;
+    static size_t g_resumeAt = 0;
+
+#ifdef _WIN32
+    static uint64_t FileTimeToU64(const FILETIME& ft)
+    {
+        return ((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    }
+
+    static unsigned CoreCount()
+    {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        return si.dwNumberOfProcessors ? si.dwNumberOfProcessors : 1;
+    }
+
+    static bool OpenProcessFor(const ProcessEnum::ProcessKey& key, Tracked& t)
+    {
+        HANDLE h = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, key.pid);
+        if (!h) h = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, key.pid);
+        if (!h) return false;
+        // The handle pins the process object: check it is the one the key names, not a recycled pid
+        FILETIME created, exited, kernel, user;
+        if (key.startTime != 0 && (!GetProcessTimes(h, &created, &exited, &kernel, &user) || FileTimeToU64(created) != key.startTime))
+        {
+            CloseHandle(h);
+            return false;
+        }
+        t.handle = h;
+        return true;
+    }
+
+    static void CloseProcessFor(Tracked& t)
+    {
+        if (t.handle) CloseHandle(t.handle);
+        t.handle = NULL;
+    }
+
+    static bool ReadCounters(Tracked& t, Counters& c)
+    {
+        if (!t.handle) return false;
+        FILETIME created, exited, kernel, user;
+        if (!GetProcessTimes(t.handle, &created, &exited, &kernel, &user)) return false;
+        c.cpuNs = (FileTimeToU64(kernel) + FileTimeToU64(user)) * 100;
+        PROCESS_MEMORY_COUNTERS pmc;
+        if (GetProcessMemoryInfo(t.handle, &pmc, sizeof(pmc))) c.workingSet = pmc.WorkingSetSize;
+        IO_COUNTERS io;
+        if (GetProcessIoCounters(t.handle, &io))
+        {
+            c.ioBytes = io.ReadTransferCount + io.WriteTransferCount;
+            c.ioOk = true;
+        }
+        return true;
+    }
+#elif defined(__linux__)
+    static unsigned CoreCount()
+    {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        return n > 0 ? (unsigned)n : 1;
+    }
+
+    static bool ReadAt(int dirFd, const char* name, char* buf, size_t size, size_t& len)
+    {
+        int fd = openat(dirFd, name, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        ssize_t n = read(fd, buf, size - 1);
+        close(fd);
+        if (n <= 0) return false;
+        len = (size_t)n;
+        buf[len] = '\0';
+        return true;
+    }
+
+    // Fields after "pid (comm)": state is field 3, utime/stime 14/15, starttime 22
+    static bool ParseStat(const char* buf, uint64_t& ticks, uint64_t& startTime)
+    {
+        const char* p = std::strrchr(buf, ')');
+        if (!p) return false;
+        p += 2;
+        uint64_t utime = 0, stime = 0;
+        for (int field = 3; field <= 22 && *p; ++field)
+        {
+            if (field == 14) utime = std::strtoull(p, nullptr, 10);
+            else if (field == 15) stime = std::strtoull(p, nullptr, 10);
+            else if (field == 22) startTime = std::strtoull(p, nullptr, 10);
+            p = std::strchr(p, ' ');
+            if (!p) break;
+            ++p;
+        }
+        ticks = utime + stime;
+        return true;
+    }
+
+    static bool OpenProcessFor(const ProcessEnum::ProcessKey& key, Tracked& t)
+    {
+        char path[32];
+        std::snprintf(path, sizeof(path), "/proc/%u", (unsigned)key.pid);
+        int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) return false;
+        // The directory fd stays bound to this process; make sure it is the one the key names
+        char buf[1024];
+        size_t len = 0;
+        uint64_t ticks = 0, startTime = 0;
+        if (!ReadAt(fd, "stat", buf, sizeof(buf), len) || !ParseStat(buf, ticks, startTime) ||
+            (key.startTime != 0 && startTime != key.startTime))
+        {
+            close(fd);
+            return false;
+        }
+        t.dirFd = fd;
+        return true;
+    }
+
+    static void CloseProcessFor(Tracked& t)
+    {
+        if (t.dirFd >= 0) close(t.dirFd);
+        t.dirFd = -1;
+    }
+
+    static bool ReadCounters(Tracked& t, Counters& c)
+    {
+        if (t.dirFd < 0) return false;
+        static const uint64_t nsPerTick = 1000000000ull / (uint64_t)std::max(1L, sysconf(_SC_CLK_TCK));
+        static const uint64_t pageSize = (uint64_t)std::max(1L, sysconf(_SC_PAGESIZE));
+        char buf[1024];
+        size_t len = 0;
+        uint64_t ticks = 0, startTime = 0;
+        if (!ReadAt(t.dirFd, "stat", buf, sizeof(buf), len) || !ParseStat(buf, ticks, startTime)) return false;
+        c.cpuNs = ticks * nsPerTick;
+        if (ReadAt(t.dirFd, "statm", buf, sizeof(buf), len))
+        {
+            char* p = nullptr;
+            std::strtoull(buf, &p, 10);                      // size
+            c.workingSet = std::strtoull(p, nullptr, 10) * pageSize;  // resident
+        }
+        // Not readable for other users' processes: I/O then simply stays empty
+        if (ReadAt(t.dirFd, "io", buf, sizeof(buf), len))
+        {
+            const char* r = std::strstr(buf, "read_bytes: ");
+            const char* w = std::strstr(buf, "\nwrite_bytes: ");
+            if (r && w)
+            {
+                c.ioBytes = std::strtoull(r + 12, nullptr, 10) + std::strtoull(w + 14, nullptr, 10);
+                c.ioOk = true;
+            }
+        }
+        return true;
+    }
+#else
+    static unsigned CoreCount() { return 1; }
+    static bool OpenProcessFor(const ProcessEnum::ProcessKey&, Tracked&) { return false; }
+    static void CloseProcessFor(Tracked&) {}
+    static bool ReadCounters(Tracked&, Counters&) { return false; }
+#endif
+
+    static void Sample(Tracked& t, std::chrono::steady_clock::time_point now, unsigned cores)
+    {
+        Counters c;
+        if (!ReadCounters(t, c)) return;
+        if (t.primed)
+        {
+            const double wallNs = std::chrono::duration<double, std::nano>(now - t.prevAt).count();
+            if (wallNs > 0.0)
+            {
+                double cpu = 100.0 * (double)(c.cpuNs - std::min(c.cpuNs, t.prev.cpuNs)) / (wallNs * cores);
+                t.history->cpu.Push((float)std::min(100.0, cpu));
+                t.history->workingSet.Push((float)((double)c.workingSet / (1024.0 * 1024.0)));
+                if (c.ioOk && t.prev.ioOk)
+                    t.history->io.Push((float)((double)(c.ioBytes - std::min(c.ioBytes, t.prev.ioBytes)) * 1e9 / wallNs));
+            }
+        }
+        t.prev = c;
+        t.prevAt = now;
+        t.primed = true;
+    }
+
+    static void Pass(const std::vector<ProcessEnum::ProcessKey>& keys, unsigned cores)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        const auto deadline = t0 + std::chrono::microseconds((long long)(kPassBudgetMs * 1000.0));
+
+        // Touch every watched key (cheap) so that nothing the budget skips gets swept
+        std::vector<Tracked*> live;
+        live.reserve(keys.size());
+        bool changed = false;
+        for (const ProcessEnum::ProcessKey& key : keys)
+        {
+            bool isNew = false;
+            Tracked& t = g_tracker.Touch(key, isNew);
+            if (isNew)
+            {
+                t.history = std::make_shared<History>();
+                t.history->key = key;
+                t.history->accessible = OpenProcessFor(key, t);
+                changed = true;
+            }
+            live.push_back(&t);
+        }
+        g_tracker.Sweep([&](const ProcessEnum::ProcessKey&, Tracked& t) {
+            CloseProcessFor(t);
+            changed = true;
+        });
+
+        // Round-robin from where the previous pass ran out of budget
+        size_t sampled = 0;
+        uint64_t deferred = 0;
+        const size_t n = live.size();
+        const size_t start = n ? g_resumeAt % n : 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                deferred = n - i;
+                g_resumeAt = start + i;
+                break;
+            }
+            Sample(*live[(start + i) % n], std::chrono::steady_clock::now(), cores);
+            ++sampled;
+        }
+        if (deferred == 0) g_resumeAt = 0;
+
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (changed)
+        {
+            g_published.clear();
+            for (Tracked* t : live) g_published[t->history->key.pid] = t->history;
+        }
+        g_stats.watched = n;
+        g_stats.sampledLastPass = sampled;
+        g_stats.lastPassMs = ms;
+        g_stats.deferred += deferred;
+    }
+
+    static void Run()
+    {
+        const unsigned cores = CoreCount();
+        std::vector<ProcessEnum::ProcessKey> keys;
+        std::unique_lock<std::mutex> lock(g_mutex);
+        while (!g_stopping)
+        {
+            keys = g_watched;
+            lock.unlock();
+            Pass(keys, cores);
+            lock.lock();
+            g_wake.wait_for(lock, std::chrono::seconds(1), []() { return g_stopping; });
+        }
+        lock.unlock();
+        // Nothing was touched since the last pass' Sweep: this drops every entry and releases its
+        // handle/fd; the next Start() reopens them
+        g_tracker.Sweep([](const ProcessEnum::ProcessKey&, Tracked& t) { CloseProcessFor(t); });
+        lock.lock();
+        g_published.clear();
+    }
+
+    void SetWatched(const std::vector<ProcessEnum::ProcessKey>& keys)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_watched = keys;
+    }
+
+    void Start()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_thread.joinable()) return;
+        g_stopping = false;
+        g_thread = std::thread(Run);
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            if (!g_thread.joinable()) return;
+            g_stopping = true;
+        }
+        g_wake.notify_all();
+        g_thread.join();
+    }
+
+    std::shared_ptr<const History> Find(uint32_t pid)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        auto it = g_published.find(pid);
+        return it == g_published.end() ? nullptr : it->second;
+    }
+
+    Stats GetStats()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_stats;
+    }
+}
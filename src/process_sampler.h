@@ -0,0 +1,51 @@
+#pragma once
+
+#include "instance_tracker.h"
+#include "time_series.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Per-process resource history for the VS/Cursor instances VSInspector tracks.
+// The refresh worker hands over the (pid, start time) keys it found; a sampler thread reads CPU
+// time, working set and I/O counters for them once per second (Windows: GetProcessTimes,
+// GetProcessMemoryInfo, GetProcessIoCounters on a handle kept open per instance; Linux:
+// /proc/<pid>/stat, statm and io through a directory fd kept open per instance). A pass stops at
+// kPassBudgetMs and resumes with the processes it did not reach on the next pass.
+namespace ProcessSampler
+{
+    constexpr size_t kHistorySamples = 120;  // two minutes at 1 Hz
+    constexpr double kPassBudgetMs = 4.0;
+
+    struct History
+    {
+        ProcessEnum::ProcessKey key;
+        TimeSeries cpu{ kHistorySamples };         // % of the whole machine (all cores)
+        TimeSeries workingSet{ kHistorySamples };  // MB
+        TimeSeries io{ kHistorySamples };          // bytes/s, read + write
+        bool accessible = true;                    // false if the process could not be opened
+    };
+
+    struct Stats
+    {
+        size_t watched = 0;
+        size_t sampledLastPass = 0;
+        double lastPassMs = 0.0;
+        uint64_t deferred = 0;  // samples pushed to a later pass by the budget
+    };
+
+    // Replace the set of processes to sample (refresh worker, after each refresh)
+    void SetWatched(const std::vector<ProcessEnum::ProcessKey>& keys);
+
+    // Start the sampler thread (no-op if running) / stop and join it
+    void Start();
+    void Stop();
+
+    // History of a watched process; nullptr if pid is not watched. The series can be read while
+    // the sampler keeps writing.
+    std::shared_ptr<const History> Find(uint32_t pid);
+
+    Stats GetStats();
+}
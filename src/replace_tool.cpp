@@ -1,4 +1,5 @@
 #include "replace_tool.h"
+#include "glyph_cache.h"
 
 #include "imgui.h"
 #include <string>
@@ -50,6 +51,7 @@ namespace ReplaceTool
 
     void AppendLog(const std::string& line)
     {
+        GlyphCache::AddText(line); // log lines are shown in the shared log view
         std::lock_guard<std::mutex> lock(g_state.logMutex);
         g_state.logLines.emplace_back(line);
         if (g_state.logFile.is_open())
@@ -0,0 +1,340 @@
+#include "review_log.h"
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace WordReminder
+{
+    namespace History
+    {
+        // 文件：8 字节文件头，之后是若干块。每块：magic、条数 n，然后按列
+        // card[n] (u64) | time[n] (i64) | interval[n] (u32) | grade[n] (u8)，小端
+        static const char kFileMagic[4] = { 'W', 'R', 'R', 'L' };
+        static constexpr uint32_t kVersion = 1;
+        static constexpr uint32_t kBlockMagic = 0x314B4C42;  // "BLK1"
+        static constexpr size_t kHeaderBytes = 8;
+        static constexpr size_t kBlockHeaderBytes = 8;
+        static constexpr size_t kBytesPerEvent = 8 + 8 + 4 + 1;
+
+        struct Columns
+        {
+            std::vector<uint64_t> card;
+            std::vector<int64_t> time;
+            std::vector<uint32_t> interval;
+            std::vector<uint8_t> grade;
+
+            size_t size() const { return card.size(); }
+        };
+
+        static const int64_t kBucketLimits[] = { 3600, 6 * 3600, 86400, 3 * 86400, 7 * 86400, 30 * 86400 };
+        static const char* const kBucketLabels[] = { "<1小时", "1-6小时", "6-24小时", "1-3天", "3-7天", "7-30天", ">30天" };
+        static constexpr size_t kBucketCount = sizeof(kBucketLabels) / sizeof(kBucketLabels[0]);
+
+        struct Aggregates
+        {
+            std::unordered_map<int32_t, Day> days;
+            std::unordered_map<uint64_t, int64_t> lastSeen;  // 卡片 -> 最近一次复习时间
+            uint32_t bucketReviews[kBucketCount] = {};
+            uint32_t bucketRecalled[kBucketCount] = {};
+            Totals totals;
+        };
+
+        static Aggregates g_agg;
+        static bool g_loaded = false;
+        static int64_t g_utcOffset = 0;  // 本地时间 - UTC，Load 时取一次
+
+        static int64_t LocalUtcOffset()
+        {
+            time_t now = std::time(nullptr);
+            std::tm gm = *std::gmtime(&now);
+            gm.tm_isdst = -1;
+            // 把 UTC 的各字段当作本地时间解释，差值就是时区偏移
+            return (int64_t)now - (int64_t)std::mktime(&gm);
+        }
+
+        static int32_t DayOf(int64_t t)
+        {
+            int64_t local = t + g_utcOffset;
+            return (int32_t)(local >= 0 ? local / 86400 : (local - 86399) / 86400);
+        }
+
+        static size_t BucketOf(int64_t gap)
+        {
+            size_t i = 0;
+            while (i < kBucketCount - 1 && gap >= kBucketLimits[i]) ++i;
+            return i;
+        }
+
+        static void Accumulate(uint64_t card, int64_t time, uint8_t grade)
+        {
+            if (grade >= GradeCount) grade = Good;
+            const int32_t d = DayOf(time);
+            Day& day = g_agg.days[d];
+            day.day = d;
+            day.reviews++;
+            day.byGrade[grade]++;
+
+            auto seen = g_agg.lastSeen.find(card);
+            if (seen == g_agg.lastSeen.end())
+            {
+                day.newCards++;
+                g_agg.lastSeen.emplace(card, time);
+            }
+            else
+            {
+                // 时钟被往回调过时间差为负，不计入保持率
+                const int64_t gap = time - seen->second;
+                if (gap >= 0)
+                {
+                    const size_t b = BucketOf(gap);
+                    g_agg.bucketReviews[b]++;
+                    if (grade != Again) g_agg.bucketRecalled[b]++;
+                }
+                seen->second = time;
+            }
+
+            Totals& t = g_agg.totals;
+            if (t.events == 0 || d < t.firstDay) t.firstDay = d;
+            if (t.events == 0 || d > t.lastDay) t.lastDay = d;
+            t.events++;
+        }
+
+        template <typename T>
+        static void AppendColumn(std::string& out, const std::vector<T>& column)
+        {
+            out.append(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+        }
+
+        static void AppendBlock(std::string& out, const Columns& cols)
+        {
+            uint32_t header[2] = { kBlockMagic, (uint32_t)cols.size() };
+            out.append(reinterpret_cast<const char*>(header), sizeof(header));
+            AppendColumn(out, cols.card);
+            AppendColumn(out, cols.time);
+            AppendColumn(out, cols.interval);
+            AppendColumn(out, cols.grade);
+        }
+
+        static std::string FileHeader()
+        {
+            std::string out(kFileMagic, 4);
+            out.append(reinterpret_cast<const char*>(&kVersion), 4);
+            return out;
+        }
+
+        // 解析整个文件；返回有效部分的字节数（文件头错误时为 0）
+        static size_t ParseFile(const std::string& data, Columns& cols, uint64_t& blocks)
+        {
+            blocks = 0;
+            if (data.size() < kHeaderBytes || std::memcmp(data.data(), kFileMagic, 4) != 0) return 0;
+            uint32_t version = 0;
+            std::memcpy(&version, data.data() + 4, 4);
+            if (version != kVersion) return 0;
+
+            size_t pos = kHeaderBytes;
+            while (data.size() - pos >= kBlockHeaderBytes)
+            {
+                uint32_t header[2];
+                std::memcpy(header, data.data() + pos, sizeof(header));
+                const size_t n = header[1];
+                if (header[0] != kBlockMagic || n > (data.size() - pos - kBlockHeaderBytes) / kBytesPerEvent) break;
+                const char* p = data.data() + pos + kBlockHeaderBytes;
+                const size_t base = cols.size();
+                cols.card.resize(base + n);
+                cols.time.resize(base + n);
+                cols.interval.resize(base + n);
+                cols.grade.resize(base + n);
+                std::memcpy(cols.card.data() + base, p, n * 8);        p += n * 8;
+                std::memcpy(cols.time.data() + base, p, n * 8);        p += n * 8;
+                std::memcpy(cols.interval.data() + base, p, n * 4);    p += n * 4;
+                std::memcpy(cols.grade.data() + base, p, n);
+                pos += kBlockHeaderBytes + n * kBytesPerEvent;
+                blocks++;
+            }
+            return pos;
+        }
+
+        static bool ReadFile(std::string& data)
+        {
+            std::ifstream file(fs::u8path(kLogFile), std::ios::binary);
+            if (!file.is_open()) return false;
+            file.seekg(0, std::ios::end);
+            data.resize((size_t)file.tellg());
+            file.seekg(0, std::ios::beg);
+            file.read(&data[0], (std::streamsize)data.size());
+            return (bool)file;
+        }
+
+        // 整个日志重写为一块：先写 .tmp 再改名
+        static bool Rewrite(const Columns& cols)
+        {
+            std::string out = FileHeader();
+            out.reserve(kHeaderBytes + kBlockHeaderBytes + cols.size() * kBytesPerEvent);
+            if (cols.size() > 0) AppendBlock(out, cols);
+
+            const fs::path target = fs::u8path(kLogFile);
+            fs::path tmp = target;
+            tmp += ".tmp";
+            {
+                std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) return false;
+                file.write(out.data(), (std::streamsize)out.size());
+                if (!file) return false;
+            }
+            std::error_code ec;
+            fs::rename(tmp, target, ec);
+            if (ec)
+            {
+                fs::remove(tmp, ec);
+                return false;
+            }
+            g_agg.totals.blocks = cols.size() > 0 ? 1 : 0;
+            g_agg.totals.fileBytes = out.size();
+            g_agg.totals.compactions++;
+            return true;
+        }
+
+        bool Load()
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            g_agg = Aggregates();
+            g_utcOffset = LocalUtcOffset();
+            g_loaded = true;
+
+            std::string data;
+            if (!ReadFile(data)) return true;  // 还没有记录
+
+            Columns cols;
+            uint64_t blocks = 0;
+            const size_t valid = ParseFile(data, cols, blocks);
+            if (valid == 0 && !data.empty())
+            {
+                // 认不出的文件（例如更新版本写的）保持原样，也不往里追加
+                g_loaded = false;
+                return false;
+            }
+            for (size_t i = 0; i < cols.size(); ++i)
+            {
+                Accumulate(cols.card[i], cols.time[i], cols.grade[i]);
+            }
+            g_agg.totals.blocks = blocks;
+            g_agg.totals.fileBytes = data.size();
+
+            bool ok = true;
+            // 尾部写了一半的块丢掉，块太多就顺便整理。丢不掉时不再追加：接在坏块后面的记录读不回来
+            if (valid != data.size()) ok = g_loaded = Rewrite(cols);
+            else if (blocks > kCompactBlocks) Rewrite(cols);
+            g_agg.totals.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            return ok;
+        }
+
+        bool Append(const std::vector<Event>& events)
+        {
+            // 没读过日志就追加会把已有文件当成新文件覆盖
+            if (!g_loaded) return false;
+            if (events.empty()) return true;
+            Columns cols;
+            cols.card.reserve(events.size());
+            cols.time.reserve(events.size());
+            cols.interval.reserve(events.size());
+            cols.grade.reserve(events.size());
+            for (const Event& e : events)
+            {
+                cols.card.push_back(e.card);
+                cols.time.push_back(e.time);
+                cols.interval.push_back(e.intervalSec);
+                cols.grade.push_back(e.grade);
+            }
+
+            // 文件还不存在时连文件头一起写
+            const bool fresh = g_agg.totals.fileBytes < kHeaderBytes;
+            std::string out = fresh ? FileHeader() : std::string();
+            AppendBlock(out, cols);
+            {
+                std::ofstream file(fs::u8path(kLogFile), std::ios::binary | (fresh ? std::ios::trunc : std::ios::app));
+                if (!file.is_open()) return false;
+                file.write(out.data(), (std::streamsize)out.size());
+                if (!file) return false;
+            }
+            g_agg.totals.fileBytes += out.size();
+            g_agg.totals.blocks++;
+            for (const Event& e : events) Accumulate(e.card, e.time, e.grade);
+
+            if (g_agg.totals.blocks > kCompactBlocks)
+            {
+                std::string data;
+                Columns all;
+                uint64_t blocks = 0;
+                if (ReadFile(data) && ParseFile(data, all, blocks) == data.size()) Rewrite(all);
+            }
+            return true;
+        }
+
+        void Unload()
+        {
+            g_loaded = false;
+            g_agg = Aggregates();
+        }
+
+        uint64_t CardKey(std::string_view word)
+        {
+            // FNV-1a 64
+            uint64_t h = 14695981039346656037ull;
+            for (unsigned char c : word)
+            {
+                h ^= c;
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        Day GetDay(int32_t day)
+        {
+            auto it = g_agg.days.find(day);
+            if (it != g_agg.days.end()) return it->second;
+            Day empty;
+            empty.day = day;
+            return empty;
+        }
+
+        int32_t Today()
+        {
+            return DayOf((int64_t)std::time(nullptr));
+        }
+
+        std::vector<Day> Range(int32_t first, int32_t last)
+        {
+            std::vector<Day> out;
+            if (last < first) return out;
+            out.reserve((size_t)(last - first + 1));
+            for (int32_t d = first; d <= last; ++d) out.push_back(GetDay(d));
+            return out;
+        }
+
+        std::vector<RetentionBucket> Retention()
+        {
+            std::vector<RetentionBucket> out(kBucketCount);
+            for (size_t i = 0; i < kBucketCount; ++i)
+            {
+                out[i].label = kBucketLabels[i];
+                out[i].reviews = g_agg.bucketReviews[i];
+                out[i].recalled = g_agg.bucketRecalled[i];
+            }
+            return out;
+        }
+
+        Totals GetTotals()
+        {
+            Totals t = g_agg.totals;
+            t.cards = g_agg.lastSeen.size();
+            return t;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace WordReminder
+{
+    // 复习记录：每次评分追加一条事件（卡片、时间、评分、排到多久以后）到 word_reminder_reviews.bin。
+    // 文件按块追加，每块按列存放；块太多时整理成一块（先写 .tmp 再改名）。
+    // 启动时读一遍算出按天的汇总和按间隔分组的记忆保持率，之后随追加增量更新，
+    // 界面上的热力图和统计只查汇总，不扫原始事件。只在 UI 线程使用。
+    namespace History
+    {
+        constexpr const char* kLogFile = "word_reminder_reviews.bin";
+        constexpr size_t kCompactBlocks = 64;  // 块数超过这个就整理
+
+        // 与 Review::Grade 同序
+        enum Grade : uint8_t { Again = 0, Hard = 1, Good = 2, Easy = 3, GradeCount = 4 };
+
+        struct Event
+        {
+            uint64_t card = 0;        // CardKey(单词)，跨进程稳定
+            int64_t time = 0;         // unix 秒
+            uint8_t grade = Good;
+            uint32_t intervalSec = 0; // 本次评分后排到多久以后
+        };
+
+        // 单词文本的 64 位哈希；改了拼写就算新卡片
+        uint64_t CardKey(std::string_view word);
+
+        // 读整个日志并重建汇总；尾部写坏的块会被丢掉
+        bool Load();
+        // 追加一块（须先 Load）；失败时事件不计入汇总
+        bool Append(const std::vector<Event>& events);
+        // 释放汇总（不影响文件）
+        void Unload();
+
+        struct Day
+        {
+            int32_t day = 0;  // 本地日期，距 1970-01-01 的天数
+            uint32_t reviews = 0;
+            uint32_t byGrade[GradeCount] = {};
+            uint32_t newCards = 0;  // 这一天第一次复习的卡片
+        };
+
+        // 汇总里的一天；没有记录时 reviews 为 0
+        Day GetDay(int32_t day);
+        int32_t Today();
+        // [first, last] 每天一项（含没有记录的日子）
+        std::vector<Day> Range(int32_t first, int32_t last);
+
+        // 按距上次复习的时间分组：这一组里非 Again 的比例即记忆保持率
+        struct RetentionBucket
+        {
+            const char* label;
+            uint32_t reviews = 0;
+            uint32_t recalled = 0;
+        };
+        std::vector<RetentionBucket> Retention();
+
+        struct Totals
+        {
+            uint64_t events = 0;
+            uint64_t cards = 0;
+            uint64_t blocks = 0;       // 文件里的块数
+            uint64_t fileBytes = 0;
+            uint64_t compactions = 0;
+            int32_t firstDay = 0;      // 没有记录时为 0
+            int32_t lastDay = 0;
+            double loadMs = 0.0;
+        };
+        Totals GetTotals();
+    }
+}
@@ -0,0 +1,192 @@
+#include "review_session.h"
+#include "glyph_cache.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+namespace WordReminder
+{
+    namespace Review
+    {
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t kLatencySamples = 256;
+
+        struct SessionState
+        {
+            Source source;
+            bool active = false;
+            std::deque<Card> queue;           // front 是当前卡片
+            bool revealed = false;
+            Clock::time_point shownAt;        // 当前卡片出现的时间
+            Clock::time_point startedAt;
+            Clock::time_point endedAt;
+            bool exhausted = false;           // 上次 fetch 没取到新卡
+            Clock::time_point lastFetch;
+            std::vector<Answer> batch;        // 已应用、未提交
+            std::vector<double> latencies;    // 最近的回答，环形
+            size_t latencyNext = 0;
+            Stats stats;
+        };
+
+        static std::unique_ptr<SessionState> g_session;
+
+        static double MsSince(Clock::time_point t, Clock::time_point now)
+        {
+            return std::chrono::duration<double, std::milli>(now - t).count();
+        }
+
+        static void Refill()
+        {
+            SessionState& s = *g_session;
+            if (s.queue.size() >= kPrefetchCards / 2) return;
+            // 取空之后每秒再看一次："重来"的卡片一分钟后又会到期
+            const auto now = Clock::now();
+            if (s.exhausted && now - s.lastFetch < std::chrono::seconds(1)) return;
+            s.lastFetch = now;
+
+            std::vector<uint64_t> skip;
+            skip.reserve(s.queue.size());
+            for (const Card& c : s.queue) skip.push_back(c.id);
+            std::sort(skip.begin(), skip.end());
+
+            std::vector<Card> cards = s.source.fetch(kPrefetchCards - s.queue.size(), skip);
+            s.exhausted = cards.empty();
+            const bool wasEmpty = s.queue.empty();
+            for (Card& c : cards)
+            {
+                // 提前把字形报给字体图集，真正出卡时图集已经重建好
+                GlyphCache::AddText(c.word);
+                GlyphCache::AddText(c.meaning);
+                GlyphCache::AddText(c.pronunciation);
+                s.queue.push_back(std::move(c));
+            }
+            if (wasEmpty && !s.queue.empty()) s.shownAt = now;
+        }
+
+        static void Commit()
+        {
+            SessionState& s = *g_session;
+            if (s.batch.empty()) return;
+            auto t0 = Clock::now();
+            bool ok = s.source.commit(s.batch);
+            double ms = MsSince(t0, Clock::now());
+            s.stats.lastCommitMs = ms;
+            s.stats.maxCommitMs = (std::max)(s.stats.maxCommitMs, ms);
+            if (ok)
+            {
+                s.stats.commits++;
+                s.batch.clear();
+            }
+            else
+            {
+                // 回答已经应用在内存里，下次提交再试
+                s.stats.failedCommits++;
+            }
+        }
+
+        void Start(Source source)
+        {
+            if (g_session && g_session->active) End();
+            g_session = std::make_unique<SessionState>();
+            g_session->source = std::move(source);
+            g_session->active = true;
+            g_session->startedAt = Clock::now();
+            g_session->latencies.reserve(kLatencySamples);
+            Refill();
+        }
+
+        void End()
+        {
+            if (!g_session || !g_session->active) return;
+            Commit();
+            g_session->active = false;
+            g_session->endedAt = Clock::now();
+            g_session->queue.clear();
+        }
+
+        bool Active()
+        {
+            return g_session && g_session->active;
+        }
+
+        const Card* Current()
+        {
+            if (!Active()) return nullptr;
+            if (g_session->queue.empty()) Refill();
+            if (g_session->queue.empty()) return nullptr;
+            return &g_session->queue.front();
+        }
+
+        bool Revealed()
+        {
+            return Active() && g_session->revealed;
+        }
+
+        void Reveal()
+        {
+            if (Active()) g_session->revealed = true;
+        }
+
+        void Submit(Grade grade)
+        {
+            if (!Current()) return;
+            SessionState& s = *g_session;
+            const auto now = Clock::now();
+
+            Answer answer;
+            answer.id = s.queue.front().id;
+            answer.grade = grade;
+            answer.at = std::chrono::system_clock::now();
+            answer.latencyMs = MsSince(s.shownAt, now);
+            s.queue.pop_front();
+
+            if (s.source.apply(answer))
+            {
+                s.batch.push_back(answer);
+                s.stats.answered++;
+                s.stats.byGrade[(size_t)grade]++;
+                if (s.latencies.size() < kLatencySamples) s.latencies.push_back(answer.latencyMs);
+                else s.latencies[s.latencyNext] = answer.latencyMs;
+                s.latencyNext = (s.latencyNext + 1) % kLatencySamples;
+            }
+            if (s.batch.size() >= kCommitEvery) Commit();
+
+            Refill();
+            s.revealed = false;
+            s.shownAt = Clock::now();
+        }
+
+        Stats GetStats()
+        {
+            if (!g_session) return Stats();
+            SessionState& s = *g_session;
+            Stats out = s.stats;
+            out.queued = s.queue.size();
+            out.uncommitted = s.batch.size();
+            out.elapsedSec = std::chrono::duration<double>((s.active ? Clock::now() : s.endedAt) - s.startedAt).count();
+            if (out.elapsedSec > 0.0) out.cardsPerMinute = out.answered * 60.0 / out.elapsedSec;
+            if (!s.latencies.empty())
+            {
+                std::vector<double> sorted = s.latencies;
+                std::sort(sorted.begin(), sorted.end());
+                out.latencyP50Ms = sorted[sorted.size() / 2];
+                out.latencyP95Ms = sorted[(std::min)(sorted.size() - 1, sorted.size() * 95 / 100)];
+            }
+            return out;
+        }
+
+        const char* GradeName(Grade grade)
+        {
+            switch (grade)
+            {
+            case Grade::Again: return "重来";
+            case Grade::Hard: return "困难";
+            case Grade::Good: return "记得";
+            case Grade::Easy: return "简单";
+            default: return "?";
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace WordReminder
+{
+    // 复习模式：按到期集合的顺序逐张出卡、评分。
+    // 队列里始终预取好下一批卡片（文本复制出来并提前报给 GlyphCache），翻到下一张时不用查单词表也不会触发字体重建；
+    // 评分立即改内存里的单词（下次提醒时间），但落盘攒成一批，每 kCommitEvery 个回答或结束时提交一次。
+    // 只在 UI 线程使用。
+    namespace Review
+    {
+        constexpr size_t kPrefetchCards = 20;  // 队列预取的卡片数，低于一半时补满
+        constexpr size_t kCommitEvery = 50;    // 攒够这么多回答就提交一次
+
+        enum class Grade { Again, Hard, Good, Easy, Count };
+
+        struct Card
+        {
+            uint64_t id = 0;
+            uint32_t revision = 0;
+            std::string word;           // 预取的显示文本
+            std::string meaning;
+            std::string pronunciation;
+        };
+
+        struct Answer
+        {
+            uint64_t id = 0;
+            Grade grade = Grade::Good;
+            std::chrono::system_clock::time_point at;
+            double latencyMs = 0.0;  // 出卡到评分
+        };
+
+        struct Source
+        {
+            // 下一批到期卡片（按调度顺序，最多 max 张），跳过 skip 里的 id（升序）
+            std::function<std::vector<Card>(size_t max, const std::vector<uint64_t>& skip)> fetch;
+            // 把一个评分应用到内存里的单词；卡片已被删除时返回 false
+            std::function<bool(const Answer&)> apply;
+            // 把一批已应用的回答写到存储
+            std::function<bool(const std::vector<Answer>&)> commit;
+        };
+
+        void Start(Source source);
+        // 提交剩余回答并结束
+        void End();
+        bool Active();
+
+        // 当前卡片；队列空了（今天复习完）时为 nullptr，之后每秒补一次货
+        const Card* Current();
+        bool Revealed();
+        void Reveal();
+        // 给当前卡片评分并翻到下一张
+        void Submit(Grade grade);
+
+        struct Stats
+        {
+            size_t answered = 0;
+            size_t byGrade[(size_t)Grade::Count] = {};
+            size_t queued = 0;            // 预取队列里的卡片（含当前）
+            size_t uncommitted = 0;       // 已应用、未提交的回答
+            size_t commits = 0;
+            size_t failedCommits = 0;
+            double elapsedSec = 0.0;
+            double cardsPerMinute = 0.0;
+            double latencyP50Ms = 0.0;    // 出卡到评分，最近的回答
+            double latencyP95Ms = 0.0;
+            double lastCommitMs = 0.0;
+            double maxCommitMs = 0.0;
+        };
+        Stats GetStats();
+
+        const char* GradeName(Grade grade);
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Runs an expensive probe on one dedicated thread and publishes each result as an immutable
+// snapshot. Readers call Latest() (atomic shared_ptr load, never waits for the probe) and keep
+// the returned pointer for as long as they use it. At most one probe is queued or running;
+// Request() while busy is dropped. The probe is a plain callable, so tests can substitute a mock.
+template <typename T>
+class SnapshotWorker
+{
+public:
+    using Probe = std::function<std::shared_ptr<const T>()>;
+    using ThreadHook = std::function<void()>;
+
+    SnapshotWorker() = default;
+    ~SnapshotWorker() { Stop(); }
+    SnapshotWorker(const SnapshotWorker&) = delete;
+    SnapshotWorker& operator=(const SnapshotWorker&) = delete;
+
+    // onThreadStart/onThreadExit run once on the worker thread (e.g. CoInitializeEx/CoUninitialize).
+    // Ignored while the worker is running.
+    void SetProbe(Probe fn, ThreadHook onThreadStart = nullptr, ThreadHook onThreadExit = nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (thread.joinable()) return;
+        probe = std::move(fn);
+        threadStart = std::move(onThreadStart);
+        threadExit = std::move(onThreadExit);
+    }
+
+    // Queue one probe, starting the thread on first use. False if a probe is already in flight.
+    bool Request()
+    {
+        bool expected = false;
+        if (!inFlight.compare_exchange_strong(expected, true)) return false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!probe) { inFlight = false; return false; }
+            requested = true;
+            stopping = false;
+            if (!thread.joinable()) thread = std::thread([this]() { Run(); });
+        }
+        wake.notify_one();
+        return true;
+    }
+
+    bool InFlight() const { return inFlight.load(); }
+
+    // Latest published snapshot (nullptr until the first probe completes)
+    std::shared_ptr<const T> Latest() const { return std::atomic_load(&latest); }
+
+    // Incremented on every publish; lets readers skip work when nothing changed
+    uint64_t Generation() const { return generation.load(std::memory_order_acquire); }
+
+    // Join the worker (waits for a running probe). The last snapshot stays readable and a later
+    // Request() starts a new thread.
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!thread.joinable()) return;
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+        std::lock_guard<std::mutex> lock(mutex);
+        thread = std::thread();
+        if (requested) { requested = false; inFlight = false; }
+    }
+
+    // Drop the published snapshot so Latest() returns nullptr until the next probe completes
+    // (e.g. after Stop() when the owner releases its state)
+    void ClearLatest() { std::atomic_store(&latest, std::shared_ptr<const T>()); }
+
+private:
+    void Run()
+    {
+        if (threadStart) threadStart();
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() { return requested || stopping; });
+                if (stopping) break;
+                requested = false;
+            }
+            std::shared_ptr<const T> result;
+            try
+            {
+                result = probe();
+            }
+            catch (...)
+            {
+                // Keep the previous snapshot; the next Request() retries
+            }
+            if (result)
+            {
+                std::atomic_store(&latest, std::move(result));
+                generation.fetch_add(1, std::memory_order_release);
+            }
+            inFlight = false;
+        }
+        if (threadExit) threadExit();
+    }
+
+    Probe probe;
+    ThreadHook threadStart;
+    ThreadHook threadExit;
+    std::shared_ptr<const T> latest;
+    std::atomic<uint64_t> generation{0};
+    std::atomic<bool> inFlight{false};
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool requested = false;
+    bool stopping = false;
+    std::thread thread;
+};
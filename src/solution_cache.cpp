@@ -0,0 +1,210 @@
+#include "solution_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace SolutionCache
+{
+    struct StrategyConfig
+    {
+        const char* name;
+        double budgetMs;
+        double cooldownSeconds; // skip period after a run over budget (0: never skipped)
+        double ttlSeconds;      // freshness of per-process answers (< 0: process lifetime)
+    };
+
+    // Dte is the primary source and is never skipped; the fallbacks back off when they get slow
+    static const StrategyConfig kConfig[(int)Strategy::Count] = {
+        { "DTE (ROT)",       2000.0,  0.0,  0.0 },
+        { "Command line",     200.0, 10.0, -1.0 },
+        { "Document walk",    300.0, 30.0,  0.0 },
+        { "Process handles", 1500.0, 60.0, 60.0 },
+    };
+
+    struct ProcessAnswer
+    {
+        std::string path;
+        std::chrono::steady_clock::time_point at;
+    };
+
+    struct DirAnswer
+    {
+        fs::file_time_type mtime;
+        std::string sln; // empty: no .sln in this directory
+    };
+
+    struct ProcessKeyStrategyHash
+    {
+        size_t operator()(const std::pair<ProcessEnum::ProcessKey, int>& k) const
+        {
+            return ProcessEnum::ProcessKeyHash()(k.first) * 31 + (size_t)k.second;
+        }
+    };
+
+    static std::mutex g_mutex;
+    static StrategyStats g_stats[(int)Strategy::Count];
+    static std::chrono::steady_clock::time_point g_coolUntil[(int)Strategy::Count];
+    static std::unordered_map<std::pair<ProcessEnum::ProcessKey, int>, ProcessAnswer, ProcessKeyStrategyHash> g_processAnswers;
+    static std::unordered_map<std::string, DirAnswer> g_dirAnswers;
+    static const size_t g_maxDirAnswers = 4096;
+
+    const char* StrategyName(Strategy s)
+    {
+        return (int)s < (int)Strategy::Count ? kConfig[(int)s].name : "?";
+    }
+
+    Deadline::Deadline(double budgetMs)
+        : end(std::chrono::steady_clock::now() + std::chrono::microseconds((long long)(budgetMs * 1000.0)))
+    {
+    }
+
+    // Caller holds g_mutex
+    static void RecordLocked(Strategy s, double ms, bool found)
+    {
+        StrategyStats& st = g_stats[(int)s];
+        st.calls++;
+        if (found) st.found++;
+        st.totalMs += ms;
+        st.maxMs = std::max(st.maxMs, ms);
+        const StrategyConfig& cfg = kConfig[(int)s];
+        if (ms > cfg.budgetMs)
+        {
+            st.overBudget++;
+            if (cfg.cooldownSeconds > 0.0)
+                g_coolUntil[(int)s] = std::chrono::steady_clock::now() + std::chrono::milliseconds((long long)(cfg.cooldownSeconds * 1000.0));
+        }
+    }
+
+    void Record(Strategy s, double ms, bool found)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        RecordLocked(s, ms, found);
+    }
+
+    std::string Run(Strategy s, const StrategyFn& fn)
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            if (std::chrono::steady_clock::now() < g_coolUntil[(int)s])
+            {
+                g_stats[(int)s].skipped++;
+                return std::string();
+            }
+        }
+        // The strategy runs unlocked: it may take its whole budget
+        auto t0 = std::chrono::steady_clock::now();
+        std::string result = fn(Deadline(kConfig[(int)s].budgetMs));
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        Record(s, ms, !result.empty());
+        return result;
+    }
+
+    std::string RunForProcess(Strategy s, const ProcessEnum::ProcessKey& key, const StrategyFn& fn)
+    {
+        const auto cacheKey = std::make_pair(key, (int)s);
+        const double ttl = kConfig[(int)s].ttlSeconds;
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            auto it = g_processAnswers.find(cacheKey);
+            if (it != g_processAnswers.end() &&
+                (ttl < 0.0 || std::chrono::duration<double>(std::chrono::steady_clock::now() - it->second.at).count() < ttl))
+            {
+                g_stats[(int)s].cacheHits++;
+                return it->second.path;
+            }
+            if (std::chrono::steady_clock::now() < g_coolUntil[(int)s])
+            {
+                g_stats[(int)s].skipped++;
+                return std::string();
+            }
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        Deadline deadline(kConfig[(int)s].budgetMs);
+        std::string result = fn(deadline);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::lock_guard<std::mutex> lock(g_mutex);
+        RecordLocked(s, ms, !result.empty());
+        // A run cut short by its deadline proves nothing: only complete answers are cached
+        if (!result.empty() || !deadline.Expired())
+            g_processAnswers[cacheKey] = ProcessAnswer{ result, std::chrono::steady_clock::now() };
+        return result;
+    }
+
+    void ForgetProcess(const ProcessEnum::ProcessKey& key)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        for (int s = 0; s < (int)Strategy::Count; ++s)
+            g_processAnswers.erase(std::make_pair(key, s));
+    }
+
+    static std::string ListSolution(const fs::path& dir)
+    {
+        std::error_code ec;
+        for (fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec), end; !ec && it != end; it.increment(ec))
+        {
+            std::error_code fileEc;
+            if (!it->is_regular_file(fileEc) || fileEc) continue;
+            std::string ext = it->path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+            if (ext == ".sln") return it->path().string();
+        }
+        return std::string();
+    }
+
+    std::string FindSolutionUpward(const fs::path& startDir, int maxDepth, const Deadline& deadline)
+    {
+        fs::path dir = startDir;
+        for (int depth = 0; depth < maxDepth && !dir.empty(); ++depth)
+        {
+            if (deadline.Expired()) return std::string();
+            std::error_code ec;
+            fs::file_time_type mtime = fs::last_write_time(dir, ec);
+            if (!ec)
+            {
+                const std::string dirKey = dir.string();
+                std::string sln;
+                bool cached = false;
+                {
+                    std::lock_guard<std::mutex> lock(g_mutex);
+                    auto it = g_dirAnswers.find(dirKey);
+                    if (it != g_dirAnswers.end() && it->second.mtime == mtime)
+                    {
+                        sln = it->second.sln;
+                        cached = true;
+                        g_stats[(int)Strategy::DocumentWalk].cacheHits++;
+                    }
+                }
+                if (!cached)
+                {
+                    sln = ListSolution(dir);
+                    std::lock_guard<std::mutex> lock(g_mutex);
+                    if (g_dirAnswers.size() >= g_maxDirAnswers) g_dirAnswers.clear();
+                    g_dirAnswers[dirKey] = DirAnswer{ mtime, sln };
+                }
+                if (!sln.empty()) return sln;
+            }
+            fs::path parent = dir.parent_path();
+            if (parent == dir) break;
+            dir = parent;
+        }
+        return std::string();
+    }
+
+    std::vector<StrategyStats> GetStats()
+    {
+        std::vector<StrategyStats> out;
+        std::lock_guard<std::mutex> lock(g_mutex);
+        for (int s = 0; s < (int)Strategy::Count; ++s)
+        {
+            StrategyStats st = g_stats[s];
+            st.strategy = (Strategy)s;
+            st.budgetMs = kConfig[s].budgetMs;
+            out.push_back(st);
+        }
+        return out;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "instance_tracker.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Memoized solution-path resolution for VSInspector.
+// Every strategy (DTE, command line, handle scan, .sln walk near the active document) runs
+// through Run()/RunForProcess(), which enforce a per-strategy time budget and record latency/
+// hit counters for the UI. Per-process results are cached by (pid, start time); the upward .sln
+// walk caches each directory's answer (including "no .sln here") until the directory's mtime
+// changes. Thread-safe; strategies run on the refresh worker, the UI only reads GetStats().
+namespace SolutionCache
+{
+    enum class Strategy { Dte, CommandLine, DocumentWalk, ProcessHandles, Count };
+
+    const char* StrategyName(Strategy s);
+
+    // Cooperative time limit handed to a strategy; long loops should stop once Expired()
+    class Deadline
+    {
+    public:
+        explicit Deadline(double budgetMs);
+        bool Expired() const { return std::chrono::steady_clock::now() >= end; }
+        std::chrono::steady_clock::time_point End() const { return end; }
+
+    private:
+        std::chrono::steady_clock::time_point end;
+    };
+
+    struct StrategyStats
+    {
+        Strategy strategy = Strategy::Dte;
+        double budgetMs = 0.0;
+        uint64_t calls = 0;       // strategy actually executed
+        uint64_t found = 0;       // executions that produced a path
+        uint64_t cacheHits = 0;   // answered from the process/directory cache
+        uint64_t overBudget = 0;  // executions that exceeded budgetMs
+        uint64_t skipped = 0;     // not run because the strategy is cooling down after going over budget
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    using StrategyFn = std::function<std::string(const Deadline&)>;
+
+    // Run a strategy (unless it is cooling down) and record its latency. Returns "" if skipped.
+    std::string Run(Strategy s, const StrategyFn& fn);
+
+    // Run() memoized per process: a cached answer for (key, s) is returned while it is fresh
+    // (command line: process lifetime; handle scan: 60 s; negative answers included).
+    std::string RunForProcess(Strategy s, const ProcessEnum::ProcessKey& key, const StrategyFn& fn);
+
+    // Drop cached answers of an exited process
+    void ForgetProcess(const ProcessEnum::ProcessKey& key);
+
+    // First .sln in startDir or one of its parents (at most maxDepth levels); "" if none or if the
+    // deadline expired. Directory listings are memoized and revalidated by directory mtime.
+    std::string FindSolutionUpward(const std::filesystem::path& startDir, int maxDepth, const Deadline& deadline);
+
+    // Record a run measured by the caller (e.g. the inline ROT walk)
+    void Record(Strategy s, double ms, bool found);
+
+    std::vector<StrategyStats> GetStats();
+}
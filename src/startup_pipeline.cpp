@@ -0,0 +1,270 @@
+#include "startup_pipeline.h"
+#include "replace_tool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+
+namespace Startup
+{
+    using ReplaceTool::AppendLog;
+
+    struct TraceEvent
+    {
+        std::string name;
+        long long tsUs;
+        long long durUs; // < 0 for instant events
+        unsigned tid;
+    };
+
+    static std::mutex g_traceMutex;
+    static std::vector<TraceEvent> g_events;
+    static std::atomic<int> g_openPhases{0};
+    static std::atomic<bool> g_firstFrameMarked{false};
+    static std::atomic<bool> g_traceWritten{false};
+    static long long g_firstFrameUs = 0;
+
+    static long long NowUs()
+    {
+        // Time base starts at the first startup call (process_start is marked first thing in main)
+        static const auto origin = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    static unsigned ThreadTag()
+    {
+        return (unsigned)(std::hash<std::thread::id>{}(std::this_thread::get_id()) & 0xFFFF);
+    }
+
+    static void Record(const std::string& name, long long tsUs, long long durUs)
+    {
+        std::lock_guard<std::mutex> lock(g_traceMutex);
+        g_events.push_back({ name, tsUs, durUs, ThreadTag() });
+    }
+
+    // ---------------------------------------------------------------------
+    // ScopedPhase / markers
+    // ---------------------------------------------------------------------
+    ScopedPhase::ScopedPhase(const std::string& name)
+        : name(name), startUs(0), active(!g_traceWritten.load())
+    {
+        if (!active) return;
+        g_openPhases.fetch_add(1);
+        startUs = NowUs();
+    }
+
+    ScopedPhase::~ScopedPhase()
+    {
+        if (!active) return;
+        Record(name, startUs, NowUs() - startUs);
+        g_openPhases.fetch_sub(1);
+    }
+
+    void Mark(const std::string& name)
+    {
+        if (g_traceWritten.load()) return;
+        Record(name, NowUs(), -1);
+    }
+
+    void MarkFirstFrame()
+    {
+        if (g_firstFrameMarked.exchange(true)) return;
+        g_firstFrameUs = NowUs();
+        Record("first_frame", g_firstFrameUs, -1);
+        AppendLog("[startup] time-to-first-frame: " + std::to_string(g_firstFrameUs / 1000) + " ms");
+    }
+
+    static void WriteJsonString(std::ofstream& ofs, const std::string& s)
+    {
+        ofs << '"';
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\') { ofs << '\\' << c; }
+            else if ((unsigned char)c < 0x20) { char buf[8]; std::snprintf(buf, sizeof(buf), "\\u%04x", c); ofs << buf; }
+            else ofs << c;
+        }
+        ofs << '"';
+    }
+
+    void WriteTraceWhenIdle()
+    {
+        if (g_traceWritten.load() || !g_firstFrameMarked.load() || g_openPhases.load() != 0) return;
+        if (g_traceWritten.exchange(true)) return;
+
+        std::vector<TraceEvent> events;
+        {
+            std::lock_guard<std::mutex> lock(g_traceMutex);
+            events.swap(g_events);
+        }
+        std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.tsUs < b.tsUs; });
+
+        const char* path = "startup_trace.json"; // 与 DearImGuiExample.log 同目录
+        std::ofstream ofs(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!ofs)
+        {
+            AppendLog(std::string("[startup] 无法写入启动追踪文件: ") + path);
+            return;
+        }
+        ofs << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"time_to_first_frame_us\":" << g_firstFrameUs << "},\"traceEvents\":[\n";
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const auto& ev = events[i];
+            ofs << "{\"name\":";
+            WriteJsonString(ofs, ev.name);
+            if (ev.durUs >= 0) ofs << ",\"ph\":\"X\",\"dur\":" << ev.durUs;
+            else ofs << ",\"ph\":\"i\",\"s\":\"g\"";
+            ofs << ",\"cat\":\"startup\",\"ts\":" << ev.tsUs << ",\"pid\":1,\"tid\":" << ev.tid << "}";
+            ofs << (i + 1 < events.size() ? ",\n" : "\n");
+        }
+        ofs << "]}\n";
+
+        for (const auto& ev : events)
+        {
+            if (ev.durUs < 0) continue;
+            AppendLog("[startup] " + ev.name + ": " + std::to_string(ev.durUs / 1000) + "." +
+                      std::to_string((ev.durUs / 100) % 10) + " ms (at +" + std::to_string(ev.tsUs / 1000) + " ms)");
+        }
+        AppendLog(std::string("[startup] trace written: ") + path);
+    }
+
+    // ---------------------------------------------------------------------
+    // TaskGraph
+    // ---------------------------------------------------------------------
+    TaskGraph::TaskGraph(unsigned count)
+    {
+        unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        workerCount = count ? count : std::min(4u, hw);
+    }
+
+    TaskGraph::~TaskGraph()
+    {
+        if (started) WaitAll();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (auto& t : workers)
+        {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    TaskId TaskGraph::Add(const std::string& name, std::function<void()> fn, const std::vector<TaskId>& deps, bool mainThread)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (started)
+        {
+            AppendLog("[startup] task added after Start() ignored: " + name);
+            return -1;
+        }
+        TaskId id = (TaskId)tasks.size();
+        Task task;
+        task.name = name;
+        task.fn = std::move(fn);
+        task.mainThread = mainThread;
+        for (TaskId dep : deps)
+        {
+            if (dep < 0 || dep >= id) continue;
+            tasks[dep].dependents.push_back(id);
+            task.pendingDeps++;
+        }
+        tasks.push_back(std::move(task));
+        return id;
+    }
+
+    // Caller holds mutex
+    void TaskGraph::EnqueueLocked(TaskId id)
+    {
+        if (tasks[id].mainThread) mainQueue.push_back(id);
+        else workerQueue.push_back(id);
+    }
+
+    void TaskGraph::Start()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (started) return;
+            started = true;
+            for (TaskId id = 0; id < (TaskId)tasks.size(); ++id)
+            {
+                if (tasks[id].pendingDeps == 0) EnqueueLocked(id);
+            }
+        }
+        for (unsigned i = 0; i < workerCount; ++i)
+        {
+            workers.emplace_back([this]() { WorkerLoop(); });
+        }
+        workAvailable.notify_all();
+    }
+
+    void TaskGraph::RunTask(TaskId id)
+    {
+        {
+            ScopedPhase phase(tasks[id].name);
+            try
+            {
+                if (tasks[id].fn) tasks[id].fn();
+            }
+            catch (const std::exception& e)
+            {
+                AppendLog("[startup] task '" + tasks[id].name + "' threw: " + e.what());
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks[id].done = true;
+            for (TaskId dep : tasks[id].dependents)
+            {
+                if (--tasks[dep].pendingDeps == 0) EnqueueLocked(dep);
+            }
+        }
+        workAvailable.notify_all();
+        taskDone.notify_all();
+    }
+
+    void TaskGraph::WorkerLoop()
+    {
+        for (;;)
+        {
+            TaskId id = -1;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workAvailable.wait(lock, [this]() { return stopping || !workerQueue.empty(); });
+                if (workerQueue.empty()) return; // stopping
+                id = workerQueue.front();
+                workerQueue.pop_front();
+            }
+            RunTask(id);
+        }
+    }
+
+    void TaskGraph::Wait(TaskId id)
+    {
+        if (id < 0 || id >= (TaskId)tasks.size()) return;
+        if (!started) Start();
+        for (;;)
+        {
+            TaskId mainTask = -1;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskDone.wait(lock, [&]() { return tasks[id].done || !mainQueue.empty(); });
+                if (tasks[id].done) return;
+                mainTask = mainQueue.front();
+                mainQueue.pop_front();
+            }
+            RunTask(mainTask);
+        }
+    }
+
+    void TaskGraph::WaitAll()
+    {
+        for (TaskId id = 0; id < (TaskId)tasks.size(); ++id)
+        {
+            Wait(id);
+        }
+    }
+}
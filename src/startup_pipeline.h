@@ -0,0 +1,92 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Startup task graph + startup-phase tracing.
+// Independent startup steps run concurrently on a small worker pool; steps that must run on the
+// UI thread (ImGui/D3D/GLFW calls) are flagged mainThread and executed inside Wait().
+// Every task and ScopedPhase is recorded and written as a Chrome trace (startup_trace.json,
+// next to DearImGuiExample.log) once the first frame has been presented and all phases closed.
+namespace Startup
+{
+    using TaskId = int;
+
+    class TaskGraph
+    {
+    public:
+        // workerCount == 0 picks min(4, hardware_concurrency)
+        explicit TaskGraph(unsigned workerCount = 0);
+        ~TaskGraph();
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        // Register a task; must be called before Start(). deps must refer to earlier tasks.
+        TaskId Add(const std::string& name, std::function<void()> fn, const std::vector<TaskId>& deps = {}, bool mainThread = false);
+
+        // Spawn workers and queue every task whose dependencies are met
+        void Start();
+
+        // Block until the task is done, running ready main-thread tasks in the meantime
+        void Wait(TaskId id);
+
+        // Wait for every task
+        void WaitAll();
+
+    private:
+        struct Task
+        {
+            std::string name;
+            std::function<void()> fn;
+            std::vector<TaskId> dependents;
+            int pendingDeps = 0;
+            bool mainThread = false;
+            bool done = false;
+        };
+
+        void WorkerLoop();
+        void RunTask(TaskId id);
+        void EnqueueLocked(TaskId id);
+
+        std::vector<Task> tasks;
+        std::deque<TaskId> workerQueue;
+        std::deque<TaskId> mainQueue;
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::condition_variable taskDone;
+        unsigned workerCount = 0;
+        bool started = false;
+        bool stopping = false;
+    };
+
+    // Records [construction, destruction) as a named startup phase on the calling thread
+    class ScopedPhase
+    {
+    public:
+        explicit ScopedPhase(const std::string& name);
+        ~ScopedPhase();
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    private:
+        std::string name;
+        long long startUs;
+        bool active;
+    };
+
+    // Instant event (e.g. "process_start")
+    void Mark(const std::string& name);
+
+    // Record time-to-first-frame; call right after the first Present/SwapBuffers
+    void MarkFirstFrame();
+
+    // Write startup_trace.json once the first frame is marked and no phase is still open.
+    // Cheap no-op after the trace has been written; call once per frame.
+    void WriteTraceWhenIdle();
+}
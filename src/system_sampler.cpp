@@ -0,0 +1,369 @@
+#include "system_sampler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#include <winioctl.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+#endif
+
+namespace SystemSampler
+{
+    struct CpuCounters
+    {
+        uint64_t busy = 0;
+        uint64_t total = 0;
+    };
+
+    struct RawSample
+    {
+        CpuCounters all;
+        std::vector<CpuCounters> cores;
+        uint64_t memTotal = 0;
+        uint64_t memAvailable = 0;
+        bool diskIoOk = false;
+        uint64_t diskReadBytes = 0;
+        uint64_t diskWriteBytes = 0;
+        uint64_t diskTotal = 0;
+        uint64_t diskFree = 0;
+        uint64_t uptimeSeconds = 0;
+    };
+
+    static const std::chrono::milliseconds g_interval(1000);
+
+    static std::mutex g_mutex;               // guards the thread handle, g_totals and g_cores' size
+    static std::condition_variable g_wake;
+    static std::thread g_thread;
+    static bool g_stopping = false;
+    static Totals g_totals;
+
+    static TimeSeries g_cpu(kHistorySeconds);
+    static TimeSeries g_memory(kHistorySeconds);
+    static TimeSeries g_diskRead(kHistorySeconds);
+    static TimeSeries g_diskWrite(kHistorySeconds);
+    static std::vector<std::unique_ptr<TimeSeries>> g_cores;
+    static std::atomic<size_t> g_coreCount{ 0 };
+
+#ifdef _WIN32
+    static uint64_t FileTimeToU64(const FILETIME& ft)
+    {
+        return ((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    }
+
+    // SystemProcessorPerformanceInformation (8): one entry per logical processor; kernel time includes idle
+    struct ProcessorPerformance
+    {
+        LARGE_INTEGER IdleTime;
+        LARGE_INTEGER KernelTime;
+        LARGE_INTEGER UserTime;
+        LARGE_INTEGER DpcTime;
+        LARGE_INTEGER InterruptTime;
+        ULONG InterruptCount;
+    };
+
+    static bool ReadRaw(RawSample& s)
+    {
+        FILETIME idle, kernel, user;
+        if (!GetSystemTimes(&idle, &kernel, &user)) return false;
+        s.all.total = FileTimeToU64(kernel) + FileTimeToU64(user);
+        s.all.busy = s.all.total - FileTimeToU64(idle);
+
+        typedef LONG (WINAPI *PNtQuerySystemInformation)(ULONG, PVOID, ULONG, PULONG);
+        static PNtQuerySystemInformation query = (PNtQuerySystemInformation)GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation");
+        static std::vector<ProcessorPerformance> perf;
+        if (perf.empty())
+        {
+            SYSTEM_INFO si;
+            GetSystemInfo(&si);
+            perf.resize(si.dwNumberOfProcessors ? si.dwNumberOfProcessors : 1);
+        }
+        ULONG len = 0;
+        s.cores.clear();
+        if (query && query(8, perf.data(), (ULONG)(perf.size() * sizeof(ProcessorPerformance)), &len) >= 0)
+        {
+            for (size_t i = 0; i < len / sizeof(ProcessorPerformance); ++i)
+            {
+                CpuCounters c;
+                c.total = (uint64_t)perf[i].KernelTime.QuadPart + (uint64_t)perf[i].UserTime.QuadPart;
+                c.busy = c.total - (uint64_t)perf[i].IdleTime.QuadPart;
+                s.cores.push_back(c);
+            }
+        }
+
+        MEMORYSTATUSEX mem;
+        mem.dwLength = sizeof(mem);
+        if (GlobalMemoryStatusEx(&mem))
+        {
+            s.memTotal = mem.ullTotalPhys;
+            s.memAvailable = mem.ullAvailPhys;
+        }
+
+        // Volume I/O counters of C: (opened without access rights: IOCTL_DISK_PERFORMANCE needs none)
+        static HANDLE volume = CreateFileW(L"\\\\.\\C:", 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+        if (volume != INVALID_HANDLE_VALUE)
+        {
+            DISK_PERFORMANCE dp;
+            DWORD bytes = 0;
+            if (DeviceIoControl(volume, IOCTL_DISK_PERFORMANCE, NULL, 0, &dp, sizeof(dp), &bytes, NULL))
+            {
+                s.diskIoOk = true;
+                s.diskReadBytes = (uint64_t)dp.BytesRead.QuadPart;
+                s.diskWriteBytes = (uint64_t)dp.BytesWritten.QuadPart;
+            }
+        }
+
+        ULARGE_INTEGER freeAvail, totalBytes, totalFree;
+        if (GetDiskFreeSpaceExW(L"C:\\", &freeAvail, &totalBytes, &totalFree))
+        {
+            s.diskTotal = totalBytes.QuadPart;
+            s.diskFree = totalFree.QuadPart;
+        }
+        s.uptimeSeconds = GetTickCount64() / 1000;
+        return true;
+    }
+#elif defined(__linux__)
+    // Whole file into buf (buffer reused between samples); false if unreadable
+    static bool ReadSmallFile(const char* path, std::string& buf)
+    {
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        buf.clear();
+        char chunk[8192];
+        for (;;)
+        {
+            ssize_t n = read(fd, chunk, sizeof(chunk));
+            if (n <= 0) break;
+            buf.append(chunk, (size_t)n);
+        }
+        close(fd);
+        return !buf.empty();
+    }
+
+    // "cpu  user nice system idle iowait irq softirq steal ..." (USER_HZ ticks)
+    static bool ParseCpuLine(const char* p, CpuCounters& c)
+    {
+        uint64_t v[8] = {};
+        char* end = nullptr;
+        for (int i = 0; i < 8; ++i)
+        {
+            v[i] = std::strtoull(p, &end, 10);
+            if (end == p) { if (i < 4) return false; break; }
+            p = end;
+        }
+        c.total = v[0] + v[1] + v[2] + v[3] + v[4] + v[5] + v[6] + v[7];
+        c.busy = c.total - v[3] - v[4];
+        return true;
+    }
+
+    // Whole disks from /sys/block; partitions, loop/ram/zram and device-mapper nodes would double count
+    static const std::vector<std::string>& PhysicalDisks()
+    {
+        static const std::vector<std::string> disks = []() {
+            std::vector<std::string> out;
+            if (DIR* d = opendir("/sys/block"))
+            {
+                while (dirent* e = readdir(d))
+                {
+                    std::string name = e->d_name;
+                    if (name[0] == '.' || name.compare(0, 4, "loop") == 0 || name.compare(0, 3, "ram") == 0 ||
+                        name.compare(0, 4, "zram") == 0 || name.compare(0, 3, "dm-") == 0)
+                        continue;
+                    out.push_back(name);
+                }
+                closedir(d);
+            }
+            return out;
+        }();
+        return disks;
+    }
+
+    static bool ReadRaw(RawSample& s)
+    {
+        static std::string buf;
+        if (!ReadSmallFile("/proc/stat", buf)) return false;
+        s.cores.clear();
+        for (size_t pos = 0; pos < buf.size() && buf.compare(pos, 3, "cpu") == 0; )
+        {
+            const char* line = buf.c_str() + pos;
+            if (line[3] == ' ')
+            {
+                ParseCpuLine(line + 3, s.all);
+            }
+            else
+            {
+                const char* p = line + 3;
+                while (*p >= '0' && *p <= '9') ++p;
+                CpuCounters c;
+                if (ParseCpuLine(p, c)) s.cores.push_back(c);
+            }
+            size_t nl = buf.find('\n', pos);
+            if (nl == std::string::npos) break;
+            pos = nl + 1;
+        }
+
+        if (ReadSmallFile("/proc/meminfo", buf))
+        {
+            auto field = [&](const char* key) -> uint64_t {
+                size_t at = buf.find(key);
+                return at == std::string::npos ? 0 : std::strtoull(buf.c_str() + at + std::strlen(key), nullptr, 10) * 1024;
+            };
+            s.memTotal = field("MemTotal:");
+            s.memAvailable = field("MemAvailable:");
+        }
+
+        if (ReadSmallFile("/proc/diskstats", buf))
+        {
+            const std::vector<std::string>& disks = PhysicalDisks();
+            size_t pos = 0;
+            while (pos < buf.size())
+            {
+                size_t nl = buf.find('\n', pos);
+                if (nl == std::string::npos) nl = buf.size();
+                char name[64] = {};
+                unsigned long long f[7] = {};
+                // major minor name reads merged sectorsRead msRead writes merged sectorsWritten
+                if (std::sscanf(buf.c_str() + pos, "%*u %*u %63s %llu %llu %llu %llu %llu %llu %llu",
+                                name, &f[0], &f[1], &f[2], &f[3], &f[4], &f[5], &f[6]) == 8)
+                {
+                    for (const std::string& d : disks)
+                    {
+                        if (d != name) continue;
+                        s.diskIoOk = true;
+                        s.diskReadBytes += f[2] * 512;
+                        s.diskWriteBytes += f[6] * 512;
+                        break;
+                    }
+                }
+                pos = nl + 1;
+            }
+        }
+
+        struct statvfs vfs;
+        if (statvfs("/", &vfs) == 0)
+        {
+            s.diskTotal = (uint64_t)vfs.f_blocks * vfs.f_frsize;
+            s.diskFree = (uint64_t)vfs.f_bfree * vfs.f_frsize;
+        }
+        if (ReadSmallFile("/proc/uptime", buf)) s.uptimeSeconds = std::strtoull(buf.c_str(), nullptr, 10);
+        return true;
+    }
+#else
+    static bool ReadRaw(RawSample&) { return false; }
+#endif
+
+    static float BusyPercent(const CpuCounters& now, const CpuCounters& prev)
+    {
+        if (now.total <= prev.total || now.busy < prev.busy) return 0.0f;
+        double pct = 100.0 * (double)(now.busy - prev.busy) / (double)(now.total - prev.total);
+        return (float)std::min(100.0, std::max(0.0, pct));
+    }
+
+    static void Run(RawSample prev)
+    {
+        auto prevAt = std::chrono::steady_clock::now();
+        RawSample now;
+        std::unique_lock<std::mutex> lock(g_mutex);
+        while (!g_wake.wait_for(lock, g_interval, []() { return g_stopping; }))
+        {
+            lock.unlock();
+            auto t0 = std::chrono::steady_clock::now();
+            now = RawSample();
+            bool ok = ReadRaw(now);
+            if (ok)
+            {
+                const double seconds = std::chrono::duration<double>(t0 - prevAt).count();
+                g_cpu.Push(BusyPercent(now.all, prev.all));
+                const size_t cores = std::min(now.cores.size(), std::min(prev.cores.size(), g_coreCount.load()));
+                for (size_t i = 0; i < cores; ++i) g_cores[i]->Push(BusyPercent(now.cores[i], prev.cores[i]));
+                g_memory.Push(now.memTotal ? (float)(100.0 * (double)(now.memTotal - now.memAvailable) / (double)now.memTotal) : 0.0f);
+                if (now.diskIoOk && prev.diskIoOk && seconds > 0.0)
+                {
+                    g_diskRead.Push((float)((double)(now.diskReadBytes - std::min(now.diskReadBytes, prev.diskReadBytes)) / seconds));
+                    g_diskWrite.Push((float)((double)(now.diskWriteBytes - std::min(now.diskWriteBytes, prev.diskWriteBytes)) / seconds));
+                }
+                prev = now;
+                prevAt = t0;
+            }
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            lock.lock();
+            if (ok)
+            {
+                g_totals.memTotal = now.memTotal;
+                g_totals.memUsed = now.memTotal - std::min(now.memTotal, now.memAvailable);
+                g_totals.diskTotal = now.diskTotal;
+                g_totals.diskFree = now.diskFree;
+                g_totals.uptimeSeconds = now.uptimeSeconds;
+                g_totals.diskIoAvailable = now.diskIoOk;
+            }
+            g_totals.sampleMs = ms;
+        }
+    }
+
+    void Start()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (g_thread.joinable()) return;
+        // Baseline sample: fixes the core count and gives the first interval something to diff against
+        RawSample first;
+        ReadRaw(first);
+        if (g_cores.empty())
+        {
+            for (size_t i = 0; i < first.cores.size(); ++i)
+                g_cores.push_back(std::unique_ptr<TimeSeries>(new TimeSeries(kCoreHistorySeconds)));
+            g_coreCount = g_cores.size();
+        }
+        g_stopping = false;
+        g_thread = std::thread(Run, std::move(first));
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            if (!g_thread.joinable()) return;
+            g_stopping = true;
+        }
+        g_wake.notify_all();
+        g_thread.join();
+    }
+
+    bool IsRunning()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_thread.joinable();
+    }
+
+    Totals Latest()
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_totals;
+    }
+
+    const TimeSeries& Cpu() { return g_cpu; }
+    const TimeSeries& Memory() { return g_memory; }
+    const TimeSeries& DiskRead() { return g_diskRead; }
+    const TimeSeries& DiskWrite() { return g_diskWrite; }
+
+    size_t CoreCount() { return g_coreCount.load(); }
+
+    const TimeSeries& Core(size_t index)
+    {
+        static const TimeSeries empty(2);
+        return index < g_coreCount.load() ? *g_cores[index] : empty;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "time_series.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// System resource sampler for the VSInspector dashboard.
+// A background thread reads real counters once per second (Windows: GetSystemTimes, per-core
+// processor performance info, GlobalMemoryStatusEx, volume I/O counters; Linux: /proc/stat,
+// /proc/meminfo, /proc/diskstats) and appends them to fixed-size TimeSeries rings, so the UI can
+// draw the last hour at constant memory cost without ever waiting on the sampler.
+namespace SystemSampler
+{
+    constexpr size_t kHistorySeconds = 3600;     // total CPU, memory and disk I/O
+    constexpr size_t kCoreHistorySeconds = 300;  // per-core CPU
+
+    struct Totals
+    {
+        uint64_t memTotal = 0;       // bytes
+        uint64_t memUsed = 0;
+        uint64_t diskTotal = 0;      // system volume, bytes
+        uint64_t diskFree = 0;
+        uint64_t uptimeSeconds = 0;
+        double sampleMs = 0.0;       // cost of the last sampling pass
+        bool diskIoAvailable = false;
+    };
+
+    // Start the sampler thread (no-op if running). The first values arrive after one interval.
+    void Start();
+
+    // Stop and join the sampler thread; the series keep their history
+    void Stop();
+
+    bool IsRunning();
+
+    Totals Latest();
+
+    const TimeSeries& Cpu();         // % busy, all cores
+    const TimeSeries& Memory();      // % physical memory in use
+    const TimeSeries& DiskRead();    // bytes/s
+    const TimeSeries& DiskWrite();   // bytes/s
+
+    // Per-core series; the core count is fixed by the first Start()
+    size_t CoreCount();
+    const TimeSeries& Core(size_t index);
+}
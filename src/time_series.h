@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Fixed-capacity time series with one writer (a sampler thread) and any number of readers, no
+// locks. Push() stores into a ring of atomics and then publishes the new count; a reader that was
+// lapped by the writer while copying retries. Memory is fixed at construction, so an hour of 1 Hz
+// samples costs the same after a week of uptime as after the first hour.
+class TimeSeries
+{
+public:
+    explicit TimeSeries(size_t capacity)
+        : capacity(std::max<size_t>(capacity, 2)), slots(new std::atomic<float>[std::max<size_t>(capacity, 2)])
+    {
+        for (size_t i = 0; i < this->capacity; ++i) slots[i].store(0.0f, std::memory_order_relaxed);
+    }
+
+    TimeSeries(const TimeSeries&) = delete;
+    TimeSeries& operator=(const TimeSeries&) = delete;
+
+    size_t Capacity() const { return capacity; }
+
+    // Total samples ever pushed (doubles as a change counter for cached views)
+    uint64_t Count() const { return count.load(std::memory_order_acquire); }
+
+    // Writer thread only
+    void Push(float value)
+    {
+        uint64_t n = count.load(std::memory_order_relaxed);
+        slots[n % capacity].store(value, std::memory_order_relaxed);
+        count.store(n + 1, std::memory_order_release);
+    }
+
+    float Latest(float fallback = 0.0f) const
+    {
+        uint64_t n = Count();
+        return n == 0 ? fallback : slots[(n - 1) % capacity].load(std::memory_order_relaxed);
+    }
+
+    // Min/max of the newest `window` samples folded into at most `buckets` columns, oldest first.
+    // While the series holds fewer than `window` samples only the buckets that have data are
+    // returned, so a young series fills in from the right. Returns the number of buckets written.
+    size_t Downsample(size_t window, size_t buckets, std::vector<float>& mins, std::vector<float>& maxs) const
+    {
+        mins.clear();
+        maxs.clear();
+        // The slot the writer may be filling right now is never part of the window
+        window = std::min(window, capacity - 1);
+        if (window == 0 || buckets == 0) return 0;
+        buckets = std::min(buckets, window);
+        const double perBucket = (double)window / (double)buckets;
+
+        for (int attempt = 0; attempt < 3; ++attempt)
+        {
+            const uint64_t end = Count();
+            const size_t available = (size_t)std::min<uint64_t>(end, window);
+            if (available == 0) return 0;
+            const size_t filled = std::min(buckets, (size_t)((double)available / perBucket + 0.999999));
+            mins.assign(filled, 0.0f);
+            maxs.assign(filled, 0.0f);
+            for (size_t b = 0; b < filled; ++b)
+            {
+                // Bucket b covers ages [ageHi, ageLo) counted back from the newest sample
+                const size_t ageLo = (size_t)((double)(filled - 1 - b) * perBucket);
+                size_t ageHi = std::max(ageLo + 1, (size_t)((double)(filled - b) * perBucket));
+                ageHi = std::min(ageHi, available);
+                float lo = 0.0f, hi = 0.0f;
+                for (size_t age = ageLo; age < ageHi; ++age)
+                {
+                    float v = slots[(end - 1 - age) % capacity].load(std::memory_order_relaxed);
+                    if (age == ageLo) { lo = hi = v; }
+                    else { lo = std::min(lo, v); hi = std::max(hi, v); }
+                }
+                mins[b] = lo;
+                maxs[b] = hi;
+            }
+            // Valid unless the writer wrapped onto the oldest slot we read
+            if (Count() - end < capacity - available) return filled;
+        }
+        mins.clear();
+        maxs.clear();
+        return 0;
+    }
+
+private:
+    size_t capacity;
+    std::unique_ptr<std::atomic<float>[]> slots;
+    std::atomic<uint64_t> count{ 0 };
+};
@@ -1,11 +1,26 @@
 #include "vs_inspector.h"
 #include "replace_tool.h"
+#include "glyph_cache.h"
+#include "config_store.h"
+#include "file_watcher.h"
+#include "handle_scan.h"
+#include "instance_tracker.h"
+#include "json.h"
+#include "launch_scheduler.h"
+#include "process_enum.h"
+#include "process_sampler.h"
+#include "snapshot_worker.h"
+#include "solution_cache.h"
+#include "system_sampler.h"
 
 #include "imgui.h"
 #include <string>
 #include <vector>
 #include <mutex>
+#include <memory>
 #include <algorithm>
+#include <chrono>
+#include <deque>
 #include <fstream>
 #include <iterator>
 #include <cstring>
@@ -50,29 +65,45 @@ namespace VSInspector
         std::string workspaceName;
     };
 
-    static std::vector<VSInstance> g_vsList;
-    static std::vector<CursorInstance> g_cursorList;
-    static std::string g_feishuPath;
-    static bool g_feishuRunning = false;
-    static std::string g_wechatPath;
-    static bool g_wechatRunning = false;
-    static std::string g_currentWechatPath;  // 当前检测到的微信路径
-    static std::mutex g_vsMutexVS;
+    // Applications the refresh looks for (tags in AppNameTable())
+    enum AppKind { kAppNone = 0, kAppVS, kAppCursor, kAppFeishu, kAppWechat, kAppWechatHelper };
+
+    // Instance added/removed/changed between two refreshes
+    struct InstanceEvent
+    {
+        enum Kind { Added, Removed, Changed };
+        uint64_t seq = 0;
+        Kind kind = Added;
+        AppKind app = kAppNone;
+        DWORD pid = 0;
+        std::string detail;
+    };
 
-    // Configuration structure
-    struct SavedConfig
+    // Result of one background refresh; published whole and never modified afterwards
+    struct RefreshSnapshot
     {
-        std::string name;
-        std::string vsSolutionPath;
-        std::string cursorFolderPath;
+        std::vector<InstanceEvent> recentEvents; // last events, oldest first (seq increasing)
+        std::vector<VSInstance> vsInstances;
+        std::vector<CursorInstance> cursorInstances;
         std::string feishuPath;
-        std::string wechatPath;
-        unsigned long long createdAt = 0;    // unix time seconds
-        unsigned long long lastUsedAt = 0;   // unix time seconds
+        bool feishuRunning = false;
+        std::string wechatPath;  // 当前检测到的微信路径
+        bool wechatRunning = false;
     };
 
+    // Process/ROT/storage.json probing runs on this worker; the UI draws from g_view
+    static SnapshotWorker<RefreshSnapshot> g_refreshWorker;
+    static bool g_refreshCoInit = false;                  // worker thread only
+    static std::shared_ptr<const RefreshSnapshot> g_view; // UI thread only
+    static uint64_t g_viewGeneration = 0;
+
+    static std::string g_feishuPath;
+    static std::string g_wechatPath;
+
+    using ConfigStore::SavedConfig;
+
     // Selections and persistence
-    static std::vector<SavedConfig> g_savedConfigs;
+    static ConfigStore::Store g_configs;
     static std::string g_selectedSlnPath;
     static std::unordered_set<std::string> g_selectedSlnPaths;
     static std::string g_selectedCursorFolder;
@@ -80,6 +111,18 @@ namespace VSInspector
     static std::string g_currentConfigName;
     static bool g_prefsLoaded = false;  // Track if prefs have been loaded
 
+    // SavePrefs() only marks the configs dirty; FlushPrefs() writes once changes settle so a burst
+    // of edits (or an import) costs one write of each file
+    static const double kPrefsSaveDelayMs = 750.0;      // quiet time before writing
+    static const double kPrefsSaveMaxDelayMs = 3000.0;  // upper bound while changes keep coming
+    static bool g_prefsDirty = false;
+    static int g_prefsPendingSaves = 0;
+    static std::chrono::steady_clock::time_point g_prefsFirstChange;
+    static std::chrono::steady_clock::time_point g_prefsLastChange;
+    // prefs.json as last read or written, for merging changes made by another instance or a sync client
+    static ConfigStore::Snapshot g_prefsBase;
+    static FileWatcher::Id g_prefsWatch = 0;
+
              // 用于主界面配置名称输入框的全局变量
     static char g_mainConfigNameBuf[256] = {0};
     static bool g_shouldFillConfigName = false;
@@ -113,81 +156,120 @@ namespace VSInspector
     // Forward declare env helper used by prefs
     static std::string GetEnvU8(const char* name);
     
-    // System resource monitoring
-    struct SystemResources {
-        float cpuUsage = 0.0f;
-        unsigned long long totalMemory = 0;
-        unsigned long long usedMemory = 0;
-        unsigned long long totalDisk = 0;
-        unsigned long long freeDisk = 0;
-        unsigned long long uptime = 0;
-    };
-    
-    static SystemResources g_systemResources;
-    static float g_lastResourceUpdate = 0.0f;
-    static const float g_resourceUpdateInterval = 2.0f; // 2秒更新一次
-    
+    // System resource panel: sparkline span selection (seconds of 1 Hz history)
+    static const int g_resourceSpans[] = { 60, 300, 3600 };
+    static int g_resourceSpanIndex = 1;
 
-    
-    // Get system resources
-    static void UpdateSystemResources()
+    // Min/max band of the newest `seconds` samples, one column per ~2 px, newest at the right edge.
+    // maxValue <= 0 scales to the highest sample shown; returns the scale used.
+    static float DrawSparkline(const TimeSeries& series, size_t seconds, float maxValue, ImU32 color, float height)
     {
-        // CPU Usage (simplified - using GetTickCount64 for demo)
-        static ULONGLONG lastTickCount = 0;
-        ULONGLONG currentTickCount = GetTickCount64();
-        if (lastTickCount > 0) {
-            g_systemResources.cpuUsage = 50.0f + 20.0f * sinf(ImGui::GetTime() * 0.5f); // 模拟CPU使用率
+        static std::vector<float> mins, maxs;
+        const float width = std::max(60.0f, ImGui::GetContentRegionAvail().x);
+        const size_t buckets = (size_t)std::max(1.0f, width / 2.0f);
+        const size_t filled = series.Downsample(seconds, buckets, mins, maxs);
+        if (maxValue <= 0.0f)
+        {
+            maxValue = 1.0f;
+            for (size_t i = 0; i < filled; ++i) maxValue = std::max(maxValue, maxs[i]);
         }
-        lastTickCount = currentTickCount;
-        
-        // Memory Info
-        MEMORYSTATUSEX memInfo;
-        memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-        if (GlobalMemoryStatusEx(&memInfo)) {
-            g_systemResources.totalMemory = memInfo.ullTotalPhys;
-            g_systemResources.usedMemory = memInfo.ullTotalPhys - memInfo.ullAvailPhys;
+
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImDrawList* dl = ImGui::GetWindowDrawList();
+        dl->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(15, 20, 28, 255));
+        const float colW = width / (float)std::min(buckets, std::max<size_t>(seconds, 1));
+        for (size_t i = 0; i < filled; ++i)
+        {
+            float x = origin.x + width - (float)(filled - i) * colW;
+            float yHi = origin.y + height - std::min(1.0f, maxs[i] / maxValue) * height;
+            float yLo = origin.y + height - std::min(1.0f, mins[i] / maxValue) * height;
+            dl->AddRectFilled(ImVec2(x, yHi), ImVec2(x + std::max(1.0f, colW - 0.5f), std::max(yLo, yHi + 1.0f)), color);
         }
-        
-        // Disk Info (C: drive)
-        ULARGE_INTEGER freeBytesAvailable, totalBytes, totalFreeBytes;
-        if (GetDiskFreeSpaceExA("C:\\", &freeBytesAvailable, &totalBytes, &totalFreeBytes)) {
-            g_systemResources.totalDisk = totalBytes.QuadPart;
-            g_systemResources.freeDisk = totalFreeBytes.QuadPart;
+        ImGui::Dummy(ImVec2(width, height));
+        return maxValue;
+    }
+
+    static std::string FormatRate(float bytesPerSecond)
+    {
+        char buf[32];
+        if (bytesPerSecond >= 1024.0f * 1024.0f) snprintf(buf, sizeof(buf), "%.1f MB/s", bytesPerSecond / (1024.0f * 1024.0f));
+        else snprintf(buf, sizeof(buf), "%.0f KB/s", bytesPerSecond / 1024.0f);
+        return buf;
+    }
+
+    // Instance list order (VS list and Cursor table share it)
+    enum InstanceSort { kSortPid, kSortCpu, kSortMemory, kSortIo };
+    static int g_instanceSort = kSortPid;
+    static bool g_instanceSortAscending = true;
+
+    static float InstanceMetric(DWORD pid, int sort)
+    {
+        std::shared_ptr<const ProcessSampler::History> h = ProcessSampler::Find(pid);
+        if (!h || h->cpu.Count() == 0) return -1.0f; // not sampled yet: sorts last
+        switch (sort)
+        {
+        case kSortCpu: return h->cpu.Latest();
+        case kSortMemory: return h->workingSet.Latest();
+        case kSortIo: return h->io.Latest();
+        default: return (float)pid;
         }
-        
-        // System Uptime
-        g_systemResources.uptime = GetTickCount64() / 1000; // 转换为秒
     }
-    
+
+    template <typename Inst>
+    static std::vector<const Inst*> SortedInstances(const std::vector<Inst>& list)
+    {
+        std::vector<std::pair<float, const Inst*>> keyed;
+        keyed.reserve(list.size());
+        for (const Inst& inst : list) keyed.emplace_back(InstanceMetric(inst.pid, g_instanceSort), &inst);
+        std::stable_sort(keyed.begin(), keyed.end(), [](const std::pair<float, const Inst*>& a, const std::pair<float, const Inst*>& b) {
+            if ((a.first < 0.0f) != (b.first < 0.0f)) return b.first < 0.0f;
+            return g_instanceSortAscending ? a.first < b.first : a.first > b.first;
+        });
+        std::vector<const Inst*> out;
+        out.reserve(keyed.size());
+        for (const auto& k : keyed) out.push_back(k.second);
+        return out;
+    }
+
+    // "CPU 12.3% | 1.25 GB | 3.4 MB/s" plus a CPU sparkline of the instance's recent history
+    static void DrawInstanceLoad(DWORD pid)
+    {
+        std::shared_ptr<const ProcessSampler::History> h = ProcessSampler::Find(pid);
+        if (!h || !h->accessible) { ImGui::TextDisabled(h ? "[Load] access denied" : "[Load] -"); return; }
+        if (h->cpu.Count() == 0) { ImGui::TextDisabled("[Load] sampling..."); return; }
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "[Load] CPU %.1f%% | %.2f GB | %s", h->cpu.Latest(),
+                           h->workingSet.Latest() / 1024.0f, h->io.Count() ? FormatRate(h->io.Latest()).c_str() : "I/O n/a");
+        DrawSparkline(h->cpu, ProcessSampler::kHistorySamples, 0.0f, IM_COL32(0, 255, 128, 200), ImGui::GetTextLineHeight());
+    }
+
     // Forward declare launch helpers
     static bool LaunchVSWithSolution(const std::string& slnPath);
     static bool LaunchCursorWithFolder(const std::string& folderPath);
     static bool LaunchFeishu();
     static bool LaunchWechat();
+    static int RestoreEnvironment();
 
-    // Generic process detection helper
-    static bool DetectProcessAndGetPath(const std::string& exeLower, const std::vector<std::string>& processNames, 
-                                       DWORD processId, std::string& outPath, bool& outRunning, const std::string& logPrefix)
+    static const ProcessEnum::NameTable& AppNameTable()
     {
-        for (const auto& name : processNames)
-        {
-            if (exeLower == name)
-            {
-                HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, processId);
-                if (hProc)
-                {
-                    char buf[MAX_PATH];
-                    DWORD sz = (DWORD)sizeof(buf);
-                    if (QueryFullProcessImageNameA(hProc, 0, buf, &sz))
-                        outPath.assign(buf, sz);
-                    CloseHandle(hProc);
-                }
-                outRunning = true;
-                // 进程检测日志已删除
-                return true;
-            }
-        }
-        return false;
+        static const ProcessEnum::NameTable table = []() {
+            ProcessEnum::NameTable t;
+            t.Add("devenv.exe", kAppVS);
+            t.Add("cursor.exe", kAppCursor);
+            t.Add("feishu.exe", kAppFeishu);
+            t.Add("lark.exe", kAppFeishu);
+            t.Add("weixin.exe", kAppWechat);
+            t.Add("wechat.exe", kAppWechat);
+            t.Add("wechatappex.exe", kAppWechatHelper);
+            return t;
+        }();
+        return table;
+    }
+
+    // Refresh worker thread only (the enumerator reuses its buffers)
+    static ProcessEnum::ProcessEnumerator& Processes()
+    {
+        static std::unique_ptr<ProcessEnum::ProcessEnumerator> enumerator = ProcessEnum::CreateSystemEnumerator();
+        return *enumerator;
     }
 
     // File dialog helpers (ANSI)
@@ -248,241 +330,92 @@ namespace VSInspector
         return base / buf;
     }
 
-    static std::string JsonEscape(const std::string& s)
+    // Reflect the current selection in the config named g_currentConfigName (created if new)
+    static void SyncCurrentSelection()
     {
-        std::string out; out.reserve(s.size() + 8);
-        for (char c : s)
-        {
-            switch (c)
-            {
-                case '\\': out += "\\\\"; break;
-                case '"': out += "\\\""; break;
-                case '\n': out += "\\n"; break;
-                case '\r': out += "\\r"; break;
-                case '\t': out += "\\t"; break;
-                default: out += c; break;
-            }
-        }
-        return out;
+        if (g_currentConfigName.empty()) return;
+        g_configs.Upsert(g_currentConfigName, g_selectedSlnPath, g_selectedCursorFolder, g_feishuPath, g_wechatPath,
+                         (unsigned long long)time(nullptr));
     }
 
-    // Forward declarations for legacy txt load/save
-    static void SavePrefsToTxt();
-    static bool LoadPrefsFromTxt();
-
-    static void SaveConfigsToJsonFile(const fs::path& filePath)
+    // Write to a temp file next to the target, then rename over it: a crash mid-write leaves the
+    // previous file intact
+    static bool WriteFileAtomic(const fs::path& path, const std::string& content)
     {
-        // Ensure current selection is reflected in g_savedConfigs
-        if (!g_currentConfigName.empty())
+        fs::path tmpPath = path;
+        tmpPath += ".tmp";
         {
-            bool found = false;
-            for (auto& config : g_savedConfigs)
-            {
-                if (config.name == g_currentConfigName)
-                {
-                    config.vsSolutionPath = g_selectedSlnPath;
-                    config.cursorFolderPath = g_selectedCursorFolder;
-                    config.feishuPath = g_feishuPath;
-                    config.wechatPath = g_wechatPath;
-                    if (config.createdAt == 0) config.createdAt = (unsigned long long)time(nullptr);
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
-            {
-                SavedConfig newConfig;
-                newConfig.name = g_currentConfigName;
-                newConfig.vsSolutionPath = g_selectedSlnPath;
-                newConfig.cursorFolderPath = g_selectedCursorFolder;
-                newConfig.feishuPath = g_feishuPath;
-                newConfig.wechatPath = g_wechatPath;
-                newConfig.createdAt = (unsigned long long)time(nullptr);
-                g_savedConfigs.push_back(newConfig);
-            }
-        }
-
-        fs::path p = filePath;
-        std::ofstream ofs(p.string(), std::ios::binary);
-        if (!ofs) { AppendLog(std::string("[prefs] open for write failed: ") + p.string()); return; }
-        ofs << "{\n  \"configs\": [\n";
-        for (size_t i = 0; i < g_savedConfigs.size(); ++i)
-        {
-            const auto& c = g_savedConfigs[i];
-            ofs << "    {\n";
-            ofs << "      \"name\": \"" << JsonEscape(c.name) << "\",\n";
-            ofs << "      \"vs\": \"" << JsonEscape(c.vsSolutionPath) << "\",\n";
-            ofs << "      \"cursor\": \"" << JsonEscape(c.cursorFolderPath) << "\",\n";
-            ofs << "      \"feishu\": \"" << JsonEscape(c.feishuPath) << "\",\n";
-            ofs << "      \"wechat\": \"" << JsonEscape(c.wechatPath) << "\",\n";
-            ofs << "      \"createdAt\": " << c.createdAt << ",\n";
-            ofs << "      \"lastUsedAt\": " << c.lastUsedAt << "\n";
-            ofs << "    }" << (i + 1 < g_savedConfigs.size() ? ",\n" : "\n");
-        }
-        ofs << "  ]\n}";
-        AppendLog(std::string("[prefs] saved JSON ") + std::to_string(g_savedConfigs.size()) + " config(s) to " + p.string());
-        if (!g_selectedSlnPath.empty()) AppendLog("[prefs] saved VS solution: " + g_selectedSlnPath);
-        if (!g_selectedCursorFolder.empty()) AppendLog("[prefs] saved Cursor folder: " + g_selectedCursorFolder);
-        if (!g_feishuPath.empty()) AppendLog("[prefs] saved Feishu path: " + g_feishuPath);
-        if (!g_wechatPath.empty()) AppendLog("[prefs] saved WeChat path: " + g_wechatPath);
-    }
-
-    static void SavePrefsToJson()
-    {
-        SaveConfigsToJsonFile(GetPrefsJsonFile());
-    }
-
-    static bool ParseJsonString(const std::string& s, size_t& pos, std::string& out)
-    {
-        out.clear();
-        if (pos >= s.size() || s[pos] != '"') return false;
-        pos++;
-        while (pos < s.size())
+            std::ofstream ofs(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!ofs) { AppendLog(std::string("[prefs] open for write failed: ") + tmpPath.string()); return false; }
+            ofs.write(content.data(), (std::streamsize)content.size());
+            if (!ofs) { AppendLog(std::string("[prefs] write failed: ") + tmpPath.string()); return false; }
+        }
+        std::error_code ec;
+        fs::rename(tmpPath, path, ec);
+        if (ec)
         {
-            char c = s[pos++];
-            if (c == '"') return true;
-            if (c == '\\' && pos < s.size())
-            {
-                char e = s[pos++];
-                switch (e) { case 'n': out += '\n'; break; case 'r': out += '\r'; break; case 't': out += '\t'; break; case '"': out += '"'; break; case '\\': out += '\\'; break; default: out += e; break; }
-            }
-            else { out += c; }
+            AppendLog(std::string("[prefs] replace failed: ") + path.string() + " (" + ec.message() + ")");
+            fs::remove(tmpPath, ec);
+            return false;
         }
-        return false;
+        return true;
     }
 
-    static void SkipWs(const std::string& s, size_t& pos) { while (pos < s.size() && (s[pos]==' '||s[pos]=='\n'||s[pos]=='\r'||s[pos]=='\t')) pos++; }
+    static bool WriteConfigsJson(const fs::path& p)
+    {
+        std::string out;
+        ConfigStore::WriteJson(g_configs.All(), out);
+        if (!WriteFileAtomic(p, out)) return false;
+        AppendLog(std::string("[prefs] saved JSON ") + std::to_string(g_configs.Size()) + " config(s) to " + p.string());
+        return true;
+    }
 
     static bool ParseConfigsFromJson(const std::string& content, std::vector<SavedConfig>& out)
     {
-        out.clear();
-        size_t pos = 0; SkipWs(content, pos);
-        if (pos >= content.size() || content[pos] != '{') { return false; }
-        pos++; // '{'
-        bool ok = false;
-        while (pos < content.size())
-        {
-            SkipWs(content, pos);
-            if (pos < content.size() && content[pos] == '}') { pos++; break; }
-            // parse key
-            std::string key; if (!ParseJsonString(content, pos, key)) break;
-            SkipWs(content, pos); if (pos >= content.size() || content[pos] != ':') break; pos++;
-            SkipWs(content, pos);
-            if (key == "configs")
-            {
-                if (pos >= content.size() || content[pos] != '[') break; pos++;
-                SkipWs(content, pos);
-                while (pos < content.size() && content[pos] != ']')
-                {
-                    SkipWs(content, pos);
-                    if (pos >= content.size() || content[pos] != '{') break; pos++;
-                    SavedConfig c;
-                    while (pos < content.size())
-                    {
-                        SkipWs(content, pos);
-                        if (pos < content.size() && content[pos] == '}') { pos++; break; }
-                        std::string k; if (!ParseJsonString(content, pos, k)) { pos = content.size(); break; }
-                        SkipWs(content, pos); if (pos >= content.size() || content[pos] != ':') { pos = content.size(); break; } pos++;
-                        SkipWs(content, pos);
-                                                 if (k == "name" || k == "vs" || k == "cursor" || k == "feishu" || k == "wechat")
-                         {
-                             std::string v; if (!ParseJsonString(content, pos, v)) { pos = content.size(); break; }
-                             if (k == "name") c.name = v; else if (k == "vs") c.vsSolutionPath = v; else if (k == "cursor") c.cursorFolderPath = v; else if (k == "feishu") c.feishuPath = v; else c.wechatPath = v;
-                         }
-                        else if (k == "createdAt" || k == "lastUsedAt")
-                        {
-                            size_t start = pos; while (pos < content.size() && (isdigit((unsigned char)content[pos]) || content[pos]=='-')) pos++; unsigned long long val = strtoull(content.substr(start, pos-start).c_str(), nullptr, 10);
-                            if (k == "createdAt") c.createdAt = val; else c.lastUsedAt = val;
-                        }
-                        SkipWs(content, pos);
-                        if (pos < content.size() && content[pos] == ',') { pos++; }
-                    }
-                    if (!c.name.empty()) out.push_back(c);
-                    SkipWs(content, pos);
-                    if (pos < content.size() && content[pos] == ',') { pos++; }
-                    SkipWs(content, pos);
-                }
-                if (pos < content.size() && content[pos] == ']') { pos++; ok = true; }
-            }
-            SkipWs(content, pos);
-            if (pos < content.size() && content[pos] == ',') { pos++; continue; }
-        }
-        return ok;
+        std::string error;
+        if (ConfigStore::ParseJson(content, out, error)) return true;
+        AppendLog("[prefs] JSON: " + error);
+        return false;
     }
 
     static bool LoadPrefsFromJson()
     {
-        g_savedConfigs.clear();
+        g_configs.Assign({});
         fs::path p = GetPrefsJsonFile();
         std::error_code ec; if (!fs::exists(p, ec)) { return false; }
-        std::ifstream ifs(p.string(), std::ios::binary);
-        if (!ifs) { AppendLog(std::string("[prefs] open for read failed: ") + p.string()); return false; }
-        std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-        bool ok = ParseConfigsFromJson(content, g_savedConfigs);
-        if (ok) AppendLog(std::string("[prefs] loaded JSON ") + std::to_string(g_savedConfigs.size()) + " config(s) from " + p.string());
+        std::string content;
+        if (!Json::ReadFile(p, content)) { AppendLog(std::string("[prefs] open for read failed: ") + p.string()); return false; }
+        std::vector<SavedConfig> loaded;
+        bool ok = ParseConfigsFromJson(content, loaded);
+        g_configs.Assign(std::move(loaded));
+        if (ok) AppendLog(std::string("[prefs] loaded JSON ") + std::to_string(g_configs.Size()) + " config(s) from " + p.string());
         return ok;
     }
 
-    static void SavePrefsToTxt()
+    static bool WriteConfigsTxt(const fs::path& p)
     {
-        // Save current selection to the current config
-        if (!g_currentConfigName.empty())
-        {
-            // Find existing config or create new one
-            bool found = false;
-            for (auto& config : g_savedConfigs)
-            {
-                if (config.name == g_currentConfigName)
-                {
-                    config.vsSolutionPath = g_selectedSlnPath;
-                    config.cursorFolderPath = g_selectedCursorFolder;
-                    if (config.createdAt == 0) config.createdAt = (unsigned long long)time(nullptr);
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
-            {
-                SavedConfig newConfig;
-                newConfig.name = g_currentConfigName;
-                newConfig.vsSolutionPath = g_selectedSlnPath;
-                newConfig.cursorFolderPath = g_selectedCursorFolder;
-                newConfig.createdAt = (unsigned long long)time(nullptr);
-                g_savedConfigs.push_back(newConfig);
-            }
-        }
-
-        // Save all configs to file
-        fs::path p = GetPrefsFile();
-        std::ofstream ofs(p.string(), std::ios::binary);
-        if (!ofs) { AppendLog(std::string("[prefs] open for write failed: ") + p.string()); return; }
-        
-        for (const auto& config : g_savedConfigs)
-        {
-                         ofs << "config=" << config.name << "\n";
-             ofs << "sln=" << config.vsSolutionPath << "\n";
-             ofs << "cursor=" << config.cursorFolderPath << "\n";
-             ofs << "feishu=" << config.feishuPath << "\n";
-             ofs << "wechat=" << config.wechatPath << "\n";
-             ofs << "created=" << config.createdAt << "\n";
-             ofs << "used=" << config.lastUsedAt << "\n";
-            ofs << "---\n";  // Separator between configs
-        }
-        
-                 AppendLog(std::string("[prefs] saved ") + std::to_string(g_savedConfigs.size()) + " config(s) to " + p.string());
-         if (!g_selectedSlnPath.empty())
-             AppendLog("[prefs] saved VS solution: " + g_selectedSlnPath);
-         if (!g_selectedCursorFolder.empty())
-             AppendLog("[prefs] saved Cursor folder: " + g_selectedCursorFolder);
-         if (!g_feishuPath.empty())
-             AppendLog("[prefs] saved Feishu path: " + g_feishuPath);
-         if (!g_wechatPath.empty())
-             AppendLog("[prefs] saved WeChat path: " + g_wechatPath);
+        const std::vector<SavedConfig>& configs = g_configs.All();
+        std::string out;
+        out.reserve(configs.size() * 224);
+        for (const auto& config : configs)
+        {
+            out += "config=" + config.name + "\n";
+            out += "sln=" + config.vsSolutionPath + "\n";
+            out += "cursor=" + config.cursorFolderPath + "\n";
+            out += "feishu=" + config.feishuPath + "\n";
+            out += "wechat=" + config.wechatPath + "\n";
+            out += "created=" + std::to_string(config.createdAt) + "\n";
+            out += "used=" + std::to_string(config.lastUsedAt) + "\n";
+            out += "---\n";  // Separator between configs
+        }
+        if (!WriteFileAtomic(p, out)) return false;
+        AppendLog(std::string("[prefs] saved ") + std::to_string(configs.size()) + " config(s) to " + p.string());
+        return true;
     }
 
     static bool LoadPrefsFromTxt()
     {
-        g_savedConfigs.clear();
+        g_configs.Assign({});
         fs::path p = GetPrefsFile();
         std::error_code ec; if (!fs::exists(p, ec)) { AppendLog("[prefs] no prefs file"); return false; }
         std::ifstream ifs(p.string(), std::ios::binary);
@@ -491,6 +424,7 @@ namespace VSInspector
         std::string line;
         SavedConfig currentConfig;
         bool inConfig = false;
+        std::vector<SavedConfig> loaded;
         
         while (std::getline(ifs, line))
         {
@@ -499,7 +433,7 @@ namespace VSInspector
                 // End of config, save it
                 if (inConfig && !currentConfig.name.empty())
                 {
-                    g_savedConfigs.push_back(currentConfig);
+                    loaded.push_back(currentConfig);
                 }
                 currentConfig = SavedConfig();
                 inConfig = false;
@@ -538,386 +472,535 @@ namespace VSInspector
         // Don't forget the last config if no separator
         if (inConfig && !currentConfig.name.empty())
         {
-            g_savedConfigs.push_back(currentConfig);
+            loaded.push_back(currentConfig);
         }
+        g_configs.Assign(std::move(loaded));
         
-        AppendLog(std::string("[prefs] loaded ") + std::to_string(g_savedConfigs.size()) + " config(s) from " + p.string());
+        AppendLog(std::string("[prefs] loaded ") + std::to_string(g_configs.Size()) + " config(s) from " + p.string());
         return true;
     }
 
     static void SavePrefs()
     {
+        SyncCurrentSelection();
+        const auto now = std::chrono::steady_clock::now();
+        if (!g_prefsDirty) g_prefsFirstChange = now;
+        g_prefsLastChange = now;
+        g_prefsDirty = true;
+        ++g_prefsPendingSaves;
+    }
+
+    static bool MergePrefsFromDisk(const fs::path& p);
+
+    // Write pending changes once they have been quiet for kPrefsSaveDelayMs (or force, on exit)
+    static void FlushPrefs(bool force)
+    {
+        if (!g_prefsDirty) return;
+        if (!force)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const double quietMs = std::chrono::duration<double, std::milli>(now - g_prefsLastChange).count();
+            const double waitedMs = std::chrono::duration<double, std::milli>(now - g_prefsFirstChange).count();
+            if (quietMs < kPrefsSaveDelayMs && waitedMs < kPrefsSaveMaxDelayMs) return;
+        }
+        // prefs.json changed on disk since we last read or wrote it: merge first so the write does
+        // not drop someone else's change (the watcher callback may still be debouncing)
+        if (FileWatcher::ChangedSinceSync(g_prefsWatch)) MergePrefsFromDisk(GetPrefsJsonFile());
         // Prefer JSON; also write legacy txt for backward compatibility
-        SavePrefsToJson();
-        SavePrefsToTxt();
+        bool ok = WriteConfigsJson(GetPrefsJsonFile());
+        if (ok)
+        {
+            g_prefsBase = ConfigStore::TakeSnapshot(g_configs.All());
+            FileWatcher::MarkSynced(g_prefsWatch);
+        }
+        ok = WriteConfigsTxt(GetPrefsFile()) && ok;
+        if (g_prefsPendingSaves > 1) AppendLog("[prefs] coalesced " + std::to_string(g_prefsPendingSaves) + " save request(s)");
+        if (!g_selectedSlnPath.empty()) AppendLog("[prefs] saved VS solution: " + g_selectedSlnPath);
+        if (!g_selectedCursorFolder.empty()) AppendLog("[prefs] saved Cursor folder: " + g_selectedCursorFolder);
+        if (!g_feishuPath.empty()) AppendLog("[prefs] saved Feishu path: " + g_feishuPath);
+        if (!g_wechatPath.empty()) AppendLog("[prefs] saved WeChat path: " + g_wechatPath);
+        // A failed write stays dirty and is retried after the next quiet period
+        g_prefsDirty = !ok;
+        g_prefsPendingSaves = ok ? 0 : 1;
+        g_prefsFirstChange = g_prefsLastChange = std::chrono::steady_clock::now();
     }
 
     static void LoadPrefs()
     {
+        // Unsaved edits would otherwise be replaced by the older file contents
+        FlushPrefs(true);
         // Try JSON first; fall back to txt
-        if (!LoadPrefsFromJson())
+        if (LoadPrefsFromJson())
         {
+            g_prefsBase = ConfigStore::TakeSnapshot(g_configs.All());
+        }
+        else
+        {
+            // Nothing in prefs.json to merge against: everything here counts as not saved yet
+            g_prefsBase.clear();
             if (!LoadPrefsFromTxt())
             {
                 AppendLog("[prefs] no prefs found in JSON or TXT");
             }
         }
+        // The watch itself is created on the UI thread (DrawVSUI); this may run on the init worker
+        FileWatcher::MarkSynced(g_prefsWatch);
+        // Config names and paths are displayed in the workspace list
+        for (const auto& config : g_configs.All())
+        {
+            GlyphCache::AddText(config.name);
+            GlyphCache::AddText(config.vsSolutionPath);
+            GlyphCache::AddText(config.cursorFolderPath);
+        }
         g_prefsLoaded = true;
     }
 
     static void LoadConfig(const std::string& configName)
     {
-        for (const auto& config : g_savedConfigs)
-        {
-            if (config.name == configName)
-            {
-                                 g_selectedSlnPath = config.vsSolutionPath;
-                 g_selectedCursorFolder = config.cursorFolderPath;
-                 g_feishuPath = config.feishuPath;
-                 g_wechatPath = config.wechatPath;
-                 // Keep the multi-select sets in sync with single selection
-                 g_selectedSlnPaths.clear();
-                 if (!g_selectedSlnPath.empty())
-                     g_selectedSlnPaths.insert(g_selectedSlnPath);
-                 g_selectedCursorFolders.clear();
-                 if (!g_selectedCursorFolder.empty())
-                     g_selectedCursorFolders.insert(g_selectedCursorFolder);
-                 g_currentConfigName = configName;
-                AppendLog("[prefs] loaded config: " + configName);
-                                 if (!g_selectedSlnPath.empty())
-                     AppendLog("[prefs] loaded VS solution: " + g_selectedSlnPath);
-                 if (!g_selectedCursorFolder.empty())
-                     AppendLog("[prefs] loaded Cursor folder: " + g_selectedCursorFolder);
-                 if (!g_feishuPath.empty())
-                     AppendLog("[prefs] loaded Feishu path: " + g_feishuPath);
-                 if (!g_wechatPath.empty())
-                     AppendLog("[prefs] loaded WeChat path: " + g_wechatPath);
-                return;
-            }
-        }
-        AppendLog("[prefs] config not found: " + configName);
+        const SavedConfig* config = g_configs.Find(configName);
+        if (!config)
+        {
+            AppendLog("[prefs] config not found: " + configName);
+            return;
+        }
+        g_selectedSlnPath = config->vsSolutionPath;
+        g_selectedCursorFolder = config->cursorFolderPath;
+        g_feishuPath = config->feishuPath;
+        g_wechatPath = config->wechatPath;
+        // Keep the multi-select sets in sync with single selection
+        g_selectedSlnPaths.clear();
+        if (!g_selectedSlnPath.empty())
+            g_selectedSlnPaths.insert(g_selectedSlnPath);
+        g_selectedCursorFolders.clear();
+        if (!g_selectedCursorFolder.empty())
+            g_selectedCursorFolders.insert(g_selectedCursorFolder);
+        g_currentConfigName = configName;
+        AppendLog("[prefs] loaded config: " + configName);
+        if (!g_selectedSlnPath.empty())
+            AppendLog("[prefs] loaded VS solution: " + g_selectedSlnPath);
+        if (!g_selectedCursorFolder.empty())
+            AppendLog("[prefs] loaded Cursor folder: " + g_selectedCursorFolder);
+        if (!g_feishuPath.empty())
+            AppendLog("[prefs] loaded Feishu path: " + g_feishuPath);
+        if (!g_wechatPath.empty())
+            AppendLog("[prefs] loaded WeChat path: " + g_wechatPath);
     }
 
-    static void DeleteConfig(const std::string& configName)
+    // Stamp lastUsedAt (moves the config to the top of the list), then load it. Takes a copy:
+    // SavePrefs() may add the current config to the store and move its records.
+    static void UseConfig(std::string configName)
     {
-        for (auto it = g_savedConfigs.begin(); it != g_savedConfigs.end(); ++it)
-        {
-            if (it->name == configName)
-            {
-                g_savedConfigs.erase(it);
-                // If we deleted the current config, clear the current config name
-                if (g_currentConfigName == configName)
-                {
-                    g_currentConfigName.clear();
-                }
-                // Save the updated configs to file
-                SavePrefs();
-                AppendLog("[prefs] deleted config: " + configName);
-                return;
-            }
-        }
-        AppendLog("[prefs] config not found for deletion: " + configName);
+        g_configs.MarkUsed(configName, (unsigned long long)time(nullptr));
+        SavePrefs();
+        LoadConfig(configName);
     }
 
-    // Merge helpers for import
-    static void MergeConfigs(std::vector<SavedConfig>& into, const std::vector<SavedConfig>& incoming)
+    static void DeleteConfig(const std::string& configName)
     {
-        for (const auto& inc : incoming)
+        if (!g_configs.Remove(configName))
         {
-            if (inc.name.empty()) continue;
-            bool found = false;
-            for (auto& cur : into)
-            {
-                if (cur.name == inc.name)
-                {
-                    found = true;
-                    // Merge rule: keep earliest createdAt, max lastUsedAt, overwrite paths if provided
-                    if (cur.createdAt == 0 || (inc.createdAt != 0 && inc.createdAt < cur.createdAt)) cur.createdAt = inc.createdAt;
-                    if (inc.lastUsedAt > cur.lastUsedAt) cur.lastUsedAt = inc.lastUsedAt;
-                                         if (!inc.vsSolutionPath.empty()) cur.vsSolutionPath = inc.vsSolutionPath;
-                     if (!inc.cursorFolderPath.empty()) cur.cursorFolderPath = inc.cursorFolderPath;
-                     if (!inc.feishuPath.empty()) cur.feishuPath = inc.feishuPath;
-                     if (!inc.wechatPath.empty()) cur.wechatPath = inc.wechatPath;
-                    break;
-                }
-            }
-            if (!found)
-            {
-                into.push_back(inc);
-            }
+            AppendLog("[prefs] config not found for deletion: " + configName);
+            return;
+        }
+        // If we deleted the current config, clear the current config name
+        if (g_currentConfigName == configName)
+        {
+            g_currentConfigName.clear();
         }
+        // Save the updated configs to file
+        SavePrefs();
+        AppendLog("[prefs] deleted config: " + configName);
     }
 
-    
-
-    static void EnsurePrefsLoaded()
+    // Merge prefs.json as changed by someone else record by record instead of reloading, so the
+    // current selection and edits not yet flushed are kept. True if there were conflicts (the
+    // local versions were kept and should be written back).
+    static bool MergePrefsFromDisk(const fs::path& p)
     {
-        if (!g_prefsLoaded)
+        std::string content;
+        std::vector<SavedConfig> remote;
+        if (!Json::ReadFile(p, content))
         {
-            LoadPrefs();
+            AppendLog("[prefs] external change: prefs.json is gone, keeping " + std::to_string(g_configs.Size()) + " config(s) in memory");
+            return false;
         }
-    }
+        // A half-written or broken file is left alone; the next complete write triggers again
+        if (!ParseConfigsFromJson(content, remote)) return false;
 
-    static bool LaunchVSWithSolution(const std::string& slnPath)
-    {
-        if (slnPath.empty()) return false;
-        
-        // Try to find Visual Studio installation
-        std::vector<std::string> vsPaths = {
-            "C:\\Program Files\\Microsoft Visual Studio\\2022\\Community\\Common7\\IDE\\devenv.exe",
-            "C:\\Program Files\\Microsoft Visual Studio\\2022\\Professional\\Common7\\IDE\\devenv.exe",
-            "C:\\Program Files\\Microsoft Visual Studio\\2022\\Enterprise\\Common7\\IDE\\devenv.exe",
-            "C:\\Program Files (x86)\\Microsoft Visual Studio\\2019\\Community\\Common7\\IDE\\devenv.exe",
-            "C:\\Program Files (x86)\\Microsoft Visual Studio\\2019\\Professional\\Common7\\IDE\\devenv.exe",
-            "C:\\Program Files (x86)\\Microsoft Visual Studio\\2019\\Enterprise\\Common7\\IDE\\devenv.exe"
-        };
-        
-        std::string vsExePath;
-        for (const auto& path : vsPaths)
+        ConfigStore::SyncResult result = g_configs.Sync(remote, g_prefsBase);
+        g_prefsBase = ConfigStore::TakeSnapshot(remote);
+        for (const SavedConfig& config : remote)
         {
-            if (fs::exists(path))
-            {
-                vsExePath = path;
-                break;
-            }
+            GlyphCache::AddText(config.name);
+            GlyphCache::AddText(config.vsSolutionPath);
+            GlyphCache::AddText(config.cursorFolderPath);
         }
-        
-        if (vsExePath.empty())
+
+        const auto listed = [](const std::vector<std::string>& names, const std::string& name) {
+            return std::find(names.begin(), names.end(), name) != names.end();
+        };
+        if (!g_currentConfigName.empty())
         {
-            AppendLog("[launch] Visual Studio not found in common locations");
-            return false;
+            if (listed(result.removedNames, g_currentConfigName)) g_currentConfigName.clear();
+            else if (listed(result.updatedNames, g_currentConfigName)) LoadConfig(g_currentConfigName);
         }
-        
-        std::string cmd = "\"" + vsExePath + "\" \"" + slnPath + "\"";
-        AppendLog("[launch] VS command: " + cmd);
-        
-        STARTUPINFOA si = { sizeof(si) };
-        PROCESS_INFORMATION pi = {};
-        si.dwFlags = STARTF_USESHOWWINDOW;
-        si.wShowWindow = SW_SHOW;
-        
-        if (CreateProcessA(NULL, (LPSTR)cmd.c_str(), NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
+
+        AppendLog("[prefs] external change merged: " + std::to_string(result.added) + " added, " +
+                  std::to_string(result.updated) + " updated, " + std::to_string(result.removed) + " removed, " +
+                  std::to_string(result.conflicts) + " conflict(s)");
+        if (result.conflicts > 0)
         {
-            CloseHandle(pi.hProcess);
-            CloseHandle(pi.hThread);
-            AppendLog("[launch] VS launched successfully");
-            return true;
+            std::string names;
+            for (const std::string& name : result.conflictNames) names += (names.empty() ? "" : ", ") + name;
+            AppendLog("[prefs] changed on both sides, keeping local: " + names);
         }
-        else
+        return result.conflicts > 0;
+    }
+
+    static void OnPrefsChanged(const fs::path& p)
+    {
+        // Write the local versions back so the file agrees with what is shown
+        if (MergePrefsFromDisk(p)) SavePrefs();
+    }
+
+    // Saved-config list shared by the wide and narrow layouts. Rows are the store's MRU order
+    // narrowed by the type-ahead filter; they are rebuilt only when the store or the filter
+    // changes, and the clipper submits just the visible rows, so an idle frame allocates nothing.
+    struct ConfigListView
+    {
+        uint64_t generation = ~0ull;
+        char filter[128] = {0};
+        char appliedFilter[128] = {0};
+        std::vector<uint32_t> rows;  // indices into g_configs.All()
+    };
+    static ConfigListView g_configListView;
+    static std::string g_pendingDeleteConfig;
+
+    static bool ContainsNoCase(const std::string& haystack, const char* needle, size_t needleLen)
+    {
+        if (needleLen == 0) return true;
+        if (haystack.size() < needleLen) return false;
+        for (size_t i = 0; i + needleLen <= haystack.size(); ++i)
         {
-            DWORD error = GetLastError();
-            AppendLog("[launch] VS launch failed, error: " + std::to_string(error));
-            return false;
+            size_t k = 0;
+            while (k < needleLen && tolower((unsigned char)haystack[i + k]) == tolower((unsigned char)needle[k])) ++k;
+            if (k == needleLen) return true;
         }
+        return false;
     }
 
-    static bool LaunchCursorWithFolder(const std::string& folderPath)
+    static const std::vector<uint32_t>& ConfigListRows()
     {
-        if (folderPath.empty()) return false;
-        
-        // Try to find Cursor installation
-        std::vector<std::string> cursorPaths = {
-            "C:\\Users\\" + GetEnvU8("USERNAME") + "\\AppData\\Local\\Programs\\cursor\\Cursor.exe",
-            "C:\\Program Files\\Cursor\\Cursor.exe",
-            "C:\\Program Files (x86)\\Cursor\\Cursor.exe"
-        };
-        
-        std::string cursorExePath;
-        for (const auto& path : cursorPaths)
+        ConfigListView& view = g_configListView;
+        if (view.generation == g_configs.Generation() && strcmp(view.filter, view.appliedFilter) == 0) return view.rows;
+        view.generation = g_configs.Generation();
+        memcpy(view.appliedFilter, view.filter, sizeof(view.filter));
+        const size_t len = strlen(view.filter);
+        const std::vector<SavedConfig>& configs = g_configs.All();
+        view.rows.clear();
+        for (uint32_t i : g_configs.MruOrder())
         {
-            if (fs::exists(path))
+            const SavedConfig& c = configs[i];
+            if (ContainsNoCase(c.name, view.filter, len) || ContainsNoCase(c.vsSolutionPath, view.filter, len) ||
+                ContainsNoCase(c.cursorFolderPath, view.filter, len))
             {
-                cursorExePath = path;
-                break;
+                view.rows.push_back(i);
             }
         }
-        
-        if (cursorExePath.empty())
+        return view.rows;
+    }
+
+    // height 0 fills the remaining space
+    static void DrawSavedConfigList(float height)
+    {
+        if (g_configs.Empty())
         {
-            AppendLog("[launch] Cursor not found in common locations");
-            return false;
+            ImGui::TextDisabled("No saved configurations");
+            return;
         }
-        
-        std::string cmd = "\"" + cursorExePath + "\" \"" + folderPath + "\"";
-        AppendLog("[launch] Cursor command: " + cmd);
-        
-        STARTUPINFOA si = { sizeof(si) };
-        PROCESS_INFORMATION pi = {};
-        si.dwFlags = STARTF_USESHOWWINDOW;
-        si.wShowWindow = SW_SHOW;
-        
-        if (CreateProcessA(NULL, (LPSTR)cmd.c_str(), NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
+        ImGui::TextColored(ImVec4(0.6f, 0.8f, 1.0f, 1.0f), "[Saved Configurations]");
+        ConfigListView& view = g_configListView;
+        ImGui::SetNextItemWidth(-1);
+        const bool enter = ImGui::InputTextWithHint("##config_filter", "Filter (Enter loads the top match)", view.filter,
+                                                    sizeof(view.filter), ImGuiInputTextFlags_EnterReturnsTrue);
+        const std::vector<uint32_t>& rows = ConfigListRows();
+        if (enter && !rows.empty())
         {
-            CloseHandle(pi.hProcess);
-            CloseHandle(pi.hThread);
-            AppendLog("[launch] Cursor launched successfully");
-            return true;
+            UseConfig(g_configs.All()[rows[0]].name);
         }
-        else
+        if (view.filter[0] != '\0')
         {
-            DWORD error = GetLastError();
-            AppendLog("[launch] Cursor launch failed, error: " + std::to_string(error));
-            return false;
+            ImGui::TextDisabled("%d of %d match", (int)rows.size(), (int)g_configs.Size());
         }
-    }
 
-    static bool LaunchFeishu()
-    {
-        // Use saved path if available
-        if (!g_feishuPath.empty())
+        // 创建可滚动的配置列表区域，自定义滚动条样式
+        ImGui::PushStyleVar(ImGuiStyleVar_ScrollbarSize, 8.0f); // 设置滚动条宽度为8像素
+        ImGui::PushStyleColor(ImGuiCol_ScrollbarBg, ImVec4(0.1f, 0.1f, 0.1f, 0.6f)); // 滚动条背景色
+        ImGui::PushStyleColor(ImGuiCol_ScrollbarGrab, ImVec4(0.3f, 0.3f, 0.3f, 0.8f)); // 滚动条抓取器颜色
+        ImGui::PushStyleColor(ImGuiCol_ScrollbarGrabHovered, ImVec4(0.4f, 0.4f, 0.4f, 0.9f)); // 悬停时颜色
+        ImGui::PushStyleColor(ImGuiCol_ScrollbarGrabActive, ImVec4(0.5f, 0.5f, 0.5f, 1.0f)); // 激活时颜色
+        ImGui::BeginChild("ConfigList", ImVec2(0, height), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+        bool openDelete = false;
+        ImGuiListClipper clipper;
+        clipper.Begin((int)rows.size());
+        while (clipper.Step())
         {
-            std::string feishuExePath = g_feishuPath;
-            if (fs::exists(feishuExePath))
+            for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r)
             {
-                std::string cmd = "\"" + feishuExePath + "\"";
-                AppendLog("[launch] Feishu command: " + cmd);
-                
-                STARTUPINFOA si = { sizeof(si) };
-                PROCESS_INFORMATION pi = {};
-                si.dwFlags = STARTF_USESHOWWINDOW;
-                si.wShowWindow = SW_SHOW;
-                
-                if (CreateProcessA(NULL, (LPSTR)cmd.c_str(), NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
+                const uint32_t index = rows[r];
+                // Load/Launch may append the current config to the store; later buttons re-read the record
+                const SavedConfig& config = g_configs.All()[index];
+                ImGui::PushID((int)index);
+                const bool current = config.name == g_currentConfigName;
+                ImGui::TextColored(current ? ImVec4(0.2f, 0.8f, 0.2f, 1.0f) : ImVec4(1.0f, 0.8f, 0.2f, 1.0f), // 亮橙色
+                                   "%s %s", current ? ">" : " ", config.name.c_str());
+                if (ImGui::IsItemHovered())
                 {
-                    CloseHandle(pi.hProcess);
-                    CloseHandle(pi.hThread);
-                    AppendLog("[launch] Feishu launched successfully");
-                    return true;
+                    ImGui::BeginTooltip();
+                    if (!config.vsSolutionPath.empty()) ImGui::Text("VS: %s", config.vsSolutionPath.c_str());
+                    if (!config.cursorFolderPath.empty()) ImGui::Text("Cursor: %s", config.cursorFolderPath.c_str());
+                    if (!config.feishuPath.empty()) ImGui::Text("Feishu: %s", config.feishuPath.c_str());
+                    if (!config.wechatPath.empty()) ImGui::Text("WeChat: %s", config.wechatPath.c_str());
+                    ImGui::EndTooltip();
                 }
-                else
+                ImGui::SameLine();
+                if (ImGui::SmallButton("[Load]"))
                 {
-                    DWORD error = GetLastError();
-                    AppendLog("[launch] Feishu launch failed, error: " + std::to_string(error));
-                    return false;
+                    UseConfig(config.name);
+                }
+                ImGui::SameLine();
+                if (ImGui::SmallButton("[Launch]"))
+                {
+                    // Load, then restore the whole workspace without blocking the frame
+                    UseConfig(config.name);
+                    RestoreEnvironment();
                 }
+                ImGui::SameLine();
+                if (ImGui::SmallButton("[Edit]"))
+                {
+                    // 直接将配置名称填入到主界面的 Config Name 输入框
+                    memset(g_mainConfigNameBuf, 0, sizeof(g_mainConfigNameBuf));
+                    strncpy(g_mainConfigNameBuf, g_configs.All()[index].name.c_str(), sizeof(g_mainConfigNameBuf) - 1);
+                    g_currentConfigName = g_configs.All()[index].name;
+
+                    // 加载配置到当前选择
+                    LoadConfig(g_currentConfigName);
+                }
+                ImGui::SameLine();
+                if (ImGui::SmallButton("[Delete]"))
+                {
+                    g_pendingDeleteConfig = g_configs.All()[index].name;
+                    openDelete = true;
+                }
+                ImGui::PopID();
             }
         }
-        
-        // Fallback: Try to find Feishu installation
-        std::vector<std::string> feishuPaths = {
-            "C:\\Users\\" + GetEnvU8("USERNAME") + "\\AppData\\Local\\Programs\\feishu\\feishu.exe",
-            "C:\\Users\\" + GetEnvU8("USERNAME") + "\\AppData\\Local\\Programs\\lark\\lark.exe",
-            "C:\\Program Files\\feishu\\feishu.exe",
-            "C:\\Program Files\\lark\\lark.exe",
-            "C:\\Program Files (x86)\\feishu\\feishu.exe",
-            "C:\\Program Files (x86)\\lark\\lark.exe"
-        };
-        
-        std::string feishuExePath;
-        for (const auto& path : feishuPaths)
+        clipper.End();
+
+        // 结束可滚动的配置列表区域
+        ImGui::EndChild();
+        // 恢复滚动条样式
+        ImGui::PopStyleColor(4); // 弹出4个颜色样式
+        ImGui::PopStyleVar(); // 弹出滚动条大小样式
+
+        // 确认删除弹窗 (outside the clipped rows, so it stays up when its row scrolls away)
+        if (openDelete) ImGui::OpenPopup("Confirm Delete Config");
+        if (ImGui::BeginPopupModal("Confirm Delete Config", NULL, ImGuiWindowFlags_AlwaysAutoResize))
         {
-            if (fs::exists(path))
+            ImGui::Text("Are you sure you want to delete configuration '%s'?", g_pendingDeleteConfig.c_str());
+            ImGui::Text("This action cannot be undone.");
+            ImGui::Separator();
+
+            if (ImGui::Button("Yes, Delete", ImVec2(120, 0)))
             {
-                feishuExePath = path;
-                break;
+                DeleteConfig(g_pendingDeleteConfig);
+                g_pendingDeleteConfig.clear();
+                ImGui::CloseCurrentPopup();
             }
+            ImGui::SetItemDefaultFocus();
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel", ImVec2(120, 0)))
+            {
+                g_pendingDeleteConfig.clear();
+                ImGui::CloseCurrentPopup();
+            }
+            ImGui::EndPopup();
         }
-        
-        if (feishuExePath.empty())
+    }
+
+    static void EnsurePrefsLoaded()
+    {
+        if (!g_prefsLoaded)
         {
-            AppendLog("[launch] Feishu not found in common locations");
-            return false;
+            LoadPrefs();
         }
-        
-        std::string cmd = "\"" + feishuExePath + "\"";
-        AppendLog("[launch] Feishu command: " + cmd);
-        
-        STARTUPINFOA si = { sizeof(si) };
-        PROCESS_INFORMATION pi = {};
-        si.dwFlags = STARTF_USESHOWWINDOW;
-        si.wShowWindow = SW_SHOW;
-        
-        if (CreateProcessA(NULL, (LPSTR)cmd.c_str(), NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
+    }
+
+    static std::string FirstExistingPath(const std::vector<std::string>& candidates)
+    {
+        for (const auto& path : candidates)
         {
-            CloseHandle(pi.hProcess);
-            CloseHandle(pi.hThread);
-            AppendLog("[launch] Feishu launched successfully");
-            return true;
+            std::error_code ec;
+            if (!path.empty() && fs::exists(path, ec)) return path;
         }
-        else
+        return std::string();
+    }
+
+    static std::string BaseName(const std::string& path)
+    {
+        size_t end = path.find_last_not_of("\\/");
+        if (end == std::string::npos) return path;
+        size_t start = path.find_last_of("\\/", end);
+        return path.substr(start == std::string::npos ? 0 : start + 1, end - (start == std::string::npos ? 0 : start + 1) + 1);
+    }
+
+    // Launch scheduler worker thread: the exe lookup and CreateProcess run there, not in the frame
+    static LaunchScheduler::Command LaunchCommand(const char* app, const std::string& exePath, const std::string& argument)
+    {
+        LaunchScheduler::Command command;
+        if (exePath.empty())
         {
-            DWORD error = GetLastError();
-            AppendLog("[launch] Feishu launch failed, error: " + std::to_string(error));
-            return false;
+            command.error = std::string(app) + " not found in common locations";
+            AppendLog("[launch] " + command.error);
+            return command;
         }
+        command.commandLine = "\"" + exePath + "\"";
+        if (!argument.empty()) command.commandLine += " \"" + argument + "\"";
+        AppendLog(std::string("[launch] ") + app + " command: " + command.commandLine);
+        return command;
+    }
+
+    static void LogLaunchDone(const LaunchScheduler::Launch& l)
+    {
+        char buf[160];
+        snprintf(buf, sizeof(buf), ": %s, pid %u, queued %.0f ms, start %.0f ms, ready %.0f ms", LaunchScheduler::StateName(l.state),
+                 (unsigned)l.pid, l.queuedMs, l.spawnMs, l.readyMs);
+        AppendLog("[launch] " + l.label + buf + (l.detail.empty() ? std::string() : " (" + l.detail + ")"));
+    }
+
+    static bool LaunchVSWithSolution(const std::string& slnPath)
+    {
+        if (slnPath.empty()) return false;
+        LaunchScheduler::Enqueue("VS " + BaseName(slnPath), [slnPath]() {
+            // Try to find Visual Studio installation
+            return LaunchCommand("Visual Studio", FirstExistingPath({
+                "C:\\Program Files\\Microsoft Visual Studio\\2022\\Community\\Common7\\IDE\\devenv.exe",
+                "C:\\Program Files\\Microsoft Visual Studio\\2022\\Professional\\Common7\\IDE\\devenv.exe",
+                "C:\\Program Files\\Microsoft Visual Studio\\2022\\Enterprise\\Common7\\IDE\\devenv.exe",
+                "C:\\Program Files (x86)\\Microsoft Visual Studio\\2019\\Community\\Common7\\IDE\\devenv.exe",
+                "C:\\Program Files (x86)\\Microsoft Visual Studio\\2019\\Professional\\Common7\\IDE\\devenv.exe",
+                "C:\\Program Files (x86)\\Microsoft Visual Studio\\2019\\Enterprise\\Common7\\IDE\\devenv.exe"
+            }), slnPath);
+        }, LogLaunchDone);
+        return true;
+    }
+
+    static bool LaunchCursorWithFolder(const std::string& folderPath)
+    {
+        if (folderPath.empty()) return false;
+        LaunchScheduler::Enqueue("Cursor " + BaseName(folderPath), [folderPath]() {
+            // Try to find Cursor installation
+            return LaunchCommand("Cursor", FirstExistingPath({
+                "C:\\Users\\" + GetEnvU8("USERNAME") + "\\AppData\\Local\\Programs\\cursor\\Cursor.exe",
+                "C:\\Program Files\\Cursor\\Cursor.exe",
+                "C:\\Program Files (x86)\\Cursor\\Cursor.exe"
+            }), folderPath);
+        }, LogLaunchDone);
+        return true;
+    }
+
+    static bool LaunchFeishu()
+    {
+        // Saved path first, then the usual install locations
+        const std::string savedPath = g_feishuPath;
+        LaunchScheduler::Enqueue("Feishu", [savedPath]() {
+            return LaunchCommand("Feishu", FirstExistingPath({
+                savedPath,
+                "C:\\Users\\" + GetEnvU8("USERNAME") + "\\AppData\\Local\\Programs\\feishu\\feishu.exe",
+                "C:\\Users\\" + GetEnvU8("USERNAME") + "\\AppData\\Local\\Programs\\lark\\lark.exe",
+                "C:\\Program Files\\feishu\\feishu.exe",
+                "C:\\Program Files\\lark\\lark.exe",
+                "C:\\Program Files (x86)\\feishu\\feishu.exe",
+                "C:\\Program Files (x86)\\lark\\lark.exe"
+            }), std::string());
+        }, LogLaunchDone);
+        return true;
     }
 
     static bool LaunchWechat()
     {
-        // Use saved path if available
-        if (!g_wechatPath.empty())
-        {
-            std::string wechatExePath = g_wechatPath;
-            if (fs::exists(wechatExePath))
-            {
-                std::string cmd = "\"" + wechatExePath + "\"";
-                AppendLog("[launch] WeChat command: " + cmd);
-                
-                STARTUPINFOA si = { sizeof(si) };
-                PROCESS_INFORMATION pi = {};
-                si.dwFlags = STARTF_USESHOWWINDOW;
-                si.wShowWindow = SW_SHOW;
-                
-                if (CreateProcessA(NULL, (LPSTR)cmd.c_str(), NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
-                {
-                    CloseHandle(pi.hProcess);
-                    CloseHandle(pi.hThread);
-                    AppendLog("[launch] WeChat launched successfully");
-                    return true;
-                }
-                else
-                {
-                    DWORD error = GetLastError();
-                    AppendLog("[launch] WeChat launch failed, error: " + std::to_string(error));
-                    return false;
-                }
-            }
-        }
-        
-        // Fallback: Try to find WeChat installation
-        std::vector<std::string> wechatPaths = {
-            "C:\\Program Files\\Tencent\\Weixin\\Weixin.exe",
-            "C:\\Users\\" + GetEnvU8("USERNAME") + "\\AppData\\Local\\Tencent\\WeChat\\WeChat.exe",
-            "C:\\Program Files\\Tencent\\WeChat\\WeChat.exe",
-            "C:\\Program Files (x86)\\Tencent\\WeChat\\WeChat.exe"
-        };
-        
-        std::string wechatExePath;
-        for (const auto& path : wechatPaths)
-        {
-            if (fs::exists(path))
-            {
-                wechatExePath = path;
-                break;
-            }
+        // Saved path first, then the usual install locations
+        const std::string savedPath = g_wechatPath;
+        LaunchScheduler::Enqueue("WeChat", [savedPath]() {
+            return LaunchCommand("WeChat", FirstExistingPath({
+                savedPath,
+                "C:\\Program Files\\Tencent\\Weixin\\Weixin.exe",
+                "C:\\Users\\" + GetEnvU8("USERNAME") + "\\AppData\\Local\\Tencent\\WeChat\\WeChat.exe",
+                "C:\\Program Files\\Tencent\\WeChat\\WeChat.exe",
+                "C:\\Program Files (x86)\\Tencent\\WeChat\\WeChat.exe"
+            }), std::string());
+        }, LogLaunchDone);
+        return true;
+    }
+
+    // Queue everything the current selection names; returns the number of launches queued
+    static int RestoreEnvironment()
+    {
+        int queued = 0;
+        if (!g_selectedSlnPaths.empty())
+        {
+            for (const auto& sln : g_selectedSlnPaths) queued += LaunchVSWithSolution(sln) ? 1 : 0;
         }
-        
-        if (wechatExePath.empty())
+        else
         {
-            AppendLog("[launch] WeChat not found in common locations");
-            return false;
+            queued += LaunchVSWithSolution(g_selectedSlnPath) ? 1 : 0;
         }
-        
-        std::string cmd = "\"" + wechatExePath + "\"";
-        AppendLog("[launch] WeChat command: " + cmd);
-        
-        STARTUPINFOA si = { sizeof(si) };
-        PROCESS_INFORMATION pi = {};
-        si.dwFlags = STARTF_USESHOWWINDOW;
-        si.wShowWindow = SW_SHOW;
-        
-        if (CreateProcessA(NULL, (LPSTR)cmd.c_str(), NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi))
+        if (!g_selectedCursorFolders.empty())
         {
-            CloseHandle(pi.hProcess);
-            CloseHandle(pi.hThread);
-            AppendLog("[launch] WeChat launched successfully");
-            return true;
+            for (const auto& folder : g_selectedCursorFolders) queued += LaunchCursorWithFolder(folder) ? 1 : 0;
         }
         else
         {
-            DWORD error = GetLastError();
-            AppendLog("[launch] WeChat launch failed, error: " + std::to_string(error));
-            return false;
+            queued += LaunchCursorWithFolder(g_selectedCursorFolder) ? 1 : 0;
+        }
+        if (!g_feishuPath.empty()) queued += LaunchFeishu() ? 1 : 0;
+        if (!g_wechatPath.empty()) queued += LaunchWechat() ? 1 : 0;
+        AppendLog("[launch] restore queued " + std::to_string(queued) + " launch(es)");
+        return queued;
+    }
+
+    // Launch queue: concurrency limit and per-launch latency
+    static void DrawLaunchStatus()
+    {
+        int concurrency = LaunchScheduler::Concurrency();
+        ImGui::SetNextItemWidth(120);
+        if (ImGui::SliderInt("Parallel launches", &concurrency, 1, LaunchScheduler::kMaxConcurrency))
+        {
+            LaunchScheduler::SetConcurrency(concurrency);
+        }
+        std::vector<LaunchScheduler::Launch> launches = LaunchScheduler::Launches();
+        if (launches.empty()) return;
+        ImGui::SameLine();
+        if (ImGui::SmallButton("[Clear]")) LaunchScheduler::ClearFinished();
+        for (const auto& l : launches)
+        {
+            ImVec4 color = ImVec4(0.8f, 0.8f, 0.2f, 1.0f);
+            if (l.state == LaunchScheduler::State::Ready || l.state == LaunchScheduler::State::HandedOff) color = ImVec4(0.2f, 0.8f, 0.2f, 1.0f);
+            else if (l.state == LaunchScheduler::State::Failed || l.state == LaunchScheduler::State::TimedOut) color = ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
+            if (LaunchScheduler::IsFinished(l.state))
+            {
+                ImGui::TextColored(color, "%s: %s in %.1f s", l.label.c_str(), LaunchScheduler::StateName(l.state), (l.spawnMs + l.readyMs) / 1000.0);
+                if (ImGui::IsItemHovered())
+                {
+                    ImGui::SetTooltip("pid %u\nqueued %.0f ms\nstart %.0f ms\nready %.0f ms%s%s", (unsigned)l.pid, l.queuedMs, l.spawnMs,
+                                      l.readyMs, l.detail.empty() ? "" : "\n", l.detail.c_str());
+                }
+            }
+            else
+            {
+                ImGui::TextColored(color, "%s: %s...", l.label.c_str(), LaunchScheduler::StateName(l.state));
+            }
         }
     }
 
@@ -1173,32 +1256,12 @@ namespace VSInspector
 
     static void SearchSlnNearDocument(const std::string& docPath, std::string& slnOut)
     {
-        slnOut.clear();
-        std::error_code ec2; fs::path pdir = fs::path(docPath).parent_path(); fs::path startDir = pdir; int depth = 0;
-        while (!pdir.empty() && depth < 12)
-        {
-            ec2.clear();
-            for (fs::directory_iterator dit(pdir, fs::directory_options::skip_permission_denied, ec2), dend; dit != dend; dit.increment(ec2))
-            {
-                if (ec2) { ec2.clear(); continue; }
-                const fs::directory_entry& e = *dit;
-                if (e.is_regular_file(ec2) && !ec2)
-                {
-                    std::string ext = e.path().extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return (char)std::tolower(c); });
-                    if (ext == ".sln")
-                    {
-                        slnOut = e.path().string();
-                        AppendLog(std::string("[vs] Found nearby solution: ") + slnOut);
-                        return;
-                    }
-                }
-            }
-            if (!slnOut.empty()) break;
-            pdir = pdir.parent_path();
-            depth++;
-        }
-        if (slnOut.empty()) AppendLog(std::string("[vs] No .sln found near ") + startDir.string());
+        fs::path startDir = fs::path(docPath).parent_path();
+        slnOut = SolutionCache::Run(SolutionCache::Strategy::DocumentWalk, [&](const SolutionCache::Deadline& deadline) {
+            return SolutionCache::FindSolutionUpward(startDir, 12, deadline);
+        });
+        if (!slnOut.empty()) AppendLog(std::string("[vs] Found nearby solution: ") + slnOut);
+        else AppendLog(std::string("[vs] No .sln found near ") + startDir.string());
     }
 
 
@@ -1212,182 +1275,73 @@ namespace VSInspector
 
 
     // Step 2: 通过进程文件句柄枚举获取solution路径（需要管理员权限）
-    static std::string TryGetSolutionFromProcessHandles(DWORD pid)
+    static std::string TryGetSolutionFromProcessHandles(DWORD pid, const std::string& activeDocument, const SolutionCache::Deadline& deadline)
     {
         AppendLog("[vs] TryGetSolutionFromProcessHandles: pid=" + std::to_string((unsigned long)pid));
-        
-        // 需要管理员权限才能枚举其他进程的句柄
-        HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
-        if (!hProcess) 
-        {
-            AppendLog("[vs] TryGetSolutionFromProcessHandles: OpenProcess failed - need admin privileges");
-            return "";
-        }
-        
-        // 使用NtQuerySystemInformation获取系统句柄信息
-        typedef NTSTATUS (WINAPI *PNtQuerySystemInformation)(ULONG, PVOID, ULONG, PULONG);
-        HMODULE hNtdll = GetModuleHandleW(L"ntdll.dll");
-        if (!hNtdll)
-        {
-            AppendLog("[vs] TryGetSolutionFromProcessHandles: Failed to get ntdll.dll");
-            CloseHandle(hProcess);
-            return "";
-        }
-        
-        PNtQuerySystemInformation NtQuerySystemInformation = 
-            (PNtQuerySystemInformation)GetProcAddress(hNtdll, "NtQuerySystemInformation");
-        if (!NtQuerySystemInformation)
-        {
-            AppendLog("[vs] TryGetSolutionFromProcessHandles: Failed to get NtQuerySystemInformation");
-            CloseHandle(hProcess);
-            return "";
-        }
-        
-        // 获取系统句柄信息
-        ULONG bufferSize = 0x10000;
-        PVOID buffer = VirtualAlloc(NULL, bufferSize, MEM_COMMIT, PAGE_READWRITE);
-        if (!buffer)
-        {
-            AppendLog("[vs] TryGetSolutionFromProcessHandles: Failed to allocate buffer");
-            CloseHandle(hProcess);
-            return "";
-        }
-        
-        NTSTATUS status = NtQuerySystemInformation(16, buffer, bufferSize, &bufferSize); // SystemHandleInformation
-        if (status != 0)
+
+        // 需要 PROCESS_DUP_HANDLE 权限才能复制其他进程的句柄
+        std::vector<std::string> openFiles;
+        if (!HandleScan::QueryOpenFilePaths(pid, openFiles, deadline.End()))
         {
-            AppendLog("[vs] TryGetSolutionFromProcessHandles: NtQuerySystemInformation failed with status " + std::to_string(status));
-            VirtualFree(buffer, 0, MEM_RELEASE);
-            CloseHandle(hProcess);
+            AppendLog("[vs] TryGetSolutionFromProcessHandles: handle list unavailable - need admin privileges");
             return "";
         }
-        
-        // 解析句柄信息结构
-        typedef struct _SYSTEM_HANDLE_TABLE_ENTRY_INFO {
-            ULONG ProcessId;
-            BYTE ObjectTypeNumber;
-            BYTE Flags;
-            USHORT Handle;
-            PVOID Object;
-            ULONG_PTR GrantedAccess;
-        } SYSTEM_HANDLE_TABLE_ENTRY_INFO, *PSYSTEM_HANDLE_TABLE_ENTRY_INFO;
-        
-        typedef struct _SYSTEM_HANDLE_INFORMATION {
-            ULONG NumberOfHandles;
-            SYSTEM_HANDLE_TABLE_ENTRY_INFO Handles[1];
-        } SYSTEM_HANDLE_INFORMATION, *PSYSTEM_HANDLE_INFORMATION;
-        
-        PSYSTEM_HANDLE_INFORMATION handleInfo = (PSYSTEM_HANDLE_INFORMATION)buffer;
-        std::vector<std::string> candidateSolutions;
-        
-        for (ULONG i = 0; i < handleInfo->NumberOfHandles; i++)
-        {
-            SYSTEM_HANDLE_TABLE_ENTRY_INFO& handle = handleInfo->Handles[i];
-            
-            // 只检查目标进程的句柄
-            if (handle.ProcessId != pid) continue;
-            
-            // 尝试获取句柄的文件名
-            HANDLE hFile = (HANDLE)handle.Handle;
-            wchar_t fileName[MAX_PATH];
-            DWORD fileNameLen = GetFinalPathNameByHandleW(hFile, fileName, MAX_PATH, FILE_NAME_NORMALIZED);
-            
-            if (fileNameLen > 0 && fileNameLen < MAX_PATH)
-            {
-                std::string filePath = WideToUtf8(fileName);
-                
-                // 检查是否是.sln文件
-                if (filePath.find(".sln") != std::string::npos && 
-                    filePath.find("Dear-ImGui-Tool") == std::string::npos &&
-                    std::filesystem::exists(filePath))
-                {
-                    AppendLog("[vs] TryGetSolutionFromProcessHandles: Found solution handle: " + filePath);
-                    candidateSolutions.push_back(filePath);
-                }
-            }
-        }
-        
-        VirtualFree(buffer, 0, MEM_RELEASE);
-        CloseHandle(hProcess);
-        
-        // 如果有多个候选，选择与活动文档目录最近的
-        if (!candidateSolutions.empty())
+
+        // 多个候选时，与活动文档目录最近的排在最前
+        std::vector<std::string> ranked = HandleScan::RankSolutionCandidates(openFiles, activeDocument);
+        AppendLog("[vs] TryGetSolutionFromProcessHandles: " + std::to_string(openFiles.size()) + " open file(s), " +
+                  std::to_string(ranked.size()) + " solution candidate(s)");
+        for (const std::string& candidate : ranked)
         {
-            if (candidateSolutions.size() == 1)
-            {
-                AppendLog("[vs] TryGetSolutionFromProcessHandles: Single solution found: " + candidateSolutions[0]);
-                return candidateSolutions[0];
-            }
-            else
-            {
-                AppendLog("[vs] TryGetSolutionFromProcessHandles: Multiple solutions found, using first: " + candidateSolutions[0]);
-                return candidateSolutions[0];
-            }
+            std::error_code ec;
+            if (candidate.find("Dear-ImGui-Tool") != std::string::npos || !fs::exists(candidate, ec)) continue;
+            AppendLog("[vs] TryGetSolutionFromProcessHandles: Found solution handle: " + candidate);
+            return candidate;
         }
-        
+
         AppendLog("[vs] TryGetSolutionFromProcessHandles: No solution handles found");
         return "";
     }
     
+    // .slnf: {"solution": {"path": "..\\App.sln", "projects": [...]}}; the path is relative to the .slnf
+    static std::string ReadSolutionFilterTarget(const std::string& slnfPath)
+    {
+        std::string content;
+        if (!Json::ReadFile(slnfPath, content)) return "";
+        std::string_view json(content);
+        if (json.substr(0, 3) == "\xEF\xBB\xBF") json.remove_prefix(3);  // VS writes a UTF-8 BOM
+        Json::Reader r(json);
+        if (r.Next() != Json::Token::ObjectBegin) return "";
+        while (r.Next() == Json::Token::Key)
+        {
+            if (r.Text() != "solution") { if (!r.SkipValue()) return ""; continue; }
+            if (r.Next() != Json::Token::ObjectBegin) return "";
+            while (r.Next() == Json::Token::Key)
+            {
+                if (r.Text() != "path") { if (!r.SkipValue()) return ""; continue; }
+                if (r.Next() != Json::Token::String) return "";
+                fs::path target = fs::path(slnfPath).parent_path() / fs::u8path(r.Text().begin(), r.Text().end());
+                return target.lexically_normal().string();
+            }
+            return "";
+        }
+        return "";
+    }
+
     // Step 3: 解析进程命令行，支持.slnf文件
     static std::string TryGetSolutionFromCommandLine(DWORD pid)
     {
         AppendLog("[vs] TryGetSolutionFromCommandLine: pid=" + std::to_string((unsigned long)pid));
         
-        HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
-        if (!hProcess) 
+        // 获取进程命令行 (ProcessEnum, refresh worker thread)
+        std::string cmdLineUtf8 = Processes().QueryCommandLine(pid);
+        if (cmdLineUtf8.empty())
         {
-            AppendLog("[vs] TryGetSolutionFromCommandLine: OpenProcess failed");
+            AppendLog("[vs] TryGetSolutionFromCommandLine: command line unavailable");
             return "";
         }
-        
-        // 获取进程命令行
-        wchar_t commandLine[4096];
-        DWORD commandLineLen = 0;
-        
-        // 使用NtQueryInformationProcess获取命令行
-        typedef NTSTATUS (WINAPI *PNtQueryInformationProcess)(HANDLE, ULONG, PVOID, ULONG, PULONG);
-        HMODULE hNtdll = GetModuleHandleW(L"ntdll.dll");
-        if (hNtdll)
-        {
-            PNtQueryInformationProcess NtQueryInformationProcess = 
-                (PNtQueryInformationProcess)GetProcAddress(hNtdll, "NtQueryInformationProcess");
-            
-            if (NtQueryInformationProcess)
-            {
-                typedef struct _PROCESS_BASIC_INFORMATION {
-                    PVOID Reserved1;
-                    PVOID PebBaseAddress;
-                    PVOID Reserved2_0;
-                    PVOID Reserved2_1;
-                    PVOID UniqueProcessId;
-                    PVOID Reserved3;
-                } PROCESS_BASIC_INFORMATION;
-                
-                PROCESS_BASIC_INFORMATION pbi;
-                NTSTATUS status = NtQueryInformationProcess(hProcess, 0, &pbi, sizeof(pbi), NULL);
-                if (status == 0 && pbi.PebBaseAddress)
-                {
-                    // 读取PEB中的命令行信息
-                    PVOID commandLinePtr = nullptr;
-                    SIZE_T bytesRead;
-                    if (ReadProcessMemory(hProcess, (PVOID)((BYTE*)pbi.PebBaseAddress + 0x70), &commandLinePtr, sizeof(commandLinePtr), &bytesRead))
-                    {
-                        if (commandLinePtr && ReadProcessMemory(hProcess, commandLinePtr, commandLine, sizeof(commandLine), &bytesRead))
-                        {
-                            commandLineLen = (DWORD)bytesRead / sizeof(wchar_t);
-                        }
-                    }
-                }
-            }
-        }
-        
-        CloseHandle(hProcess);
-        
-        if (commandLineLen > 0)
+
         {
-            std::wstring cmdLine(commandLine, commandLineLen);
-            std::string cmdLineUtf8 = WideToUtf8(cmdLine);
             AppendLog("[vs] Process command line: " + cmdLineUtf8);
             
             // 查找.sln或.slnf文件路径
@@ -1407,29 +1361,12 @@ namespace VSInspector
                     AppendLog("[vs] Found .slnf file: " + slnfPath);
                     
                     // 解析.slnf文件，查找solution路径
-                    std::ifstream file(slnfPath);
-                    if (file.is_open())
+                    std::string slnPath = ReadSolutionFilterTarget(slnfPath);
+                    std::error_code ec;
+                    if (!slnPath.empty() && fs::exists(slnPath, ec))
                     {
-                        std::string line;
-                        while (std::getline(file, line))
-                        {
-                            if (line.find("solution") != std::string::npos && line.find(".sln") != std::string::npos)
-                            {
-                                // 提取solution路径
-                                size_t start = line.find("\"");
-                                size_t end = line.find("\"", start + 1);
-                                if (start != std::string::npos && end != std::string::npos)
-                                {
-                                    std::string slnPath = line.substr(start + 1, end - start - 1);
-                                    if (std::filesystem::exists(slnPath))
-                                    {
-                                        AppendLog("[vs] Resolved .slnf to solution: " + slnPath);
-                                        return slnPath;
-                                    }
-                                }
-                            }
-                        }
-                        file.close();
+                        AppendLog("[vs] Resolved .slnf to solution: " + slnPath);
+                        return slnPath;
                     }
                 }
             }
@@ -1452,48 +1389,6 @@ namespace VSInspector
         return "";
     }
     
-    // Step 4: 从活动文档路径向上搜索.sln文件（兜底方法）
-    static std::string TryGetSolutionFromActiveDocument(const std::string& activeDocPath)
-    {
-        if (activeDocPath.empty()) return "";
-        
-        AppendLog("[vs] TryGetSolutionFromActiveDocument: searching from " + activeDocPath);
-        
-        std::filesystem::path docPath(activeDocPath);
-        std::filesystem::path currentDir = docPath.parent_path();
-        int depth = 0;
-        const int MAX_DEPTH = 8;
-        
-        while (!currentDir.empty() && depth < MAX_DEPTH)
-        {
-            try
-            {
-                for (const auto& entry : std::filesystem::directory_iterator(currentDir))
-                {
-                    if (entry.is_regular_file() && entry.path().extension() == ".sln")
-                    {
-                        std::string slnPath = entry.path().string();
-                        if (slnPath.find("Dear-ImGui-Tool") == std::string::npos)
-                        {
-                            AppendLog("[vs] Found solution near active document: " + slnPath);
-                            return slnPath;
-                        }
-                    }
-                }
-            }
-            catch (const std::exception& e)
-            {
-                AppendLog("[vs] TryGetSolutionFromActiveDocument: Exception: " + std::string(e.what()));
-            }
-            
-            currentDir = currentDir.parent_path();
-            depth++;
-        }
-        
-        AppendLog("[vs] TryGetSolutionFromActiveDocument: No solution found");
-        return "";
-    }
-
     static void TryFillFromActiveDocument(IDispatch* pDisp, DWORD pid, std::vector<VSInstance>& found, std::string& slnOut)
     {
         slnOut.clear();
@@ -1526,444 +1421,139 @@ namespace VSInspector
             AppendLog("[vs] Invoke(ActiveDocument.FullName) failed");
         }
         VariantClear(&resultActiveDoc);
-    }
-
-    static void ProcessDteMoniker(IRunningObjectTable* pRot, IMoniker* pMoniker, std::vector<VSInstance>& found, DWORD pidHint)
-    {
-        // 参考C#代码的实现方式
-        IUnknown* pUnk = NULL; 
-        HRESULT hrGetObj = pRot->GetObject(pMoniker, &pUnk);
-        if (FAILED(hrGetObj) || !pUnk) 
-        { 
-            AppendLog(std::string("[vs] GetObject(moniker) failed hr=") + std::to_string((long)hrGetObj)); 
-            return; 
-        }
-        
-        // 直接尝试获取DTE接口，就像C#代码中的 (DTE)comObject
-        IDispatch* pDisp = NULL; 
-        HRESULT hrQI = pUnk->QueryInterface(IID_IDispatch, (void**)&pDisp);
-        if (FAILED(hrQI) || !pDisp) 
-        { 
-            AppendLog(std::string("[vs] QueryInterface(IDispatch) failed hr=") + std::to_string((long)hrQI)); 
-            pUnk->Release(); 
-            return; 
-        }
-
-        // 获取进程ID
-        DWORD pid = 0; 
-        if (!GetPidFromDTE(pDisp, pid) || pid == 0) 
-        {
-            if (pidHint != 0) 
-            {
-                pid = pidHint;
-                AppendLog(std::string("[vs] Using pidHint from ROT: ") + std::to_string((unsigned long)pid));
-            } 
-            else 
-            {
-                AppendLog("[vs] GetPidFromDTE failed and no pidHint"); 
-                pDisp->Release(); 
-                pUnk->Release(); 
-                return;
-            }
-        }
-        
-        // 直接获取Solution.FullName，就像C#代码中的 dte.Solution.FullName
-        std::string sln; 
-        bool gotSln = TryGetSolutionFullName(pDisp, sln);
-        AppendLog(std::string("[vs] TryGetSolutionFullName result=") + (gotSln?"true":"false") + std::string(" sln=") + (sln.empty()?"<empty>":sln));
-        
-        // 如果COM方法成功，直接使用结果
-        if (!sln.empty())
-        {
-            for (auto& inst : found) 
-            { 
-                if (inst.pid == pid) 
-                { 
-                    inst.solutionPath = sln; 
-                    AppendLog(std::string("[vs] pid ") + std::to_string((unsigned long)pid) + std::string(" Set solutionPath via COM: ") + sln); 
-                } 
-            }
-        }
-        else
-        {
-            // COM接口失败，尝试备用方法
-            AppendLog("[vs] COM interface failed, trying alternative methods for pid=" + std::to_string((unsigned long)pid));
-            
-            // Step 2: 尝试进程文件句柄枚举
-            std::string handlePath = TryGetSolutionFromProcessHandles(pid);
-            if (!handlePath.empty())
-            {
-                sln = handlePath;
-                AppendLog("[vs] Found solution via process handles: " + sln);
-            }
-            else
-            {
-                // Step 3: 尝试命令行解析
-                std::string cmdLinePath = TryGetSolutionFromCommandLine(pid);
-                if (!cmdLinePath.empty())
-                {
-                    sln = cmdLinePath;
-                    AppendLog("[vs] Found solution via command line: " + sln);
-                }
-                else
-                {
-                    // Step 4: 从活动文档路径向上搜索
-                    TryFillFromActiveDocument(pDisp, pid, found, sln);
-                    if (!sln.empty())
-                    {
-                        std::string docPath = TryGetSolutionFromActiveDocument(sln);
-                        if (!docPath.empty())
-                        {
-                            sln = docPath;
-                            AppendLog("[vs] Found solution via active document search: " + sln);
-                        }
-                    }
-                }
-            }
-            
-            // 设置备用方法找到的结果
-            if (!sln.empty())
-            {
-                for (auto& inst : found) 
-                { 
-                    if (inst.pid == pid) 
-                    { 
-                        inst.solutionPath = sln; 
-                        AppendLog(std::string("[vs] pid ") + std::to_string((unsigned long)pid) + std::string(" Set solutionPath via backup method: ") + sln); 
-                    } 
-                }
-            }
-            else
-            {
-                AppendLog(std::string("[vs] pid ") + std::to_string((unsigned long)pid) + std::string(" no solution resolved - VS may be in Open Folder mode"));
-            }
-        }
-        
-        pDisp->Release(); 
-        pUnk->Release();
-    }
-
-    void Refresh()
-    {
-        AppendLog("[vs] RefreshVSInstances: begin");
-        
-        // Update system resources
-        float currentTime = ImGui::GetTime();
-        if (currentTime - g_lastResourceUpdate >= g_resourceUpdateInterval) {
-            UpdateSystemResources();
-            g_lastResourceUpdate = currentTime;
-        }
-        
-        std::vector<VSInstance> found;
-        std::vector<CursorInstance> foundCursor;
-        std::string foundFeishuPath;
-        bool foundFeishuRunning = false;
-        std::string foundWechatPath;
-        bool foundWechatRunning = false;
-
-        // Load persisted prefs once per refresh to show defaults
-        if (g_selectedSlnPath.empty() && g_selectedCursorFolder.empty())
-        {
-            LoadPrefs();
-        }
-
-        HANDLE hSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-        if (hSnap == INVALID_HANDLE_VALUE)
-            return;
-
-        PROCESSENTRY32 pe;
-        pe.dwSize = sizeof(PROCESSENTRY32);
-        if (Process32First(hSnap, &pe))
-        {
-            do
-            {
-                std::string exeU;
-            #ifdef UNICODE
-                exeU = WideToUtf8(pe.szExeFile);
-            #else
-                exeU = pe.szExeFile;
-            #endif
-                std::string exeLower = exeU;
-                std::transform(exeLower.begin(), exeLower.end(), exeLower.begin(), [](unsigned char c){ return (char)std::tolower(c); });
-                if (exeLower == std::string("devenv.exe"))
-                {
-                    VSInstance inst;
-                    inst.pid = pe.th32ProcessID;
-
-                    HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, pe.th32ProcessID);
-                    if (hProc)
-                    {
-                        char buf[MAX_PATH];
-                        DWORD sz = (DWORD)sizeof(buf);
-                        if (QueryFullProcessImageNameA(hProc, 0, buf, &sz))
-                            inst.exePath.assign(buf, sz);
-                        CloseHandle(hProc);
-                    }
-                    AppendLog(std::string("[vs] found devenv.exe pid=") + std::to_string((unsigned long)inst.pid) + (inst.exePath.empty() ? std::string(" path=<unknown>") : std::string(" path=") + inst.exePath));
-                    found.push_back(inst);
-                }
-                else if (exeLower == std::string("cursor.exe"))
-                {
-                    CursorInstance cinst;
-                    cinst.pid = pe.th32ProcessID;
-                    HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, pe.th32ProcessID);
-                    if (hProc)
-                    {
-                        char buf[MAX_PATH];
-                        DWORD sz = (DWORD)sizeof(buf);
-                        if (QueryFullProcessImageNameA(hProc, 0, buf, &sz))
-                            cinst.exePath.assign(buf, sz);
-                        CloseHandle(hProc);
-                    }
-                    // Cursor进程检测日志已删除
-                    foundCursor.push_back(cinst);
-                }
-                else if (DetectProcessAndGetPath(exeLower, {"feishu.exe", "lark.exe"}, pe.th32ProcessID, foundFeishuPath, foundFeishuRunning, "feishu"))
-                {
-                    // Processed by DetectProcessAndGetPath
-                }
-                else if (exeLower == "weixin.exe" || exeLower == "wechat.exe")
-                {
-                    // 优先检测微信主程序
-                    HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, pe.th32ProcessID);
-                    if (hProc)
-                    {
-                        char buf[MAX_PATH];
-                        DWORD sz = (DWORD)sizeof(buf);
-                        if (QueryFullProcessImageNameA(hProc, 0, buf, &sz))
-                            foundWechatPath.assign(buf, sz);
-                        CloseHandle(hProc);
-                    }
-                    foundWechatRunning = true;
-                    // 微信进程检测日志已删除
-                }
-                else if (exeLower == "wechatappex.exe")
-                {
-                    // 检测到微信插件进程，但不保存路径（只用于状态检测）
-                    if (!foundWechatRunning)
-                    {
-                        foundWechatRunning = true;
-                        // 微信插件进程检测日志已删除
-                    }
-                }
-            } while (Process32Next(hSnap, &pe));
-        }
-        CloseHandle(hSnap);
-
-        std::unordered_map<DWORD, std::string> pidToTitle;
-        EnumWindows([](HWND hWnd, LPARAM lParam)->BOOL{
-            if (!IsWindowVisible(hWnd)) return TRUE;
-            DWORD pid = 0;
-            GetWindowThreadProcessId(hWnd, &pid);
-            if (pid == 0) return TRUE;
-            wchar_t wtitle[512];
-            int lenW = GetWindowTextW(hWnd, wtitle, (int)(sizeof(wtitle)/sizeof(wtitle[0])));
-            if (lenW > 0)
-            {
-                std::wstring wstr(wtitle, lenW);
-                std::string utf8 = WideToUtf8(wstr);
-                auto* mapPtr = reinterpret_cast<std::unordered_map<DWORD, std::string>*>(lParam);
-                auto it = mapPtr->find(pid);
-                if (it == mapPtr->end() || (int)it->second.size() < (int)utf8.size())
-                    (*mapPtr)[pid] = utf8;
-            }
-            return TRUE;
-        }, reinterpret_cast<LPARAM>(&pidToTitle));
-
-        AppendLog(std::string("[vs] Found ") + std::to_string(found.size()) + " VS processes before ROT processing");
-        for (auto& inst : found)
-        {
-            auto it = pidToTitle.find(inst.pid);
-            if (it != pidToTitle.end()) inst.windowTitle = it->second;
-            AppendLog(std::string("[vs] VS process: pid=") + std::to_string((unsigned long)inst.pid) + 
-                     std::string(" title=") + (inst.windowTitle.empty()?"<none>":inst.windowTitle) +
-                     std::string(" solutionPath=") + (inst.solutionPath.empty()?"<none>":inst.solutionPath));
-        }
-
-
-
-        // 首先获取所有openedWindows中的文件夹
-        std::vector<std::string> openedFolders;
-        std::string appdata = GetEnvU8("APPDATA");
-        // Cursor APPDATA日志已删除
-        if (!appdata.empty())
-        {
-            fs::path p = fs::path(appdata) / "Cursor" / "User" / "globalStorage" / "storage.json";
-            // Cursor storage.json检查日志已删除
-            std::error_code ec; 
-            if (fs::exists(p, ec))
-            {
-                // Cursor storage.json读取日志已删除
-                std::ifstream ifs(p.string(), std::ios::binary);
-                if (ifs)
-                {
-                    std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-                    // Cursor storage.json内容大小日志已删除
-                    size_t openedWindowsPos = content.find("\"openedWindows\"");
-                    if (openedWindowsPos != std::string::npos)
-                    {
-                        // Cursor openedWindows位置日志已删除
-                        size_t pos = openedWindowsPos;
-                        int folderCount = 0;
-                        while (true)
-                        {
-                            size_t folderPos = content.find("\"folder\"", pos);
-                            if (folderPos == std::string::npos) 
-                            {
-                                // Cursor文件夹条目统计日志已删除
-                                break;
-                            }
-                            
-                            folderCount++;
-                            // Cursor文件夹条目位置日志已删除
-                            
-                            // 改进的JSON解析逻辑
-                            // 查找 "folder": 后面的值
-                            size_t colonPos = content.find(':', folderPos + 8);
-                            if (colonPos == std::string::npos) break;
-                            
-                            // 跳过冒号后的空白字符
-                            size_t valueStart = colonPos + 1;
-                            while (valueStart < content.size() && (content[valueStart] == ' ' || content[valueStart] == '\t' || content[valueStart] == '\n' || content[valueStart] == '\r'))
-                                valueStart++;
-                            
-                            if (valueStart >= content.size()) break;
-                            
-                            // 检查是否是字符串值（以双引号开始）
-                            if (content[valueStart] != '"') break;
-                            
-                            // 找到字符串的结束位置
-                            size_t valueEnd = valueStart + 1;
-                            while (valueEnd < content.size() && content[valueEnd] != '"')
-                            {
-                                if (content[valueEnd] == '\\' && valueEnd + 1 < content.size())
-                                    valueEnd += 2; // 跳过转义字符
-                                else
-                                    valueEnd++;
-                            }
-                            
-                            if (valueEnd >= content.size()) break;
-                            
-                            std::string folderUri = content.substr(valueStart + 1, valueEnd - valueStart - 1);
-                            // Cursor文件夹URI日志已删除
-                            
-                            std::string winPath;
-                            if (DecodeFileUriToWindowsPath(folderUri, winPath))
-                            {
-                                openedFolders.push_back(winPath);
-                                // Cursor解码文件夹路径日志已删除
-                            }
-                            else
-                            {
-                                // Cursor URI解码失败日志已删除
-                            }
-                            pos = valueEnd + 1;
-                        }
-                    }
-                    else
-                    {
-                        // Cursor openedWindows未找到日志已删除
-                    }
-                }
-                else
-                {
-                    // Cursor storage.json读取失败日志已删除
-                }
-            }
-            else
-            {
-                // Cursor storage.json不存在日志已删除
-            }
-        }
-        else
+    }
+
+    // Cursor's storage.json is re-parsed only when its mtime/size change (refresh worker only)
+    struct CursorStorageCache
+    {
+        bool valid = false;
+        fs::file_time_type mtime;
+        uintmax_t size = 0;
+        std::vector<std::string> folders;
+    };
+    static CursorStorageCache g_cursorStorage;
+
+    // Reads storage.json and parses it up to the end of windowsState.openedWindows: the folder of
+    // every opened window, or the lastActiveWindow folder when no window is listed. Keys are
+    // matched as string_views into the buffer; only the folder URIs are copied.
+    static bool ReadCursorFolders(const fs::path& p, std::vector<std::string>& folders)
+    {
+        folders.clear();
+        std::string content;
+        if (!Json::ReadFile(p, content))
         {
-            // Cursor APPDATA环境变量为空日志已删除
+            AppendLog(std::string("[vs] Cursor storage.json: open for read failed: ") + p.string());
+            return false;
         }
-        // Cursor统计信息日志已删除
 
-        // 如果没有从 openedWindows 解析到任何文件夹，则尝试从 lastActiveWindow 读取一个文件夹作为回退
-        if (openedFolders.empty())
+        // What opened each container, and the key of the value that comes next
+        enum class Scope : uint8_t { Other, OpenedWindows, OpenedWindow, LastActiveWindow };
+        enum class Key : uint8_t { None, Other, Folder, OpenedWindows, LastActiveWindow };
+        std::vector<Scope> scopes;
+        Key key = Key::None;
+        std::string lastActiveUri;
+        std::vector<std::string> openedUris;
+        bool openedClosed = false;
+        bool stopped = false;
+
+        Json::Reader r(content);
+        for (Json::Token t = r.Next(); !stopped && t != Json::Token::End && t != Json::Token::Error; t = r.Next())
         {
-            // Cursor回退机制日志已删除
-            std::string appdata2 = GetEnvU8("APPDATA");
-            if (!appdata2.empty())
+            switch (t)
             {
-                fs::path p2 = fs::path(appdata2) / "Cursor" / "User" / "globalStorage" / "storage.json";
-                std::error_code ec2;
-                if (fs::exists(p2, ec2))
+            case Json::Token::Key:
+            {
+                const std::string_view k = r.Text();
+                key = k == "folder" ? Key::Folder
+                    : k == "openedWindows" ? Key::OpenedWindows
+                    : k == "lastActiveWindow" ? Key::LastActiveWindow
+                    : Key::Other;
+                break;
+            }
+            case Json::Token::ObjectBegin:
+            case Json::Token::ArrayBegin:
+            {
+                Scope scope = Scope::Other;
+                if (key == Key::OpenedWindows) scope = Scope::OpenedWindows;
+                else if (key == Key::LastActiveWindow) scope = Scope::LastActiveWindow;
+                else if (key == Key::None && !scopes.empty() && scopes.back() == Scope::OpenedWindows) scope = Scope::OpenedWindow;
+                scopes.push_back(scope);
+                key = Key::None;
+                break;
+            }
+            case Json::Token::ObjectEnd:
+            case Json::Token::ArrayEnd:
+                if (t == Json::Token::ArrayEnd && scopes.back() == Scope::OpenedWindows) openedClosed = true;
+                scopes.pop_back();
+                key = Key::None;
+                // Nothing after openedWindows is needed, unless lastActiveWindow is still to come
+                stopped = openedClosed && (!openedUris.empty() || !lastActiveUri.empty());
+                break;
+            case Json::Token::String:
+                if (key == Key::Folder && !scopes.empty())
                 {
-                    std::ifstream ifs2(p2.string(), std::ios::binary);
-                    if (ifs2)
-                    {
-                        std::string content2((std::istreambuf_iterator<char>(ifs2)), std::istreambuf_iterator<char>());
-                        size_t lastActiveWindowPos = content2.find("\"lastActiveWindow\"");
-                        // Cursor lastActiveWindow位置日志已删除
-                        if (lastActiveWindowPos != std::string::npos)
-                        {
-                            size_t folderKeyPos = content2.find("\"folder\"", lastActiveWindowPos);
-                            if (folderKeyPos != std::string::npos)
-                            {
-                                size_t colonPos = content2.find(':', folderKeyPos + 8);
-                                if (colonPos != std::string::npos)
-                                {
-                                    size_t valueStart = colonPos + 1;
-                                    while (valueStart < content2.size() && (content2[valueStart] == ' ' || content2[valueStart] == '\t' || content2[valueStart] == '\n' || content2[valueStart] == '\r')) valueStart++;
-                                    if (valueStart < content2.size() && content2[valueStart] == '"')
-                                    {
-                                        size_t valueEnd = valueStart + 1;
-                                        while (valueEnd < content2.size() && content2[valueEnd] != '"')
-                                        {
-                                            if (content2[valueEnd] == '\\' && valueEnd + 1 < content2.size()) valueEnd += 2; else valueEnd++;
-                                        }
-                                        if (valueEnd < content2.size())
-                                        {
-                                            std::string folderUri = content2.substr(valueStart + 1, valueEnd - valueStart - 1);
-                                            std::string winPath2;
-                                            if (DecodeFileUriToWindowsPath(folderUri, winPath2))
-                                            {
-                                                openedFolders.push_back(winPath2);
-                                                // Cursor回退文件夹路径日志已删除
-                                            }
-                                            else
-                                            {
-                                                // Cursor回退URI解码失败日志已删除
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
+                    if (scopes.back() == Scope::LastActiveWindow) lastActiveUri.assign(r.Text().data(), r.Text().size());
+                    else if (scopes.back() == Scope::OpenedWindow) openedUris.emplace_back(r.Text());
                 }
+                key = Key::None;
+                break;
+            default:
+                key = Key::None;
+                break;
             }
         }
+        const bool ok = !r.Failed();
+
+        if (openedUris.empty() && !lastActiveUri.empty()) openedUris.push_back(lastActiveUri);
+        for (const std::string& uri : openedUris)
+        {
+            std::string winPath;
+            if (DecodeFileUriToWindowsPath(uri, winPath)) folders.push_back(winPath);
+        }
+        AppendLog("[vs] Cursor storage.json parsed: " + std::to_string(folders.size()) + " folder(s), scanned " +
+                  std::to_string(r.Offset() / 1024) + " of " + std::to_string(content.size() / 1024) + " KiB" +
+                  (ok ? "" : " (malformed: " + r.Error() + ")"));
+        return ok || !folders.empty();
+    }
 
-        // 重置静态索引，确保每次刷新都从头开始分配
-        static size_t cursorIndex = 0;
-        cursorIndex = 0;  // 重置为0
+    // Cursor: folders from storage.json (openedWindows, falling back to lastActiveWindow),
+    // assigned to the running instances in order
+    static void AssignCursorFolders(std::vector<CursorInstance>& foundCursor)
+    {
+        if (foundCursor.empty()) return;
+        std::string appdata = GetEnvU8("APPDATA");
+        if (appdata.empty()) return;
+        fs::path p = fs::path(appdata) / "Cursor" / "User" / "globalStorage" / "storage.json";
+
+        std::error_code ec;
+        fs::file_time_type mtime = fs::last_write_time(p, ec);
+        uintmax_t size = ec ? 0 : fs::file_size(p, ec);
+        if (ec)
+        {
+            g_cursorStorage = CursorStorageCache();
+            return;
+        }
+        if (!g_cursorStorage.valid || g_cursorStorage.mtime != mtime || g_cursorStorage.size != size)
+        {
+            g_cursorStorage.valid = ReadCursorFolders(p, g_cursorStorage.folders);
+            g_cursorStorage.mtime = mtime;
+            g_cursorStorage.size = size;
+        }
 
-        // 直接为每个Cursor实例分配openedFolders中的文件夹
-        for (size_t idx = 0; idx < foundCursor.size(); ++idx)
+        const std::vector<std::string>& openedFolders = g_cursorStorage.folders;
+        for (size_t idx = 0; idx < foundCursor.size() && idx < openedFolders.size(); ++idx)
         {
             auto& cinst = foundCursor[idx];
-            auto it = pidToTitle.find(cinst.pid);
-            if (it != pidToTitle.end()) cinst.windowTitle = it->second;
-            
-            // 直接分配openedFolders中的文件夹，按索引顺序
-            if (idx < openedFolders.size())
-            {
-                cinst.folderPath = openedFolders[idx];
-                fs::path folderPath = cinst.folderPath;
-                cinst.workspaceName = folderPath.filename().string();
-            }
-            else
-            {
-            }
+            cinst.folderPath = openedFolders[idx];
+            cinst.workspaceName = fs::path(cinst.folderPath).filename().string();
         }
+    }
 
-        HRESULT hr = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
-        bool didCoInit = SUCCEEDED(hr);
-        AppendLog(std::string("[vs] CoInitializeEx hr=") + std::to_string((long)hr) + std::string(" didCoInit=") + (didCoInit?"true":"false"));
+    // Solution.FullName via the ROT for the VS instances in found (all of them are in wanted);
+    // DTE entries of other processes are not bound
+    static void ResolveSolutionsViaRot(std::vector<VSInstance>& found, const std::unordered_set<DWORD>& wanted)
+    {
+        HRESULT hr = S_OK;
         
         // 检查当前进程权限
         HANDLE hToken;
@@ -2101,8 +1691,16 @@ namespace VSInspector
                                     
                                     // 尝试获取COM对象
                                     IUnknown* pUnk = NULL;
-                                    hr = pRot->GetObject(monikers[0], &pUnk);
-                                    if (SUCCEEDED(hr) && pUnk)
+                                    // 已解析且标题未变的实例跳过 (GetObject/Invoke 是跨进程调用)
+                                    DWORD rotPid = 0;
+                                    bool skipped = ParsePidFromRotName(ws, rotPid) && wanted.count(rotPid) == 0;
+                                    if (!skipped)
+                                        hr = pRot->GetObject(monikers[0], &pUnk);
+                                    if (skipped)
+                                    {
+                                        AppendLog("[vs]  DTE pid=" + std::to_string((unsigned long)rotPid) + " unchanged, skipped");
+                                    }
+                                    else if (SUCCEEDED(hr) && pUnk)
                                     {
                                         //log
                                         AppendLog("[vs]  in GetDisplayName succeeded");
@@ -2268,6 +1866,15 @@ namespace VSInspector
 
                                             AppendLog("[vs]  Failed to get Solution DISPID: " + std::to_string(hr));
                                         }
+                                        // Solution.FullName 为空 (Open Folder 模式等)：从活动文档向上查找 .sln
+                                        for (auto& inst : found)
+                                        {
+                                            if (rotPid == 0 || inst.pid != rotPid || !inst.solutionPath.empty()) continue;
+                                            std::string nearSln;
+                                            TryFillFromActiveDocument(pDisp, rotPid, found, nearSln);
+                                            if (!nearSln.empty()) inst.solutionPath = nearSln;
+                                            break;
+                                        }
                                         pDisp->Release();
                                     }
                                     else
@@ -2336,39 +1943,332 @@ namespace VSInspector
         
         // 只使用COM接口获取solution路径，不使用备用方法
         AppendLog("[vs] Solution detection completed - only COM interface used");
+    }
+
+    // Worker-thread state kept between refreshes
+    struct TrackedProcess
+    {
+        AppKind kind = kAppNone;
+        std::string exePath;
+        std::string windowTitle;
+        std::string solutionPath;     // VS only
+        bool solutionProbed = false;  // VS: ROT lookup done for the current window title
+        bool announced = false;       // Added event emitted; later differences are Changed events
+    };
+
+    static ProcessEnum::InstanceTracker<TrackedProcess> g_tracked;
+    static std::deque<InstanceEvent> g_recentEvents;
+    static uint64_t g_eventSeq = 0;
+    static const size_t g_maxRecentEvents = 64;
+
+    static const char* AppKindName(AppKind kind)
+    {
+        switch (kind)
+        {
+        case kAppVS: return "VS";
+        case kAppCursor: return "Cursor";
+        case kAppFeishu: return "Feishu";
+        case kAppWechat: return "WeChat";
+        case kAppWechatHelper: return "WeChatAppEx";
+        default: return "?";
+        }
+    }
+
+    static void PushEvent(InstanceEvent::Kind kind, AppKind app, DWORD pid, const std::string& detail)
+    {
+        static const char kKindMark[] = { '+', '-', '~' };
+        InstanceEvent ev;
+        ev.seq = ++g_eventSeq;
+        ev.kind = kind;
+        ev.app = app;
+        ev.pid = pid;
+        ev.detail = detail;
+        AppendLog(std::string("[vs] ") + kKindMark[kind] + " " + AppKindName(app) + " pid=" + std::to_string((unsigned long)pid) + (detail.empty() ? std::string() : " " + detail));
+        g_recentEvents.push_back(std::move(ev));
+        if (g_recentEvents.size() > g_maxRecentEvents) g_recentEvents.pop_front();
+    }
+
+    // Runs on the refresh worker thread (COM already initialized there): no ImGui calls, no UI
+    // state. Processes are tracked by (pid, start time): only new ones are opened and only VS
+    // instances that are new or changed their window title go through the ROT, so a steady-state
+    // refresh costs one process listing plus one EnumWindows pass.
+    // Returns nullptr when the process list fails so the previous result stays visible.
+    static std::shared_ptr<const RefreshSnapshot> ProbeRunningApps()
+    {
+        static std::vector<ProcessEnum::ProcessInfo> processes; // reused
+        if (!Processes().Enumerate(processes))
+            return nullptr;
+
+        // 1. Track matched processes; exited ones are swept
+        const ProcessEnum::NameTable& names = AppNameTable();
+        for (const auto& proc : processes)
+        {
+            AppKind kind = (AppKind)names.Match(proc.name);
+            if (kind == kAppNone) continue;
+            ProcessEnum::ProcessKey key;
+            key.pid = proc.pid;
+            key.startTime = proc.startTime ? proc.startTime : Processes().QueryStartTime(proc.pid);
+            bool isNew = false;
+            TrackedProcess& tracked = g_tracked.Touch(key, isNew);
+            if (!isNew) continue;
+            tracked.kind = kind;
+            // 微信插件进程只用于状态检测，不保存路径
+            if (kind != kAppWechatHelper) tracked.exePath = Processes().QueryExePath(proc.pid);
+        }
+        g_tracked.Sweep([](const ProcessEnum::ProcessKey& key, const TrackedProcess& tracked) {
+            if (tracked.announced) PushEvent(InstanceEvent::Removed, tracked.kind, key.pid, tracked.windowTitle);
+            if (tracked.kind == kAppVS) SolutionCache::ForgetProcess(key);
+        });
+
+        // 2. Window titles of tracked VS/Cursor processes (one EnumWindows pass)
+        std::unordered_map<DWORD, std::string> pidToTitle;
+        g_tracked.ForEach([&](const ProcessEnum::ProcessKey& key, TrackedProcess& tracked) {
+            if (tracked.kind == kAppVS || tracked.kind == kAppCursor) pidToTitle.emplace(key.pid, std::string());
+        });
+        if (!pidToTitle.empty())
+        {
+            EnumWindows([](HWND hWnd, LPARAM lParam)->BOOL{
+                if (!IsWindowVisible(hWnd)) return TRUE;
+                DWORD pid = 0;
+                GetWindowThreadProcessId(hWnd, &pid);
+                auto* mapPtr = reinterpret_cast<std::unordered_map<DWORD, std::string>*>(lParam);
+                auto it = mapPtr->find(pid);
+                if (it == mapPtr->end()) return TRUE;
+                wchar_t wtitle[512];
+                int lenW = GetWindowTextW(hWnd, wtitle, (int)(sizeof(wtitle)/sizeof(wtitle[0])));
+                if (lenW > 0)
+                {
+                    std::string utf8 = WideToUtf8(std::wstring(wtitle, lenW));
+                    if (it->second.size() < utf8.size())
+                        it->second = utf8;
+                }
+                return TRUE;
+            }, reinterpret_cast<LPARAM>(&pidToTitle));
+        }
+
+        // 3. Announce new processes, diff titles, collect VS instances that need a ROT lookup
+        std::vector<VSInstance> toResolve;
+        std::vector<TrackedProcess*> toResolveTracked;
+        std::vector<ProcessEnum::ProcessKey> toResolveKeys;
+        std::unordered_set<DWORD> wanted;
+        g_tracked.ForEach([&](const ProcessEnum::ProcessKey& key, TrackedProcess& tracked) {
+            auto it = pidToTitle.find(key.pid);
+            const std::string title = it != pidToTitle.end() ? it->second : std::string();
+            if (!tracked.announced)
+            {
+                tracked.windowTitle = title;
+                tracked.announced = true;
+                PushEvent(InstanceEvent::Added, tracked.kind, key.pid, tracked.exePath.empty() ? std::string("path=<unknown>") : "path=" + tracked.exePath);
+            }
+            else if (title != tracked.windowTitle)
+            {
+                tracked.windowTitle = title;
+                tracked.solutionProbed = false; // VS puts the solution name in its title
+                PushEvent(InstanceEvent::Changed, tracked.kind, key.pid, "title=" + (title.empty() ? std::string("<none>") : title));
+            }
+            if (tracked.kind == kAppVS && !tracked.solutionProbed)
+            {
+                VSInstance inst;
+                inst.pid = key.pid;
+                toResolve.push_back(inst);
+                toResolveTracked.push_back(&tracked);
+                toResolveKeys.push_back(key);
+                wanted.insert(key.pid);
+            }
+        });
 
+        // 4. ROT/DTE solution lookup, only for the instances collected above
+        if (!toResolve.empty())
         {
-            std::lock_guard<std::mutex> lock(g_vsMutexVS);
-            g_vsList.swap(found);
-            g_cursorList.swap(foundCursor);
-            // 只有在检测到飞书运行时才更新路径，避免覆盖已保存的路径
-            if (foundFeishuRunning)
+            AppendLog(std::string("[vs] Resolving solutions for ") + std::to_string(toResolve.size()) + " VS instance(s) via ROT");
+            auto rotStart = std::chrono::steady_clock::now();
+            ResolveSolutionsViaRot(toResolve, wanted);
+            double rotMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rotStart).count();
+            bool anyResolved = std::any_of(toResolve.begin(), toResolve.end(), [](const VSInstance& inst) { return !inst.solutionPath.empty(); });
+            SolutionCache::Record(SolutionCache::Strategy::Dte, rotMs, anyResolved);
+
+            for (size_t i = 0; i < toResolve.size(); ++i)
+            {
+                // Fallbacks when the DTE gave nothing, cheapest first; answers cached per process
+                VSInstance& inst = toResolve[i];
+                if (inst.solutionPath.empty())
+                {
+                    inst.solutionPath = SolutionCache::RunForProcess(SolutionCache::Strategy::CommandLine, toResolveKeys[i],
+                        [&](const SolutionCache::Deadline&) { return TryGetSolutionFromCommandLine(inst.pid); });
+                }
+                if (inst.solutionPath.empty())
+                {
+                    inst.solutionPath = SolutionCache::RunForProcess(SolutionCache::Strategy::ProcessHandles, toResolveKeys[i],
+                        [&](const SolutionCache::Deadline& deadline) { return TryGetSolutionFromProcessHandles(inst.pid, inst.activeDocumentPath, deadline); });
+                }
+
+                TrackedProcess& tracked = *toResolveTracked[i];
+                tracked.solutionProbed = true;
+                if (tracked.solutionPath != toResolve[i].solutionPath)
+                {
+                    tracked.solutionPath = toResolve[i].solutionPath;
+                    PushEvent(InstanceEvent::Changed, kAppVS, toResolve[i].pid, "solution=" + (tracked.solutionPath.empty() ? std::string("<none>") : tracked.solutionPath));
+                }
+            }
+        }
+
+        // 5. Publish the tracked state (sorted by pid for a stable UI order)
+        auto snapshot = std::make_shared<RefreshSnapshot>();
+        g_tracked.ForEach([&](const ProcessEnum::ProcessKey& key, TrackedProcess& tracked) {
+            switch (tracked.kind)
+            {
+            case kAppVS:
             {
-                g_feishuPath = foundFeishuPath;
+                VSInstance inst;
+                inst.pid = key.pid;
+                inst.exePath = tracked.exePath;
+                inst.windowTitle = tracked.windowTitle;
+                inst.solutionPath = tracked.solutionPath;
+                snapshot->vsInstances.push_back(std::move(inst));
+                break;
+            }
+            case kAppCursor:
+            {
+                CursorInstance cinst;
+                cinst.pid = key.pid;
+                cinst.exePath = tracked.exePath;
+                cinst.windowTitle = tracked.windowTitle;
+                snapshot->cursorInstances.push_back(std::move(cinst));
+                break;
+            }
+            case kAppFeishu:
+                snapshot->feishuPath = tracked.exePath;
+                snapshot->feishuRunning = true;
+                break;
+            case kAppWechat:
+                // 优先使用微信主程序路径
+                snapshot->wechatPath = tracked.exePath;
+                snapshot->wechatRunning = true;
+                break;
+            case kAppWechatHelper:
+                snapshot->wechatRunning = true;
+                break;
+            default:
+                break;
             }
-            g_feishuRunning = foundFeishuRunning;
-            // 微信路径不自动更新，只有用户手动勾选时才保存
-            // if (foundWechatRunning)
-            // {
-            //     g_wechatPath = foundWechatPath;
-            // }
-            g_wechatRunning = foundWechatRunning;
-            g_currentWechatPath = foundWechatPath;  // 更新当前检测到的路径
+        });
+        std::sort(snapshot->vsInstances.begin(), snapshot->vsInstances.end(), [](const VSInstance& a, const VSInstance& b) { return a.pid < b.pid; });
+        std::sort(snapshot->cursorInstances.begin(), snapshot->cursorInstances.end(), [](const CursorInstance& a, const CursorInstance& b) { return a.pid < b.pid; });
+        AssignCursorFolders(snapshot->cursorInstances);
+
+        std::vector<ProcessEnum::ProcessKey> sampled;
+        g_tracked.ForEach([&](const ProcessEnum::ProcessKey& key, TrackedProcess& tracked) {
+            if (tracked.kind == kAppVS || tracked.kind == kAppCursor) sampled.push_back(key);
+        });
+        ProcessSampler::SetWatched(sampled);
+        snapshot->recentEvents.assign(g_recentEvents.begin(), g_recentEvents.end());
+        return snapshot;
+    }
+
+    static void RefreshThreadStart()
+    {
+        HRESULT hr = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
+        g_refreshCoInit = SUCCEEDED(hr);
+        AppendLog(std::string("[vs] CoInitializeEx hr=") + std::to_string((long)hr) + std::string(" didCoInit=") + (g_refreshCoInit?"true":"false"));
+    }
+
+    static void RefreshThreadExit()
+    {
+        if (g_refreshCoInit) CoUninitialize();
+        g_refreshCoInit = false;
+    }
+
+    // UI thread: switch to the newest published snapshot (once per frame)
+    static void AdoptLatestSnapshot()
+    {
+        uint64_t generation = g_refreshWorker.Generation();
+        if (g_view && generation == g_viewGeneration) return;
+        std::shared_ptr<const RefreshSnapshot> latest = g_refreshWorker.Latest();
+        if (!latest) return;
+        g_viewGeneration = generation;
+        // 只有在检测到飞书运行时才更新路径，避免覆盖已保存的路径
+        // 微信路径不自动更新，只有用户手动勾选时才保存
+        if (latest->feishuRunning)
+        {
+            g_feishuPath = latest->feishuPath;
+        }
+        g_view = std::move(latest);
+    }
+
+    static const RefreshSnapshot& View()
+    {
+        static const RefreshSnapshot empty;
+        return g_view ? *g_view : empty;
+    }
+
+    void Refresh()
+    {
+        // System resource history is sampled on its own thread
+        SystemSampler::Start();
+        ProcessSampler::Start();
+
+        // Load persisted prefs once per refresh to show defaults
+        if (g_selectedSlnPath.empty() && g_selectedCursorFolder.empty())
+        {
+            LoadPrefs();
         }
-        // VS实例刷新结束日志已删除
-        // Cursor实例刷新结束日志已删除
-        // 飞书状态日志已删除
-        // 微信状态日志已删除
-        for (const auto& inst : g_vsList)
+
+        g_refreshWorker.SetProbe(ProbeRunningApps, RefreshThreadStart, RefreshThreadExit);
+        if (!g_refreshWorker.Request())
         {
-            // VS实例汇总日志已删除
+            AppendLog("[vs] refresh already in flight, request dropped");
         }
     }
 
+    void Cleanup()
+    {
+        SystemSampler::Stop();
+        ProcessSampler::Stop();
+        LaunchScheduler::Shutdown();
+        g_refreshWorker.Stop();
+        FlushPrefs(true);
+        FileWatcher::Unwatch(g_prefsWatch);
+        g_prefsWatch = 0;
+        // Not watched while unloaded: read the file again when the feature comes back
+        g_prefsLoaded = false;
+
+        // Release prefs / snapshot state; everything is rebuilt by LoadPrefs and the next refresh
+        g_configs.Assign({});
+        g_prefsBase.clear();
+        g_prefsDirty = false;
+        g_prefsPendingSaves = 0;
+        g_selectedSlnPath.clear();
+        g_selectedSlnPaths.clear();
+        g_selectedCursorFolder.clear();
+        g_selectedCursorFolders.clear();
+        g_currentConfigName.clear();
+        g_feishuPath.clear();
+        g_wechatPath.clear();
+        g_pendingDeleteConfig.clear();
+        g_configListView = ConfigListView();
+        g_refreshWorker.ClearLatest(); // otherwise AdoptLatestSnapshot re-adopts stale instances
+        g_view.reset();
+        g_viewGeneration = 0;
+        // The refresh worker is stopped above, so its caches are safe to drop here
+        g_cursorStorage = CursorStorageCache();
+        g_tracked = ProcessEnum::InstanceTracker<TrackedProcess>();
+        g_recentEvents.clear();
+        g_recentEvents.shrink_to_fit();
+    }
+
+    void Initialize()
+    {
+        EnsurePrefsLoaded();
+    }
+
     void DrawVSUI()
     {
         // Ensure preferences are loaded on first UI draw
         EnsurePrefsLoaded();
+        // Initialize() runs on a worker; the watch is created here, on the UI thread
+        if (g_prefsWatch == 0) g_prefsWatch = FileWatcher::Watch(GetPrefsJsonFile(), OnPrefsChanged);
+        AdoptLatestSnapshot();
+        FlushPrefs(false);
         
         // 启动动画逻辑
         float currentTime = ImGui::GetTime();
@@ -2591,7 +2491,7 @@ namespace VSInspector
         ImGui::SameLine();
         ImGui::SetCursorPosX(ImGui::GetWindowWidth() * 0.7f);
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "VS: %d | Cursor: %d | Configs: %d", 
-                          (int)g_vsList.size(), (int)g_cursorList.size(), (int)g_savedConfigs.size());
+                          (int)View().vsInstances.size(), (int)View().cursorInstances.size(), (int)g_configs.Size());
         
         ImGui::EndChild();
         ImGui::PopStyleColor();
@@ -2605,6 +2505,11 @@ namespace VSInspector
             Refresh();
             g_lastRefreshTime = currentTime; // 更新最后刷新时间
         }
+        if (g_refreshWorker.InFlight())
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("刷新中...");
+        }
         ImGui::SameLine();
         if (ImGui::Checkbox("Auto Refresh", &g_autoRefreshEnabled))
         {
@@ -2657,32 +2562,30 @@ namespace VSInspector
         
         // 移除左侧的系统资源监控，将移到下方
         
-        std::vector<VSInstance> local;
-        std::vector<CursorInstance> localCursor;
-        std::string localFeishuPath;
-        bool localFeishuRunning;
-        std::string localWechatPath;
-        bool localWechatRunning;
-        std::string localCurrentWechatPath;
-        {
-            std::lock_guard<std::mutex> lock(g_vsMutexVS);
-            local = g_vsList;
-            localCursor = g_cursorList;
-            localFeishuPath = g_feishuPath;
-            localFeishuRunning = g_feishuRunning;
-            localWechatPath = g_wechatPath;
-            localWechatRunning = g_wechatRunning;
-            localCurrentWechatPath = g_currentWechatPath;
-        }
+        // g_view only changes in AdoptLatestSnapshot() at the top of the frame, so no copy/lock here
+        const RefreshSnapshot& view = View();
+        const std::vector<VSInstance>& local = view.vsInstances;
+        const std::vector<CursorInstance>& localCursor = view.cursorInstances;
+        std::string localFeishuPath = g_feishuPath;
+        bool localFeishuRunning = view.feishuRunning;
+        bool localWechatRunning = view.wechatRunning;
+        const std::string& localCurrentWechatPath = view.wechatPath;
         
         // VS Instances
         if (!local.empty())
         {
             ImGui::TextColored(ImVec4(0.6f, 0.8f, 1.0f, 1.0f), "Visual Studio (%d)", (int)local.size());
-            for (const auto& inst : local)
+            ImGui::SameLine();
+            static const char* sortNames[] = { "PID", "CPU", "Memory", "I/O" };
+            ImGui::SetNextItemWidth(100.0f);
+            if (ImGui::Combo("Sort##vs_sort", &g_instanceSort, sortNames, 4))
+                g_instanceSortAscending = (g_instanceSort == kSortPid);
+            for (const VSInstance* instPtr : SortedInstances(local))
             {
+                const VSInstance& inst = *instPtr;
                 ImGui::BeginGroup();
                 ImGui::Text("[PID] %lu", (unsigned long)inst.pid);
+                DrawInstanceLoad(inst.pid);
                 if (!inst.windowTitle.empty())
                 {
                     ImGui::TextWrapped("[Title] %s", inst.windowTitle.c_str());
@@ -2738,16 +2641,29 @@ namespace VSInspector
             for (const auto& c : localCursor) { if (!c.folderPath.empty()) ++validCursorCount; }
             ImGui::TextColored(ImVec4(0.6f, 0.8f, 1.0f, 1.0f), "Cursor (%d)", validCursorCount);
             ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_NoHostExtendX;
-            if (ImGui::BeginTable("cursor_table", 4, flags))
-            {
-                ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_WidthFixed, 80.0f);
-                ImGui::TableSetupColumn("Title", ImGuiTableColumnFlags_WidthStretch, 2.0f);
-                ImGui::TableSetupColumn("Path", ImGuiTableColumnFlags_WidthStretch, 2.5f);
-                ImGui::TableSetupColumn("Action", ImGuiTableColumnFlags_WidthFixed, 130.0f);
+            if (ImGui::BeginTable("cursor_table", 6, flags | ImGuiTableFlags_Sortable))
+            {
+                ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort, 80.0f, kSortPid);
+                ImGui::TableSetupColumn("CPU", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 110.0f, kSortCpu);
+                ImGui::TableSetupColumn("Memory", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 80.0f, kSortMemory);
+                ImGui::TableSetupColumn("Title", ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_NoSort, 2.0f);
+                ImGui::TableSetupColumn("Path", ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_NoSort, 2.5f);
+                ImGui::TableSetupColumn("Action", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoSort, 130.0f);
                 ImGui::TableHeadersRow();
 
-                for (const auto& c : localCursor)
+                if (ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs())
+                {
+                    if (specs->SpecsDirty && specs->SpecsCount > 0)
+                    {
+                        g_instanceSort = (int)specs->Specs[0].ColumnUserID;
+                        g_instanceSortAscending = specs->Specs[0].SortDirection == ImGuiSortDirection_Ascending;
+                    }
+                    specs->SpecsDirty = false;
+                }
+
+                for (const CursorInstance* cPtr : SortedInstances(localCursor))
                 {
+                    const CursorInstance& c = *cPtr;
                     if (c.folderPath.empty()) continue;
                     ImGui::TableNextRow();
 
@@ -2755,16 +2671,31 @@ namespace VSInspector
                     ImGui::TableSetColumnIndex(0);
                     ImGui::Text("%lu", (unsigned long)c.pid);
 
-                    // Title
+                    // CPU / Memory (sampled off the UI thread)
+                    std::shared_ptr<const ProcessSampler::History> load = ProcessSampler::Find(c.pid);
                     ImGui::TableSetColumnIndex(1);
+                    if (load && load->cpu.Count() > 0)
+                    {
+                        ImGui::Text("%.1f%%", load->cpu.Latest());
+                        DrawSparkline(load->cpu, ProcessSampler::kHistorySamples, 0.0f, IM_COL32(0, 255, 128, 200), ImGui::GetTextLineHeight());
+                    }
+                    else
+                    {
+                        ImGui::TextDisabled("-");
+                    }
+                    ImGui::TableSetColumnIndex(2);
+                    if (load && load->workingSet.Count() > 0) ImGui::Text("%.0f MB", load->workingSet.Latest()); else ImGui::TextDisabled("-");
+
+                    // Title
+                    ImGui::TableSetColumnIndex(3);
                     if (!c.windowTitle.empty()) ImGui::TextWrapped("%s", c.windowTitle.c_str()); else ImGui::TextDisabled("<none>");
 
                     // Path
-                    ImGui::TableSetColumnIndex(2);
+                    ImGui::TableSetColumnIndex(4);
                     ImGui::TextWrapped("%s", c.folderPath.c_str());
 
                     // Action
-                    ImGui::TableSetColumnIndex(3);
+                    ImGui::TableSetColumnIndex(5);
                     bool isSelected = (g_selectedCursorFolders.find(c.folderPath) != g_selectedCursorFolders.end());
                     const char* label = isSelected ? "[Deselect]" : "[Select]";
                     if (ImGui::SmallButton((std::string(label) + "##" + std::to_string((unsigned long)c.pid)).c_str()))
@@ -2975,6 +2906,13 @@ namespace VSInspector
         {
             LaunchWechat();
         }
+
+        // Everything selected above in one go; launches run on the scheduler's workers
+        if (ImGui::Button("[Restore All]"))
+        {
+            RestoreEnvironment();
+        }
+        DrawLaunchStatus();
         
                  // Third column (only in wide layout): Configuration Management
          if (useWideLayout)
@@ -3004,15 +2942,7 @@ namespace VSInspector
              ImGui::InputText("Config Name", g_mainConfigNameBuf, sizeof(g_mainConfigNameBuf));
              
              // 根据是否已存在配置来决定按钮文本和行为
-             bool configExists = false;
-             for (const auto& cfg : g_savedConfigs)
-             {
-                 if (cfg.name == g_mainConfigNameBuf)
-                 {
-                     configExists = true;
-                     break;
-                 }
-             }
+             bool configExists = g_configs.Find(g_mainConfigNameBuf) != nullptr;
              
              const char* buttonText = configExists ? "[Update Existing Config]" : "[Save Current as New Config]";
              if (ImGui::Button(buttonText))
@@ -3035,104 +2965,8 @@ namespace VSInspector
              
              ImGui::Spacing();
              
-             // Load existing configurations (sorted by lastUsedAt desc, then createdAt desc)
-             if (!g_savedConfigs.empty())
-             {
-                 ImGui::TextColored(ImVec4(0.6f, 0.8f, 1.0f, 1.0f), "[Saved Configurations]");
-                 
-                 // 创建可滚动的配置列表区域，使用剩余空间，自定义滚动条样式
-                 ImGui::PushStyleVar(ImGuiStyleVar_ScrollbarSize, 8.0f); // 设置滚动条宽度为8像素
-                 ImGui::PushStyleColor(ImGuiCol_ScrollbarBg, ImVec4(0.1f, 0.1f, 0.1f, 0.6f)); // 滚动条背景色
-                 ImGui::PushStyleColor(ImGuiCol_ScrollbarGrab, ImVec4(0.3f, 0.3f, 0.3f, 0.8f)); // 滚动条抓取器颜色
-                 ImGui::PushStyleColor(ImGuiCol_ScrollbarGrabHovered, ImVec4(0.4f, 0.4f, 0.4f, 0.9f)); // 悬停时颜色
-                 ImGui::PushStyleColor(ImGuiCol_ScrollbarGrabActive, ImVec4(0.5f, 0.5f, 0.5f, 1.0f)); // 激活时颜色
-                 
-                 ImGui::BeginChild("ConfigList", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
-                 
-                 std::vector<SavedConfig> sorted = g_savedConfigs;
-                 std::sort(sorted.begin(), sorted.end(), [](const SavedConfig& a, const SavedConfig& b){
-                     if (a.lastUsedAt != b.lastUsedAt) return a.lastUsedAt > b.lastUsedAt;
-                     return a.createdAt > b.createdAt;
-                 });
-                 for (const auto& config : sorted)
-                 {
-                     ImGui::BeginGroup();
-                     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.2f, 1.0f)); // 亮橙色
-                     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(8, 4));
-                     ImGui::Text(" [Config] %s", config.name.c_str());
-                     ImGui::PopStyleVar();
-                     ImGui::PopStyleColor();
-                     if (!config.vsSolutionPath.empty())
-                         ImGui::TextWrapped("VS: %s", config.vsSolutionPath.c_str());
-                     if (!config.cursorFolderPath.empty())
-                         ImGui::TextWrapped("Cursor: %s", config.cursorFolderPath.c_str());
-                     if (!config.feishuPath.empty())
-                         ImGui::TextWrapped("Feishu: %s", config.feishuPath.c_str());
-                     if (!config.wechatPath.empty())
-                         ImGui::TextWrapped("WeChat: %s", config.wechatPath.c_str());
-                     
-                     if (ImGui::Button(("[Load]##" + config.name).c_str()))
-                     {
-                         // Update last used timestamp then load
-                         for (auto &cfg : g_savedConfigs) { if (cfg.name == config.name) { cfg.lastUsedAt = (unsigned long long)time(nullptr); break; } }
-                         SavePrefs();
-                         LoadConfig(config.name);
-                     }
-                     ImGui::SameLine();
-                     if (ImGui::Button(("[Edit]##" + config.name).c_str()))
-                     {
-                         // 直接将配置名称填入到主界面的 Config Name 输入框
-                         memset(g_mainConfigNameBuf, 0, sizeof(g_mainConfigNameBuf));
-                         strncpy(g_mainConfigNameBuf, config.name.c_str(), sizeof(g_mainConfigNameBuf) - 1);
-                         g_currentConfigName = config.name;
-                         
-                         // 加载配置到当前选择
-                         LoadConfig(config.name);
-                     }
-                    ImGui::SameLine();
-                    if (ImGui::Button(("[Delete]##" + config.name).c_str()))
-                    {
-                        // 显示确认对话框
-                        ImGui::OpenPopup(("Confirm Delete##" + config.name).c_str());
-                    }
-                    
-                    // 确认删除弹窗
-                    if (ImGui::BeginPopupModal(("Confirm Delete##" + config.name).c_str(), NULL, ImGuiWindowFlags_AlwaysAutoResize))
-                    {
-                        ImGui::Text("Are you sure you want to delete configuration '%s'?", config.name.c_str());
-                        ImGui::Text("This action cannot be undone.");
-                        ImGui::Separator();
-                        
-                        if (ImGui::Button("Yes, Delete", ImVec2(120, 0)))
-                        {
-                            DeleteConfig(config.name);
-                            ImGui::CloseCurrentPopup();
-                            // 强制UI更新
-                            ImGui::SetWindowFocus();
-                        }
-                        ImGui::SetItemDefaultFocus();
-                        ImGui::SameLine();
-                        if (ImGui::Button("Cancel", ImVec2(120, 0)))
-                        {
-                            ImGui::CloseCurrentPopup();
-                        }
-                        ImGui::EndPopup();
-                    }
-                    ImGui::EndGroup();
-                    ImGui::Spacing();
-                }
-                
-                                 // 结束可滚动的配置列表区域
-                 ImGui::EndChild();
-                 
-                 // 恢复滚动条样式
-                 ImGui::PopStyleColor(4); // 弹出4个颜色样式
-                 ImGui::PopStyleVar(); // 弹出滚动条大小样式
-            }
-            else
-            {
-                ImGui::TextDisabled("No saved configurations");
-            }
+             // Load existing configurations (most recently used first)
+             DrawSavedConfigList(0.0f);
         }
         else
         {
@@ -3151,15 +2985,7 @@ namespace VSInspector
             ImGui::InputText("Config Name", g_mainConfigNameBuf, sizeof(g_mainConfigNameBuf));
             
             // 根据是否已存在配置来决定按钮文本和行为
-            bool configExists = false;
-            for (const auto& cfg : g_savedConfigs)
-            {
-                if (cfg.name == g_mainConfigNameBuf)
-                {
-                    configExists = true;
-                    break;
-                }
-            }
+            bool configExists = g_configs.Find(g_mainConfigNameBuf) != nullptr;
             
             const char* buttonText = configExists ? "[Update Existing Config]" : "[Save Current as New Config]";
             if (ImGui::Button(buttonText))
@@ -3182,85 +3008,8 @@ namespace VSInspector
             
             ImGui::Spacing();
             
-            // Load existing configurations (sorted by lastUsedAt desc, then createdAt desc)
-            if (!g_savedConfigs.empty())
-            {
-                ImGui::TextColored(ImVec4(0.6f, 0.8f, 1.0f, 1.0f), "[Saved Configurations]");
-                std::vector<SavedConfig> sorted = g_savedConfigs;
-                std::sort(sorted.begin(), sorted.end(), [](const SavedConfig& a, const SavedConfig& b){
-                    if (a.lastUsedAt != b.lastUsedAt) return a.lastUsedAt > b.lastUsedAt;
-                    return a.createdAt > b.createdAt;
-                });
-                for (const auto& config : sorted)
-                {
-                    ImGui::BeginGroup();
-                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.2f, 1.0f)); // 亮橙色
-                    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(8, 4));
-                    ImGui::Text(" [Config] %s", config.name.c_str());
-                    ImGui::PopStyleVar();
-                    ImGui::PopStyleColor();
-                    if (!config.vsSolutionPath.empty())
-                        ImGui::TextWrapped("VS: %s", config.vsSolutionPath.c_str());
-                    if (!config.cursorFolderPath.empty())
-                        ImGui::TextWrapped("Cursor: %s", config.cursorFolderPath.c_str());
-                    if (!config.feishuPath.empty())
-                        ImGui::TextWrapped("Feishu: %s", config.feishuPath.c_str());
-                    
-                    if (ImGui::Button(("[Load]##" + config.name).c_str()))
-                    {
-                        // Update last used timestamp then load
-                        for (auto &cfg : g_savedConfigs) { if (cfg.name == config.name) { cfg.lastUsedAt = (unsigned long long)time(nullptr); break; } }
-                        SavePrefs();
-                        LoadConfig(config.name);
-                    }
-                    ImGui::SameLine();
-                                         if (ImGui::Button(("[Edit]##" + config.name).c_str()))
-                     {
-                         // 直接将配置名称填入到主界面的 Config Name 输入框
-                         memset(g_mainConfigNameBuf, 0, sizeof(g_mainConfigNameBuf));
-                         strncpy(g_mainConfigNameBuf, config.name.c_str(), sizeof(g_mainConfigNameBuf) - 1);
-                         g_currentConfigName = config.name;
-                         
-                         // 加载配置到当前选择
-                         LoadConfig(config.name);
-                     }
-                    ImGui::SameLine();
-                    if (ImGui::Button(("[Delete]##" + config.name).c_str()))
-                    {
-                        // 显示确认对话框
-                        ImGui::OpenPopup(("Confirm Delete##" + config.name).c_str());
-                    }
-                    
-                    // 确认删除弹窗
-                    if (ImGui::BeginPopupModal(("Confirm Delete##" + config.name).c_str(), NULL, ImGuiWindowFlags_AlwaysAutoResize))
-                    {
-                        ImGui::Text("Are you sure you want to delete configuration '%s'?", config.name.c_str());
-                        ImGui::Text("This action cannot be undone.");
-                        ImGui::Separator();
-                        
-                        if (ImGui::Button("Yes, Delete", ImVec2(120, 0)))
-                        {
-                            DeleteConfig(config.name);
-                            ImGui::CloseCurrentPopup();
-                            // 强制UI更新
-                            ImGui::SetWindowFocus();
-                        }
-                        ImGui::SetItemDefaultFocus();
-                        ImGui::SameLine();
-                        if (ImGui::Button("Cancel", ImVec2(120, 0)))
-                        {
-                            ImGui::CloseCurrentPopup();
-                        }
-                        ImGui::EndPopup();
-                    }
-                    ImGui::EndGroup();
-                    ImGui::Spacing();
-                }
-            }
-            else
-            {
-                ImGui::TextDisabled("No saved configurations");
-            }
+            // Load existing configurations (most recently used first)
+            DrawSavedConfigList(ImGui::GetFrameHeightWithSpacing() * 10.0f);
         }
         
         
@@ -3276,6 +3025,17 @@ namespace VSInspector
         ImGui::Text("📊 SYSTEM RESOURCES MONITOR");
         ImGui::PopStyleColor();
         
+        ImGui::SameLine();
+        ImGui::TextDisabled("  history:");
+        static const char* spanLabels[] = { "1m", "5m", "1h" };
+        for (int i = 0; i < 3; ++i)
+        {
+            ImGui::SameLine();
+            if (ImGui::RadioButton(spanLabels[i], g_resourceSpanIndex == i)) g_resourceSpanIndex = i;
+        }
+        const size_t span = (size_t)g_resourceSpans[g_resourceSpanIndex];
+        const SystemSampler::Totals totals = SystemSampler::Latest();
+
         // 创建两列布局显示系统资源
         ImGui::Columns(2, "SystemResources", true);
         ImGui::SetColumnWidth(0, ImGui::GetWindowWidth() * 0.5f);
@@ -3284,49 +3044,82 @@ namespace VSInspector
         // 左列：系统资源
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "CPU:");
         ImGui::SameLine();
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%.1f%%", g_systemResources.cpuUsage);
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%.1f%%", SystemSampler::Cpu().Latest());
+        DrawSparkline(SystemSampler::Cpu(), span, 100.0f, IM_COL32(0, 255, 128, 200), 28.0f);
+
+        // 每个核心的当前占用（最近 kCoreHistorySeconds 秒保留历史）
+        if (SystemSampler::CoreCount() > 0)
+        {
+            const size_t cores = SystemSampler::CoreCount();
+            const float cellW = std::max(6.0f, std::min(18.0f, ImGui::GetContentRegionAvail().x / (float)cores - 1.0f));
+            const float cellH = 14.0f;
+            ImVec2 origin = ImGui::GetCursorScreenPos();
+            ImDrawList* dl = ImGui::GetWindowDrawList();
+            for (size_t i = 0; i < cores; ++i)
+            {
+                float pct = std::min(100.0f, SystemSampler::Core(i).Latest()) / 100.0f;
+                ImVec2 a(origin.x + (float)i * (cellW + 1.0f), origin.y);
+                dl->AddRectFilled(a, ImVec2(a.x + cellW, a.y + cellH), IM_COL32(15, 20, 28, 255));
+                dl->AddRectFilled(ImVec2(a.x, a.y + cellH * (1.0f - pct)), ImVec2(a.x + cellW, a.y + cellH), IM_COL32(0, 200, 255, 220));
+            }
+            ImGui::Dummy(ImVec2((float)cores * (cellW + 1.0f), cellH));
+            if (ImGui::IsItemHovered()) ImGui::SetTooltip("%d logical cores", (int)cores);
+        }
         
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "Memory:");
         ImGui::SameLine();
-        float memoryUsagePercent = g_systemResources.totalMemory > 0 ? 
-            (float)g_systemResources.usedMemory / g_systemResources.totalMemory * 100.0f : 0.0f;
         ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%.1f%% (%.1fGB/%.1fGB)", 
-                          memoryUsagePercent,
-                          g_systemResources.usedMemory / (1024.0f * 1024.0f * 1024.0f),
-                          g_systemResources.totalMemory / (1024.0f * 1024.0f * 1024.0f));
+                          SystemSampler::Memory().Latest(),
+                          totals.memUsed / (1024.0f * 1024.0f * 1024.0f),
+                          totals.memTotal / (1024.0f * 1024.0f * 1024.0f));
+        DrawSparkline(SystemSampler::Memory(), span, 100.0f, IM_COL32(255, 200, 0, 200), 20.0f);
         
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "Disk C:");
         ImGui::SameLine();
-        float diskUsagePercent = g_systemResources.totalDisk > 0 ? 
-            (float)(g_systemResources.totalDisk - g_systemResources.freeDisk) / g_systemResources.totalDisk * 100.0f : 0.0f;
+        float diskUsagePercent = totals.diskTotal > 0 ? 
+            (float)(totals.diskTotal - totals.diskFree) / totals.diskTotal * 100.0f : 0.0f;
         ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%.1f%% (%.1fGB/%.1fGB)", 
                           diskUsagePercent,
-                          (g_systemResources.totalDisk - g_systemResources.freeDisk) / (1024.0f * 1024.0f * 1024.0f),
-                          g_systemResources.totalDisk / (1024.0f * 1024.0f * 1024.0f));
+                          (totals.diskTotal - totals.diskFree) / (1024.0f * 1024.0f * 1024.0f),
+                          totals.diskTotal / (1024.0f * 1024.0f * 1024.0f));
+        if (totals.diskIoAvailable)
+        {
+            ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "I/O:");
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "R %s  W %s",
+                               FormatRate(SystemSampler::DiskRead().Latest()).c_str(),
+                               FormatRate(SystemSampler::DiskWrite().Latest()).c_str());
+            float readPeak = DrawSparkline(SystemSampler::DiskRead(), span, 0.0f, IM_COL32(0, 160, 255, 200), 16.0f);
+            float writePeak = DrawSparkline(SystemSampler::DiskWrite(), span, 0.0f, IM_COL32(255, 80, 80, 200), 16.0f);
+            ImGui::TextDisabled("peak R %s / W %s, sampler %.2f ms/s", FormatRate(readPeak).c_str(), FormatRate(writePeak).c_str(), totals.sampleMs);
+        }
+        const ProcessSampler::Stats procStats = ProcessSampler::GetStats();
+        ImGui::TextDisabled("per-instance sampler: %d watched, %.2f ms/pass (budget %.0f ms), %llu deferred",
+                            (int)procStats.watched, procStats.lastPassMs, ProcessSampler::kPassBudgetMs, (unsigned long long)procStats.deferred);
         
         // 右列：应用状态和系统信息
         ImGui::NextColumn();
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "Uptime:");
         ImGui::SameLine();
-        unsigned long long hours = g_systemResources.uptime / 3600;
-        unsigned long long minutes = (g_systemResources.uptime % 3600) / 60;
+        unsigned long long hours = totals.uptimeSeconds / 3600;
+        unsigned long long minutes = (totals.uptimeSeconds % 3600) / 60;
         ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%llu:%02llu", hours, minutes);
         
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "VS:");
         ImGui::SameLine();
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%d running", (int)g_vsList.size());
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%d running", (int)View().vsInstances.size());
         
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "Cursor:");
         ImGui::SameLine();
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%d running", (int)g_cursorList.size());
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%d running", (int)View().cursorInstances.size());
         
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "Feishu:");
         ImGui::SameLine();
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%s", g_feishuRunning ? "ONLINE" : "OFFLINE");
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%s", View().feishuRunning ? "ONLINE" : "OFFLINE");
         
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "WeChat:");
         ImGui::SameLine();
-        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%s", g_wechatRunning ? "ONLINE" : "OFFLINE");
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%s", View().wechatRunning ? "ONLINE" : "OFFLINE");
         
         ImGui::Columns(1);
         ImGui::Spacing();
@@ -3377,7 +3170,7 @@ namespace VSInspector
                 }
                 if (ImGui::Button("Save", ImVec2(120, 0)))
                 {
-                    if (strlen(exportPath) > 0) { SaveConfigsToJsonFile(fs::path(exportPath)); }
+                    if (strlen(exportPath) > 0) { SavePrefs(); WriteConfigsJson(fs::path(exportPath)); }
                     AppendLog(std::string("[prefs] exported to ") + exportPath);
                     ImGui::CloseCurrentPopup();
                 }
@@ -3406,10 +3199,9 @@ namespace VSInspector
                 if (ImGui::Button("Import", ImVec2(120, 0)))
                 {
                     std::vector<SavedConfig> incoming;
-                    std::ifstream ifs(std::string(importPath), std::ios::binary);
-                    if (ifs)
+                    std::string content;
+                    if (Json::ReadFile(fs::path(importPath), content))
                     {
-                        std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
                         if (!ParseConfigsFromJson(content, incoming))
                         {
                             AppendLog("[prefs] import failed: invalid JSON content");
@@ -3418,9 +3210,10 @@ namespace VSInspector
                     else { AppendLog("[prefs] import failed: cannot open file"); }
                     if (!incoming.empty())
                     {
-                        MergeConfigs(g_savedConfigs, incoming);
+                        const ConfigStore::MergeResult merged = g_configs.Merge(incoming);
                         SavePrefs();
-                        AppendLog(std::string("[prefs] imported ") + std::to_string((int)incoming.size()) + " config(s) from " + importPath);
+                        AppendLog(std::string("[prefs] imported ") + std::to_string((int)incoming.size()) + " config(s) from " + importPath +
+                                  " (" + std::to_string(merged.added) + " new, " + std::to_string(merged.updated) + " merged)");
                     }
                     else { AppendLog("[prefs] import found 0 valid configs"); }
                     ImGui::CloseCurrentPopup();
@@ -3436,6 +3229,55 @@ namespace VSInspector
         
         // 移除底部状态栏，已移至顶部
         
+        // Solution lookup strategies: budgets, hit rates, latency (updated by the refresh worker)
+        if (ImGui::CollapsingHeader("[Solution Resolution]"))
+        {
+            if (ImGui::BeginTable("solution_strategies", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+            {
+                ImGui::TableSetupColumn("Strategy");
+                ImGui::TableSetupColumn("Budget ms");
+                ImGui::TableSetupColumn("Runs");
+                ImGui::TableSetupColumn("Found %");
+                ImGui::TableSetupColumn("Cache hits");
+                ImGui::TableSetupColumn("Over / skipped");
+                ImGui::TableSetupColumn("Avg ms");
+                ImGui::TableSetupColumn("Max ms");
+                ImGui::TableHeadersRow();
+                for (const auto& st : SolutionCache::GetStats())
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(SolutionCache::StrategyName(st.strategy));
+                    ImGui::TableNextColumn(); ImGui::Text("%.0f", st.budgetMs);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)st.calls);
+                    ImGui::TableNextColumn(); ImGui::Text("%.0f", st.calls ? 100.0 * st.found / st.calls : 0.0);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)st.cacheHits);
+                    ImGui::TableNextColumn(); ImGui::Text("%llu / %llu", (unsigned long long)st.overBudget, (unsigned long long)st.skipped);
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", st.calls ? st.totalMs / st.calls : 0.0);
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", st.maxMs);
+                }
+                ImGui::EndTable();
+            }
+        }
+
+        // Instance changes reported by the background refresh (newest first)
+        const std::vector<InstanceEvent>& events = View().recentEvents;
+        char eventsHeader[64];
+        snprintf(eventsHeader, sizeof(eventsHeader), "[Instance Events] (%d)###instance_events", (int)events.size());
+        if (ImGui::CollapsingHeader(eventsHeader))
+        {
+            static const char* kKindLabel[] = { "+", "-", "~" };
+            static const ImVec4 kKindColor[] = { ImVec4(0.3f, 1.0f, 0.4f, 1.0f), ImVec4(1.0f, 0.4f, 0.4f, 1.0f), ImVec4(1.0f, 0.8f, 0.3f, 1.0f) };
+            for (auto it = events.rbegin(); it != events.rend(); ++it)
+            {
+                ImGui::TextColored(kKindColor[it->kind], "%s %-11s pid=%lu", kKindLabel[it->kind], AppKindName(it->app), (unsigned long)it->pid);
+                if (!it->detail.empty())
+                {
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("%s", it->detail.c_str());
+                }
+            }
+        }
+
         // Log section (collapsible)
         if (ImGui::CollapsingHeader("[Debug Log]", ImGuiTreeNodeFlags_DefaultOpen))
         {
@@ -3446,6 +3288,8 @@ namespace VSInspector
     }
 #else
     void Refresh() {}
+    void Initialize() {}
+    void Cleanup() {}
     void DrawVSUI()
     {
         ImGui::Begin("Running Visual Studio");
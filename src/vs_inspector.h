@@ -2,9 +2,17 @@
 
 namespace VSInspector
 {
-    // Refresh the list of running Visual Studio instances (Windows only; no-op elsewhere)
+    // Request a refresh of running VS/Cursor/Feishu/WeChat instances (Windows only; no-op elsewhere).
+    // Probing runs on a background worker and the UI picks up the published snapshot on a later
+    // frame; ignored while a refresh is already in flight.
     void Refresh();
 
+    // Load saved prefs/workspace configs (file I/O only, safe on a worker thread)
+    void Initialize();
+
+    // Stop the refresh worker (waits for an in-flight refresh)
+    void Cleanup();
+
     // Draw the Visual Studio inspector UI (shows instances and shared log)
     void DrawVSUI();
 }
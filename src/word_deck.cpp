@@ -0,0 +1,382 @@
+#include "word_deck.h"
+#include "word_reminder_utils.h"
+#include "glyph_cache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string_view>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace WordReminder
+{
+    namespace Decks
+    {
+        static const unsigned char kBom[3] = { 0xEF, 0xBB, 0xBF };
+
+        // 打开并跳过 UTF-8 BOM（若存在）
+        static bool OpenUtf8(const std::string& path, std::ifstream& file)
+        {
+            file.open(fs::u8path(path), std::ios::binary);
+            if (!file.is_open()) return false;
+            char bom[3] = { 0 };
+            file.read(bom, 3);
+            if (!(static_cast<unsigned char>(bom[0]) == kBom[0] && static_cast<unsigned char>(bom[1]) == kBom[1] && static_cast<unsigned char>(bom[2]) == kBom[2]))
+            {
+                // 无BOM，则回退到文件开头
+                file.clear();
+                file.seekg(0, std::ios::beg);
+            }
+            return true;
+        }
+
+        static bool WriteAtomic(const std::string& path, const std::string& content)
+        {
+            const fs::path target = fs::u8path(path);
+            fs::path tmp = target;
+            tmp += ".tmp";
+            {
+                std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) return false;
+                file.write(content.data(), (std::streamsize)content.size());
+                if (!file) return false;
+            }
+            std::error_code ec;
+            fs::rename(tmp, target, ec);
+            if (ec)
+            {
+                fs::remove(tmp, ec);
+                return false;
+            }
+            return true;
+        }
+
+        static time_t ToTime(const std::string& s)
+        {
+            try { return (time_t)std::stoll(s); } catch (...) { return (time_t)std::time(nullptr); }
+        }
+
+        static int ToInt(const std::string& s)
+        {
+            try { return (int)std::stol(s); } catch (...) { return 0; }
+        }
+
+        static bool ToBool(const std::string& s)
+        {
+            return (s == "1" || s == "true" || s == "True" || s == "TRUE");
+        }
+
+        std::vector<DeckInfo> LoadIndex(int& active)
+        {
+            std::vector<DeckInfo> decks;
+            std::string activeName;
+            std::ifstream file;
+            if (OpenUtf8(kIndexFile, file))
+            {
+                std::string line;
+                while (std::getline(file, line))
+                {
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    auto parts = Utils::SplitByUnescapedPipe(line);
+                    // @active|name 记录上次打开的词库；其余每行：name|file|total|mastered|pending|nextDue
+                    if (parts.size() == 2 && parts[0] == "@active")
+                    {
+                        activeName = Utils::UnescapeField(parts[1]);
+                        continue;
+                    }
+                    if (parts.size() < 2) continue;
+                    DeckInfo d;
+                    d.name = Utils::UnescapeField(parts[0]);
+                    d.file = Utils::UnescapeField(parts[1]);
+                    if (d.name.empty() || d.file.empty()) continue;
+                    // 词库名显示在下拉框里，可能来自别的机器
+                    GlyphCache::AddText(d.name);
+                    if (parts.size() >= 6)
+                    {
+                        d.total = ToInt(parts[2]);
+                        d.mastered = ToInt(parts[3]);
+                        d.pending = ToInt(parts[4]);
+                        d.nextDue = ToTime(parts[5]);
+                    }
+                    decks.push_back(d);
+                }
+            }
+            if (decks.empty())
+            {
+                DeckInfo d;
+                d.name = kDefaultDeckName;
+                d.file = kLegacyShard;
+                decks.push_back(d);
+            }
+            active = 0;
+            for (size_t i = 0; i < decks.size(); ++i)
+            {
+                if (decks[i].name == activeName) active = (int)i;
+            }
+            return decks;
+        }
+
+        bool SaveIndex(const std::vector<DeckInfo>& decks, int active)
+        {
+            std::string out(reinterpret_cast<const char*>(kBom), 3);
+            if (active >= 0 && active < (int)decks.size())
+            {
+                out += "@active|" + Utils::EscapeField(decks[active].name) + "\n";
+            }
+            for (const auto& d : decks)
+            {
+                out += Utils::EscapeField(d.name) + "|" + Utils::EscapeField(d.file) + "|" +
+                       std::to_string(d.total) + "|" + std::to_string(d.mastered) + "|" +
+                       std::to_string(d.pending) + "|" + std::to_string((long long)d.nextDue) + "\n";
+            }
+            return WriteAtomic(kIndexFile, out);
+        }
+
+        bool LoadShard(const std::string& path, std::vector<WordEntry>& out)
+        {
+            std::ifstream file;
+            if (!OpenUtf8(path, file)) return false;
+            std::string line;
+            std::string buffer;
+            while (std::getline(file, line))
+            {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!buffer.empty()) buffer += "\n"; // 为兼容旧数据，将换行保留到缓冲区
+                buffer += line;
+
+                // 按未被转义的分隔符分割
+                auto parts = Utils::SplitByUnescapedPipe(buffer);
+                // 旧数据至少包含：word | meaning | pronunciation | remindTime | isActive
+                if (parts.size() < 5)
+                {
+                    // 字段不足，继续读取下一行（说明有未转义的换行打断了记录）
+                    continue;
+                }
+
+                // 解析一个完整记录
+                WordEntry entry;
+                entry.word = Strings::Intern(Utils::UnescapeField(parts[0]));
+                entry.meaning = Strings::Intern(Utils::UnescapeField(parts[1]));
+                entry.pronunciation = Strings::Intern(Utils::UnescapeField(parts[2]));
+                entry.remindTime = std::chrono::system_clock::from_time_t(ToTime(parts[3]));
+                entry.isActive = ToBool(parts[4]);
+
+                bool hasMastered = parts.size() >= 6;
+                bool hasReview = parts.size() >= 7;
+                bool hasLastReview = parts.size() >= 8;
+
+                entry.isMastered = hasMastered ? ToBool(parts[5]) : false;
+                entry.reviewCount = hasReview ? ToInt(parts[6]) : 0;
+                entry.lastReview = std::chrono::system_clock::from_time_t(
+                    hasLastReview ? ToTime(parts[7]) : ToTime(parts[3])
+                );
+
+                out.push_back(entry);
+                buffer.clear();
+            }
+            return true;
+        }
+
+        // 分片里的一行（不含换行）
+        static void AppendRecord(std::string& out, const WordEntry& entry)
+        {
+            out += Utils::EscapeField(Strings::Str(entry.word));
+            out += '|';
+            out += Utils::EscapeField(Strings::Str(entry.meaning));
+            out += '|';
+            out += Utils::EscapeField(Strings::Str(entry.pronunciation));
+            out += '|';
+            out += std::to_string((long long)std::chrono::system_clock::to_time_t(entry.remindTime));
+            out += entry.isActive ? "|1|" : "|0|";
+            out += entry.isMastered ? "1|" : "0|";
+            out += std::to_string(entry.reviewCount);
+            out += '|';
+            out += std::to_string((long long)std::chrono::system_clock::to_time_t(entry.lastReview));
+        }
+
+        bool SaveShard(const std::string& path, const std::vector<WordEntry>& words)
+        {
+            // 写入 BOM 以便在一些编辑器中正确显示
+            std::string out(reinterpret_cast<const char*>(kBom), 3);
+            out.reserve(3 + words.size() * 96);
+            for (const auto& entry : words)
+            {
+                AppendRecord(out, entry);
+                out += '\n';
+            }
+            return WriteAtomic(path, out);
+        }
+
+        // FNV-1a 64
+        static uint64_t Hash(std::string_view data, uint64_t h = 14695981039346656037ull)
+        {
+            for (unsigned char c : data)
+            {
+                h ^= c;
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        static uint64_t RecordHash(const WordEntry& entry)
+        {
+            static std::string line;
+            line.clear();
+            AppendRecord(line, entry);
+            return Hash(line);
+        }
+
+        // 同一个单词出现多次时按出现顺序区分
+        static std::vector<uint64_t> RecordKeys(const std::vector<WordEntry>& words)
+        {
+            std::vector<uint64_t> keys;
+            keys.reserve(words.size());
+            std::unordered_map<uint64_t, uint32_t> seen;
+            for (const auto& entry : words)
+            {
+                const uint64_t wordHash = Hash(Strings::View(entry.word));
+                const uint32_t occurrence = seen[wordHash]++;
+                keys.push_back(Hash(std::string_view(reinterpret_cast<const char*>(&occurrence), sizeof(occurrence)), wordHash));
+            }
+            return keys;
+        }
+
+        Snapshot TakeSnapshot(const std::vector<WordEntry>& words)
+        {
+            Snapshot snapshot;
+            snapshot.reserve(words.size());
+            const std::vector<uint64_t> keys = RecordKeys(words);
+            for (size_t i = 0; i < words.size(); ++i) snapshot[keys[i]] = RecordHash(words[i]);
+            return snapshot;
+        }
+
+        MergeResult Merge(std::vector<WordEntry>& local, const std::vector<WordEntry>& remote,
+                          const Snapshot& base, uint64_t& nextId)
+        {
+            constexpr size_t kMaxConflictWords = 10;
+            MergeResult result;
+            auto conflict = [&result](const WordEntry& entry) {
+                result.conflicts++;
+                if (result.conflictWords.size() < kMaxConflictWords) result.conflictWords.push_back(Strings::Str(entry.word));
+            };
+
+            const std::vector<uint64_t> localKeys = RecordKeys(local);
+            const std::vector<uint64_t> remoteKeys = RecordKeys(remote);
+            std::unordered_map<uint64_t, size_t> remoteIndex;
+            remoteIndex.reserve(remote.size());
+            for (size_t j = 0; j < remote.size(); ++j) remoteIndex[remoteKeys[j]] = j;
+            std::vector<bool> remoteSeen(remote.size(), false);
+            std::vector<bool> removeLocal(local.size(), false);
+
+            for (size_t i = 0; i < local.size(); ++i)
+            {
+                const uint64_t lh = RecordHash(local[i]);
+                auto b = base.find(localKeys[i]);
+                auto r = remoteIndex.find(localKeys[i]);
+                if (r != remoteIndex.end())
+                {
+                    remoteSeen[r->second] = true;
+                    const uint64_t rh = RecordHash(remote[r->second]);
+                    if (lh == rh) continue;
+                    if (b != base.end() && b->second == rh) continue;  // 只有本地改了（还没保存）
+                    if (b != base.end() && b->second == lh)
+                    {
+                        WordEntry& entry = local[i];
+                        const uint64_t id = entry.id;
+                        const uint32_t revision = entry.revision;
+                        entry = remote[r->second];
+                        entry.id = id;
+                        entry.revision = revision + 1;
+                        result.updated++;
+                        result.touchedIds.push_back(id);
+                    }
+                    else
+                    {
+                        conflict(local[i]);
+                    }
+                }
+                else if (b != base.end())
+                {
+                    // 远端删掉了：本地没改过就跟着删
+                    if (b->second == lh)
+                    {
+                        removeLocal[i] = true;
+                        result.removed++;
+                    }
+                    else
+                    {
+                        conflict(local[i]);
+                    }
+                }
+                // 不在 base 里也不在远端：本地新加、还没保存
+            }
+
+            std::vector<WordEntry> added;
+            for (size_t j = 0; j < remote.size(); ++j)
+            {
+                if (remoteSeen[j]) continue;
+                auto b = base.find(remoteKeys[j]);
+                if (b == base.end())
+                {
+                    added.push_back(remote[j]);
+                }
+                else if (b->second != RecordHash(remote[j]))
+                {
+                    // 本地删了、远端改了
+                    conflict(remote[j]);
+                }
+                // 本地删了、远端没改：保留删除
+            }
+
+            if (result.removed > 0)
+            {
+                size_t out = 0;
+                for (size_t i = 0; i < local.size(); ++i)
+                {
+                    if (removeLocal[i]) continue;
+                    if (out != i) local[out] = local[i];
+                    ++out;
+                }
+                local.resize(out);
+            }
+            for (WordEntry& entry : added)
+            {
+                entry.id = ++nextId;
+                result.touchedIds.push_back(entry.id);
+                local.push_back(entry);
+                result.added++;
+            }
+            return result;
+        }
+
+        void Summarize(const std::vector<WordEntry>& words, DeckInfo& info)
+        {
+            info.total = (int)words.size();
+            info.mastered = 0;
+            info.pending = 0;
+            info.nextDue = 0;
+            for (const auto& entry : words)
+            {
+                if (entry.isMastered) info.mastered++;
+                if (!entry.isActive || entry.isMastered) continue;
+                info.pending++;
+                time_t t = std::chrono::system_clock::to_time_t(entry.remindTime);
+                if (info.nextDue == 0 || t < info.nextDue) info.nextDue = t;
+            }
+        }
+
+        std::string NewShardFile(const std::vector<DeckInfo>& decks)
+        {
+            std::set<std::string> used;
+            for (const auto& d : decks) used.insert(d.file);
+            for (int n = 1;; ++n)
+            {
+                std::string file = "word_reminder_deck_" + std::to_string(n) + ".txt";
+                std::error_code ec;
+                if (!used.count(file) && !fs::exists(fs::u8path(file), ec)) return file;
+            }
+        }
+    }
+}
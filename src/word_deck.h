@@ -0,0 +1,67 @@
+#pragma once
+
+#include "word_reminder.h"
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace WordReminder
+{
+    // 词库（deck）存储：每个词库一个分片文件（沿用 word_reminder_data.txt 的行格式），
+    // 外加一个很小的索引文件记录每个词库的摘要。只有打开的词库会加载单词；
+    // 其余词库的统计和最早到期时间都从摘要里读，保存时也只重写打开的那个分片和索引。
+    namespace Decks
+    {
+        // 索引文件；旧版本没有它，此时只有一个指向 kLegacyShard 的默认词库
+        constexpr const char* kIndexFile = "word_reminder_decks.txt";
+        constexpr const char* kLegacyShard = "word_reminder_data.txt";
+        constexpr const char* kDefaultDeckName = "默认词库";
+
+        struct DeckInfo
+        {
+            std::string name;
+            std::string file;      // 分片文件，相对工作目录
+            int total = 0;
+            int mastered = 0;
+            int pending = 0;       // 启用且未掌握
+            time_t nextDue = 0;    // pending 中最早的提醒时间，0 表示没有
+        };
+
+        // 读索引；文件不存在或为空时返回只含默认词库的列表，active 为打开的词库下标
+        std::vector<DeckInfo> LoadIndex(int& active);
+        bool SaveIndex(const std::vector<DeckInfo>& decks, int active);
+
+        // 分片读写（UTF-8，带 BOM），文本进 Strings 文本池。保存先写 .tmp 再改名，写到一半退出也不会留下半个文件
+        bool LoadShard(const std::string& file, std::vector<WordEntry>& out);
+        bool SaveShard(const std::string& file, const std::vector<WordEntry>& words);
+
+        // 分片内容的指纹：记录 key（单词文本 + 同名序号）-> 整条记录的哈希
+        using Snapshot = std::unordered_map<uint64_t, uint64_t>;
+        Snapshot TakeSnapshot(const std::vector<WordEntry>& words);
+
+        struct MergeResult
+        {
+            size_t added = 0;
+            size_t updated = 0;
+            size_t removed = 0;
+            size_t conflicts = 0;                 // 两边都改了同一条：保留本地
+            std::vector<std::string> conflictWords; // 前几个冲突的单词，用于日志
+            std::vector<uint64_t> touchedIds;     // 新增/修改的单词 id
+        };
+
+        // 按记录三方合并：base 是上次读/写分片时的指纹，remote 是分片的新内容。
+        // 只有远端改了的记录才会动 local：本地没改过就采用远端（修改保留 id 并 revision++，
+        // 新增的记录用 ++nextId 编号追加在末尾，保持 id 升序），本地也改过就算冲突、保留本地
+        MergeResult Merge(std::vector<WordEntry>& local, const std::vector<WordEntry>& remote,
+                          const Snapshot& base, uint64_t& nextId);
+
+        // 由单词列表重算摘要（不改 name/file）
+        void Summarize(const std::vector<WordEntry>& words, DeckInfo& info);
+
+        // 新词库的分片文件名，不与已有词库重复
+        std::string NewShardFile(const std::vector<DeckInfo>& decks);
+    }
+}
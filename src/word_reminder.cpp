@@ -1,5 +1,11 @@
 #include "word_reminder.h"
 #include "word_reminder_utils.h"
+#include "word_deck.h"
+#include "review_session.h"
+#include "review_log.h"
+#include "file_watcher.h"
+#include "glyph_cache.h"
+#include "notifier.h"
 #include "imgui.h"
 #include "replace_tool.h"
 #include <string>
@@ -11,6 +17,8 @@
 #include <ctime>
 #include <thread>
 #include <chrono>
+#include <filesystem>
+#include <system_error>
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #ifndef NOMINMAX
@@ -26,24 +34,49 @@
 #pragma comment(lib, "Comdlg32.lib")
 #endif
 #include <algorithm>
+#include <cstring>
 
 namespace WordReminder
 {
     using ReplaceTool::AppendLog;
     
+#ifdef _WIN32
     // 弹幕系统函数声明
     static LRESULT CALLBACK DanmakuWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
     static void CreateDanmakuWindow();
     static void DestroyDanmakuWindow();
     static void StartDanmakuReminder();
     static void StopDanmakuReminder();
+    static void DestroyReminderWindows();
+#endif
     
+    // 到期单词集合：只在单词列表被修改或下一个单词到期时重算，其余时候 RefreshDueSet 是 O(1)。
+    // 集合或其中条目的内容变化时 generation 递增，调用方比较版本号即可，不用逐个比较单词。
+    struct DueItem
+    {
+        uint32_t index;     // words 中的下标，下次修改列表前有效
+        uint64_t id;
+        uint32_t revision;
+    };
+
+    struct DueSet
+    {
+        uint64_t generation = 0;
+        std::vector<DueItem> items;  // 按 words 顺序，也就是 id 升序
+        std::chrono::system_clock::time_point nextChange = std::chrono::system_clock::time_point::min();
+        std::chrono::system_clock::time_point lastRefresh = std::chrono::system_clock::time_point::min();
+        bool dirty = true;
+    };
+
     // 内部状态管理
     struct FeatureState
     {
         bool enabled = true;
         bool windowOpen = true;
-        std::vector<WordEntry> words;
+        std::vector<WordEntry> words;  // 只装打开的词库
+        std::vector<Decks::DeckInfo> decks;
+        int activeDeck = 0;
+        std::vector<time_t> notifiedDeckDue;  // 与 decks 同下标：未打开词库上次通知时的 nextDue
         
         // UI状态
         char newWord[256] = "";
@@ -57,6 +90,12 @@ namespace WordReminder
         bool isEditing = false;
         char editWord[256] = "";
         char editMeaning[512] = "";
+        char newDeckName[64] = "";
+        std::vector<History::Event> pendingEvents;  // 复习模式里已应用、随下次提交写入复习记录
+        Decks::Snapshot shardBase;            // 上次读/写打开的分片时的内容，外部修改据此三方合并
+        FileWatcher::Id shardWatch = 0;
+        std::string syncStatus;               // 最近一次合并外部修改的结果
+        bool savePending = false;             // 分片被外部改过，保存要等合并完再写
         
         // 设置
         bool autoShowReminders = true;
@@ -69,115 +108,190 @@ namespace WordReminder
         int totalWords = 0;
         int reviewedToday = 0;
         int dueWords = 0;
+
+        DueSet due;
+        uint64_t nextWordId = 0;
+        std::vector<uint64_t> notifiedIds;  // 上次检查时已通知过的到期单词 id（升序）
+        uint64_t notifiedGeneration = 0;
         
         FeatureState() {}
     };
     
     static std::unique_ptr<FeatureState> g_state;
-    
-    
 
+    // 修改 words（增删、改提醒时间/掌握状态/内容）后调用
+    static void InvalidateDueSet()
+    {
+        if (g_state) g_state->due.dirty = true;
+    }
+
+    static void RefreshDueSet(std::chrono::system_clock::time_point now)
+    {
+        DueSet& due = g_state->due;
+        // 系统时间被往回调时也重算：已到期的单词可能又变成未到期
+        if (!due.dirty && now < due.nextChange && now >= due.lastRefresh)
+        {
+            due.lastRefresh = now;
+            return;
+        }
+
+        std::vector<DueItem> items;
+        items.reserve(due.items.size() + 8);
+        auto nextChange = std::chrono::system_clock::time_point::max();
+        for (size_t i = 0; i < g_state->words.size(); ++i)
+        {
+            const WordEntry& entry = g_state->words[i];
+            if (!entry.isActive || entry.isMastered) continue;
+            if (entry.remindTime <= now) items.push_back(DueItem{ (uint32_t)i, entry.id, entry.revision });
+            else if (entry.remindTime < nextChange) nextChange = entry.remindTime;
+        }
+        due.dirty = false;
+        due.nextChange = nextChange;
+        due.lastRefresh = now;
+        // 下标会因删除前面的单词而变，不算作变化
+        bool changed = items.size() != due.items.size();
+        for (size_t i = 0; !changed && i < items.size(); ++i)
+        {
+            changed = items[i].id != due.items[i].id || items[i].revision != due.items[i].revision;
+        }
+        due.items.swap(items);
+        if (changed) due.generation++;
+    }
+
+
+    static Decks::DeckInfo& ActiveDeck()
+    {
+        return g_state->decks[g_state->activeDeck];
+    }
+
+    static void WatchActiveShard();
+    static bool MergeShardFromDisk();
 
-    // 保存单词到文件 (UTF-8)
-    void SaveWords()
+    // 保存打开的词库分片，并刷新它在索引里的摘要（其余词库的分片不动）。
+    // 分片在上次读/写之后被外部改过时不能直接覆盖：平时先不写，等 FileWatcher 回调在 Pump 里
+    // 合并完再写（界面循环里可能还拿着单词的引用，这里不能改动 words）；之后不会再有 Pump 的
+    // 场合（退出、切换/导出词库）传 mergeNow，当场合并后再写
+    bool SaveWords(bool mergeNow = false)
     {
-        std::ofstream file("word_reminder_data.txt", std::ios::binary);
-        if (file.is_open())
+        if (FileWatcher::ChangedSinceSync(g_state->shardWatch))
         {
-            // 写入 BOM 以便在一些编辑器中正确显示
-            const unsigned char bom[3] = {0xEF, 0xBB, 0xBF};
-            file.write(reinterpret_cast<const char*>(bom), 3);
-            for (const auto& entry : g_state->words)
+            if (!mergeNow)
             {
-                file << Utils::EscapeField(entry.word) << "|"
-                     << Utils::EscapeField(entry.meaning) << "|"
-                     << Utils::EscapeField(entry.pronunciation) << "|"
-                     << std::chrono::system_clock::to_time_t(entry.remindTime) << "|"
-                     << entry.isActive << "|"
-                     << entry.isMastered << "|"
-                     << entry.reviewCount << "|"
-                     << std::chrono::system_clock::to_time_t(entry.lastReview) << "\n";
+                g_state->savePending = true;
+                return true;
             }
-            file.close();
+            MergeShardFromDisk();
+        }
+        g_state->savePending = false;
+        Decks::DeckInfo& deck = ActiveDeck();
+        if (!Decks::SaveShard(deck.file, g_state->words))
+        {
+            AppendLog("[词库] 保存失败: " + deck.file);
+            return false;
+        }
+        g_state->shardBase = Decks::TakeSnapshot(g_state->words);
+        FileWatcher::MarkSynced(g_state->shardWatch);
+        Decks::Summarize(g_state->words, deck);
+        Decks::SaveIndex(g_state->decks, g_state->activeDeck);
+        if (size_t freed = Strings::CompactIfNeeded(g_state->words))
+        {
+            AppendLog("[词库] 文本池整理: 回收 " + std::to_string(freed) + " 字节, 剩余 " + std::to_string(Strings::Count()) + " 条");
         }
+        return true;
     }
     
-    // 从文件加载单词 (UTF-8)
+    // 加载打开的词库分片 (UTF-8)，追加到 words
     void LoadWords()
     {
-        std::ifstream file("word_reminder_data.txt", std::ios::binary);
-        if (file.is_open())
+        const size_t first = g_state->words.size();
+        Decks::LoadShard(ActiveDeck().file, g_state->words);
+        for (size_t i = first; i < g_state->words.size(); ++i)
         {
-            std::string line;
-            // 跳过 UTF-8 BOM（若存在）
-            char bom[3] = {0};
-            file.read(bom, 3);
-            if (!(static_cast<unsigned char>(bom[0]) == 0xEF && static_cast<unsigned char>(bom[1]) == 0xBB && static_cast<unsigned char>(bom[2]) == 0xBF))
-            {
-                // 无BOM，则回退到文件开头
-                file.clear();
-                file.seekg(0, std::ios::beg);
-            }
-            std::string buffer;
-            while (std::getline(file, line))
-            {
-                if (!line.empty() && line.back() == '\r') line.pop_back();
-                if (!buffer.empty()) buffer += "\n"; // 为兼容旧数据，将换行保留到缓冲区
-                buffer += line;
-
-                // 按未被转义的分隔符分割
-                auto parts = Utils::SplitByUnescapedPipe(buffer);
-                // 旧数据至少包含：word | meaning | pronunciation | remindTime | isActive
-                if (parts.size() < 5)
-                {
-                    // 字段不足，继续读取下一行（说明有未转义的换行打断了记录）
-                    continue;
-                }
-
-                // 解析一个完整记录
-                WordEntry entry;
-                entry.word = Utils::UnescapeField(parts[0]);
-                entry.meaning = Utils::UnescapeField(parts[1]);
-                entry.pronunciation = Utils::UnescapeField(parts[2]);
-
-                auto to_time = [](const std::string& s) -> time_t {
-                    try { return (time_t)std::stoll(s); } catch (...) { return (time_t)std::time(nullptr); }
-                };
-                auto to_bool = [](const std::string& s) -> bool {
-                    return (s == "1" || s == "true" || s == "True" || s == "TRUE");
-                };
-                auto to_int = [](const std::string& s) -> int {
-                    try { return (int)std::stol(s); } catch (...) { return 0; }
-                };
-
-                entry.remindTime = std::chrono::system_clock::from_time_t(to_time(parts[3]));
-                entry.isActive = to_bool(parts[4]);
+            WordEntry& entry = g_state->words[i];
+            GlyphCache::AddText(Strings::CStr(entry.word));
+            GlyphCache::AddText(Strings::CStr(entry.meaning));
+            GlyphCache::AddText(Strings::CStr(entry.pronunciation));
+            entry.id = ++g_state->nextWordId;
+        }
+        // 摘要以分片内容为准（旧版本没有索引，或分片被外部改过）
+        Decks::Summarize(g_state->words, ActiveDeck());
+        g_state->shardBase = Decks::TakeSnapshot(g_state->words);
+        InvalidateDueSet();
+    }
+    
+    // 提醒通知：到期事件发到这个主题，弹窗/应用内提示/桌面通知各是一个限频的通道
+    static const char* kReminderTopic = "word_reminder";
 
-                bool hasMastered = parts.size() >= 6;
-                bool hasReview = parts.size() >= 7;
-                bool hasLastReview = parts.size() >= 8;
+#ifdef _WIN32
+    // 右上角提醒弹窗作为通知通道：只负责打开，内容由 EnsureReminderWindow 按到期集合绘制
+    class ReminderPopupSink : public Notifier::Sink
+    {
+    public:
+        const char* Name() const override { return "popup"; }
+        bool Deliver(const Notifier::Notification&) override
+        {
+            if (!g_state) return false;
+            g_state->showReminderPopup = true;
+            return true;
+        }
+    };
+#endif
 
-                entry.isMastered = hasMastered ? to_bool(parts[5]) : false;
-                entry.reviewCount = hasReview ? to_int(parts[6]) : 0;
-                entry.lastReview = std::chrono::system_clock::from_time_t(
-                    hasLastReview ? to_time(parts[7]) : to_time(parts[3])
-                );
+    static void FormatReminder(Notifier::Notification& n)
+    {
+        if (n.count == 1 && !n.preview.empty())
+        {
+            n.title = "该复习了: " + n.preview[0].title;
+            n.body = n.preview[0].body;
+            return;
+        }
+        n.title = std::to_string(n.count) + " 个单词待复习";
+        for (const auto& e : n.preview)
+        {
+            if (!n.body.empty()) n.body += ", ";
+            n.body += e.title;
+        }
+        if (n.count > n.preview.size()) n.body += " 等";
+    }
 
-                g_state->words.push_back(entry);
-                buffer.clear();
-            }
-            file.close();
+    static void RegisterNotificationChannels()
+    {
+        Notifier::SetFormatter(kReminderTopic, FormatReminder);
+#ifdef _WIN32
+        Notifier::AddChannel("reminder.popup", kReminderTopic, std::make_shared<ReminderPopupSink>());
+#endif
+        Notifier::ChannelLimits toastLimits;
+        toastLimits.minIntervalMs = 5000.0;
+        Notifier::AddChannel("reminder.toast", kReminderTopic, Notifier::MakeToastSink(), toastLimits);
+        if (auto desktop = Notifier::MakeDesktopSink("Dear ImGui Tool"))
+        {
+            Notifier::ChannelLimits desktopLimits;
+            desktopLimits.minIntervalMs = 60000.0;  // 桌面通知最打扰人，每分钟最多一条
+            Notifier::AddChannel("reminder.desktop", kReminderTopic, desktop, desktopLimits);
         }
     }
-    
+
+    static void UnregisterNotificationChannels()
+    {
+        Notifier::RemoveChannel("reminder.popup");
+        Notifier::RemoveChannel("reminder.toast");
+        Notifier::RemoveChannel("reminder.desktop");
+    }
+
     void Initialize()
     {
         if (!g_state)
         {
             g_state = std::make_unique<FeatureState>();
         }
+        RegisterNotificationChannels();
         
+        // 索引只有每个词库一行摘要；单词只加载上次打开的那个词库
+        g_state->decks = Decks::LoadIndex(g_state->activeDeck);
+        g_state->notifiedDeckDue.assign(g_state->decks.size(), 0);
         LoadWords();
+        // 分片的监视在 UI 线程上建（PollReminders），这里在后台线程
+        if (!History::Load()) AppendLog(std::string("[复习记录] 无法读取或修复 ") + History::kLogFile + "，本次不记录");
         
         // 更新统计信息
         g_state->totalWords = static_cast<int>(g_state->words.size());
@@ -241,27 +355,272 @@ namespace WordReminder
         }
     }
     
+    // 按复习次数取下次提醒间隔
+    static int ReviewIntervalSeconds(int reviewCount)
+    {
+        if (reviewCount <= 0) return 1800;   // 30分钟
+        if (reviewCount == 1) return 3600;   // 1小时
+        if (reviewCount == 2) return 7200;   // 2小时
+        if (reviewCount == 3) return 14400;  // 4小时
+        if (reviewCount == 4) return 28800;  // 8小时
+        return 86400;                        // 24小时
+    }
+
+    // 记一次复习：Good 等同“标记已复习”；Again 一分钟后重来，Hard 不升级，Easy 跳一级。
+    // 只改内存，调用方负责 InvalidateDueSet/SaveWords
+    static void ApplyGrade(WordEntry& entry, Review::Grade grade, std::chrono::system_clock::time_point at)
+    {
+        int nextSeconds = 0;
+        switch (grade)
+        {
+        case Review::Grade::Again:
+            entry.reviewCount = 0;
+            nextSeconds = 60;
+            break;
+        case Review::Grade::Hard:
+            nextSeconds = ReviewIntervalSeconds(entry.reviewCount);
+            break;
+        case Review::Grade::Easy:
+            entry.reviewCount += 2;
+            nextSeconds = ReviewIntervalSeconds(entry.reviewCount);
+            break;
+        default:
+            entry.reviewCount++;
+            nextSeconds = ReviewIntervalSeconds(entry.reviewCount);
+            break;
+        }
+        entry.lastReview = at;
+        entry.remindTime = at + std::chrono::seconds(nextSeconds);
+    }
+
+    static History::Event MakeHistoryEvent(const WordEntry& entry, Review::Grade grade, std::chrono::system_clock::time_point at)
+    {
+        History::Event e;
+        e.card = History::CardKey(Strings::View(entry.word));
+        e.time = (int64_t)std::chrono::system_clock::to_time_t(at);
+        e.grade = (uint8_t)grade;
+        e.intervalSec = (uint32_t)std::chrono::duration_cast<std::chrono::seconds>(entry.remindTime - at).count();
+        return e;
+    }
+
+    static void AppendHistory(const std::vector<History::Event>& events)
+    {
+        if (!History::Append(events)) AppendLog("[复习记录] 写入失败: " + std::to_string(events.size()) + " 条");
+    }
+
+    // words 始终按 id 升序（加载时顺序编号，新词追加在末尾，删除不改变顺序）
+    static WordEntry* FindWord(uint64_t id)
+    {
+        auto it = std::lower_bound(g_state->words.begin(), g_state->words.end(), id,
+            [](const WordEntry& e, uint64_t v) { return e.id < v; });
+        return (it != g_state->words.end() && it->id == id) ? &*it : nullptr;
+    }
+
+    // 复习模式的数据来源：到期集合出卡，评分改内存，攒够一批再落盘
+    static Review::Source MakeReviewSource()
+    {
+        Review::Source source;
+        source.fetch = [](size_t max, const std::vector<uint64_t>& skip) {
+            std::vector<Review::Card> cards;
+            if (!g_state) return cards;
+            RefreshDueSet(std::chrono::system_clock::now());
+            for (const DueItem& item : g_state->due.items)
+            {
+                if (cards.size() >= max) break;
+                if (std::binary_search(skip.begin(), skip.end(), item.id)) continue;
+                const WordEntry& entry = g_state->words[item.index];
+                Review::Card card;
+                card.id = entry.id;
+                card.revision = entry.revision;
+                card.word = Strings::Str(entry.word);
+                card.meaning = Strings::Str(entry.meaning);
+                card.pronunciation = Strings::Str(entry.pronunciation);
+                cards.push_back(std::move(card));
+            }
+            return cards;
+        };
+        source.apply = [](const Review::Answer& answer) {
+            if (!g_state) return false;
+            WordEntry* entry = FindWord(answer.id);
+            if (!entry) return false;
+            ApplyGrade(*entry, answer.grade, answer.at);
+            g_state->pendingEvents.push_back(MakeHistoryEvent(*entry, answer.grade, answer.at));
+            InvalidateDueSet();
+            return true;
+        };
+        source.commit = [](const std::vector<Review::Answer>& answers) {
+            if (!g_state) return false;
+            if (!SaveWords()) return false;
+            AppendHistory(g_state->pendingEvents);
+            g_state->pendingEvents.clear();
+            RecomputeStats();
+            AppendLog("[复习] 提交 " + std::to_string(answers.size()) + " 个回答");
+            return true;
+        };
+        return source;
+    }
+
+    // 把分片在磁盘上的新内容按记录合并进内存，不整个重新加载。返回是否有冲突（保留了本地版本，需要写回）
+    static bool MergeShardFromDisk()
+    {
+        const std::string file = ActiveDeck().file;
+        std::vector<WordEntry> remote;
+        if (!Decks::LoadShard(file, remote))
+        {
+            AppendLog("[词库] 分片被外部移走或无法读取，保留内存中的内容: " + file);
+            return false;
+        }
+        Decks::MergeResult merged = Decks::Merge(g_state->words, remote, g_state->shardBase, g_state->nextWordId);
+        g_state->shardBase = Decks::TakeSnapshot(remote);
+        if (merged.added + merged.updated + merged.removed + merged.conflicts == 0) return false;
+
+        for (uint64_t id : merged.touchedIds)
+        {
+            if (const WordEntry* entry = FindWord(id))
+            {
+                GlyphCache::AddText(Strings::CStr(entry->word));
+                GlyphCache::AddText(Strings::CStr(entry->meaning));
+                GlyphCache::AddText(Strings::CStr(entry->pronunciation));
+            }
+        }
+        if (merged.removed > 0)
+        {
+            // 下标可能已经指向别的单词
+            g_state->selectedWordIndex = -1;
+            g_state->isEditing = false;
+        }
+        InvalidateDueSet();
+        RecomputeStats();
+        Decks::Summarize(g_state->words, ActiveDeck());
+
+        g_state->syncStatus = "外部修改已合并: 新增 " + std::to_string(merged.added) + ", 修改 " + std::to_string(merged.updated) +
+                              ", 删除 " + std::to_string(merged.removed);
+        if (merged.conflicts > 0)
+        {
+            std::string words;
+            for (const auto& w : merged.conflictWords) words += (words.empty() ? "" : ", ") + w;
+            g_state->syncStatus += ", 冲突 " + std::to_string(merged.conflicts) + "（保留本地: " + words + "）";
+        }
+        AppendLog("[词库] " + g_state->syncStatus);
+        return merged.conflicts > 0;
+    }
+
+    // 打开的分片被外部修改（同步盘、另一个实例）
+    static void OnShardChanged(const std::filesystem::path&)
+    {
+        if (!g_state) return;
+        const bool conflicts = MergeShardFromDisk();
+        // 冲突时把保留下来的本地版本写回去，两边重新一致；被挡下的保存也在这时写
+        if (conflicts || g_state->savePending) SaveWords();
+        else Decks::SaveIndex(g_state->decks, g_state->activeDeck);
+    }
+
+    static void WatchActiveShard()
+    {
+        FileWatcher::Unwatch(g_state->shardWatch);
+        g_state->shardWatch = FileWatcher::Watch(std::filesystem::u8path(ActiveDeck().file), OnShardChanged);
+        g_state->syncStatus.clear();
+    }
+
     void Cleanup()
     {
+#ifdef _WIN32
+        // 先销毁提醒/弹幕窗口：功能可能在运行中被卸载，窗口过程不能再访问已释放的状态
+        DestroyReminderWindows();
+#endif
+        UnregisterNotificationChannels();
         if (g_state)
         {
-            SaveWords();
+            Review::End();
+            SaveWords(true);
+            FileWatcher::Unwatch(g_state->shardWatch);
             g_state.reset();
+            Strings::Clear();
+            History::Unload();
         }
-        
-#ifdef _WIN32
-        // 清理弹幕窗口
-        StopDanmakuReminder();
-#endif
+    }
+
+    // 切换打开的词库：先保存当前分片，再只加载目标分片
+    static void SwitchDeck(int index)
+    {
+        if (index < 0 || index >= (int)g_state->decks.size() || index == g_state->activeDeck) return;
+        Review::End();
+        SaveWords(true);
+        g_state->words.clear();
+        g_state->words.shrink_to_fit();
+        Strings::Clear();
+        g_state->selectedWordIndex = -1;
+        g_state->isEditing = false;
+        g_state->activeDeck = index;
+        LoadWords();
+        WatchActiveShard();
+        RecomputeStats();
+        Decks::SaveIndex(g_state->decks, g_state->activeDeck);
+        AppendLog("[词库] 切换到 " + ActiveDeck().name + ": " + std::to_string(g_state->words.size()) + " 个单词");
+    }
+
+    static bool CreateDeck(const std::string& name)
+    {
+        if (name.empty()) return false;
+        for (const auto& d : g_state->decks)
+        {
+            if (d.name == name) return false;
+        }
+        Decks::DeckInfo deck;
+        deck.name = name;
+        deck.file = Decks::NewShardFile(g_state->decks);
+        if (!Decks::SaveShard(deck.file, {})) return false;
+        GlyphCache::AddText(name);
+        g_state->decks.push_back(deck);
+        g_state->notifiedDeckDue.push_back(0);
+        SwitchDeck((int)g_state->decks.size() - 1);
+        return true;
+    }
+
+    // 删除打开的词库及其分片；至少保留一个词库
+    static void DeleteActiveDeck()
+    {
+        if (g_state->decks.size() <= 1) return;
+        Review::End();
+        const int index = g_state->activeDeck;
+        const Decks::DeckInfo removed = g_state->decks[index];
+        g_state->decks.erase(g_state->decks.begin() + index);
+        g_state->notifiedDeckDue.erase(g_state->notifiedDeckDue.begin() + index);
+        g_state->words.clear();
+        g_state->words.shrink_to_fit();
+        Strings::Clear();
+        g_state->selectedWordIndex = -1;
+        g_state->isEditing = false;
+        g_state->activeDeck = 0;
+        LoadWords();
+        WatchActiveShard();
+        RecomputeStats();
+        Decks::SaveIndex(g_state->decks, g_state->activeDeck);
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::u8path(removed.file), ec);
+        AppendLog("[词库] 已删除 " + removed.name + " (" + removed.file + ")");
     }
 
 #ifdef _WIN32
 
     // 右上角自定义置顶弹窗
     static HWND g_reminderHwnd = nullptr;
-    static std::wstring g_reminderText;
-    static std::vector<std::wstring> g_wordList;  // 存储单词列表
-    static std::vector<std::wstring> g_meaningList;  // 存储释义列表
+
+    // 提醒弹窗的文本模型：每个到期单词一块，与 DueSet 同序（id 升序）。绘制和测量都直接按块进行，
+    // 不拼整段文本：内容变化只转换改动的块，重绘只排版可见的块
+    struct ReminderBlock
+    {
+        uint64_t id;
+        uint32_t revision;
+        std::wstring word;
+        std::wstring meaning;
+        int height;  // 按 g_reminderMeasureWidth 排版的像素高度（含行距），-1 表示未测量
+    };
+    static std::vector<ReminderBlock> g_reminderBlocks;
+    static uint64_t g_reminderGeneration = 0;  // g_reminderBlocks 对应的 DueSet 版本，0 表示未同步
+    static int g_reminderMeasureWidth = -1;
+    static int g_reminderBlankHeight = 0;      // 块之间空行的高度，随宽度一起测量
+    static const int kReminderLineGap = 8;     // 每行之后的间距
     static HFONT g_fontTitle = nullptr;
     static HFONT g_fontText = nullptr;
     static HFONT g_fontWord = nullptr;  // 专门用于单词的字体
@@ -278,7 +637,6 @@ namespace WordReminder
     static HBRUSH g_scrollbarThumbBrush = nullptr; // 滚动条滑块画刷
     
     // 状态管理变量 - 用于跟踪当前显示的单词列表
-    static std::vector<WordEntry> g_currentDisplayedWords; // 当前正在窗口上显示的单词列表
     static bool g_windowShouldBeVisible = false; // 窗口是否应该可见
 
     // 弹幕系统相关变量
@@ -383,34 +741,43 @@ namespace WordReminder
     static void ExportWordsToPath(const std::wstring& savePath)
     {
         // 先保存到默认数据文件，然后复制
-        SaveWords();
-        CopyFileW(L"word_reminder_data.txt", savePath.c_str(), FALSE);
+        SaveWords(true);
+        CopyFileW(Utils::Utf8ToWide(ActiveDeck().file).c_str(), savePath.c_str(), FALSE);
     }
 
     static bool ImportWordsFromPath(const std::wstring& openPath)
     {
-        // 将选择的文件复制为默认数据文件，然后重新加载状态
-        if (!CopyFileW(openPath.c_str(), L"word_reminder_data.txt", FALSE))
+        // 将选择的文件复制为当前词库的分片，然后重新加载状态
+        Review::End();
+        if (!CopyFileW(openPath.c_str(), Utils::Utf8ToWide(ActiveDeck().file).c_str(), FALSE))
         {
             return false;
         }
         g_state->words.clear();
+        Strings::Clear();
         LoadWords();
+        WatchActiveShard();
         RecomputeStats();
+        Decks::SaveIndex(g_state->decks, g_state->activeDeck);
         return true;
     }
-#endif
 
     static void MarkAllDueReviewed()
     {
-        for (int i = 0; i < static_cast<int>(g_state->words.size()); i++)
+        // 整批改完只保存一次
+        const auto now = std::chrono::system_clock::now();
+        std::vector<History::Event> events;
+        for (auto& entry : g_state->words)
         {
-            auto& entry = g_state->words[i];
-            if (entry.isActive && entry.remindTime <= std::chrono::system_clock::now())
+            if (entry.isActive && entry.remindTime <= now)
             {
-                MarkAsReviewed(i);
+                ApplyGrade(entry, Review::Grade::Good, now);
+                events.push_back(MakeHistoryEvent(entry, Review::Grade::Good, now));
             }
         }
+        InvalidateDueSet();
+        SaveWords();
+        AppendHistory(events);
     }
 
     static void SnoozeAllDueFiveMinutes()
@@ -422,6 +789,7 @@ namespace WordReminder
                 entry.remindTime = std::chrono::system_clock::now() + std::chrono::minutes(5);
             }
         }
+        InvalidateDueSet();
         SaveWords();
     }
 
@@ -464,6 +832,151 @@ namespace WordReminder
         if (btnClose)    MoveWindow(btnClose,    startX + w1 + gap + w2 + gap + w3 + gap, y, w4, btnHeight, TRUE);
     }
 
+    static void ResetReminderModel()
+    {
+        g_reminderBlocks.clear();
+        g_reminderGeneration = 0;
+        g_reminderMeasureWidth = -1;
+    }
+
+    // 排版一块：单词行（粗体，带📖图标）之后是释义各行（普通字体，首行缩进）。
+    // draw 为假时只测量；返回整块的高度（含每行之后的行距）
+    static int LayoutReminderBlock(HDC hdc, const ReminderBlock& block, int left, int top, int right, bool draw)
+    {
+        int y = top;
+        auto line = [&](const wchar_t* text, int length, bool isWord) {
+            HFONT font = isWord ? g_fontWord : g_fontText;
+            if (font) SelectObject(hdc, font);
+            if (draw)
+            {
+                SetTextColor(hdc, isWord ? (g_darkMode ? RGB(255, 255, 255) : RGB(0, 0, 0))
+                                         : (g_darkMode ? RGB(220, 220, 225) : RGB(60, 60, 68)));
+            }
+            RECT lineRc = { left, y, right, y + 2000 };
+            const int textHeight = DrawTextW(hdc, text, length, &lineRc, DT_LEFT | DT_TOP | DT_WORDBREAK | DT_CALCRECT);
+            if (draw)
+            {
+                lineRc = { left, y, right, y + textHeight };
+                DrawTextW(hdc, text, length, &lineRc, DT_LEFT | DT_TOP | DT_WORDBREAK);
+            }
+            y += textHeight + kReminderLineGap;
+        };
+
+        const std::wstring head = L"📖 " + block.word;
+        line(head.c_str(), (int)head.size(), true);
+        const std::wstring& meaning = block.meaning;
+        size_t pos = 0;
+        bool first = true;
+        do
+        {
+            size_t end = meaning.find(L'\n', pos);
+            if (end == std::wstring::npos) end = meaning.size();
+            if (first)
+            {
+                const std::wstring indented = L"    " + meaning.substr(pos, end - pos);
+                line(indented.c_str(), (int)indented.size(), false);
+                first = false;
+            }
+            else
+            {
+                line(meaning.c_str() + pos, (int)(end - pos), false);
+            }
+            pos = end + 1;
+        } while (pos <= meaning.size());
+        return y - top;
+    }
+
+    // 把文本模型同步到当前 DueSet：版本号没变时直接返回；否则按 id 归并新旧两个有序列表，
+    // 只转换新增或被编辑的单词，其余块原样搬过去（高度缓存也保留）。返回内容是否变化。
+    static bool SyncReminderBlocks()
+    {
+        const DueSet& due = g_state->due;
+        if (g_reminderGeneration == due.generation) return false;
+
+        std::vector<ReminderBlock> next;
+        next.reserve(due.items.size());
+        size_t j = 0;
+        int inserted = 0, removed = 0, updated = 0;
+        for (const DueItem& item : due.items)
+        {
+            while (j < g_reminderBlocks.size() && g_reminderBlocks[j].id < item.id) { ++j; ++removed; }
+            if (j < g_reminderBlocks.size() && g_reminderBlocks[j].id == item.id)
+            {
+                ReminderBlock& old = g_reminderBlocks[j++];
+                if (old.revision == item.revision)
+                {
+                    next.push_back(std::move(old));
+                    continue;
+                }
+                ++updated;
+            }
+            else
+            {
+                ++inserted;
+            }
+            const WordEntry& entry = g_state->words[item.index];
+            next.push_back(ReminderBlock{ item.id, item.revision, Strings::Wide(entry.word), Strings::Wide(entry.meaning), -1 });
+        }
+        removed += (int)(g_reminderBlocks.size() - j);
+        g_reminderBlocks.swap(next);
+        g_reminderGeneration = due.generation;
+        AppendLog("[提醒] 弹窗内容更新: 新增=" + std::to_string(inserted) + ", 移除=" + std::to_string(removed) +
+                  ", 修改=" + std::to_string(updated) + ", 共" + std::to_string(g_reminderBlocks.size()) + "个单词");
+        return true;
+    }
+
+    // 文本区域的左右边界（相对客户区），测量与绘制共用
+    static void ReminderTextBounds(const RECT& rc, int& left, int& right)
+    {
+        left = rc.left + 14 + 10;
+        right = rc.right - 10;
+    }
+
+    // 内容总高度：每块按绘制时的排版单独测量并缓存，宽度不变时只测量新增/修改的块
+    static int MeasureReminderContent(HDC hdc, int width)
+    {
+        if (width != g_reminderMeasureWidth)
+        {
+            for (auto& block : g_reminderBlocks) block.height = -1;
+            g_reminderMeasureWidth = width;
+            if (g_fontText) SelectObject(hdc, g_fontText);
+            RECT lineRc = { 0, 0, width, 2000 };
+            g_reminderBlankHeight = DrawTextW(hdc, L" ", 1, &lineRc, DT_LEFT | DT_TOP | DT_WORDBREAK | DT_CALCRECT) + kReminderLineGap;
+        }
+        int total = 0;
+        for (size_t i = 0; i < g_reminderBlocks.size(); ++i)
+        {
+            ReminderBlock& block = g_reminderBlocks[i];
+            if (block.height < 0) block.height = LayoutReminderBlock(hdc, block, 0, 0, width, false);
+            if (i > 0) total += g_reminderBlankHeight;
+            total += block.height;
+        }
+        return total;
+    }
+
+    // 根据内容高度更新自定义滚动条范围；resetPos 为真时回到顶部（新建窗口）
+    static void UpdateReminderScrollRange(bool resetPos)
+    {
+        HDC hdc = GetDC(g_reminderHwnd);
+        HFONT old = nullptr;
+        if (g_fontText) old = (HFONT)SelectObject(hdc, g_fontText);
+
+        RECT rc;
+        GetClientRect(g_reminderHwnd, &rc);
+        RECT content = { rc.left + 14, rc.top + 14, rc.right - 14, rc.bottom - 58 };
+        int textLeft = 0, textRight = 0;
+        ReminderTextBounds(rc, textLeft, textRight);
+        int totalHeight = MeasureReminderContent(hdc, textRight - textLeft);
+
+        // 内容区域的实际可用高度（减去上下边距）
+        int contentAreaHeight = content.bottom - content.top - 80;
+        g_scrollMax = (std::max)(0, totalHeight - contentAreaHeight);
+        g_scrollPos = resetPos ? 0 : (std::min)(g_scrollPos, g_scrollMax);
+
+        if (old) SelectObject(hdc, old);
+        ReleaseDC(g_reminderHwnd, hdc);
+    }
+
     static LRESULT CALLBACK ReminderWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
     {
         switch (msg)
@@ -762,13 +1275,13 @@ namespace WordReminder
                 {
                     // 只复制单词到剪贴板
                     std::wstring wordsOnly;
-                    for (const auto& entry : g_currentDisplayedWords)
+                    for (const auto& block : g_reminderBlocks)
                     {
                         if (!wordsOnly.empty())
                         {
                             wordsOnly += L"\n";
                         }
-                        wordsOnly += Utils::Utf8ToWide(entry.word);
+                        wordsOnly += block.word;
                     }
                     
                     if (!wordsOnly.empty())
@@ -861,71 +1374,23 @@ namespace WordReminder
                 // std::wstring titleText = L"📚 单词复习提醒";
                 // DrawTextW(memDC, titleText.c_str(), -1, &titleRc, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
 
-                // 直接绘制文本内容，单词使用粗体字体，支持滚动
+                // 逐块绘制，单词使用粗体字体，支持滚动；块高度已缓存，可见区域外的块直接跳过
                 int yOffset = content.top + 40 - g_scrollPos;
-                AppendLog("[滚动调试] 文本绘制: yOffset=" + std::to_string(yOffset) + 
-                         ", content.top=" + std::to_string(content.top) + 
-                         ", g_scrollPos=" + std::to_string(g_scrollPos) + 
-                         ", 文本长度=" + std::to_string(g_reminderText.length()));
-                if (!g_reminderText.empty())
+                const int visibleTop = content.top + 40;
+                const int visibleBottom = content.bottom - 10;
+                int textLeft = 0, textRight = 0;
+                ReminderTextBounds(rc, textLeft, textRight);
+                MeasureReminderContent(memDC, textRight - textLeft);
+                int currentY = yOffset;
+                for (size_t i = 0; i < g_reminderBlocks.size() && currentY < visibleBottom; ++i)
                 {
-                    // 解析文本，分别绘制单词（粗体）和释义（普通）
-                    std::wstring text = g_reminderText;
-                    size_t pos = 0;
-                    int currentY = yOffset;
-                    
-                    while (pos < text.length())
+                    const ReminderBlock& block = g_reminderBlocks[i];
+                    if (i > 0) currentY += g_reminderBlankHeight;
+                    if (currentY + block.height > visibleTop && currentY < visibleBottom)
                     {
-                        size_t lineEnd = text.find(L'\n', pos);
-                        if (lineEnd == std::wstring::npos) lineEnd = text.length();
-                        
-                        std::wstring line = text.substr(pos, lineEnd - pos);
-                        
-                        // 检查是否是单词行（包含📖图标）
-                        if (line.find(L"📖") != std::wstring::npos)
-                        {
-                            // 单词行：使用粗体字体
-                            if (g_fontWord) SelectObject(memDC, g_fontWord);
-                            SetTextColor(memDC, g_darkMode ? RGB(255, 255, 255) : RGB(0, 0, 0));
-                        }
-                        else
-                        {
-                            // 释义行：使用普通字体
-                            if (g_fontText) SelectObject(memDC, g_fontText);
-                            SetTextColor(memDC, g_darkMode ? RGB(220, 220, 225) : RGB(60, 60, 68));
-                        }
-                        
-                        // 不限制宽度，让文本自然显示
-                        RECT lineRc = { content.left + 10, currentY, rc.right - 10, content.bottom - 10 };
-                        int textHeight = DrawTextW(memDC, line.c_str(), -1, &lineRc, DT_LEFT | DT_TOP | DT_WORDBREAK | DT_CALCRECT);
-                        
-                        // 检查这一行是否在可见区域内
-                        int lineBottom = currentY + textHeight;
-                        int visibleTop = content.top + 40;
-                        int visibleBottom = content.bottom - 10;
-                        
-                        // 只有当行在可见区域内时才绘制
-                        if (lineBottom > visibleTop && currentY < visibleBottom)
-                        {
-                            // 重新绘制，使用计算出的高度
-                            lineRc.bottom = lineRc.top + textHeight;
-                            DrawTextW(memDC, line.c_str(), -1, &lineRc, DT_LEFT | DT_TOP | DT_WORDBREAK);
-                            AppendLog("[滚动调试] 绘制行: currentY=" + std::to_string(currentY) + 
-                                     ", textHeight=" + std::to_string(textHeight) + 
-                                     ", 可见区域=" + std::to_string(visibleTop) + "-" + std::to_string(visibleBottom));
-                        }
-                        else
-                        {
-                            AppendLog("[滚动调试] 跳过行: currentY=" + std::to_string(currentY) + 
-                                     ", textHeight=" + std::to_string(textHeight) + 
-                                     ", 超出可见区域");
-                        }
-                        
-                        // 移动到下一行位置
-                        currentY += textHeight + 8;
-                        
-                        pos = lineEnd + 1;
+                        LayoutReminderBlock(memDC, block, textLeft, currentY, textRight, true);
                     }
+                    currentY += block.height;
                 }
 
                 // 绘制自定义滚动条
@@ -1096,7 +1561,7 @@ namespace WordReminder
                  {
                      g_reminderHwnd = nullptr;
                      g_windowShouldBeVisible = false;
-                     g_currentDisplayedWords.clear();
+                     ResetReminderModel();
                      
                      // 检查是否还有其他需要复习的单词
                      if (HasReminderToShow())
@@ -1126,33 +1591,10 @@ namespace WordReminder
 
     static void EnsureReminderWindow()
     {
-        auto dueWords = GetDueWords();
+        // 到期集合没变时这里是 O(1)：不复制单词，也不重建文本
+        RefreshDueSet(std::chrono::system_clock::now());
         
-        // 比较最新列表和当前显示的列表
-        bool wordsChanged = false;
-        if (dueWords.size() != g_currentDisplayedWords.size())
-        {
-            wordsChanged = true;
-        }
-        else
-        {
-            // 比较每个单词的内容
-            for (size_t i = 0; i < dueWords.size(); ++i)
-            {
-                if (i >= g_currentDisplayedWords.size() || 
-                    dueWords[i].word != g_currentDisplayedWords[i].word ||
-                    dueWords[i].meaning != g_currentDisplayedWords[i].meaning)
-                {
-                    wordsChanged = true;
-                    break;
-                }
-            }
-        }
-        
-        // 更新当前显示的单词列表
-        g_currentDisplayedWords = dueWords;
-        
-        if (dueWords.empty()) 
+        if (g_state->due.items.empty()) 
         { 
             // 如果没有需要复习的单词，隐藏窗口而不是销毁
             if (g_reminderHwnd) 
@@ -1164,87 +1606,14 @@ namespace WordReminder
             return; 
         }
 
-        // 构建新的文本内容，使用特殊格式突出单词
-        std::wstring fullText;
-        for (size_t i = 0; i < dueWords.size(); ++i)
-        {
-            const auto& entry = dueWords[i];
-            std::wstring word = Utils::Utf8ToWide(entry.word);
-            std::wstring meaning = Utils::Utf8ToWide(entry.meaning);
-            
-            if (i > 0)
-            {
-                fullText += L"\n\n";
-            }
-            
-            // 使用特殊符号和格式突出单词
-            fullText += L"📖 " + word;
-            fullText += L"\n    " + meaning;
-        }
+        bool contentChanged = SyncReminderBlocks();
         
-        // 如果窗口已经存在，检查内容是否需要更新
+        // 如果窗口已经存在，只有当内容真正改变时才重新计算滚动范围并重绘
         if (g_reminderHwnd) 
         {
-            // 只有当内容真正改变时才更新，避免频繁重绘
-            if (g_reminderText != fullText)
+            if (contentChanged)
             {
-                g_reminderText = fullText;
-                
-                // 计算滚动条范围 - 只针对内容区域，不包含按钮
-                HDC hdc = GetDC(g_reminderHwnd);
-                HFONT old = nullptr;
-                if (g_fontText) old = (HFONT)SelectObject(hdc, g_fontText);
-                
-                RECT rc;
-                GetClientRect(g_reminderHwnd, &rc);
-                RECT content = { rc.left + 14, rc.top + 14, rc.right - 14, rc.bottom - 58 };
-                
-                // 计算文本内容的总高度
-                RECT measureRc = { 0, 0, content.right - content.left - 20, 2000 };
-                int totalHeight = DrawTextW(hdc, g_reminderText.c_str(), -1, &measureRc, DT_LEFT | DT_TOP | DT_WORDBREAK | DT_CALCRECT);
-                
-                // 内容区域的实际可用高度（减去上下边距）
-                int contentAreaHeight = content.bottom - content.top - 80; // 减去上下边距
-                g_scrollMax = (std::max)(0, totalHeight - contentAreaHeight);
-                g_scrollPos = (std::min)(g_scrollPos, g_scrollMax);
-                
-                // 添加详细的滚动范围计算调试日志
-                AppendLog("[滚动调试] 详细计算: measureRc宽度=" + std::to_string(measureRc.right - measureRc.left) + 
-                         ", content区域=" + std::to_string(content.right - content.left) + "x" + std::to_string(content.bottom - content.top) + 
-                         ", contentAreaHeight=" + std::to_string(contentAreaHeight) + 
-                         ", totalHeight=" + std::to_string(totalHeight) + 
-                         ", 文本内容='" + std::string(g_reminderText.begin(), g_reminderText.end()) + "'");
-                
-                // 添加滚动范围计算调试日志
-                AppendLog("[滚动调试] 滚动范围计算: totalHeight=" + std::to_string(totalHeight) + 
-                         ", contentAreaHeight=" + std::to_string(contentAreaHeight) + 
-                         ", scrollMax=" + std::to_string(g_scrollMax) + 
-                         ", scrollPos=" + std::to_string(g_scrollPos));
-                
-                // 测试：强制设置滚动范围，即使内容不超出
-                if (g_scrollMax > 0 || !g_reminderText.empty())
-                {
-                    // 如果计算出的滚动范围太小，强制设置一个测试范围
-                    if (g_scrollMax <= 0 && !g_reminderText.empty())
-                    {
-                        g_scrollMax = 200; // 强制设置200像素的滚动范围用于测试
-                        AppendLog("[滚动调试] 强制设置滚动范围: " + std::to_string(g_scrollMax) + " (测试用)");
-                    }
-                    
-                    AppendLog("[滚动调试] 显示自定义滚动条: 范围0-" + std::to_string(g_scrollMax) + 
-                             ", 位置=" + std::to_string(g_scrollPos));
-                }
-                else
-                {
-                    g_scrollPos = 0;
-                    AppendLog("[滚动调试] 隐藏自定义滚动条: 内容不超出区域");
-                }
-                
-                if (old) SelectObject(hdc, old);
-                ReleaseDC(g_reminderHwnd, hdc);
-                
-                // 文本已直接绘制，无需同步到编辑框
-                // 仍然请求重绘以更新背景与边框
+                UpdateReminderScrollRange(false);
                 InvalidateRect(g_reminderHwnd, nullptr, FALSE);
             }
             
@@ -1257,9 +1626,6 @@ namespace WordReminder
             return;
         }
 
-        // 设置文本内容
-        g_reminderText = fullText;
-
         WNDCLASSW wc = {};
         wc.lpfnWndProc = ReminderWndProc;
         wc.hInstance = GetModuleHandleW(nullptr);
@@ -1326,41 +1692,7 @@ namespace WordReminder
             g_windowShouldBeVisible = true;
             
             // 窗口创建后立即计算并设置滚动范围
-            HDC hdc = GetDC(g_reminderHwnd);
-            HFONT old = nullptr;
-            if (g_fontText) old = (HFONT)SelectObject(hdc, g_fontText);
-            
-            RECT rc;
-            GetClientRect(g_reminderHwnd, &rc);
-            RECT content = { rc.left + 14, rc.top + 14, rc.right - 14, rc.bottom - 58 };
-            
-            // 计算文本内容的总高度
-            RECT measureRc = { 0, 0, content.right - content.left - 20, 2000 };
-            int totalHeight = DrawTextW(hdc, g_reminderText.c_str(), -1, &measureRc, DT_LEFT | DT_TOP | DT_WORDBREAK | DT_CALCRECT);
-            
-            // 内容区域的实际可用高度（减去上下边距）
-            int contentAreaHeight = content.bottom - content.top - 80;
-            g_scrollMax = (std::max)(0, totalHeight - contentAreaHeight);
-            g_scrollPos = 0; // 重置滚动位置
-            
-            AppendLog("[滚动调试] 窗口创建后设置滚动范围: totalHeight=" + std::to_string(totalHeight) + 
-                     ", contentAreaHeight=" + std::to_string(contentAreaHeight) + 
-                     ", scrollMax=" + std::to_string(g_scrollMax));
-            
-            // 强制设置滚动范围用于测试
-            if (g_scrollMax <= 0 && !g_reminderText.empty())
-            {
-                g_scrollMax = 200;
-                AppendLog("[滚动调试] 强制设置滚动范围: " + std::to_string(g_scrollMax) + " (测试用)");
-            }
-            
-            if (g_scrollMax > 0)
-            {
-                AppendLog("[滚动调试] 窗口创建后设置滚动范围: 范围0-" + std::to_string(g_scrollMax));
-            }
-            
-            if (old) SelectObject(hdc, old);
-            ReleaseDC(g_reminderHwnd, hdc);
+            UpdateReminderScrollRange(true);
         }
         else
         {
@@ -1469,13 +1801,13 @@ namespace WordReminder
                             const auto& word = g_state->words[randomIndex];
                             
                             // 添加到弹幕列表
-                            g_danmakuWords.push_back(Utils::Utf8ToWide(word.word + " - " + word.meaning));
+                            g_danmakuWords.push_back(Strings::Wide(word.word) + L" - " + Strings::Wide(word.meaning));
                             g_danmakuPositions.push_back((float)windowWidth); // 从弹幕窗口右侧开始
                             g_danmakuYPositions.push_back(20.0f + (rand() % (windowHeight - 60))); // 随机Y位置，确保在窗口内
                             g_danmakuOpacities.push_back(0.0f); // 初始透明
                             g_danmakuSpeeds.push_back(2.0f + (rand() % 3)); // 随机速度
                             
-                            AppendLog("[弹幕] 添加单词弹幕: " + word.word + " - " + word.meaning + 
+                            AppendLog("[弹幕] 添加单词弹幕: " + Strings::Str(word.word) + " - " + Strings::Str(word.meaning) + 
                                      ", 位置=(" + std::to_string(windowWidth) + ", " + std::to_string(g_danmakuYPositions.back()) + ")");
                         }
                         else
@@ -1758,7 +2090,7 @@ namespace WordReminder
                 {
                     int randomIndex = rand() % g_state->words.size();
                     dueWords.push_back(g_state->words[randomIndex]);
-                    AppendLog("[弹幕测试] 添加单词: " + g_state->words[randomIndex].word);
+                    AppendLog("[弹幕测试] 添加单词: " + Strings::Str(g_state->words[randomIndex].word));
                 }
             }
             else
@@ -1796,14 +2128,14 @@ namespace WordReminder
             for (size_t i = 0; i < (std::min)(dueWords.size(), size_t(3)); ++i)
             {
                 const auto& word = dueWords[i];
-                g_danmakuWords.push_back(Utils::Utf8ToWide(word.word + " - " + word.meaning));
+                g_danmakuWords.push_back(Strings::Wide(word.word) + L" - " + Strings::Wide(word.meaning));
                 // 从弹幕窗口右侧开始，适应新的窗口大小
                 g_danmakuPositions.push_back((float)(windowWidth - i * 30.0f)); // 从窗口右侧开始，错开位置
                 g_danmakuYPositions.push_back(20.0f + (rand() % (windowHeight - 60))); // 随机Y位置，确保在窗口内
                 g_danmakuOpacities.push_back(0.0f);
                 g_danmakuSpeeds.push_back(2.0f + (rand() % 3));
                 
-                AppendLog("[弹幕] 添加弹幕 " + std::to_string(i) + ": " + word.word + 
+                AppendLog("[弹幕] 添加弹幕 " + std::to_string(i) + ": " + Strings::Str(word.word) + 
                          ", 位置=(" + std::to_string(windowWidth - i * 30.0f) + 
                          ", " + std::to_string(g_danmakuYPositions.back()) + ")");
             }
@@ -1831,7 +2163,20 @@ namespace WordReminder
             DestroyDanmakuWindow();
         }
     }
-//#endif
+
+    // 销毁提醒弹窗与弹幕窗口（功能卸载/退出时调用）
+    static void DestroyReminderWindows()
+    {
+        StopDanmakuReminder();
+        if (g_reminderHwnd)
+        {
+            DestroyWindow(g_reminderHwnd);
+            g_reminderHwnd = nullptr;
+        }
+        ResetReminderModel();
+        g_windowShouldBeVisible = false;
+    }
+#endif
     
     const char* GetFeatureName()
     {
@@ -1856,13 +2201,17 @@ namespace WordReminder
         if (!g_state) return;
         
         WordEntry entry;
-        entry.word = word;
-        entry.meaning = meaning;
+        entry.word = Strings::Intern(word);
+        entry.meaning = Strings::Intern(meaning);
         entry.remindTime = std::chrono::system_clock::now() + std::chrono::seconds(secondsFromNow);
         entry.lastReview = std::chrono::system_clock::now();
         
+        GlyphCache::AddText(word);
+        GlyphCache::AddText(meaning);
+        entry.id = ++g_state->nextWordId;
         g_state->words.push_back(entry);
         g_state->totalWords++;
+        InvalidateDueSet();
         SaveWords();
     }
     
@@ -1872,6 +2221,7 @@ namespace WordReminder
         
         g_state->words.erase(g_state->words.begin() + index);
         g_state->totalWords--;
+        InvalidateDueSet();
         SaveWords();
     }
     
@@ -1879,21 +2229,13 @@ namespace WordReminder
     {
         if (!g_state || index < 0 || index >= static_cast<int>(g_state->words.size())) return;
         
-        auto& entry = g_state->words[index];
-        entry.reviewCount++;
-        entry.lastReview = std::chrono::system_clock::now();
-        
         // 根据复习次数调整下次提醒时间
-        int nextSeconds = 1800; // 30分钟
-        if (entry.reviewCount == 1) nextSeconds = 3600; // 1小时
-        else if (entry.reviewCount == 2) nextSeconds = 7200; // 2小时
-        else if (entry.reviewCount == 3) nextSeconds = 14400; // 4小时
-        else if (entry.reviewCount == 4) nextSeconds = 28800; // 8小时
-        else if (entry.reviewCount >= 5) nextSeconds = 86400; // 24小时
-        
-        entry.remindTime = std::chrono::system_clock::now() + std::chrono::seconds(nextSeconds);
+        const auto now = std::chrono::system_clock::now();
+        ApplyGrade(g_state->words[index], Review::Grade::Good, now);
         
+        InvalidateDueSet();
         SaveWords();
+        AppendHistory({ MakeHistoryEvent(g_state->words[index], Review::Grade::Good, now) });
     }
     
     void MarkAsMastered(int index)
@@ -1904,6 +2246,7 @@ namespace WordReminder
         entry.isMastered = true;
         entry.lastReview = std::chrono::system_clock::now();
         
+        InvalidateDueSet();
         SaveWords();
     }
     
@@ -1918,6 +2261,7 @@ namespace WordReminder
         // 重新设置提醒时间为5分钟后
         entry.remindTime = std::chrono::system_clock::now() + std::chrono::seconds(300);
         
+        InvalidateDueSet();
         SaveWords();
     }
     
@@ -1946,16 +2290,8 @@ namespace WordReminder
     {
         if (!g_state || !g_state->autoShowReminders) return false;
         
-        // 检查是否有需要复习的单词
-        auto now = std::chrono::system_clock::now();
-        for (const auto& entry : g_state->words)
-        {
-            if (entry.isActive && !entry.isMastered && entry.remindTime <= now)
-            {
-                return true;
-            }
-        }
-        return false;
+        RefreshDueSet(std::chrono::system_clock::now());
+        return !g_state->due.items.empty();
     }
     
     std::vector<WordEntry> GetDueWords()
@@ -1963,15 +2299,157 @@ namespace WordReminder
         std::vector<WordEntry> result;
         if (!g_state) return result;
         
-        auto now = std::chrono::system_clock::now();
-        for (const auto& entry : g_state->words)
+        RefreshDueSet(std::chrono::system_clock::now());
+        result.reserve(g_state->due.items.size());
+        for (const DueItem& item : g_state->due.items)
         {
-            if (entry.isActive && !entry.isMastered && entry.remindTime <= now)
+            result.push_back(g_state->words[item.index]);
+        }
+        return result;
+    }
+
+    // 与上次检查时的到期集合按 id 归并（两边都是 id 升序），只为新到期的单词发事件；
+    // 同一时刻到期的一大批单词由 Notifier 合并成一条通知
+    static void PostNewlyDue()
+    {
+        const DueSet& due = g_state->due;
+        const std::vector<uint64_t>& seen = g_state->notifiedIds;
+        std::vector<uint64_t> current;
+        current.reserve(due.items.size());
+        size_t j = 0;
+        for (const DueItem& item : due.items)
+        {
+            current.push_back(item.id);
+            while (j < seen.size() && seen[j] < item.id) ++j;
+            if (j < seen.size() && seen[j] == item.id) continue;
+            if (!g_state->autoShowReminders) continue;
+            const WordEntry& entry = g_state->words[item.index];
+            Notifier::Post(kReminderTopic, Notifier::Event{ std::to_string(item.id), Strings::Str(entry.word), Strings::Str(entry.meaning) });
+        }
+        g_state->notifiedIds.swap(current);
+        g_state->notifiedGeneration = due.generation;
+    }
+
+    // 未打开的词库不加载单词，只按索引摘要里的最早到期时间判断；
+    // 每个词库对同一个 nextDue 只通知一次，打开后由逐词的到期集合接手
+    static void PostDueDecks(time_t now)
+    {
+        for (size_t i = 0; i < g_state->decks.size(); ++i)
+        {
+            if ((int)i == g_state->activeDeck) continue;
+            const Decks::DeckInfo& deck = g_state->decks[i];
+            if (deck.nextDue == 0 || deck.nextDue > now) continue;
+            if (g_state->notifiedDeckDue[i] == deck.nextDue) continue;
+            g_state->notifiedDeckDue[i] = deck.nextDue;
+            if (!g_state->autoShowReminders) continue;
+            Notifier::Post(kReminderTopic, Notifier::Event{ "deck:" + deck.file, "词库「" + deck.name + "」",
+                "有单词到期（共 " + std::to_string(deck.pending) + " 个待复习）" });
+        }
+    }
+
+    void PollReminders()
+    {
+        if (!g_state) return;
+        // Initialize 在后台线程，分片的监视到这里（UI 线程）才建
+        if (g_state->shardWatch == 0) WatchActiveShard();
+        if (!g_state->enabled) return;
+
+        // 每1秒检查一次，避免过于频繁的检查
+        static auto lastCheckTime = std::chrono::steady_clock::time_point();
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastCheckTime >= std::chrono::seconds(1))
+        {
+            lastCheckTime = now;
+            RefreshDueSet(std::chrono::system_clock::now());
+            if (g_state->due.generation != g_state->notifiedGeneration) PostNewlyDue();
+            PostDueDecks(std::time(nullptr));
+            if (g_state->due.items.empty()) g_state->showReminderPopup = false;
+        }
+
+        // 系统级提醒通知 - Windows右上角原生弹窗（由 reminder.popup 通道打开）
+        if (g_state->showReminderPopup)
+        {
+#ifdef _WIN32
+            EnsureReminderWindow();
+            
+            // 如果窗口创建失败或者没有需要复习的单词，重置标志
+            if (!g_reminderHwnd && !HasReminderToShow())
             {
-                result.push_back(entry);
+                g_state->showReminderPopup = false;
             }
+#else
+            // 非Windows平台由应用内提示和桌面通知通道提醒
+            g_state->showReminderPopup = false;
+#endif
         }
-        return result;
+    }
+    
+    // 最近 26 周的复习热力图 + 按间隔的记忆保持率；都只读 History 的汇总
+    static void DrawHistoryPanel()
+    {
+        const History::Totals totals = History::GetTotals();
+        ImGui::Text("共 %llu 次复习, %llu 张卡片 | 文件 %.1f KB, %llu 块 | 读取 %.1f ms",
+            (unsigned long long)totals.events, (unsigned long long)totals.cards, totals.fileBytes / 1024.0,
+            (unsigned long long)totals.blocks, totals.loadMs);
+
+        const int weeks = 26;
+        const int32_t today = History::Today();
+        const int todayWeekday = (int)(((today + 3) % 7 + 7) % 7);  // 1970-01-01 是周四；0 = 周一
+        const int32_t first = today - todayWeekday - (weeks - 1) * 7;
+        const std::vector<History::Day> days = History::Range(first, today);
+        uint32_t peak = 1;
+        for (const auto& d : days) peak = (std::max)(peak, d.reviews);
+
+        const float uiScale = ImGui::GetFontSize() / 16.0f;
+        const float cell = 11.0f * uiScale;
+        const float gap = 2.0f * uiScale;
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImDrawList* dl = ImGui::GetWindowDrawList();
+        const ImVec2 mouse = ImGui::GetIO().MousePos;
+        const History::Day* hovered = nullptr;
+        for (size_t i = 0; i < days.size(); ++i)
+        {
+            const int col = (int)i / 7;
+            const int row = (int)i % 7;
+            ImVec2 a(origin.x + col * (cell + gap), origin.y + row * (cell + gap));
+            ImVec2 b(a.x + cell, a.y + cell);
+            ImU32 color = IM_COL32(50, 50, 58, 255);
+            if (days[i].reviews > 0)
+            {
+                const float t = 0.25f + 0.75f * (float)days[i].reviews / (float)peak;
+                color = IM_COL32((int)(30 * t), (int)(200 * t), (int)(80 * t), 255);
+            }
+            dl->AddRectFilled(a, b, color, 2.0f * uiScale);
+            if (mouse.x >= a.x && mouse.x < b.x && mouse.y >= a.y && mouse.y < b.y) hovered = &days[i];
+        }
+        ImGui::Dummy(ImVec2(weeks * (cell + gap), 7 * (cell + gap)));
+        if (hovered && ImGui::IsItemHovered())
+        {
+            const time_t t = (time_t)hovered->day * 86400;
+            std::tm tmDay = *std::gmtime(&t);
+            char date[32];
+            std::strftime(date, sizeof(date), "%Y-%m-%d", &tmDay);
+            ImGui::SetTooltip("%s: %u 次复习（新卡 %u）\n重来 %u / 困难 %u / 记得 %u / 简单 %u", date,
+                hovered->reviews, hovered->newCards, hovered->byGrade[History::Again], hovered->byGrade[History::Hard],
+                hovered->byGrade[History::Good], hovered->byGrade[History::Easy]);
+        }
+
+        ImGui::Spacing();
+        ImGui::TextDisabled("距上次复习的间隔 → 记住的比例（评分不是“重来”）");
+        ImGui::Columns(3, "retention");
+        ImGui::Text("间隔"); ImGui::NextColumn();
+        ImGui::Text("复习次数"); ImGui::NextColumn();
+        ImGui::Text("保持率"); ImGui::NextColumn();
+        ImGui::Separator();
+        for (const auto& b : History::Retention())
+        {
+            ImGui::Text("%s", b.label); ImGui::NextColumn();
+            ImGui::Text("%u", b.reviews); ImGui::NextColumn();
+            if (b.reviews > 0) ImGui::Text("%.1f%%", 100.0 * b.recalled / b.reviews);
+            else ImGui::TextDisabled("-");
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
     }
     
     void DrawUI()
@@ -1987,6 +2465,61 @@ namespace WordReminder
             return;
         }
         
+        // 词库选择：下拉列表只读索引摘要，不加载其它词库的单词
+        {
+            const time_t nowT = std::time(nullptr);
+            auto deckLabel = [nowT](const Decks::DeckInfo& d) {
+                std::string label = d.name + " (" + std::to_string(d.total) + ")";
+                if (d.nextDue != 0 && d.nextDue <= nowT) label += " · 有到期";
+                return label;
+            };
+            ImGui::Text("词库:");
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(260);
+            if (ImGui::BeginCombo("##Deck", deckLabel(ActiveDeck()).c_str()))
+            {
+                int switchTo = -1;
+                for (int i = 0; i < (int)g_state->decks.size(); ++i)
+                {
+                    const bool selected = (i == g_state->activeDeck);
+                    if (ImGui::Selectable((deckLabel(g_state->decks[i]) + "##deck" + std::to_string(i)).c_str(), selected)) switchTo = i;
+                    if (selected) ImGui::SetItemDefaultFocus();
+                }
+                ImGui::EndCombo();
+                if (switchTo >= 0) SwitchDeck(switchTo);
+            }
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(160);
+            ImGui::InputTextWithHint("##NewDeck", "新词库名称", g_state->newDeckName, sizeof(g_state->newDeckName));
+            ImGui::SameLine();
+            if (ImGui::Button("新建词库"))
+            {
+                if (CreateDeck(g_state->newDeckName)) g_state->newDeckName[0] = '\0';
+                else AppendLog("[词库] 名称为空或已存在");
+            }
+            if (g_state->decks.size() > 1)
+            {
+                ImGui::SameLine();
+                if (ImGui::Button("删除词库")) ImGui::OpenPopup("确认删除词库");
+            }
+            if (ImGui::BeginPopupModal("确认删除词库", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+            {
+                ImGui::Text("删除词库「%s」及其全部 %d 个单词？", ActiveDeck().name.c_str(), ActiveDeck().total);
+                if (ImGui::Button("删除"))
+                {
+                    DeleteActiveDeck();
+                    ImGui::CloseCurrentPopup();
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("取消")) ImGui::CloseCurrentPopup();
+                ImGui::EndPopup();
+            }
+        }
+        if (!g_state->syncStatus.empty())
+        {
+            ImGui::TextDisabled("%s", g_state->syncStatus.c_str());
+        }
+
         // 统计信息区域
         {
             const float uiScale = ImGui::GetFontSize() / 16.0f;
@@ -2008,6 +2541,83 @@ namespace WordReminder
         ImGui::Columns(1);
         ImGui::EndChild();
         
+        // 复习模式
+        ImGui::Spacing();
+        if (ImGui::CollapsingHeader("🧠 复习模式", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            if (!Review::Active())
+            {
+                if (ImGui::Button("开始复习"))
+                {
+                    Review::Start(MakeReviewSource());
+                    AppendLog("[复习] 开始, 待复习 " + std::to_string(g_state->dueWords) + " 个");
+                }
+                ImGui::SameLine();
+                ImGui::TextDisabled("空格显示释义，1-4 评分；每 %d 个回答保存一次", (int)Review::kCommitEvery);
+            }
+            else
+            {
+                const Review::Card* card = Review::Current();
+                if (!card)
+                {
+                    ImGui::TextColored(ImVec4(0.4f, 0.9f, 0.4f, 1.0f), "今天的单词都复习完了");
+                }
+                else
+                {
+                    ImGui::Text("📖 %s", card->word.c_str());
+                    if (!card->pronunciation.empty())
+                    {
+                        ImGui::SameLine();
+                        ImGui::TextDisabled("[%s]", card->pronunciation.c_str());
+                    }
+                    const bool keys = !ImGui::GetIO().WantTextInput;
+                    if (Review::Revealed())
+                    {
+                        ImGui::TextWrapped("%s", card->meaning.c_str());
+                        static const ImGuiKey gradeKeys[] = { ImGuiKey_1, ImGuiKey_2, ImGuiKey_3, ImGuiKey_4 };
+                        for (int g = 0; g < (int)Review::Grade::Count; ++g)
+                        {
+                            if (g > 0) ImGui::SameLine();
+                            const Review::Grade grade = (Review::Grade)g;
+                            std::string label = std::string(Review::GradeName(grade)) + " (" + std::to_string(g + 1) + ")";
+                            if (ImGui::Button(label.c_str()) || (keys && ImGui::IsKeyPressed(gradeKeys[g], false)))
+                            {
+                                Review::Submit(grade);
+                                break;
+                            }
+                        }
+                    }
+                    else if (ImGui::Button("显示释义 (空格)") || (keys && ImGui::IsKeyPressed(ImGuiKey_Space, false)))
+                    {
+                        Review::Reveal();
+                    }
+                }
+                if (ImGui::Button("结束复习"))
+                {
+                    Review::End();
+                }
+            }
+
+            const Review::Stats rs = Review::GetStats();
+            if (rs.answered > 0 || Review::Active())
+            {
+                ImGui::Text("已复习 %d | %.1f 张/分钟 | 每张 p50 %.1fs, p95 %.1fs | 队列 %d | 未保存 %d | 保存 %d 次 (上次 %.1f ms, 最长 %.1f ms)",
+                    (int)rs.answered, rs.cardsPerMinute, rs.latencyP50Ms / 1000.0, rs.latencyP95Ms / 1000.0,
+                    (int)rs.queued, (int)rs.uncommitted, (int)rs.commits, rs.lastCommitMs, rs.maxCommitMs);
+                if (rs.failedCommits > 0)
+                {
+                    ImGui::SameLine();
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "保存失败 %d 次", (int)rs.failedCommits);
+                }
+            }
+        }
+
+        ImGui::Spacing();
+        if (ImGui::CollapsingHeader("📈 复习记录"))
+        {
+            DrawHistoryPanel();
+        }
+
         // 提醒设置区域
         ImGui::Spacing();
         if (ImGui::CollapsingHeader("🔔 提醒设置", ImGuiTreeNodeFlags_DefaultOpen))
@@ -2035,6 +2645,7 @@ namespace WordReminder
                 ImGui::SetTooltip("单词会像弹幕一样从屏幕右侧飘过，提供更直观的提醒效果");
             }
             
+#ifdef _WIN32
             // 弹幕控制按钮
             if (g_state->enableDanmaku)
             {
@@ -2050,6 +2661,21 @@ namespace WordReminder
                     StopDanmakuReminder();
                 }
             }
+#endif
+            if (ImGui::TreeNode("通知通道统计"))
+            {
+                Notifier::DrawStats();
+                ImGui::TreePop();
+            }
+            if (ImGui::TreeNode("文件监视"))
+            {
+                for (const auto& st : FileWatcher::GetStats())
+                {
+                    ImGui::BulletText("%s [%s]: 通知 %llu, 外部修改 %llu, 自己写入 %llu", st.file.c_str(), st.backend,
+                        (unsigned long long)st.events, (unsigned long long)st.changes, (unsigned long long)st.ownWrites);
+                }
+                ImGui::TreePop();
+            }
         }
         
         // 添加新单词区域
@@ -2225,7 +2851,7 @@ namespace WordReminder
                     ImGui::SameLine();
                     {
                         std::string id = std::string("##word_") + std::to_string(i);
-                        Utils::DrawCopyableText(id.c_str(), entry.word);
+                        Utils::DrawCopyableText(id.c_str(), Strings::Str(entry.word));
                     }
                     
                     // 已移除音标显示
@@ -2233,7 +2859,7 @@ namespace WordReminder
                     ImGui::TextWrapped("释义:");
                     {
                         std::string idm = std::string("##meaning_") + std::to_string(i);
-                        Utils::DrawCopyableMultiline(idm.c_str(), entry.meaning);
+                        Utils::DrawCopyableMultiline(idm.c_str(), Strings::Str(entry.meaning));
                     }
                     
                     if (entry.isMastered)
@@ -2280,9 +2906,9 @@ namespace WordReminder
                     {
                         g_state->selectedWordIndex = i;
                         g_state->isEditing = true;
-                        strncpy(g_state->editWord, entry.word.c_str(), sizeof(g_state->editWord));
+                        strncpy(g_state->editWord, Strings::CStr(entry.word), sizeof(g_state->editWord));
                         g_state->editWord[sizeof(g_state->editWord)-1] = '\0';
-                        strncpy(g_state->editMeaning, entry.meaning.c_str(), sizeof(g_state->editMeaning));
+                        strncpy(g_state->editMeaning, Strings::CStr(entry.meaning), sizeof(g_state->editMeaning));
                         g_state->editMeaning[sizeof(g_state->editMeaning)-1] = '\0';
                     }
                     
@@ -2302,6 +2928,7 @@ namespace WordReminder
                         {
                             auto& e = g_state->words[i];
                             e.remindTime = std::chrono::system_clock::now() + std::chrono::seconds(5);
+                            InvalidateDueSet();
                             SaveWords();
                         }
                     }
@@ -2316,8 +2943,10 @@ namespace WordReminder
                         if (ImGui::Button("保存"))
                         {
                             auto& e = g_state->words[i];
-                            e.word = g_state->editWord;
-                            e.meaning = g_state->editMeaning;
+                            e.word = Strings::Intern(g_state->editWord);
+                            e.meaning = Strings::Intern(g_state->editMeaning);
+                            e.revision++;
+                            InvalidateDueSet();
                             SaveWords();
                             g_state->isEditing = false;
                             g_state->selectedWordIndex = -1;
@@ -2349,9 +2978,9 @@ namespace WordReminder
                 static bool initialized = false;
                 if (!initialized || ImGui::IsWindowAppearing())
                 {
-                    strncpy(editWord, entry.word.c_str(), sizeof(editWord)); editWord[sizeof(editWord)-1] = '\0';
-                    strncpy(editPron, entry.pronunciation.c_str(), sizeof(editPron)); editPron[sizeof(editPron)-1] = '\0';
-                    strncpy(editMeaning, entry.meaning.c_str(), sizeof(editMeaning)); editMeaning[sizeof(editMeaning)-1] = '\0';
+                    strncpy(editWord, Strings::CStr(entry.word), sizeof(editWord)); editWord[sizeof(editWord)-1] = '\0';
+                    strncpy(editPron, Strings::CStr(entry.pronunciation), sizeof(editPron)); editPron[sizeof(editPron)-1] = '\0';
+                    strncpy(editMeaning, Strings::CStr(entry.meaning), sizeof(editMeaning)); editMeaning[sizeof(editMeaning)-1] = '\0';
                     initialized = true;
                 }
 
@@ -2362,9 +2991,11 @@ namespace WordReminder
                 ImGui::Separator();
                 if (ImGui::Button("保存", ImVec2(200, 0)))
                 {
-                    entry.word = editWord;
-                    entry.pronunciation = editPron;
-                    entry.meaning = editMeaning;
+                    entry.word = Strings::Intern(editWord);
+                    entry.pronunciation = Strings::Intern(editPron);
+                    entry.meaning = Strings::Intern(editMeaning);
+                    entry.revision++;
+                    InvalidateDueSet();
                     SaveWords();
                     g_state->selectedWordIndex = -1;
                     initialized = false;
@@ -2381,69 +3012,7 @@ namespace WordReminder
             }
         }
 
-        // 检查是否需要显示提醒窗口 - 进一步减少检查频率
-        static auto lastCheckTime = std::chrono::steady_clock::now();
-        static bool lastHasReminder = false;
-        static std::vector<WordEntry> lastDueWords; // 保存上次检查的单词列表
-        auto now = std::chrono::steady_clock::now();
-        
-        // 每1秒检查一次，避免过于频繁的检查
-        if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastCheckTime).count() >= 1000)
-        {
-            auto currentDueWords = GetDueWords();
-            bool currentHasReminder = !currentDueWords.empty();
-            
-            // 检查单词列表是否真正改变
-            bool wordsChanged = false;
-            if (currentDueWords.size() != lastDueWords.size())
-            {
-                wordsChanged = true;
-            }
-            else
-            {
-                // 比较每个单词的内容
-                for (size_t i = 0; i < currentDueWords.size(); ++i)
-                {
-                    if (i >= lastDueWords.size() || 
-                        currentDueWords[i].word != lastDueWords[i].word ||
-                        currentDueWords[i].meaning != lastDueWords[i].meaning)
-                    {
-                        wordsChanged = true;
-                        break;
-                    }
-                }
-            }
-            
-            // 只有当状态真正改变时才更新
-            if (currentHasReminder != lastHasReminder || wordsChanged)
-            {
-                g_state->showReminderPopup = currentHasReminder;
-                lastHasReminder = currentHasReminder;
-                lastDueWords = currentDueWords;
-            }
-            
-            lastCheckTime = now;
-        }
-        
-        // 系统级提醒通知 - Windows右上角原生弹窗
-        if (g_state->showReminderPopup)
-        {
 #ifdef _WIN32
-            EnsureReminderWindow();
-            
-            // 如果窗口创建失败或者没有需要复习的单词，重置标志
-            if (!g_reminderHwnd && !HasReminderToShow())
-            {
-                g_state->showReminderPopup = false;
-                lastHasReminder = false;
-            }
-#else
-            // 非Windows平台暂不支持系统级弹窗，回退到关闭标志
-            g_state->showReminderPopup = false;
-            lastHasReminder = false;
-#endif
-        }
-        
         // 弹幕提醒检查 - 只在需要时创建，避免重复创建
         static auto lastDanmakuCheckTime = std::chrono::steady_clock::now();
         static bool danmakuInitialized = false;
@@ -2477,6 +3046,7 @@ namespace WordReminder
             
             lastDanmakuCheckTime = danmakuNow;
         }
+#endif
         
         ImGui::End();
     }
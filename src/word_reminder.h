@@ -1,24 +1,31 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <chrono>
 
+#include "word_strings.h"
+
 namespace WordReminder
 {
-    // 单词条目结构
+    // 单词条目结构：只放提醒/统计要扫的字段，文本在 Strings 文本池里（见 word_strings.h），
+    // 整条 48 字节，按值复制很便宜
     struct WordEntry
     {
-        std::string word;
-        std::string meaning;
-        std::string pronunciation;
         std::chrono::system_clock::time_point remindTime;
+        std::chrono::system_clock::time_point lastReview;
+        uint64_t id;        // 进程内编号（不写入文件），按加入顺序递增
+        uint32_t revision;  // 单词/释义被编辑时递增，提醒弹窗据此只更新改动的条目
+        int reviewCount;
+        Strings::Handle word;
+        Strings::Handle meaning;
+        Strings::Handle pronunciation;
         bool isActive;
         bool isMastered;  // 新增：是否已掌握
-        int reviewCount;
-        std::chrono::system_clock::time_point lastReview;
         
-        WordEntry() : isActive(true), isMastered(false), reviewCount(0) {}
+        WordEntry() : id(0), revision(0), reviewCount(0), word(Strings::kEmpty), meaning(Strings::kEmpty),
+                      pronunciation(Strings::kEmpty), isActive(true), isMastered(false) {}
     };
     
     // 初始化功能模块
@@ -57,6 +64,10 @@ namespace WordReminder
     // 检查是否有需要提醒的单词
     bool HasReminderToShow();
     
+    // 到期检查：为新到期的单词向 Notifier 发事件，并驱动提醒弹窗。
+    // 主循环每帧调用，与单词窗口是否展开无关
+    void PollReminders();
+    
     // 获取需要提醒的单词列表
     std::vector<WordEntry> GetDueWords();
     
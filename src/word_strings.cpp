@@ -0,0 +1,168 @@
+#include "word_strings.h"
+#include "word_reminder.h"
+#include "word_reminder_utils.h"
+
+#include <functional>
+#include <unordered_map>
+
+namespace WordReminder
+{
+    namespace Strings
+    {
+        struct Slot
+        {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        static std::vector<char> g_bytes;   // 每个串后面跟一个 '\0'
+        static std::vector<Slot> g_slots;   // 下标即句柄，[0] 是空串
+        static std::unordered_multimap<size_t, Handle> g_lookup;  // 文本哈希 -> 句柄
+        static size_t g_compactedBytes = 0; // 上次整理（或清空）后的缓冲大小
+#ifdef _WIN32
+        static std::vector<std::wstring> g_wide;
+        static std::vector<bool> g_wideReady;
+#endif
+
+        static void EnsureInit()
+        {
+            if (!g_slots.empty()) return;
+            g_bytes.push_back('\0');
+            g_slots.push_back(Slot{ 0, 0 });
+            g_compactedBytes = g_bytes.size();
+#ifdef _WIN32
+            g_wide.emplace_back();
+            g_wideReady.push_back(true);
+#endif
+        }
+
+        static Handle Append(std::string_view text, size_t hash)
+        {
+            Handle h = (Handle)g_slots.size();
+            g_slots.push_back(Slot{ (uint32_t)g_bytes.size(), (uint32_t)text.size() });
+            g_bytes.insert(g_bytes.end(), text.begin(), text.end());
+            g_bytes.push_back('\0');
+            g_lookup.emplace(hash, h);
+#ifdef _WIN32
+            g_wide.emplace_back();
+            g_wideReady.push_back(false);
+#endif
+            return h;
+        }
+
+        Handle Intern(std::string_view text)
+        {
+            EnsureInit();
+            if (text.empty()) return kEmpty;
+            const size_t hash = std::hash<std::string_view>()(text);
+            auto range = g_lookup.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (View(it->second) == text) return it->second;
+            }
+            return Append(text, hash);
+        }
+
+        std::string_view View(Handle h)
+        {
+            if (h >= g_slots.size()) return std::string_view();
+            const Slot& s = g_slots[h];
+            return std::string_view(g_bytes.data() + s.offset, s.length);
+        }
+
+        const char* CStr(Handle h)
+        {
+            if (h >= g_slots.size()) return "";
+            return g_bytes.data() + g_slots[h].offset;
+        }
+
+#ifdef _WIN32
+        const std::wstring& Wide(Handle h)
+        {
+            EnsureInit();
+            if (h >= g_slots.size()) return g_wide[kEmpty];
+            if (!g_wideReady[h])
+            {
+                g_wide[h] = Utils::Utf8ToWide(Str(h));
+                g_wideReady[h] = true;
+            }
+            return g_wide[h];
+        }
+#endif
+
+        void Clear()
+        {
+            g_bytes.clear();
+            g_bytes.shrink_to_fit();
+            g_slots.clear();
+            g_slots.shrink_to_fit();
+            g_lookup.clear();
+#ifdef _WIN32
+            g_wide.clear();
+            g_wide.shrink_to_fit();
+            g_wideReady.clear();
+            g_wideReady.shrink_to_fit();
+#endif
+            EnsureInit();
+        }
+
+        size_t CompactIfNeeded(std::vector<WordEntry>& words)
+        {
+            EnsureInit();
+            if (g_bytes.size() < 4096 || g_bytes.size() < g_compactedBytes * 2) return 0;
+
+            const size_t before = g_bytes.size();
+            std::vector<char> oldBytes;
+            std::vector<Slot> oldSlots;
+            oldBytes.swap(g_bytes);
+            oldSlots.swap(g_slots);
+            g_lookup.clear();
+#ifdef _WIN32
+            std::vector<std::wstring> oldWide;
+            std::vector<bool> oldWideReady;
+            oldWide.swap(g_wide);
+            oldWideReady.swap(g_wideReady);
+#endif
+            EnsureInit();
+
+            // 旧句柄 -> 新句柄；0 表示还没搬过（空串本来就是 0）
+            std::vector<Handle> remap(oldSlots.size(), kEmpty);
+            auto move = [&](Handle& h) {
+                if (h == kEmpty || h >= oldSlots.size()) { h = kEmpty; return; }
+                if (remap[h] == kEmpty)
+                {
+                    const Slot& s = oldSlots[h];
+                    std::string_view text(oldBytes.data() + s.offset, s.length);
+                    Handle moved = Append(text, std::hash<std::string_view>()(text));
+#ifdef _WIN32
+                    if (oldWideReady[h])
+                    {
+                        g_wide[moved].swap(oldWide[h]);
+                        g_wideReady[moved] = true;
+                    }
+#endif
+                    remap[h] = moved;
+                }
+                h = remap[h];
+            };
+            for (WordEntry& entry : words)
+            {
+                move(entry.word);
+                move(entry.meaning);
+                move(entry.pronunciation);
+            }
+            g_compactedBytes = g_bytes.size();
+            return before - g_bytes.size();
+        }
+
+        size_t Count()
+        {
+            return g_slots.empty() ? 0 : g_slots.size() - 1;
+        }
+
+        size_t Bytes()
+        {
+            return g_bytes.size();
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace WordReminder
+{
+    struct WordEntry;
+
+    // 单词文本池：WordEntry 只存句柄，单词/释义/音标的字节集中放在一块连续缓冲里，
+    // 相同文本共用一个句柄。复制 WordEntry 只是复制句柄。
+    // 句柄在 Clear()/Compact() 之前一直有效；View()/CStr() 返回的指针在下一次 Intern() 之前有效。
+    // 只在 UI 线程使用。
+    namespace Strings
+    {
+        using Handle = uint32_t;
+        constexpr Handle kEmpty = 0;  // 空串，WordEntry 的默认值
+
+        Handle Intern(std::string_view text);
+        std::string_view View(Handle h);
+        const char* CStr(Handle h);  // 以 '\0' 结尾
+        inline std::string Str(Handle h) { return std::string(View(h)); }
+
+#ifdef _WIN32
+        // Win32 绘制用的宽字符形式，首次取用时转换并缓存
+        const std::wstring& Wide(Handle h);
+#endif
+
+        // 丢弃全部文本（切换/重新加载词库前，words 已清空时调用）
+        void Clear();
+
+        // 编辑留下的旧文本不再被引用；自上次整理后缓冲增长到两倍以上时，
+        // 只保留 words 引用的文本并改写它们的句柄。返回回收的字节数，没有整理时返回 0
+        size_t CompactIfNeeded(std::vector<WordEntry>& words);
+
+        size_t Count();
+        size_t Bytes();
+    }
+}
@@ -0,0 +1,135 @@
+// Build-time generator for GlyphCache's UI seed: collects every non-ASCII codepoint used in
+// string literals of the given sources and writes them as a C++ array.
+//
+// Usage: glyph_seed_gen <output.inc> <source>...
+// The output is only rewritten when its content changes, so unchanged labels do not trigger a
+// rebuild of glyph_cache.cpp.
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+
+// Minimal UTF-8 decoder; invalid bytes are skipped
+static void AddCodepoints(const std::string& text, size_t begin, size_t end, std::set<uint32_t>& out)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data()) + begin;
+    const unsigned char* e = reinterpret_cast<const unsigned char*>(text.data()) + end;
+    while (p < e)
+    {
+        unsigned char b = *p;
+        int len = b < 0x80 ? 1 : (b >> 5) == 0x6 ? 2 : (b >> 4) == 0xE ? 3 : (b >> 3) == 0x1E ? 4 : 0;
+        if (len == 0 || e - p < len) { ++p; continue; }
+        uint32_t c = len == 1 ? b : len == 2 ? (b & 0x1F) : len == 3 ? (b & 0x0F) : (b & 0x07);
+        for (int i = 1; i < len; ++i) c = (c << 6) | (p[i] & 0x3F);
+        p += len;
+        if (c >= 0x80 && !(c >= 0xFE00 && c <= 0xFE0F)) out.insert(c); // variation selectors have no glyph
+    }
+}
+
+// Walk the source skipping comments and character literals; only the contents of string
+// literals (plain, prefixed and raw) are collected
+static void ScanSource(const std::string& src, std::set<uint32_t>& out)
+{
+    const size_t n = src.size();
+    size_t i = 0;
+    while (i < n)
+    {
+        const char ch = src[i];
+        if (ch == '/' && i + 1 < n && src[i + 1] == '/')
+        {
+            while (i < n && src[i] != '\n') ++i;
+        }
+        else if (ch == '/' && i + 1 < n && src[i + 1] == '*')
+        {
+            const size_t close = src.find("*/", i + 2);
+            i = close == std::string::npos ? n : close + 2;
+        }
+        else if (ch == '\'')
+        {
+            for (++i; i < n && src[i] != '\'' && src[i] != '\n'; ++i)
+            {
+                if (src[i] == '\\') ++i;
+            }
+            ++i;
+        }
+        else if (ch == '"' && i > 0 && src[i - 1] == 'R')
+        {
+            // R"delim( ... )delim"
+            const size_t open = src.find('(', i + 1);
+            if (open == std::string::npos) break;
+            const std::string terminator = ")" + src.substr(i + 1, open - i - 1) + "\"";
+            const size_t close = src.find(terminator, open + 1);
+            const size_t end = close == std::string::npos ? n : close;
+            AddCodepoints(src, open + 1, end, out);
+            i = close == std::string::npos ? n : close + terminator.size();
+        }
+        else if (ch == '"')
+        {
+            const size_t begin = ++i;
+            for (; i < n && src[i] != '"' && src[i] != '\n'; ++i)
+            {
+                if (src[i] == '\\') ++i;
+            }
+            AddCodepoints(src, begin, i < n ? i : n, out);
+            ++i;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::fprintf(stderr, "usage: %s <output.inc> <source>...\n", argv[0]);
+        return 2;
+    }
+
+    std::set<uint32_t> codepoints;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::ifstream ifs(argv[i], std::ios::in | std::ios::binary);
+        if (!ifs)
+        {
+            std::fprintf(stderr, "glyph_seed_gen: cannot read %s\n", argv[i]);
+            return 1;
+        }
+        std::string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        ScanSource(text, codepoints);
+    }
+
+    std::string content = "// Generated by tools/glyph_seed_gen.cpp from the UI sources; do not edit.\n"
+                          "// Non-ASCII codepoints used in string literals, 0-terminated.\n"
+                          "static const uint32_t kUiSeed[] = {\n";
+    int column = 0;
+    for (uint32_t c : codepoints)
+    {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%s0x%04X,", column == 0 ? "    " : " ", (unsigned)c);
+        content += buf;
+        if (++column == 12) { content += '\n'; column = 0; }
+    }
+    content += column == 0 ? "    0\n};\n" : " 0\n};\n";
+
+    {
+        std::ifstream existing(argv[1], std::ios::in | std::ios::binary);
+        if (existing)
+        {
+            std::string old((std::istreambuf_iterator<char>(existing)), std::istreambuf_iterator<char>());
+            if (old == content) return 0;
+        }
+    }
+    std::ofstream ofs(argv[1], std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs || !ofs.write(content.data(), (std::streamsize)content.size()))
+    {
+        std::fprintf(stderr, "glyph_seed_gen: cannot write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}